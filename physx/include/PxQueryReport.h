@@ -63,6 +63,7 @@ struct PxActorShape
 struct PxRaycastHit : PxGeomRaycastHit, PxActorShape	{};
 struct PxOverlapHit : PxGeomOverlapHit, PxActorShape	{};
 struct PxSweepHit : PxGeomSweepHit, PxActorShape		{};
+struct PxNearestHit : PxGeomNearestHit, PxActorShape	{};
 
 /**
 \brief Describes query behavior after returning a partial query result via a callback.
@@ -925,6 +925,20 @@ public:
 	*/
 	PxU32	contactPairSlabSize;	
 
+	/**
+	\brief Defines the size of a chunk of the per-frame task arena.
+	Transient tasks and per-step data created during the simulation are allocated from a per-scene arena, which is reset
+	at the end of fetchResults(). Each worker thread carves its own slabs out of these chunks. The chunks are kept from
+	one frame to the next, so that the simulation does not allocate heap memory once the arena has grown to its high-water
+	mark. Larger chunks reduce the number of chunks but increase the memory wasted at the end of each slab.
+
+	<b>Range:</b>[16384, PX_MAX_U32)<br>
+	<b>Default:</b> 16384
+
+	\see PxSimulationStatistics::frameArenaHighWaterMark PxSimulationStatistics::frameArenaCapacity
+	*/
+	PxU32	frameArenaChunkSize;
+
 	/**
 	\brief The scene query sub-system for the scene.
 
@@ -1031,6 +1045,7 @@ PX_INLINE PxSceneDesc::PxSceneDesc(const PxTolerancesScale& scale):
 	gpuMaxNumStaticPartitions		(16),
 	gpuComputeVersion				(0),
 	contactPairSlabSize				(256),
+	frameArenaChunkSize				(16384),
 	sceneQuerySystem				(NULL),
 	tolerancesScale					(scale)
 {
@@ -1114,6 +1129,9 @@ PX_INLINE bool PxSceneDesc::isValid() const
 	if(contactPairSlabSize == 0)
 		return false;
 
+	if(frameArenaChunkSize < 16384)
+		return false;
+
 	return true;
 }
 
@@ -261,6 +261,23 @@ public:
 	*/
 	PxU32	dynamicNbObjectsPerNode;
 
+	/**
+	\brief Use a quantized tree for PxSceneQueryDesc::staticStructure queries.
+
+	When enabled, the AABB-tree is converted to a compressed format (4-wide nodes with 16-bit bounds) after each rebuild,
+	and queries run against that version. The original nodes are then released, which reduces both memory usage and the
+	memory traffic of queries on large scenes. The tree is rebuilt from scratch each time a static shape is added, removed
+	or moved, as is already the case without this flag.
+
+	This is only used with PxPruningStructureType::eSTATIC_AABB_TREE. Structures that are refit or rebuilt incrementally
+	(PxPruningStructureType::eDYNAMIC_AABB_TREE, and the dynamic structure in general) always use regular nodes.
+
+	<b>Default:</b> false
+
+	\see PxSceneQueryDesc::staticStructure
+	*/
+	bool	staticQuantizedTree;
+
 	/**
 	\brief Defines the scene query update mode.
 
@@ -297,6 +314,7 @@ PX_INLINE PxSceneQueryDesc::PxSceneQueryDesc():
 	dynamicBVHBuildStrategy		(PxBVHBuildStrategy::eFAST),
 	staticNbObjectsPerNode		(4),
 	dynamicNbObjectsPerNode		(4),
+	staticQuantizedTree			(false),
 	sceneQueryUpdateMode		(PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_ENABLED)
 {
 }
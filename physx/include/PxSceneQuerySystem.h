@@ -50,6 +50,7 @@ namespace physx
 	class PxBVH;
 	class PxPruningStructure;
 	class PxBounds3;
+	class PxPlane;
 
 	/**
 	\brief Built-in enum for default PxScene pruners
@@ -183,6 +184,37 @@ namespace physx
 								const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
 								const PxQueryCache* cache = NULL, PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const = 0;
 
+		/**
+		\brief Performs a batch of raycasts sharing the same hit flags and filtering.
+
+		This is equivalent to calling #raycast() for each ray, but implementations can process several rays at once
+		(for example by traversing the pruning structures with packets of rays) when the rays are coherent. Results are reported
+		per ray, in the corresponding hit callback. The default implementation simply calls #raycast() for each ray.
+
+		\note	Rays do not support a query cache in this function.
+		\note	Touching hits are not ordered.
+
+		\param[in] nbRays		Number of rays.
+		\param[in] origins		Origins of the rays (nbRays entries).
+		\param[in] unitDirs		Normalized directions of the rays (nbRays entries).
+		\param[in] distances	Lengths of the rays (nbRays entries). Have to be in the [0, inf) range.
+		\param[out] hitCalls	Raycast hit buffers or callback objects used to report raycast hits, one per ray (nbRays entries).
+		\param[in] hitFlags		Specifies which properties per hit should be computed and returned via the hit callbacks.
+		\param[in] filterData	Filtering data passed to the filter shader. 
+		\param[in] filterCall	Custom filtering logic (optional). Only used if the corresponding #PxQueryFlag flags are set. If NULL, all hits are assumed to be blocking.
+		\param[in] queryFlags	Optional flags controlling the query.
+
+		\see raycast PxRaycastCallback PxRaycastBuffer PxQueryFilterData PxQueryFilterCallback PxRaycastHit PxQueryFlag PxGeometryQueryFlag
+		*/
+		virtual void	raycastBatch(	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+										PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags = PxHitFlag::eDEFAULT,
+										const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
+										PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const
+		{
+			for(PxU32 i=0;i<nbRays;i++)
+				raycast(origins[i], unitDirs[i], distances[i], *hitCalls[i], hitFlags, filterData, filterCall, NULL, queryFlags);
+		}
+
 		/**
 		\brief Performs a sweep test against objects in the scene, returns results in a PxSweepBuffer object
 		or via a custom user callback implementation inheriting from PxSweepCallback.
@@ -241,6 +273,89 @@ namespace physx
 		virtual bool	overlap(const PxGeometry& geometry, const PxTransform& pose, PxOverlapCallback& hitCall,
 								const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
 								const PxQueryCache* cache = NULL, PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const = 0;
+
+		/**
+		\brief Frustum / k-DOP culling test against objects in the scene, returns results in a PxOverlapBuffer object
+		or via a custom user callback implementation inheriting from PxOverlapCallback.
+
+		The planes define a convex volume, with normals pointing outward. Objects whose bounds are fully on the positive side
+		of any plane are culled. Results are not exact: the test is performed on the objects' bounds only, without narrow-phase,
+		which is usually an ok trade-off for view-frustum culling. Subtrees fully inside the volume are reported without further
+		plane tests, and touches are reported in bulk through the hit callback.
+
+		\note Filtering: returning eBLOCK from user filter for cull queries will cause a warning (see #PxQueryHitType).
+		\note The returned hits have no face index.
+
+		\param[in] nbPlanes		Number of planes. Only up to 32 planes are supported.
+		\param[in] planes		Array of planes, should be in the same space as the scene objects.
+		\param[out] hitCall		Overlap hit buffer or callback object used to report culling results.
+		\param[in] filterData	Filtering data and simple logic. See #PxQueryFilterData #PxQueryFilterCallback
+		\param[in] filterCall	Custom filtering logic (optional). Only used if the corresponding #PxQueryFlag flags are set. If NULL, all hits are assumed to overlap.
+		\param[in] queryFlags	Optional flags controlling the query.
+
+		\return True if any touching or blocking hits were found or any hit was found in case PxQueryFlag::eANY_HIT was specified.
+
+		\note The default implementation does not report anything and returns false, so that existing PxSceneQuerySystem
+		implementations do not have to provide this function. The PhysX implementations (PxScene and the systems created by
+		PxCreateExternalSceneQuerySystem() and PxCreateCustomSceneQuerySystem()) all support it.
+
+		\see PxOverlapCallback PxOverlapBuffer PxQueryFilterData PxQueryFilterCallback PxGeometryQueryFlag PxBVH::cull
+		*/
+		virtual bool	cull(	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hitCall,
+								const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
+								PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const
+		{
+			PX_UNUSED(nbPlanes);
+			PX_UNUSED(planes);
+			PX_UNUSED(hitCall);
+			PX_UNUSED(filterData);
+			PX_UNUSED(filterCall);
+			PX_UNUSED(queryFlags);
+			return false;
+		}
+
+		/**
+		\brief Finds the objects closest to a point, within a maximum distance.
+
+		Returns up to maxNbHits objects, sorted by increasing distance to the point. The scene's pruners are traversed best-first,
+		and once the hit buffer is full the search distance shrinks to the distance of the furthest hit in the buffer. Use
+		maxNbHits = 1 to find the closest object.
+
+		Distances are exact for spheres, capsules, boxes, convex meshes, planes and triangle meshes using the BVH34 midphase (see
+		#PxGeometryQuery::pointDistance()). For other geometry types the distance to the object's bounds is used.
+
+		\note Filtering: hits are discarded when the user filter returns eNONE. eBLOCK and eTOUCH are treated the same way.
+		\note If PxQueryFlag::eANY_HIT is specified, the query stops after the first object found within maxDist.
+
+		\param[in] point		The query point.
+		\param[in] maxDist		Maximum distance between the point and the returned objects.
+		\param[out] hits		Buffer receiving the results, sorted by increasing distance.
+		\param[in] maxNbHits	Size of the hits buffer.
+		\param[in] filterData	Filtering data and simple logic. See #PxQueryFilterData #PxQueryFilterCallback
+		\param[in] filterCall	Custom filtering logic (optional). Only used if the corresponding #PxQueryFlag flags are set. If NULL, all objects are accepted.
+		\param[in] queryFlags	Optional flags controlling the query.
+
+		\return Number of hits written to the buffer.
+
+		\note The default implementation does not report anything and returns 0, so that existing PxSceneQuerySystem implementations
+		do not have to provide this function. The PhysX implementations (PxScene and the systems created by
+		PxCreateExternalSceneQuerySystem() and PxCreateCustomSceneQuerySystem()) all support it.
+
+		\see PxNearestHit PxQueryFilterData PxQueryFilterCallback PxGeometryQueryFlag PxGeometryQuery::pointDistance
+		*/
+		virtual PxU32	nearest(const PxVec3& point, PxReal maxDist, PxNearestHit* hits, PxU32 maxNbHits,
+								const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
+								PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const
+		{
+			PX_UNUSED(point);
+			PX_UNUSED(maxDist);
+			PX_UNUSED(hits);
+			PX_UNUSED(maxNbHits);
+			PX_UNUSED(filterData);
+			PX_UNUSED(filterCall);
+			PX_UNUSED(queryFlags);
+			return 0;
+		}
 		//\}
 	};
 
@@ -199,6 +199,20 @@ public:
 	*/
 	PxU32   peakConstraintMemory;
 
+	/**
+	\brief The largest amount of memory (in bytes) used by the per-frame task arena in a single simulation step so far
+
+	\see PxSceneDesc::frameArenaChunkSize
+	*/
+	PxU64	frameArenaHighWaterMark;
+
+	/**
+	\brief The amount of memory (in bytes) currently reserved by the per-frame task arena
+
+	\see PxSceneDesc::frameArenaChunkSize
+	*/
+	PxU64	frameArenaCapacity;
+
 //broadphase:
 	/**
 	\brief Get number of broadphase volumes added for the current simulation step.
@@ -428,6 +442,8 @@ public:
 		compressedContactSize					(0),
 		requiredContactConstraintMemory			(0),
 		peakConstraintMemory					(0),
+		frameArenaHighWaterMark					(0),
+		frameArenaCapacity						(0),
 		nbDiscreteContactPairsTotal				(0),
 		nbDiscreteContactPairsWithCacheHits		(0),
 		nbDiscreteContactPairsWithContacts		(0),
@@ -50,6 +50,7 @@ class PxInsertionCallback;
 class PxFoundation;
 class PxAllocatorCallback;
 class PxHeightFieldDesc;
+class PxCpuDispatcher;
 
 /**
 \brief Result from convex cooking.
@@ -357,6 +358,19 @@ struct PxCookingParams
 	*/
 	PxReal maxWeightRatioInTet;
 
+	/**
+	\brief Optional CPU dispatcher used to run the expensive stages of mesh cooking in parallel.
+
+	When set, the BVH34 (BV4) and BV32 midphase trees of large triangle and tetrahedron meshes are built as independent
+	subtrees on the dispatcher's worker threads, and PxCookConvexMeshes() cooks its meshes on these threads. The cooked data
+	is identical to the single-threaded result. The dispatcher must remain valid for the duration of the cooking call.
+
+	\note SDF construction uses its own threads, see PxSDFDesc::numThreadsForSdfConstruction.
+
+	<b>Default value:</b> NULL (single-threaded cooking)
+	*/
+	PxCpuDispatcher* cpuDispatcher;
+
 	PxCookingParams(const PxTolerancesScale& sc):
 		areaTestEpsilon					(0.06f*sc.length*sc.length),
 		planeTolerance					(0.0007f),
@@ -370,7 +384,8 @@ struct PxCookingParams
 		meshAreaMinLimit				(0.0f),
 		meshEdgeLengthMaxLimit			(500.0f),
 		gaussMapLimit					(32),
-		maxWeightRatioInTet             (FLT_MAX)
+		maxWeightRatioInTet             (FLT_MAX),
+		cpuDispatcher					(NULL)
 	{
 	}
 };
@@ -507,6 +522,33 @@ suitable for loading and performing collision detection at runtime.
 */
 PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCookConvexMesh(const physx::PxCookingParams& params, const physx::PxConvexMeshDesc& desc, physx::PxOutputStream& stream, physx::PxConvexMeshCookingResult::Enum* condition=NULL);
 
+/**
+\brief Cooks a batch of convex meshes. The results are written to the streams.
+
+Identical descriptors (same input points, user-provided polygons and indices, flags and limits) are detected by hashing
+their input data and are cooked only once: the cooked data is then written to the stream of each duplicate. The remaining
+work is distributed over the worker threads of PxCookingParams::cpuDispatcher and the calling thread. Each thread reuses its
+convex hull scratch buffers from one mesh to the next, and they are released when the batch is complete. The cooked data is the same as
+cooking each descriptor with PxCookConvexMesh().
+
+\note Each stream is only written by one thread, but not necessarily by the calling thread. The streams must be distinct
+objects, and their write functions must be safe to call from the dispatcher's worker threads.
+\note Descriptors with an SDF descriptor are cooked on the calling thread, since SDF construction writes back to the
+PxSDFDesc and uses its own threads (see PxSDFDesc::numThreadsForSdfConstruction).
+\note Only identical inputs are shared. Instances of a mesh with a different scale should be cooked once and used with
+PxMeshScale instead.
+
+\param[in] params		The cooking parameters. If PxCookingParams::cpuDispatcher is NULL, all meshes are cooked on the calling thread.
+\param[in] descs		The convex mesh descriptors, count of them.
+\param[in] count		Number of descriptors.
+\param[in] streams		User streams to output the cooked data, count of them.
+\param[out] conditions	Optional results from convex mesh cooking, count of them.
+\return Number of successfully cooked meshes, i.e. count on success.
+
+\see PxCookConvexMesh() PxConvexMeshCookingResult::Enum
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	physx::PxU32 PxCookConvexMeshes(const physx::PxCookingParams& params, const physx::PxConvexMeshDesc* descs, physx::PxU32 count, physx::PxOutputStream* const* streams, physx::PxConvexMeshCookingResult::Enum* conditions=NULL);
+
 /**
 \brief Cooks and creates a convex mesh without going through a stream.
 
@@ -36,6 +36,8 @@ namespace physx
 {
 #endif
 
+	class PxCpuDispatcher;
+
 	/**
 	\brief A custom scene query system.
 
@@ -173,12 +175,13 @@ namespace physx
 	\param[in] contextID				Context ID parameter, sent to the profiler
 	\param[in] adapter					Adapter class implementing our extended API
 	\param[in] usesTreeOfPruners		True to keep pruners themselves in a BVH, which might increase query performance if a lot of pruners are involved
+	\param[in] dispatcher				Optional CPU dispatcher used to update the pruners (and refit large dynamic trees) in parallel. NULL to update them serially.
 
 	\return	A custom SQ system instance
 
 	\see PxCustomSceneQuerySystem PxSceneQueryUpdateMode PxCustomSceneQuerySystemAdapter PxSceneDesc::sceneQuerySystem
 	*/
-	PxCustomSceneQuerySystem* PxCreateCustomSceneQuerySystem(PxSceneQueryUpdateMode::Enum sceneQueryUpdateMode, PxU64 contextID, const PxCustomSceneQuerySystemAdapter& adapter, bool usesTreeOfPruners=false);
+	PxCustomSceneQuerySystem* PxCreateCustomSceneQuerySystem(PxSceneQueryUpdateMode::Enum sceneQueryUpdateMode, PxU64 contextID, const PxCustomSceneQuerySystemAdapter& adapter, bool usesTreeOfPruners=false, PxCpuDispatcher* dispatcher=NULL);
 
 #if !PX_DOXYGEN
 } // namespace physx
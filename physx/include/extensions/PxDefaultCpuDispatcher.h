@@ -90,6 +90,31 @@ struct PxDefaultCpuDispatcherWaitForWorkMode
 	};
 };
 
+/**
+\brief Defines how the default dispatcher distributes tasks among its worker threads.
+
+a) eSHARED_QUEUE: tasks submitted from a worker thread go to that worker's local queue, other tasks go to a queue shared by all
+workers. Idle workers scan the shared queue and all other local queues.
+b) eWORK_STEALING: each worker additionally owns a lock-free work-stealing deque. Tasks submitted from a worker thread are pushed to
+that worker's deque and executed in LIFO order by the same worker, while idle workers steal the oldest tasks from randomly chosen
+victims. This reduces contention on the shared queue when many worker threads are used.
+c) eNUMA_AWARE: same as eWORK_STEALING, but worker threads are grouped per NUMA node and each node gets its own task queue.
+Tasks with a locality hint (see PxBaseTask::setLocalityHint()) are routed to the queue of their preferred node, and idle workers
+look for work on their own node before stealing from other nodes. Unless affinity masks are provided, worker threads are pinned
+to the CPUs of their node. The topology is read from sysfs on Linux, other platforms behave like eWORK_STEALING.
+
+\note High priority tasks are always scheduled through the regular queues, before tasks from the work-stealing deques.
+*/
+struct PxDefaultCpuDispatcherSchedulingMode
+{
+	enum Enum
+	{
+		eSHARED_QUEUE,
+		eWORK_STEALING,
+		eNUMA_AWARE
+	};
+};
+
 
 /**
 \brief Create default dispatcher, extensions SDK needs to be initialized first.
@@ -99,6 +124,7 @@ struct PxDefaultCpuDispatcherWaitForWorkMode
 \param[in] mode is the strategy employed when a busy-wait is encountered. 
 \param[in] yieldProcessorCount specifies the number of times a OS-specific yield processor command will be executed
 during each cycle of a busy-wait in the event that the specified mode is eYIELD_PROCESSOR
+\param[in] schedulingMode is the strategy used to distribute tasks among worker threads.
 
 \note numThreads may be zero in which case no worker thread are initialized and
 simulation tasks will be executed on the thread that calls PxScene::simulate()
@@ -108,9 +134,9 @@ simulation tasks will be executed on the thread that calls PxScene::simulate()
 \note eYIELD_THREAD and eYIELD_PROCESSOR modes will use compute resources even if the simulation is not running.
 It is left to users to keep threads inactive, if so desired, when no simulation is running.
 
-\see PxDefaultCpuDispatcher
+\see PxDefaultCpuDispatcher PxDefaultCpuDispatcherSchedulingMode
 */
-PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks = NULL, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode = PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK, PxU32 yieldProcessorCount = 0);
+PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks = NULL, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode = PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK, PxU32 yieldProcessorCount = 0, PxDefaultCpuDispatcherSchedulingMode::Enum schedulingMode = PxDefaultCpuDispatcherSchedulingMode::eSHARED_QUEUE);
 
 #if !PX_DOXYGEN
 } // namespace physx
@@ -134,6 +134,41 @@ private:
 		PxU32			mLength;
 };
 
+/**
+\brief default implementation of a copy-on-write memory mapping of a file
+
+Maps a binary serialized collection for zero-copy loading with PxSerialization::createCollectionFromBinary(). The mapping
+is page aligned, which satisfies the 128 bytes alignment required for the memory block, and the serialized data is already
+laid out with the alignment required by the runtime objects. Deserialized meshes (e.g. PxTriangleMesh with a BVH34
+midphase, PxConvexMesh) point directly into the mapped pages instead of copying their data.
+
+Deserialization only writes to the serialized objects themselves (pointer and vtable fix-ups). These pages get private
+copies, while the pages holding the bulk mesh data (vertices, triangles, midphase nodes, hull data) are never written:
+they are loaded on demand by the OS and shared with other processes mapping the same file. The file itself is never
+modified.
+
+\note The mapping must outlive all the objects deserialized from it.
+\note On platforms without file mapping support the file is read into an aligned memory block instead.
+
+\see PxSerialization::createCollectionFromBinary
+*/
+class PxDefaultMemoryMappedFile
+{
+	PX_NOCOPY(PxDefaultMemoryMappedFile)
+public:
+						PxDefaultMemoryMappedFile(const char* name);
+						~PxDefaultMemoryMappedFile();
+
+	PX_FORCE_INLINE	void*	getAddress()	const	{ return mAddress;	}
+	PX_FORCE_INLINE	PxU32	getLength()		const	{ return mLength;	}
+
+				bool	isValid()		const;
+private:
+				void*	mAddress;
+				PxU32	mLength;
+				void*	mHandle;	// mapping handle, or allocated block when the file could not be mapped
+};
+
 #if !PX_DOXYGEN
 }
 #endif
@@ -434,9 +434,32 @@ public:
 		PxU16 maxNbTouches = 0,
 		const PxQueryFilterData& filterData = PxQueryFilterData(),
 		const PxQueryCache* cache = NULL) = 0;
-		
+
+	/**
+	\brief Performs all queries issued since the last call to execute(), on the calling thread.
+
+	Touch buffers are packed: each query only consumes the touches it actually reported.
+	*/
 	virtual void execute() = 0;
 
+	/**
+	\brief Performs all queries issued since the last call to execute(), as tasks submitted to the task manager of completionTask.
+
+	Raycasts, sweeps and overlaps are split into chunks of nbQueriesPerTask queries, and each chunk is executed as a PxLightCpuTask
+	running on the CPU dispatcher of that task manager (typically the scene's one, see PxScene::getTaskManager()). The results are available
+	once completionTask runs. Until then, no queries can be added to this object and it must not be executed again or released.
+
+	\note	Since queries complete in any order, each query reserves its requested number of touches up-front in the touch buffer.
+			Queries that do not fit report PxBatchQueryStatus::eOVERFLOW if they found touching hits, even if the touch buffer
+			would have been large enough for the touches actually reported by execute().
+
+	\param[in] completionTask		Task that is started when all queries have been performed. Must be associated with a task manager.
+	\param[in] nbQueriesPerTask	Number of queries executed by each task. Has to be greater than zero.
+
+	\see PxLightCpuTask PxTaskManager
+	*/
+	virtual void execute(PxBaseTask* completionTask, PxU32 nbQueriesPerTask = 64) = 0;
+
 protected:
 
 	virtual ~PxBatchQueryExt() {}
@@ -497,6 +520,81 @@ PxBatchQueryExt* PxCreateBatchQueryExt(
 	PxSweepBuffer* sweepBuffers, const PxU32 maxNbSweeps, PxSweepHit* sweepTouches, const PxU32 maxNbSweepTouches,
 	PxOverlapBuffer* overlapBuffers, const PxU32 maxNbOverlaps, PxOverlapHit* overlapTouches, const PxU32 maxNbOverlapTouches);
 
+/**
+\brief Cache for persistent overlap queries, i.e. queries issued every frame with slowly moving query volumes (characters, triggers, etc).
+
+Each persistent query is identified by a user handle. The first time a query runs, the static objects touching an inflated version of
+its world bounds are gathered and stored as candidates for that handle. As long as subsequent queries with the same handle stay within
+these inflated bounds, only the stored candidates are tested against the query volume, instead of traversing the static pruning structure.
+
+Candidates are gathered again when the query volume leaves the inflated bounds, or when the scene's static scene query timestamp changes
+(see #PxScene::getSceneQueryStaticTimestamp()). Candidates are cached unfiltered: the filter data and filtering callbacks are applied for
+each query, so changing a shape's query filter data does not require invalidating the cache. Dynamic objects are always queried from the scene.
+
+Results are the same as for #PxScene::overlap(), filtering callbacks included. Queries against a cache are NOT thread safe.
+
+\see PxCreateOverlapCacheExt PxScene::overlap
+*/
+class PxOverlapCacheExt
+{
+public:
+
+	virtual void release() = 0;
+
+	/**
+	\brief Performs an overlap test of a given geometry against objects in the scene, reusing the static candidates cached for a handle.
+
+	\param[in] handle		User handle of the persistent query. Must be smaller than the maxNbHandles value passed to #PxCreateOverlapCacheExt.
+	\param[in] geometry		Geometry of object to check for overlap (supported types are: box, sphere, capsule, convex).
+	\param[in] pose			Pose of the object.
+	\param[out] hitCall		Overlap hit buffer or callback object used to report overlap hits.
+	\param[in] filterData	Filtering data and simple logic. See #PxQueryFilterData #PxQueryFilterCallback
+	\param[in] filterCall	Custom filtering logic (optional). Only used if the corresponding #PxQueryFlag flags are set. If NULL, all hits are assumed to overlap.
+
+	\return True if any touching or blocking hits were found or any hit was found in case PxQueryFlag::eANY_HIT was specified.
+
+	\see PxScene::overlap
+	*/
+	virtual bool overlap(
+		PxU32 handle, const PxGeometry& geometry, const PxTransform& pose, PxOverlapCallback& hitCall,
+		const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL) = 0;
+
+	/**
+	\brief Discards the candidates cached for a handle. The next query for this handle gathers them again.
+
+	\param[in] handle		User handle of the persistent query.
+	*/
+	virtual void invalidate(PxU32 handle) = 0;
+
+	/**
+	\brief Discards the candidates cached for all handles.
+	*/
+	virtual void invalidateAll() = 0;
+
+	/**
+	\brief Returns the number of static candidates currently cached for a handle.
+
+	\param[in] handle		User handle of the persistent query.
+	*/
+	virtual PxU32 getNbCandidates(PxU32 handle) const = 0;
+
+protected:
+
+	virtual ~PxOverlapCacheExt() {}
+};
+
+/**
+\brief Create a PxOverlapCacheExt.
+
+\param[in] scene			Queries will be performed against objects in the specified PxScene
+\param[in] maxNbHandles		Number of persistent queries, i.e. valid handles are in [0, maxNbHandles).
+\param[in] volumeGrowth		Growth factor applied to the query volume's bounds when gathering candidates. Must be >= 1.0. Larger values
+							gather more candidates but let the query volume move further before they are gathered again.
+
+\return Returns a PxOverlapCacheExt instance, or NULL if the arguments are illegal.
+*/
+PxOverlapCacheExt* PxCreateOverlapCacheExt(const PxScene& scene, PxU32 maxNbHandles, PxReal volumeGrowth = 1.5f);
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
@@ -36,6 +36,8 @@ namespace physx
 {
 #endif
 
+	class PxCpuDispatcher;
+
 	/**
 	\brief Creates an external scene query system.
 
@@ -49,12 +51,13 @@ namespace physx
 
 	\param[in] desc			Scene query descriptor
 	\param[in] contextID	Context ID parameter, sent to the profiler
+	\param[in] dispatcher	Optional CPU dispatcher used to update the pruners (and refit large dynamic trees) in parallel. NULL to update them serially.
 
 	\return	An external SQ system instance
 
 	\see PxSceneQuerySystem PxSceneQueryDesc
 	*/
-	PxSceneQuerySystem* PxCreateExternalSceneQuerySystem(const PxSceneQueryDesc& desc, PxU64 contextID);
+	PxSceneQuerySystem* PxCreateExternalSceneQuerySystem(const PxSceneQueryDesc& desc, PxU64 contextID, PxCpuDispatcher* dispatcher=NULL);
 
 #if !PX_DOXYGEN
 } // namespace physx
@@ -178,11 +178,14 @@ public:
 	which is defined by "PX_PHYSICS_VERSION_MAJOR.PX_PHYSICS_VERSION_MINOR.PX_PHYSICS_VERSION_BUGFIX-PX_BINARY_SERIAL_VERSION".
 	For a list of compatible sdk releases refer to the documentation of PX_BINARY_SERIAL_VERSION.
 
+	Deserialized objects point into the memory block, which must outlive them. Use PxDefaultMemoryMappedFile to deserialize
+	directly from a mapped file without reading it into memory first.
+
 	\param[in] memBlock Pointer to memory block containing the serialized collection
 	\param[in] sr PxSerializationRegistry instance with information about registered classes.
 	\param[in] externalRefs Collection to resolve external dependencies
 
-	\see PxCollection, PxSerialization::complete, PxSerialization::serializeCollectionToBinary, PxSerializationRegistry, PX_BINARY_SERIAL_VERSION
+	\see PxCollection, PxSerialization::complete, PxSerialization::serializeCollectionToBinary, PxSerializationRegistry, PX_BINARY_SERIAL_VERSION, PxDefaultMemoryMappedFile
 	*/
 	static	PxCollection*	createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL);
 
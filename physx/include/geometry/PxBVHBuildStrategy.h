@@ -46,6 +46,7 @@ struct PxBVHBuildStrategy
 		eFAST = 0,		//!< Fast build strategy. Fast build speed, good runtime performance in most cases. Recommended for runtime cooking.
 		eDEFAULT = 1,	//!< Default build strategy. Medium build speed, good runtime performance in all cases.
 		eSAH = 2,		//!< SAH build strategy. Slower builds, slightly improved runtime performance in some cases.
+		eSAH_PARALLEL = 3,	//!< Same as eSAH, but large trees are built in parallel using the scene's CPU dispatcher when one is available. Falls back to eSAH otherwise, e.g. for PxCookBVH() and PxCreateBVH().
 
 		eLAST
 	};
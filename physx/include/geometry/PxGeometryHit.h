@@ -172,6 +172,21 @@ struct PxGeomSweepHit : PxLocationHit
 	PX_INLINE			PxGeomSweepHit() {}
 };
 
+/**
+\brief Stores results of nearest-neighbour queries.
+
+\note The inherited faceIndex is the index of the closest triangle for triangle meshes, and 0xFFFFffff otherwise.
+
+\see PxSceneQuerySystemBase.nearest
+*/
+struct PxGeomNearestHit : PxQueryHit
+{
+	PX_INLINE			PxGeomNearestHit() : position(PxVec3(0)), distance(PX_MAX_REAL)	{}
+
+	PxVec3				position;	//!< World-space closest point on the object. Equal to the query point if it is inside the object.
+	PxF32				distance;	//!< Distance between the query point and the object, 0 if the point is inside the object.
+};
+
 /**
 \brief Pair of indices, typically either object or triangle indices.
 */
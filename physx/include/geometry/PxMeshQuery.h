@@ -63,6 +63,22 @@ class PxTriangle;
 
 	PX_FLAGS_TYPEDEF(PxMeshMeshQueryFlag, PxU32)
 
+/**
+\brief Describes one sweep of a batched sweep against a triangle mesh.
+
+\see PxMeshQuery::sweepBatch
+*/
+struct PxMeshSweepDesc
+{
+	PX_INLINE PxMeshSweepDesc() : geometry(NULL), pose(PxIdentity), unitDir(0.0f), distance(0.0f), inflation(0.0f)	{}
+
+	const PxGeometry*	geometry;	//!< The geometry object to sweep. Supported geometries are #PxSphereGeometry, #PxCapsuleGeometry and #PxBoxGeometry
+	PxTransform			pose;		//!< Pose of the geometry object to sweep
+	PxVec3				unitDir;	//!< Normalized direction of the sweep
+	PxReal				distance;	//!< Sweep distance. Needs to be larger than 0. Clamped to PX_MAX_SWEEP_DISTANCE.
+	PxReal				inflation;	//!< Skin around the swept geometry, see #PxMeshQuery::sweep()
+};
+
 class PxMeshQuery
 {
 public:
@@ -273,6 +289,38 @@ public:
 							const PxReal inflation = 0.0f,
 							bool doubleSided = false,
 							PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
+
+	/**
+	\brief Sweep a batch of geometry objects against the same triangle mesh.
+
+	This is equivalent to sweeping each object against the mesh individually, but the mesh's midphase structure is traversed once
+	for a bundle of sweeps instead of once per sweep. This is faster when many small sweeps are performed against the same mesh,
+	e.g. for vehicle suspensions or character controllers moving on a terrain mesh.
+
+	Each sweep gets its own result slot: sweepHits[i] contains the closest hit for sweeps[i]. Slots for sweeps that did not hit
+	anything are reset to a default-constructed PxGeomSweepHit, i.e. with faceIndex set to 0xffffffff and distance set to PX_MAX_REAL.
+
+	\param[in] meshGeom		The triangle mesh to sweep against.
+	\param[in] meshPose		Pose of the triangle mesh.
+	\param[in] nbSweeps		Number of sweeps in the batch.
+	\param[in] sweeps			Array of nbSweeps sweep descriptors.
+	\param[out] sweepHits		Array of nbSweeps result slots.
+	\param[in] hitFlags		Specification of the kind of information to retrieve on hit, shared by all sweeps. Combination of #PxHitFlag flags.
+	\param[in] queryFlags		Optional flags controlling the query.
+	\return Number of sweeps that hit the mesh.
+
+	\note Only the following geometry types are currently supported: PxSphereGeometry, PxCapsuleGeometry, PxBoxGeometry
+	\note The batched midphase is only available for meshes using the BVH34 midphase. Other meshes perform one midphase query per sweep. Results are the same in both cases.
+	\note Supported hitFlags and returned results follow the rules of the triangle-array version of #PxMeshQuery::sweep(), for all meshes. In particular PxHitFlag::eMTD is not supported.
+	\note All sweeps are validated before any of them is performed. If one of them is invalid, an error is reported and the function returns 0 without writing any result.
+	\note The returned PxGeomSweepHit::faceIndex parameter is the index of the hit triangle in the mesh.
+
+	\see PxMeshSweepDesc PxGeomSweepHit PxTriangleMeshGeometry PxGeometryQueryFlags
+	*/
+	PX_PHYSX_COMMON_API static PxU32 sweepBatch(const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshPose,
+							PxU32 nbSweeps, const PxMeshSweepDesc* sweeps, PxGeomSweepHit* sweepHits,
+							PxHitFlags hitFlags = PxHitFlag::eDEFAULT,
+							PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
 };
 
 
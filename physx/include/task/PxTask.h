@@ -44,7 +44,7 @@ namespace physx
 class PxBaseTask
 {
 public:
-	PxBaseTask() : mContextID(0), mTm(NULL) {}
+	PxBaseTask() : mContextID(0), mTm(NULL), mLocalityHint(0xffffffff) {}
 	virtual ~PxBaseTask() {}
 
     /**
@@ -105,9 +105,28 @@ public:
 	PX_FORCE_INLINE	void	setContextId(PxU64 id)			{ mContextID = id;		}
 	PX_FORCE_INLINE	PxU64	getContextId()			const	{ return mContextID;	}
 
+    /**
+     * \brief Tells the scheduler which group of threads should preferably run this task.
+     *
+     * Tasks with the same hint touch related data (e.g. they belong to the same solver island batch),
+     * and a topology-aware scheduler can use this to keep them on the same NUMA node. Like isHighPriority(),
+     * this is only a hint and schedulers are free to ignore it.
+	 *
+	 * \param[in] hint An arbitrary locality group index, or 0xffffffff for tasks without locality preference (default)
+     */
+	PX_FORCE_INLINE	void	setLocalityHint(PxU32 hint)	{ mLocalityHint = hint;	}
+
+    /**
+     * \brief Return the locality hint set with setLocalityHint()
+     *
+	 * \return An arbitrary locality group index, or 0xffffffff for tasks without locality preference
+     */
+	PX_FORCE_INLINE	PxU32	getLocalityHint()	const	{ return mLocalityHint;	}
+
 protected:
 	PxU64				mContextID;		//!< Context ID for profiler interface
 	PxTaskManager*		mTm;			//!< Owning PxTaskManager instance
+	PxU32				mLocalityHint;	//!< Preferred thread group, see setLocalityHint()
 
 	friend class PxTaskMgr;
 };
@@ -0,0 +1,149 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet is a micro-benchmark for standalone broadphases in mostly-sleeping
+// worlds. Most objects are static or never move, a few objects move a little each
+// frame, and every now and then a batch of sleeping objects is teleported to a new
+// location (e.g. respawned). Small moves exercise the incremental update paths,
+// while teleports are the case where sorted broadphases like SAP have to move
+// endpoints a long way. The average time per frame is printed for each broadphase.
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+#include "../snippetcommon/SnippetPrint.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+
+static const PxU32	gNbStatics			= 20000;
+static const PxU32	gNbSleeping			= 20000;
+static const PxU32	gNbMovers			= 500;
+static const PxU32	gNbTeleported		= 2000;	// sleeping objects teleported on teleport frames
+static const PxU32	gTeleportPeriod		= 20;
+static const PxU32	gNbFrames			= 200;
+static const float	gWorldSize			= 1000.0f;
+static const float	gMoveDistance		= 0.5f;
+
+static const PxU32	gNbDynamics			= gNbSleeping + gNbMovers;
+static const PxU32	gNbObjects			= gNbStatics + gNbDynamics;
+
+static PxBounds3*	gBounds = NULL;
+
+static PxBounds3 computeRandomBounds(SnippetUtils::BasicRandom& rnd)
+{
+	const PxVec3 center(rnd.randomFloat32() * gWorldSize, rnd.randomFloat32() * gWorldSize, rnd.randomFloat32() * gWorldSize);
+	const PxVec3 extents(1.0f + rnd.randomFloat32(0.0f, 2.0f));
+	return PxBounds3(center - extents, center + extents);
+}
+
+static void runBenchmark(PxBroadPhaseType::Enum type, const char* name)
+{
+	SnippetUtils::BasicRandom rnd(42);
+
+	PxBroadPhaseDesc bpDesc(type);
+	PxBroadPhase* broadphase = PxCreateBroadPhase(bpDesc);
+	PxAABBManager* aabbManager = PxCreateAABBManager(*broadphase);
+
+	// Objects [0, gNbStatics) are statics, the remaining ones are dynamics. Movers are the last gNbMovers objects.
+	for(PxU32 i=0;i<gNbObjects;i++)
+	{
+		gBounds[i] = computeRandomBounds(rnd);
+		aabbManager->addObject(i, gBounds[i], i<gNbStatics ? PxGetBroadPhaseStaticFilterGroup() : PxGetBroadPhaseDynamicFilterGroup(i));
+	}
+
+	PxBroadPhaseResults results;
+	aabbManager->updateAndFetchResults(results);
+	PxU32 nbPairs = results.mNbCreatedPairs;
+
+	PxU64 totalTime = 0;
+	PxU64 teleportTime = 0;
+	PxU32 nbTeleportFrames = 0;
+	for(PxU32 frame=0;frame<gNbFrames;frame++)
+	{
+		for(PxU32 i=gNbObjects-gNbMovers;i<gNbObjects;i++)
+		{
+			const PxVec3 delta = rnd.unitRandomPt() * gMoveDistance;
+			gBounds[i].minimum += delta;
+			gBounds[i].maximum += delta;
+			aabbManager->updateObject(i, &gBounds[i]);
+		}
+
+		const bool teleportFrame = (frame % gTeleportPeriod) == gTeleportPeriod - 1;
+		if(teleportFrame)
+		{
+			for(PxU32 j=0;j<gNbTeleported;j++)
+			{
+				const PxU32 i = gNbStatics + (rnd.randomize() % gNbSleeping);
+				gBounds[i] = computeRandomBounds(rnd);
+				aabbManager->updateObject(i, &gBounds[i]);
+			}
+		}
+
+		const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+		aabbManager->updateAndFetchResults(results);
+		const PxU64 frameTime = SnippetUtils::getCurrentTimeCounterValue() - startTime;
+
+		nbPairs += results.mNbCreatedPairs;
+		nbPairs -= results.mNbDeletedPairs;
+
+		totalTime += frameTime;
+		if(teleportFrame)
+		{
+			teleportTime += frameTime;
+			nbTeleportFrames++;
+		}
+	}
+
+	PX_RELEASE(aabbManager);
+	PX_RELEASE(broadphase);
+
+	printf("%s: %f ms per frame, %f ms per teleport frame (%d pairs)\n", name,
+		double(SnippetUtils::getElapsedTimeInMilliseconds(totalTime)) / double(gNbFrames),
+		double(SnippetUtils::getElapsedTimeInMilliseconds(teleportTime)) / double(nbTeleportFrames), nbPairs);
+}
+
+int snippetMain(int, const char*const*)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gBounds = new PxBounds3[gNbObjects];
+
+	printf("%d statics, %d sleeping, %d movers, %d teleported every %d frames\n", gNbStatics, gNbSleeping, gNbMovers, gNbTeleported, gTeleportPeriod);
+	runBenchmark(PxBroadPhaseType::eSAP, "SAP");
+	runBenchmark(PxBroadPhaseType::eABP, "ABP");
+
+	delete [] gBounds;
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetBroadphaseCoherence done.\n");
+	return 0;
+}
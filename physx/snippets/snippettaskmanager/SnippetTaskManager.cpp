@@ -0,0 +1,224 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet is a micro-benchmark for the task manager. Each frame, several
+// user threads concurrently submit a large number of PxTasks and their
+// dependencies to a PxTaskManager, which then resolves the task graph on a
+// PxDefaultCpuDispatcher. The average time per frame is printed at the end.
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "../snippetutils/SnippetUtils.h"
+#include "../snippetcommon/SnippetPrint.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation		= NULL;
+static PxDefaultCpuDispatcher*	gDispatcher		= NULL;
+static PxTaskManager*			gTaskManager	= NULL;
+
+static const PxU32	gNbTasks		= 100000;
+static const PxU32	gChainLength	= 4;	// tasks are grouped in small chains using startAfter()
+static const PxU32	gNbFrames		= 100;
+
+static SnippetUtils::Sync*	gFrameDoneSyncHandle	= NULL;
+static SnippetUtils::Sync*	gSubmitDoneSyncHandle	= NULL;
+static volatile PxI32		gNbSubmitThreadsDone	= 0;
+static volatile PxI32		gNbTasksRun				= 0;
+static PxTaskID				gEndTaskID				= 0;
+
+class WorkTask : public PxTask
+{
+public:
+	virtual void run()
+	{
+		SnippetUtils::atomicIncrement(&gNbTasksRun);
+	}
+
+	virtual const char* getName() const { return "WorkTask"; }
+};
+
+class EndFrameTask : public PxTask
+{
+public:
+	virtual void run()
+	{
+	}
+
+	// Signal the end of the frame only once the task manager is done with this task
+	virtual void release()
+	{
+		PxTask::release();
+		SnippetUtils::syncSet(gFrameDoneSyncHandle);
+	}
+
+	virtual const char* getName() const { return "EndFrameTask"; }
+};
+
+static WorkTask*	gTasks = NULL;
+static EndFrameTask	gEndTask;
+
+struct SubmitThread
+{
+	SnippetUtils::Sync*		mWorkReadySyncHandle;
+	SnippetUtils::Thread*	mThreadHandle;
+	PxU32					mStart;
+	PxU32					mEnd;
+};
+static const PxU32	gNbSubmitThreads = 4;
+static SubmitThread	gSubmitThreads[gNbSubmitThreads];
+
+static void submitTasks(PxU32 start, PxU32 end)
+{
+	for(PxU32 i=start; i<end; i++)
+	{
+		gTaskManager->submitUnnamedTask(gTasks[i]);
+		gTasks[i].finishBefore(gEndTaskID);
+		if((i - start) % gChainLength)
+			gTasks[i].startAfter(gTasks[i-1].getTaskID());
+	}
+}
+
+static void submitThreadExecute(void* data)
+{
+	SubmitThread* submitThread = static_cast<SubmitThread*>(data);
+
+	for(;;)
+	{
+		SnippetUtils::syncWait(submitThread->mWorkReadySyncHandle);
+		SnippetUtils::syncReset(submitThread->mWorkReadySyncHandle);
+
+		if(SnippetUtils::threadQuitIsSignalled(submitThread->mThreadHandle))
+			break;
+
+		submitTasks(submitThread->mStart, submitThread->mEnd);
+
+		if(SnippetUtils::atomicIncrement(&gNbSubmitThreadsDone) == gNbSubmitThreads)
+			SnippetUtils::syncSet(gSubmitDoneSyncHandle);
+	}
+
+	SnippetUtils::threadQuit(submitThread->mThreadHandle);
+}
+
+static void initBenchmark()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	const PxU32 numCores = SnippetUtils::getNbPhysicalCores();
+	gDispatcher = PxDefaultCpuDispatcherCreate(numCores == 0 ? 0 : numCores - 1, NULL, PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK, 0, PxDefaultCpuDispatcherSchedulingMode::eWORK_STEALING);
+	gTaskManager = PxTaskManager::createTaskManager(gErrorCallback, gDispatcher);
+
+	gTasks = new WorkTask[gNbTasks];
+
+	gFrameDoneSyncHandle = SnippetUtils::syncCreate();
+	gSubmitDoneSyncHandle = SnippetUtils::syncCreate();
+
+	// Each submit thread handles a contiguous range of tasks, so that chains never cross threads.
+	const PxU32 nbTasksPerThread = ((gNbTasks / gNbSubmitThreads) / gChainLength) * gChainLength;
+	for(PxU32 i=0; i<gNbSubmitThreads; i++)
+	{
+		gSubmitThreads[i].mStart = i * nbTasksPerThread;
+		gSubmitThreads[i].mEnd = i == gNbSubmitThreads - 1 ? gNbTasks : (i + 1) * nbTasksPerThread;
+		gSubmitThreads[i].mWorkReadySyncHandle = SnippetUtils::syncCreate();
+		gSubmitThreads[i].mThreadHandle = SnippetUtils::threadCreate(submitThreadExecute, &gSubmitThreads[i]);
+	}
+}
+
+static PxU64 runFrame()
+{
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+
+	gTaskManager->resetDependencies();
+	gEndTaskID = gTaskManager->submitNamedTask(&gEndTask, "EndFrame");
+
+	// Submit the task graph from several threads concurrently
+	gNbSubmitThreadsDone = 0;
+	for(PxU32 i=0; i<gNbSubmitThreads; i++)
+		SnippetUtils::syncSet(gSubmitThreads[i].mWorkReadySyncHandle);
+
+	SnippetUtils::syncWait(gSubmitDoneSyncHandle);
+	SnippetUtils::syncReset(gSubmitDoneSyncHandle);
+
+	// Resolve it
+	gTaskManager->startSimulation();
+
+	SnippetUtils::syncWait(gFrameDoneSyncHandle);
+	SnippetUtils::syncReset(gFrameDoneSyncHandle);
+
+	gTaskManager->stopSimulation();
+
+	return SnippetUtils::getCurrentTimeCounterValue() - startTime;
+}
+
+static void releaseBenchmark()
+{
+	for(PxU32 i=0; i<gNbSubmitThreads; i++)
+	{
+		SnippetUtils::threadSignalQuit(gSubmitThreads[i].mThreadHandle);
+		SnippetUtils::syncSet(gSubmitThreads[i].mWorkReadySyncHandle);
+	}
+
+	for(PxU32 i=0; i<gNbSubmitThreads; i++)
+	{
+		SnippetUtils::threadWaitForQuit(gSubmitThreads[i].mThreadHandle);
+		SnippetUtils::threadRelease(gSubmitThreads[i].mThreadHandle);
+		SnippetUtils::syncRelease(gSubmitThreads[i].mWorkReadySyncHandle);
+	}
+
+	SnippetUtils::syncRelease(gSubmitDoneSyncHandle);
+	SnippetUtils::syncRelease(gFrameDoneSyncHandle);
+
+	delete [] gTasks;
+
+	PX_RELEASE(gTaskManager);
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gFoundation);
+}
+
+int snippetMain(int, const char*const*)
+{
+	initBenchmark();
+
+	PxU64 totalTime = 0;
+	for(PxU32 i=0; i<gNbFrames; i++)
+		totalTime += runFrame();
+
+	const PxU32 nbTasksRun = PxU32(gNbTasksRun);
+	releaseBenchmark();
+
+	printf("%d tasks per frame, %d frames: %f ms per frame\n", gNbTasks, gNbFrames, double(SnippetUtils::getElapsedTimeInMilliseconds(totalTime)) / double(gNbFrames));
+	if(nbTasksRun != gNbTasks * gNbFrames)
+		printf("Error: %d tasks executed, expected %d\n", nbTasksRun, gNbTasks * gNbFrames);
+
+	printf("SnippetTaskManager done.\n");
+
+	return 0;
+}
@@ -31,11 +31,22 @@
 
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxBitUtils.h"
+#include "foundation/PxMath.h"
 #include "foundation/PxMutex.h"
 #include "foundation/PxArray.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxHash.h"
+#include "foundation/PxAlignedMalloc.h"
 
 /*
 Pool used to allocate variable sized tasks. It's intended to be cleared after a short period (time step).
+
+This is also the per-scene frame arena. Each thread that allocates from the pool gets its own slab carved out
+of the shared chunks, so that most allocations are a lock-free pointer bump. Slabs are owned by thread IDs and
+stored in the pool itself, so pools don't consume TLS slots. Slabs and their ownership are released each time the
+pool is reset, so threads only hold a slab for the frame they allocate in. resetFrame() keeps all chunks around so
+that a steady-state frame does not touch the heap.
 */
 
 namespace physx
@@ -44,24 +55,72 @@ namespace Cm
 {
 	static const PxU32 sSpareChunkCount = 2;
 
+	// max number of threads that can own a slab in a frame, must be a power of two. Additional threads fall back to the locked path.
+	#define CM_FLUSH_POOL_MAX_NB_SLABS	64
+
 	class FlushPool
 	{
 		PX_NOCOPY(FlushPool)
+
+		// one cache line per slab, the array is 64-byte aligned to avoid false sharing between threads
+		struct Slab
+		{
+			PxU8*			mCurrent;
+			PxU8*			mEnd;
+			volatile void*	mOwner;	// ID of the owner thread, NULL for unused slabs
+			PxU8			mPad[64 - 3*sizeof(void*)];
+		};
+
 	public:
-		FlushPool(PxU32 chunkSize) : mChunks("FlushPoolChunk"), mChunkIndex(0), mOffset(0), mChunkSize(chunkSize)
+		FlushPool(PxU32 chunkSize) :
+			mChunks			("FlushPoolChunk"),
+			mChunkIndex		(0),
+			mOffset			(0),
+			mChunkSize		(chunkSize),
+			mSlabSize		(chunkSize/4),
+			mHighWaterMark	(0)
 		{
+			PX_COMPILE_TIME_ASSERT(sizeof(Slab) == 64);
 			mChunks.pushBack(static_cast<PxU8*>(PX_ALLOC(mChunkSize, "PxU8")));
+			mSlabs = reinterpret_cast<Slab*>(PxAlignedAllocator<64>().allocate(sizeof(Slab)*CM_FLUSH_POOL_MAX_NB_SLABS, PX_FL));
+			releaseSlabs();
 		}
 
 		~FlushPool()
 		{
 			for (PxU32 i = 0; i < mChunks.size(); ++i)
 				PX_FREE(mChunks[i]);
+			PxAlignedAllocator<64>().deallocate(mSlabs);
 		}
 
 		// alignment must be a power of two
 		void* allocate(PxU32 size, PxU32 alignment=16)
 		{
+			PX_ASSERT(PxIsPowerOfTwo(alignment));
+
+			// large allocations would waste most of a slab, they go straight to the shared chunks
+			if(size + alignment <= mSlabSize/2)
+			{
+				Slab* slab = getThreadSlab();
+				if(slab)
+				{
+					PxU8* ptr = alignPtr(slab->mCurrent, alignment);
+					if(!ptr || ptr + size > slab->mEnd)
+					{
+						{
+							PxMutex::ScopedLock lock(mMutex);
+							slab->mCurrent = static_cast<PxU8*>(allocateNotThreadSafe(mSlabSize, 64));
+						}
+						slab->mEnd = slab->mCurrent + mSlabSize;
+						ptr = alignPtr(slab->mCurrent, alignment);
+					}
+
+					PX_ASSERT(ptr + size <= slab->mEnd);
+					slab->mCurrent = ptr + size;
+					return ptr;
+				}
+			}
+
 			PxMutex::ScopedLock lock(mMutex);
 			return allocateNotThreadSafe(size, alignment);
 		}
@@ -103,6 +162,8 @@ namespace Cm
 
 		void clearNotThreadSafe(PxU32 spareChunkCount = sSpareChunkCount)
 		{
+			updateHighWaterMark();
+
 			//release memory not used previously
 			PxU32 targetSize = mChunkIndex+spareChunkCount;
 			while (mChunks.size() > targetSize)
@@ -113,6 +174,19 @@ namespace Cm
 
 			mChunkIndex = 0;
 			mOffset = 0;
+			releaseSlabs();
+		}
+
+		// end-of-frame reset. Unlike clear(), this keeps all the chunks allocated so far, so that
+		// the next frames can run without heap allocations once the high-water mark has been reached.
+		// Must not be called while other threads are allocating from the pool.
+		void resetFrame()
+		{
+			updateHighWaterMark();
+
+			mChunkIndex = 0;
+			mOffset = 0;
+			releaseSlabs();
 		}
 
 		void resetNotThreadSafe()
@@ -126,8 +200,14 @@ namespace Cm
 			mChunks.pushBack(firstChunk);
 			mChunkIndex = 0;
 			mOffset = 0;
+			releaseSlabs();
 		}
 
+		// Max number of bytes used in a single frame so far
+		PX_FORCE_INLINE	PxU64	getHighWaterMark()	const	{ return PxMax(mHighWaterMark, getUsedMemory());	}
+		// Number of bytes currently reserved by the pool
+		PX_FORCE_INLINE	PxU64	getCapacity()		const	{ return PxU64(mChunks.size()) * mChunkSize;		}
+
 		void lock()
 		{
 			mMutex.lock();
@@ -139,11 +219,59 @@ namespace Cm
 		}
 
 	private:
+		PX_FORCE_INLINE	PxU64	getUsedMemory()	const	{ return PxU64(mChunkIndex) * mChunkSize + mOffset;	}
+
+		PX_FORCE_INLINE	void	updateHighWaterMark()
+		{
+			const PxU64 used = getUsedMemory();
+			if(used > mHighWaterMark)
+				mHighWaterMark = used;
+		}
+
+		static PX_FORCE_INLINE PxU8* alignPtr(PxU8* ptr, PxU32 alignment)
+		{
+			return reinterpret_cast<PxU8*>((size_t(ptr) + alignment - 1) & ~(size_t(alignment) - 1));
+		}
+
+		// gives the slabs back to the pool, including their ownership. Must not be called while other threads are allocating.
+		void releaseSlabs()
+		{
+			for(PxU32 i=0; i<CM_FLUSH_POOL_MAX_NB_SLABS; i++)
+			{
+				mSlabs[i].mCurrent = NULL;
+				mSlabs[i].mEnd = NULL;
+				mSlabs[i].mOwner = NULL;
+			}
+		}
+
+		// returns the calling thread's slab, or NULL if all slabs have already been handed out in this frame. The slab is
+		// found by open addressing on the thread ID, and claimed with a CAS the first time a thread allocates after a reset.
+		PX_FORCE_INLINE Slab* getThreadSlab()
+		{
+			void* threadId = reinterpret_cast<void*>(PxThread::getId());
+			PX_ASSERT(threadId);
+
+			const PxU32 start = PxComputeHash(threadId);
+			for(PxU32 i=0; i<CM_FLUSH_POOL_MAX_NB_SLABS; i++)
+			{
+				Slab& slab = mSlabs[(start + i) & (CM_FLUSH_POOL_MAX_NB_SLABS - 1)];
+				const void* owner = const_cast<const void*>(slab.mOwner);
+				if(owner == threadId)
+					return &slab;
+				if(!owner && !PxAtomicCompareExchangePointer(&slab.mOwner, threadId, NULL))
+					return &slab;
+			}
+			return NULL;
+		}
+
 		PxMutex mMutex;
 		PxArray<PxU8*> mChunks;
 		PxU32 mChunkIndex;
 		PxU32 mOffset;
 		PxU32 mChunkSize;
+		PxU32 mSlabSize;
+		PxU64 mHighWaterMark;
+		Slab* mSlabs;	// CM_FLUSH_POOL_MAX_NB_SLABS slabs
 	};
 
 	
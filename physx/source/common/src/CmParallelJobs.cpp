@@ -0,0 +1,176 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxAssert.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxFPU.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxSync.h"
+#include "foundation/PxUserAllocated.h"
+#include "task/PxTask.h"
+#include "task/PxCpuDispatcher.h"
+#include "CmParallelJobs.h"
+
+using namespace physx;
+using namespace Cm;
+
+namespace physx
+{
+namespace Cm
+{
+	class ParallelJobsTask : public PxLightCpuTask
+	{
+	public:
+							ParallelJobsTask() : mContext(NULL), mThreadIndex(0)	{}
+
+		virtual	void		run()		PX_OVERRIDE;
+		virtual	void		release()	PX_OVERRIDE;
+		virtual	const char*	getName()	const	PX_OVERRIDE;
+
+		ParallelJobsContext*	mContext;
+		PxU32					mThreadIndex;
+	};
+
+	class ParallelJobsContext : public PxUserAllocated
+	{
+		PX_NOCOPY(ParallelJobsContext)
+	public:
+							ParallelJobsContext(const char* name) : mName(name), mJobs(NULL), mNbJobs(0), mRefCount(1), mNextJob(0), mNbDone(0)
+							{
+								for(PxU32 i=0;i<CM_PARALLEL_JOBS_MAX_NB_THREADS-1;i++)
+								{
+									mTasks[i].mContext = this;
+									mTasks[i].mThreadIndex = i+1;
+								}
+							}
+
+		void				work(PxU32 threadIndex)
+		{
+			const PxI32 nbJobs = PxI32(mNbJobs);
+			for(;;)
+			{
+				const PxI32 job = PxAtomicIncrement(&mNextJob) - 1;
+				if(job>=nbJobs)
+					break;
+
+				mJobs->processJob(PxU32(job), threadIndex);
+
+				// the thread completing the last job wakes up the calling thread
+				if(PxAtomicIncrement(&mNbDone)==nbJobs)
+					mDone.set();
+			}
+		}
+
+		void				releaseReference()
+		{
+			if(!PxAtomicDecrement(&mRefCount))
+				PX_DELETE_THIS;
+		}
+
+		const char*			mName;
+		ParallelJobs*		mJobs;		// only used while the calling thread waits, late tasks don't touch it
+		PxU32				mNbJobs;
+		volatile PxI32		mRefCount;
+		volatile PxI32		mNextJob;
+		volatile PxI32		mNbDone;
+		PxSync				mDone;
+		ParallelJobsTask	mTasks[CM_PARALLEL_JOBS_MAX_NB_THREADS-1];
+	};
+
+	void ParallelJobsTask::run()
+	{
+		PX_SIMD_GUARD;
+		mContext->work(mThreadIndex);
+	}
+
+	void ParallelJobsTask::release()
+	{
+		mContext->releaseReference();
+	}
+
+	const char* ParallelJobsTask::getName() const
+	{
+		return mContext->mName;
+	}
+}
+}
+
+ParallelJobsRunner::ParallelJobsRunner(const char* name) : mName(name), mContext(NULL)
+{
+}
+
+ParallelJobsRunner::~ParallelJobsRunner()
+{
+	if(mContext)
+		mContext->releaseReference();
+}
+
+PxU32 ParallelJobsRunner::getNbThreads(const PxCpuDispatcher* dispatcher, PxU32 nbJobs)
+{
+	if(!dispatcher || nbJobs<2)
+		return 1;
+	return PxMin(PxMin(nbJobs, dispatcher->getWorkerCount() + 1), PxU32(CM_PARALLEL_JOBS_MAX_NB_THREADS));
+}
+
+void ParallelJobsRunner::start(PxCpuDispatcher* dispatcher, ParallelJobs& jobs, PxU32 nbJobs)
+{
+	// tasks from the previous set of jobs that haven't run yet still use the context, don't touch it
+	if(mContext && mContext->mRefCount!=1)
+	{
+		mContext->releaseReference();
+		mContext = NULL;
+	}
+
+	if(!mContext)
+		mContext = PX_NEW(ParallelJobsContext)(mName);
+
+	ParallelJobsContext& context = *mContext;
+	context.mJobs = &jobs;
+	context.mNbJobs = nbJobs;
+	context.mNextJob = 0;
+	context.mNbDone = 0;
+	context.mDone.reset();
+	if(!nbJobs)
+		context.mDone.set();
+
+	const PxU32 nbTasks = getNbThreads(dispatcher, nbJobs) - 1;
+	if(nbTasks)
+	{
+		PxAtomicAdd(&context.mRefCount, PxI32(nbTasks));
+		for(PxU32 i=0;i<nbTasks;i++)
+			dispatcher->submitTask(context.mTasks[i]);
+	}
+}
+
+void ParallelJobsRunner::finish()
+{
+	PX_ASSERT(mContext);
+	mContext->work(0);
+	mContext->mDone.wait();
+	mContext->mJobs = NULL;
+}
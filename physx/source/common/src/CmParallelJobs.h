@@ -0,0 +1,120 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef CM_PARALLEL_JOBS_H
+#define CM_PARALLEL_JOBS_H
+
+#include "foundation/PxSimpleTypes.h"
+#include "common/PxPhysXCommonConfig.h"
+
+namespace physx
+{
+class PxCpuDispatcher;
+
+namespace Cm
+{
+	// max number of threads working on the same set of jobs, including the calling thread
+	#define CM_PARALLEL_JOBS_MAX_NB_THREADS	64
+
+	/**
+	\brief A set of independent jobs, see ParallelJobsRunner.
+	*/
+	class ParallelJobs
+	{
+	public:
+		/**
+		\brief Processes one job.
+
+		\param[in] jobIndex		Index of the job, between 0 and the number of jobs passed to ParallelJobsRunner.
+		\param[in] threadIndex	Index of the thread processing the job, 0 for the calling thread. Jobs processed at the same
+								time always have different thread indices, so it can be used to access per-thread scratch
+								memory. It is smaller than ParallelJobsRunner::getNbThreads().
+		*/
+		virtual	void	processJob(PxU32 jobIndex, PxU32 threadIndex)	= 0;
+	protected:
+		virtual			~ParallelJobs()	{}
+	};
+
+	class ParallelJobsContext;
+
+	/**
+	\brief Processes a set of independent jobs with a dispatcher's workers and the calling thread.
+
+	Jobs are claimed with an atomic counter by the submitted tasks and by the calling thread, which then blocks until the
+	jobs being processed by other threads are done. The calling thread never waits for tasks that have not started yet, so
+	it is safe to use this from within a task, even if all other workers are busy.
+
+	Tasks starting after all jobs have been claimed only release their reference to the shared context, which is deleted
+	by the last reference holder. The runner keeps its context, and the tasks it contains, for the next set of jobs unless
+	such late tasks still hold it. Steady-state use therefore doesn't allocate.
+	*/
+	class ParallelJobsRunner
+	{
+		PX_NOCOPY(ParallelJobsRunner)
+	public:
+						ParallelJobsRunner(const char* name);
+						~ParallelJobsRunner();
+
+		/**
+		\brief Returns the number of threads that will work on the given number of jobs, including the calling thread.
+
+		This is 1 when dispatcher is NULL or has no workers, in which case all jobs run on the calling thread.
+		*/
+		static	PxU32	getNbThreads(const PxCpuDispatcher* dispatcher, PxU32 nbJobs);
+
+		/**
+		\brief Submits the tasks. The calling thread can do unrelated work before calling finish().
+
+		\param[in] dispatcher	Dispatcher running the tasks, can be NULL.
+		\param[in] jobs			Jobs to process. Must remain valid until finish() returns.
+		\param[in] nbJobs		Number of jobs.
+		*/
+				void	start(PxCpuDispatcher* dispatcher, ParallelJobs& jobs, PxU32 nbJobs);
+
+		/**
+		\brief Processes the remaining jobs on the calling thread, then waits until all jobs are done.
+		*/
+				void	finish();
+
+		/**
+		\brief Same as start() followed by finish().
+		*/
+				void	run(PxCpuDispatcher* dispatcher, ParallelJobs& jobs, PxU32 nbJobs)
+				{
+					start(dispatcher, jobs, nbJobs);
+					finish();
+				}
+
+	private:
+		const char*				mName;
+		ParallelJobsContext*	mContext;
+	};
+}
+}
+
+#endif
@@ -28,6 +28,9 @@
 
 #include "foundation/PxMemory.h"
 #include "foundation/PxAssert.h"
+#include "foundation/PxBasicTemplates.h"
+#include "foundation/PxMath.h"
+#include "task/PxCpuDispatcher.h"
 #include "CmRadixSort.h"
 
 // PT: code archeology: this initially came from ICE (IceRevisitedRadix.h/cpp). Consider putting it back the way it was initially.
@@ -557,3 +560,263 @@ RadixSortBuffered& RadixSortBuffered::Sort(const float* input2, PxU32 nb)
 	return *this;
 }
 
+namespace
+{
+	enum RadixSortPhase
+	{
+		RADIX_PHASE_INIT,		// Copy (or convert) the input keys, create all 4 histograms of each chunk
+		RADIX_PHASE_HISTOGRAM,	// Create the histogram of each chunk for the current pass
+		RADIX_PHASE_SCATTER		// Scatter each chunk to its precomputed offsets
+	};
+
+	// data shared by all the chunks of a parallel sort
+	struct RadixSortMTData
+	{
+		const void*		mInput;
+		const PxU32*	mInputValues;	// NULL when sorting floats, in which case values are the input indices
+		PxU32*			mSrcKeys;
+		PxU32*			mSrcValues;
+		PxU32*			mDstKeys;
+		PxU32*			mDstValues;
+		PxU32*			mHistograms;	// 4*256 counters per chunk
+		PxU32			mNb;
+		PxU32			mNbChunks;
+		PxU32			mChunkSize;
+		PxU32			mPass;
+		bool			mFloatKeys;
+	};
+
+	// maps IEEE floats to unsigned integers with the same ordering
+	PX_FORCE_INLINE PxU32 encodeFloatKey(PxU32 bits)
+	{
+		return bits ^ (PxU32(PxI32(bits)>>31) | 0x80000000);
+	}
+
+	void processChunk(RadixSortMTData& data, RadixSortPhase phase, PxU32 chunk)
+	{
+		const PxU32 start = chunk * data.mChunkSize;
+		const PxU32 end = PxMin(start + data.mChunkSize, data.mNb);
+		PxU32* PX_RESTRICT histograms = data.mHistograms + chunk*1024;
+
+		if(phase==RADIX_PHASE_INIT)
+		{
+			PxMemZero(histograms, 1024*sizeof(PxU32));
+			PxU32* PX_RESTRICT h0 = histograms;
+			PxU32* PX_RESTRICT h1 = histograms + 256;
+			PxU32* PX_RESTRICT h2 = histograms + 512;
+			PxU32* PX_RESTRICT h3 = histograms + 768;
+
+			const PxU32* PX_RESTRICT input = reinterpret_cast<const PxU32*>(data.mInput);
+			PxU32* PX_RESTRICT keys = data.mSrcKeys;
+			PxU32* PX_RESTRICT values = data.mSrcValues;
+			for(PxU32 i=start;i<end;i++)
+			{
+				const PxU32 key = data.mFloatKeys ? encodeFloatKey(input[i]) : input[i];
+				keys[i] = key;
+				values[i] = data.mInputValues ? data.mInputValues[i] : i;
+				h0[key&0xff]++;	h1[(key>>8)&0xff]++;	h2[(key>>16)&0xff]++;	h3[key>>24]++;
+			}
+		}
+		else
+		{
+			const PxU32 shift = data.mPass*8;
+			PxU32* PX_RESTRICT h = histograms + data.mPass*256;
+			const PxU32* PX_RESTRICT srcKeys = data.mSrcKeys;
+
+			if(phase==RADIX_PHASE_HISTOGRAM)
+			{
+				PxMemZero(h, 256*sizeof(PxU32));
+				for(PxU32 i=start;i<end;i++)
+					h[(srcKeys[i]>>shift)&0xff]++;
+			}
+			else
+			{
+				// 'h' contains the offsets of this chunk for each bucket here
+				const PxU32* PX_RESTRICT srcValues = data.mSrcValues;
+				PxU32* PX_RESTRICT dstKeys = data.mDstKeys;
+				PxU32* PX_RESTRICT dstValues = data.mDstValues;
+				for(PxU32 i=start;i<end;i++)
+				{
+					const PxU32 key = srcKeys[i];
+					const PxU32 dstIndex = h[(key>>shift)&0xff]++;
+					dstKeys[dstIndex] = key;
+					dstValues[dstIndex] = srcValues[i];
+				}
+			}
+		}
+	}
+
+	// one phase of a parallel sort, each job is a chunk of the input
+	class RadixSortPhaseJobs : public ParallelJobs
+	{
+		PX_NOCOPY(RadixSortPhaseJobs)
+	public:
+						RadixSortPhaseJobs(RadixSortMTData& data, RadixSortPhase phase) : mData(data), mPhase(phase)	{}
+
+		virtual	void	processJob(PxU32 chunk, PxU32)	PX_OVERRIDE
+		{
+			processChunk(mData, mPhase, chunk);
+		}
+
+		RadixSortMTData&		mData;
+		const RadixSortPhase	mPhase;
+	};
+
+	void runPhase(ParallelJobsRunner& runner, RadixSortMTData& data, RadixSortPhase phase, PxCpuDispatcher& dispatcher)
+	{
+		RadixSortPhaseJobs jobs(data, phase);
+		runner.run(&dispatcher, jobs, data.mNbChunks);
+	}
+}
+
+RadixSortMT::RadixSortMT() : mRunner("Cm::RadixSortMT"), mBuffers(NULL), mHistograms(NULL), mCapacity(0), mKeys(NULL), mValues(NULL)
+{
+}
+
+RadixSortMT::~RadixSortMT()
+{
+	reset();
+}
+
+void RadixSortMT::reset()
+{
+	mSerial.reset();
+	PX_FREE(mHistograms);
+	PX_FREE(mBuffers);
+	mCapacity = 0;
+	mKeys = NULL;
+	mValues = NULL;
+}
+
+void RadixSortMT::checkResize(PxU32 nb)
+{
+	if(nb>mCapacity)
+	{
+		PX_FREE(mBuffers);
+		mBuffers = PX_ALLOCATE(PxU32, nb*4, "RadixSortMT:mBuffers");
+		mCapacity = nb;
+	}
+	if(!mHistograms)
+		mHistograms = PX_ALLOCATE(PxU32, RADIX_SORT_MT_MAX_NB_CHUNKS*1024, "RadixSortMT:mHistograms");
+}
+
+void RadixSortMT::sortParallel(const void* input, const PxU32* values, PxU32 nb, bool floatKeys, PxCpuDispatcher& dispatcher)
+{
+	checkResize(nb);
+
+	// chunks must be large enough to amortize their 4 histograms. There are more chunks than threads so that the
+	// calling thread and fast workers can pick up the slack when some workers are busy with other tasks.
+	const PxU32 nbThreads = dispatcher.getWorkerCount() + 1;
+	const PxU32 nbChunks = PxClamp(nb/4096, PxU32(1), PxMin(nbThreads*2, PxU32(RADIX_SORT_MT_MAX_NB_CHUNKS)));
+
+	RadixSortMTData data;
+	data.mInput			= input;
+	data.mInputValues	= values;
+	data.mSrcKeys		= mBuffers;
+	data.mDstKeys		= mBuffers + mCapacity;
+	data.mSrcValues		= mBuffers + mCapacity*2;
+	data.mDstValues		= mBuffers + mCapacity*3;
+	data.mHistograms	= mHistograms;
+	data.mNb			= nb;
+	data.mNbChunks		= nbChunks;
+	data.mChunkSize		= (nb + nbChunks - 1)/nbChunks;
+	data.mPass			= 0;
+	data.mFloatKeys		= floatKeys;
+
+	runPhase(mRunner, data, RADIX_PHASE_INIT, dispatcher);
+
+	// the chunk histograms from the init phase remain valid until the data moves, i.e. until the first scatter
+	bool histogramsValid = true;
+
+	for(PxU32 j=0;j<4;j++)
+	{
+		data.mPass = j;
+
+		// skip the pass if all keys have the same byte, as in CheckPassValidity. The global histogram
+		// is the sum of the chunk histograms from the init phase.
+		{
+			PxU32 count = 0;
+			const PxU32 uniqueByte = (data.mSrcKeys[0]>>(j*8))&0xff;
+			for(PxU32 c=0;c<nbChunks;c++)
+				count += mHistograms[c*1024 + j*256 + uniqueByte];
+			if(count==nb)
+				continue;
+		}
+
+		if(!histogramsValid)
+			runPhase(mRunner, data, RADIX_PHASE_HISTOGRAM, dispatcher);
+
+		// turn the chunk histograms into offsets. Buckets are processed in order, and chunks in order within a
+		// bucket, which makes the sort stable.
+		{
+			PxU32 offset = 0;
+			for(PxU32 b=0;b<256;b++)
+			{
+				for(PxU32 c=0;c<nbChunks;c++)
+				{
+					PxU32& h = mHistograms[c*1024 + j*256 + b];
+					const PxU32 count = h;
+					h = offset;
+					offset += count;
+				}
+			}
+			PX_ASSERT(offset==nb);
+		}
+
+		runPhase(mRunner, data, RADIX_PHASE_SCATTER, dispatcher);
+		histogramsValid = false;
+
+		PxSwap(data.mSrcKeys, data.mDstKeys);
+		PxSwap(data.mSrcValues, data.mDstValues);
+	}
+
+	mKeys = data.mSrcKeys;
+	mValues = data.mSrcValues;
+}
+
+RadixSortMT& RadixSortMT::SortKeyValues(const PxU32* keys, const PxU32* values, PxU32 nb, PxCpuDispatcher* dispatcher)
+{
+	// Checkings
+	if(!keys || !values || !nb || nb&0x80000000)
+		return *this;
+
+	if(dispatcher && nb>=RADIX_SORT_MT_MIN_SIZE)
+	{
+		sortParallel(keys, values, nb, false, *dispatcher);
+		return *this;
+	}
+
+	// small inputs, sort ranks with the regular code then gather the pairs
+	checkResize(nb);
+	mSerial.invalidateRanks();
+	const PxU32* PX_RESTRICT ranks = mSerial.Sort(keys, nb, RADIX_UNSIGNED).GetRanks();
+	PxU32* PX_RESTRICT sortedKeys = mBuffers;
+	PxU32* PX_RESTRICT sortedValues = mBuffers + mCapacity;
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxU32 index = ranks[i];
+		sortedKeys[i] = keys[index];
+		sortedValues[i] = values[index];
+	}
+	mKeys = sortedKeys;
+	mValues = sortedValues;
+	return *this;
+}
+
+RadixSortMT& RadixSortMT::Sort(const float* input, PxU32 nb, PxCpuDispatcher* dispatcher)
+{
+	// Checkings
+	if(!input || !nb || nb&0x80000000)
+		return *this;
+
+	if(dispatcher && nb>=RADIX_SORT_MT_MIN_SIZE)
+	{
+		sortParallel(input, NULL, nb, true, *dispatcher);
+		return *this;
+	}
+
+	mSerial.invalidateRanks();
+	mKeys = NULL;
+	mValues = mSerial.Sort(input, nb).GetRanks();
+	return *this;
+}
@@ -30,9 +30,12 @@
 #define CM_RADIX_SORT_H
 
 #include "common/PxPhysXCommonConfig.h"
+#include "CmParallelJobs.h"
 
 namespace physx
 {
+class PxCpuDispatcher;
+
 namespace Cm
 {
 	enum RadixHint
@@ -111,6 +114,55 @@ namespace Cm
 		void				CheckResize(PxU32 nb);
 		bool				Resize(PxU32 nb);
 	};
+
+#define RADIX_SORT_MT_MIN_SIZE		16384	//!< Inputs smaller than this are sorted with the single-threaded code
+#define RADIX_SORT_MT_MAX_NB_CHUNKS	32		//!< Max number of chunks processed in parallel by RadixSortMT
+
+	/**
+	\brief Parallel radix sort for large inputs.
+
+	This is an LSD radix sort working on key/value pairs, 8 bits per pass. For each pass, each chunk of the input computes
+	its own histogram, offsets are derived for all chunks, then each chunk scatters its pairs independently. The sort is
+	stable and its results do not depend on the number of worker threads.
+
+	The work is fanned out to the given dispatcher with a ParallelJobsRunner and the calling thread takes part in it, so it
+	is safe to call this from within a task, even if all other workers are busy. Inputs smaller than RADIX_SORT_MT_MIN_SIZE, or a NULL dispatcher,
+	use the single-threaded RadixSort code.
+	*/
+	class PX_PHYSX_COMMON_API RadixSortMT
+	{
+											PX_NOCOPY(RadixSortMT)
+		public:
+											RadixSortMT();
+											~RadixSortMT();
+
+						void				reset();
+
+		//! Sorts unsigned keys along with their values. Results are returned by GetKeys() and GetValues().
+						RadixSortMT&		SortKeyValues(const PxU32* keys, const PxU32* values, PxU32 nb, PxCpuDispatcher* dispatcher);
+
+		//! Sorts floating-point values, like RadixSort::Sort(). Results are returned by GetRanks().
+						RadixSortMT&		Sort(const float* input, PxU32 nb, PxCpuDispatcher* dispatcher);
+
+		//! Sorted keys, only valid after SortKeyValues()
+		PX_FORCE_INLINE	const PxU32*		GetKeys()			const	{ return mKeys;		}
+		//! Values in sorted order, only valid after SortKeyValues()
+		PX_FORCE_INLINE	const PxU32*		GetValues()			const	{ return mValues;	}
+		//! Indices in sorted order, only valid after Sort()
+		PX_FORCE_INLINE	const PxU32*		GetRanks()			const	{ return mValues;	}
+
+		private:
+						RadixSortBuffered	mSerial;		//!< Used for small inputs
+						ParallelJobsRunner	mRunner;		//!< Runs the chunks of each phase, reused by all phases and sorts
+						PxU32*				mBuffers;		//!< Keys and values, two lists of each, swapped each pass
+						PxU32*				mHistograms;	//!< One set of 4 histograms per chunk
+						PxU32				mCapacity;
+						const PxU32*		mKeys;
+						const PxU32*		mValues;
+
+						void				checkResize(PxU32 nb);
+						void				sortParallel(const void* input, const PxU32* values, PxU32 nb, bool floatKeys, PxCpuDispatcher& dispatcher);
+	};
 }
 }
 
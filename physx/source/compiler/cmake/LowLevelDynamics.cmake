@@ -119,6 +119,9 @@ SET(LLDYNAMICS_SOURCE
 	${LLDYNAMICS_BASE_DIR}/src/DySolverConstraintTypes.h
 	${LLDYNAMICS_BASE_DIR}/src/DySolverContact.h
 	${LLDYNAMICS_BASE_DIR}/src/DySolverContact4.h
+	${LLDYNAMICS_BASE_DIR}/src/DySolverContact8.h
+	${LLDYNAMICS_BASE_DIR}/src/DySolverContact8.cpp
+	${LLDYNAMICS_BASE_DIR}/src/DySolverContactStep4.h
 	${LLDYNAMICS_BASE_DIR}/src/DySolverContext.h
 	${LLDYNAMICS_BASE_DIR}/src/DySolverControl.h
 	${LLDYNAMICS_BASE_DIR}/src/DySolverCore.h
@@ -52,6 +52,8 @@ SET(PHYSX_COMMON_SOURCE
 	${COMMON_SRC_DIR}/CmFlushPool.h
 	${COMMON_SRC_DIR}/CmIDPool.h
 	${COMMON_SRC_DIR}/CmMatrix34.h
+	${COMMON_SRC_DIR}/CmParallelJobs.h
+	${COMMON_SRC_DIR}/CmParallelJobs.cpp
 	${COMMON_SRC_DIR}/CmPool.h
 	${COMMON_SRC_DIR}/CmPreallocatingPool.h
 	${COMMON_SRC_DIR}/CmPriorityQueue.h
@@ -379,6 +381,7 @@ SET(PHYSXCOMMON_GU_INTERSECTION_SOURCE
 SOURCE_GROUP(geomutils\\src\\intersection FILES ${PHYSXCOMMON_GU_INTERSECTION_SOURCE})
 
 SET(PXCOMMON_BVH4_FILES
+	${GU_SOURCE_DIR}/src/mesh/GuBV4_AABBBatchOverlap.cpp
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_AABBSweep.cpp
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_BoxOverlap.cpp
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_CapsuleSweep.cpp
@@ -454,6 +457,7 @@ SET(PHYSXCOMMON_GU_MESH_SOURCE
 SOURCE_GROUP(geomutils\\src\\mesh FILES ${PHYSXCOMMON_GU_MESH_SOURCE})
 
 SET(PHYSXCOMMON_GU_PCM_SOURCE
+	${GU_SOURCE_DIR}/src/pcm/GuPCMContactBatch.cpp
 	${GU_SOURCE_DIR}/src/pcm/GuPCMContactBoxBox.cpp
 	${GU_SOURCE_DIR}/src/pcm/GuPCMContactBoxConvex.cpp
 	${GU_SOURCE_DIR}/src/pcm/GuPCMContactCapsuleBox.cpp
@@ -529,6 +533,8 @@ SET(PHYSXCOMMON_GU_PRUNERS_SOURCE
 	${GU_SOURCE_DIR}/src/GuAABBTreeNode.h
 	${GU_SOURCE_DIR}/src/GuAABBTreeBuildStats.h
 	${GU_SOURCE_DIR}/src/GuAABBTreeQuery.h
+	${GU_SOURCE_DIR}/src/GuQuantizedAABBTree.cpp
+	${GU_SOURCE_DIR}/src/GuQuantizedAABBTree.h
 	${GU_SOURCE_DIR}/src/GuSqInternal.cpp
 	${GU_SOURCE_DIR}/src/GuIncrementalAABBTree.h
 	${GU_SOURCE_DIR}/src/GuIncrementalAABBTree.cpp
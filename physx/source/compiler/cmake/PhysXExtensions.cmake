@@ -38,6 +38,7 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtBroadPhase.cpp
 	${LL_SOURCE_DIR}/ExtCollection.cpp
 	${LL_SOURCE_DIR}/ExtConvexMeshExt.cpp
+	${LL_SOURCE_DIR}/ExtCpuTopology.cpp
 	${LL_SOURCE_DIR}/ExtCpuWorkerThread.cpp
 	${LL_SOURCE_DIR}/ExtDefaultCpuDispatcher.cpp
 	${LL_SOURCE_DIR}/ExtDefaultErrorCallback.cpp
@@ -64,6 +65,7 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtTriangleMeshExt.cpp
 	${LL_SOURCE_DIR}/ExtTetrahedronMeshExt.cpp
 	${LL_SOURCE_DIR}/ExtRemeshingExt.cpp
+	${LL_SOURCE_DIR}/ExtCpuTopology.h
 	${LL_SOURCE_DIR}/ExtCpuWorkerThread.h
 	${LL_SOURCE_DIR}/ExtDefaultCpuDispatcher.h
 	${LL_SOURCE_DIR}/ExtDefaultProfiler.h
@@ -73,6 +75,7 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtSerialization.h
 	${LL_SOURCE_DIR}/ExtSharedQueueEntryPool.h
 	${LL_SOURCE_DIR}/ExtTaskQueueHelper.h
+	${LL_SOURCE_DIR}/ExtWorkStealingQueue.h
 	${LL_SOURCE_DIR}/ExtSampling.cpp
 	${LL_SOURCE_DIR}/ExtTetMakerExt.cpp
 	${LL_SOURCE_DIR}/ExtGjkQueryExt.cpp
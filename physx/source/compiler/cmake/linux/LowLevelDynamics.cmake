@@ -48,5 +48,12 @@ SET(LOWLEVELDYNAMICS_COMPILE_DEFS
 	$<$<CONFIG:release>:${PHYSX_LINUX_RELEASE_COMPILE_DEFS};>
 )
 
+# Only the 8-wide contact kernels are compiled for AVX2/FMA. They are selected at runtime (see DySolverContact8.h),
+# so nothing else may be compiled with these flags.
+IF(PX_AVX2_FMA AND NOT CMAKE_SYSTEM_PROCESSOR STREQUAL "aarch64")
+	SET(LOWLEVELDYNAMICS_COMPILE_DEFS ${LOWLEVELDYNAMICS_COMPILE_DEFS};PX_AVX2_FMA)
+	SET_SOURCE_FILES_PROPERTIES(${LL_SOURCE_DIR}/DySolverContact8.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
+ENDIF()
+
 SET(LOWLEVELDYNAMICS_LIBTYPE OBJECT)
 
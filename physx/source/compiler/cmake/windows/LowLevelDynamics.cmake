@@ -54,6 +54,12 @@ SET(LOWLEVELDYNAMICS_COMPILE_DEFS
 	$<$<CONFIG:release>:${PHYSX_WINDOWS_RELEASE_COMPILE_DEFS};>
 )
 
+# The 8-wide contact kernels are selected at runtime (see DySolverContact8.h). MSVC compiles the AVX2/FMA intrinsics they
+# use without /arch:AVX2, which keeps everything else in DySolverContact8.cpp (e.g. non-inlined helpers in debug builds) SSE2.
+IF(PX_AVX2_FMA)
+	SET(LOWLEVELDYNAMICS_COMPILE_DEFS ${LOWLEVELDYNAMICS_COMPILE_DEFS};PX_AVX2_FMA)
+ENDIF()
+
 IF(LOWLEVELDYNAMICS_LIBTYPE STREQUAL "STATIC")
 	SET(LLDYNAMICS_COMPILE_PDB_NAME_DEBUG "LowLevelDynamics_static${CMAKE_DEBUG_POSTFIX}")
 	SET(LLDYNAMICS_COMPILE_PDB_NAME_CHECKED "LowLevelDynamics_static${CMAKE_CHECKED_POSTFIX}")
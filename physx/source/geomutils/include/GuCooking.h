@@ -106,6 +106,8 @@ namespace physx
 			return createConvexMesh(params, desc, *getInsertionCallback());
 		}
 
+		PX_C_EXPORT PX_PHYSX_COMMON_API	PxU32 cookConvexMeshes(const PxCookingParams& params, const PxConvexMeshDesc* descs, PxU32 count, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions=NULL);
+
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool validateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc);
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool computeHullPolygons(const PxCookingParams& params, const PxSimpleTriangleMesh& mesh, PxAllocatorCallback& inCallback, PxU32& nbVerts, PxVec3*& vertices,
 																PxU32& nbIndices, PxU32*& indices, PxU32& nbPolygons, PxHullPolygon*& hullPolygons);
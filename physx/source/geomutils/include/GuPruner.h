@@ -31,18 +31,24 @@
 
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxTransform.h"
+#include "foundation/PxBitUtils.h"
 #include "GuPrunerPayload.h"
 #include "GuPrunerTypedef.h"
 
 namespace physx
 {
+	class PxPlane;
 	class PxRenderOutput;
 	class PxBounds3;
+	class PxCpuDispatcher;
 
 namespace Gu
 {
 	class ShapeData;
 
+// Maximum number of rays in a packet for Pruner::raycastPacket(). Ray masks are 32-bit so this must remain <= 32.
+#define GU_RAY_PACKET_SIZE	16
+
 	struct PrunerRaycastCallback
 	{
 						PrunerRaycastCallback()		{}
@@ -155,6 +161,42 @@ namespace Gu
 		virtual	bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&) const = 0;
 		virtual	bool					overlap(const Gu::ShapeData& queryVolume, PrunerOverlapCallback&) const = 0;
 		virtual	bool					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&) const = 0;
+		// frustum / k-DOP culling, see PxSceneQuerySystemBase::cull(). Planes point outward, results are conservative.
+		virtual	bool					cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback&) const = 0;
+		// nearest-neighbour query. The callback is called for objects whose bounds are closer than inOutDistance to the
+		// point, roughly in order of increasing distance, and can shrink inOutDistance. See PxSceneQuerySystemBase::nearest().
+		virtual	bool					nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback&) const = 0;
+
+		/**
+		\brief	Raycasts a packet of rays against the pruner.
+
+		This is equivalent to calling raycast() for each active ray, but implementations can traverse their acceleration
+		structure once for the whole packet. Rays are independent: each has its own callback and its own distance, and
+		a ray stops when its callback returns false.
+
+		\param[in]		nbRays			Number of rays in the packet (at most GU_RAY_PACKET_SIZE)
+		\param[in]		origins			Ray origins
+		\param[in]		unitDirs		Normalized ray directions
+		\param[in,out]	inOutDistances	Per-ray max distances, shrunk as closer hits are found
+		\param[in]		callbacks		Per-ray callbacks. Only entries for active rays are accessed.
+		\param[in]		activeMask		Bitmask of rays to process (bit i for ray i)
+
+		\return	Bitmask of rays that were not stopped by their callback
+		*/
+		virtual	PxU32					raycastPacket(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, PxReal* inOutDistances, PrunerRaycastCallback* const* callbacks, PxU32 activeMask) const
+		{
+			PX_ASSERT(nbRays<=GU_RAY_PACKET_SIZE);
+			PX_UNUSED(nbRays);
+			PxU32 mask = activeMask;
+			while(mask)
+			{
+				const PxU32 i = PxLowestSetBit(mask);
+				mask &= mask - 1;
+				if(!raycast(origins[i], unitDirs[i], inOutDistances[i], *callbacks[i]))
+					activeMask &= ~(1<<i);
+			}
+			return activeMask;
+		}
 
 		/**
 		\brief	Retrieves the object's payload and data associated with the handle.
@@ -220,6 +262,12 @@ namespace Gu
 		 * returns true if new tree is needed
 		 */
 		virtual bool					prepareBuild() = 0;	
+
+		/**
+		 * Sets an optional dispatcher, used to split the work done in commit() (e.g. large tree refits) across threads.
+		 * NULL (the default) means all the work is done on the calling thread.
+		 */
+		virtual void					setTaskDispatcher(PxCpuDispatcher* dispatcher)	{ PX_UNUSED(dispatcher);	}
 	};
 }
 }
@@ -134,6 +134,7 @@ namespace Gu
 		PX_PHYSX_COMMON_API	void					raycast(const PxVec3& origin, const PxVec3& unitDir, float& inOutDistance, PrunerRaycastCallback& cb, const PrunerFilter* prunerFilter)			const;
 		PX_PHYSX_COMMON_API	void					overlap(const ShapeData& queryVolume, PrunerOverlapCallback& cb, const PrunerFilter* prunerFilter)												const;
 		PX_PHYSX_COMMON_API	void					sweep(const ShapeData& queryVolume, const PxVec3& unitDir, float& inOutDistance, PrunerRaycastCallback& cb, const PrunerFilter* prunerFilter)	const;
+		PX_PHYSX_COMMON_API	void					nearest(const PxVec3& point, float& inOutDistance, PrunerRaycastCallback& cb, const PrunerFilter* prunerFilter)								const;
 
 							PxU32					startCustomBuildstep();
 							void					customBuildstep(PxU32 index);
@@ -175,6 +176,7 @@ namespace Gu
 #include "GuCachedFuncs.h"
 #include "GuCapsule.h"
 #include "GuBounds.h"
+#include "GuSqInternal.h"
 
 #if PX_VC
 #pragma warning(disable: 4355 )	// "this" used in base member initializer list
@@ -287,7 +289,6 @@ namespace Gu
 		const GeomOverlapTable*	mCachedFuncs;
 		const PxGeometry&		mGeometry;
 		const PxTransform&		mPose;
-		PxHitFlags				mUnused;
 
 		DefaultPrunerOverlapCallback(PrunerFilterCallback& filterCB, const GeomOverlapTable* funcs, const PxGeometry& geometry, const PxTransform& pose, PxOverlapThreadContext* context=NULL) :
 			mContext		(context ? context : this),
@@ -309,7 +310,8 @@ namespace Gu
 
 			const PrunerPayload& payload = payloads[primIndex];
 
-			const PxGeometry* shapeGeom = mFilterCB.validatePayload(payload, mUnused);
+			PxHitFlags unused;
+			const PxGeometry* shapeGeom = mFilterCB.validatePayload(payload, unused);
 			if(!shapeGeom || !Gu::overlap(mGeometry, mPose, *shapeGeom, transforms[primIndex], mCachedFuncs, mContext))
 				return true;
 
@@ -452,6 +454,56 @@ namespace Gu
 		PX_NOCOPY(DefaultPrunerSweepCallbackT)
 	};
 
+	struct PrunerNearestHit : PxGeomNearestHit
+	{
+		PrunerPayload	payload;
+	};
+
+	// K-nearest-neighbour callback. The exact distance to each candidate is computed and the hit is inserted in the user
+	// buffer, sorted by increasing distance. Once the buffer is full, the query distance shrinks to the furthest hit's distance.
+	struct DefaultPrunerNearestCallback : public PrunerRaycastCallback
+	{
+		PrunerFilterCallback&	mFilterCB;
+		const PxVec3&			mPoint;
+		PrunerNearestHit*		mHits;
+		const PxU32				mMaxNbHits;
+		PxU32					mNbHits;
+
+		DefaultPrunerNearestCallback(PrunerFilterCallback& filterCB, const PxVec3& point, PxU32 maxNbHits, PrunerNearestHit* hits) :
+			mFilterCB	(filterCB),
+			mPoint		(point),
+			mHits		(hits),
+			mMaxNbHits	(maxNbHits),
+			mNbHits		(0)
+		{
+		}
+
+		virtual bool	invoke(PxReal& aDist, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms)	PX_OVERRIDE PX_FINAL
+		{
+			PX_ASSERT(payloads && transforms);
+
+			const PrunerPayload& payload = payloads[primIndex];
+
+			PxHitFlags unused;
+			const PxGeometry* shapeGeom = mFilterCB.validatePayload(payload, unused);
+			if(!shapeGeom)
+				return true;
+
+			PrunerNearestHit hit;
+			hit.distance = PxSqrt(computeNearestDistance2(mPoint, *shapeGeom, transforms[primIndex], hit.position, hit.faceIndex));
+			if(hit.distance > aDist)
+				return true;
+
+			hit.payload = payload;
+			mNbHits = insertNearestHit(mHits, mNbHits, mMaxNbHits, hit);
+			if(mNbHits == mMaxNbHits)
+				aDist = mHits[mNbHits-1].distance;
+			return true;
+		}
+
+		PX_NOCOPY(DefaultPrunerNearestCallback)
+	};
+
 typedef DefaultPrunerSweepCallbackT<SphereShapeCast>	DefaultPrunerSphereSweepCallback;
 typedef DefaultPrunerSweepCallbackT<BoxShapeCast>		DefaultPrunerBoxSweepCallback;
 typedef DefaultPrunerSweepCallbackT<CapsuleShapeCast>	DefaultPrunerCapsuleSweepCallback;
@@ -30,6 +30,7 @@
 #define GU_SQ_INTERNAL_H
 
 #include "foundation/PxSimpleTypes.h"
+#include "foundation/PxTransform.h"
 #include "common/PxPhysXCommonConfig.h"
 
 #define SQ_DEBUG_VIZ_STATIC_COLOR	PxU32(PxDebugColor::eARGB_BLUE)
@@ -42,11 +43,15 @@ namespace physx
 {
 	class PxRenderOutput;
 	class PxBounds3;
+	class PxCpuDispatcher;
+	class PxGeometry;
 
 	namespace Gu
 	{
+		class Pruner;
 		class BVH;
 		class AABBTree;
+		class QuantizedAABBTree;
 		class IncrementalAABBTree;
 		class IncrementalAABBTreeNode;
 	}
@@ -62,8 +67,33 @@ namespace physx
 
 	PX_PHYSX_COMMON_API	void visualizeTree(physx::PxRenderOutput& out, physx::PxU32 color, const physx::Gu::BVH* tree);
 	PX_PHYSX_COMMON_API	void visualizeTree(physx::PxRenderOutput& out, physx::PxU32 color, const physx::Gu::AABBTree* tree);
+	PX_PHYSX_COMMON_API	void visualizeTree(physx::PxRenderOutput& out, physx::PxU32 color, const physx::Gu::QuantizedAABBTree* tree);
 	PX_PHYSX_COMMON_API	void visualizeTree(physx::PxRenderOutput& out, physx::PxU32 color, const physx::Gu::IncrementalAABBTree* tree, physx::DebugVizCallback* cb=NULL);
 
+	// per-frame update of a set of pruners: a build step for dynamic pruners (if 'buildStep' is true) followed by a commit
+	// (if 'commit' is true). Pruners are independent so when a dispatcher is available, they are updated by separate tasks.
+	PX_PHYSX_COMMON_API	void updatePruners(physx::Gu::Pruner* const* pruners, physx::PxU32 nbPruners, bool buildStep, bool commit, physx::PxCpuDispatcher* dispatcher, physx::PxU64 contextID);
+
+	// squared distance between a point and an object for nearest-neighbour queries. This uses PxGeometryQuery::pointDistance()
+	// when the geometry type is supported, planes are handled directly, and other types fall back to the distance to their bounds.
+	// The face index is only computed for triangle meshes (0xffffffff otherwise).
+	PX_PHYSX_COMMON_API	physx::PxReal computeNearestDistance2(const physx::PxVec3& point, const physx::PxGeometry& geom, const physx::PxTransform& pose, physx::PxVec3& closestPoint, physx::PxU32& faceIndex);
+
+	// inserts a hit in a buffer of hits sorted by increasing distance, and returns the new number of hits. When the buffer
+	// is full the furthest hit is dropped, so callers should only insert hits closer than the last one in that case.
+	template<typename HitType>
+	PX_FORCE_INLINE physx::PxU32 insertNearestHit(HitType* hits, physx::PxU32 nbHits, physx::PxU32 maxNbHits, const HitType& hit)
+	{
+		physx::PxU32 i = nbHits < maxNbHits ? nbHits++ : maxNbHits - 1;
+		while(i && hits[i-1].distance > hit.distance)
+		{
+			hits[i] = hits[i-1];
+			i--;
+		}
+		hits[i] = hit;
+		return nbHits;
+	}
+
 	// PT: macros to try limiting the code duplication in headers. Mostly it just redefines the
 	// SqPruner API in implementation classes, and you shouldn't have to worry about it.
 	// Note that this assumes pool-based pruners with an mPool class member (for now).
@@ -82,6 +112,8 @@ namespace physx
 	virtual	bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, Gu::PrunerRaycastCallback&)				const;														\
 	virtual	bool					overlap(const Gu::ShapeData& queryVolume, Gu::PrunerOverlapCallback&)												const;														\
 	virtual	bool					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, Gu::PrunerRaycastCallback&)	const;														\
+	virtual	bool					cull(PxU32 nbPlanes, const PxPlane* planes, Gu::PrunerOverlapCallback&)												const;														\
+	virtual	bool					nearest(const PxVec3& point, PxReal& inOutDistance, Gu::PrunerRaycastCallback&)									const;														\
 	virtual	const PrunerPayload&	getPayloadData(PrunerHandle handle, PrunerPayloadData* data)														const	{ return mPool.getPayloadData(handle, data);	}	\
 	virtual	void					preallocate(PxU32 entries)																									{ mPool.preallocate(entries);					}	\
 	virtual	bool					setTransform(PrunerHandle handle, const PxTransform& transform)																{ return mPool.setTransform(handle, transform);	}	\
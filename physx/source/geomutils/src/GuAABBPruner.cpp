@@ -49,7 +49,7 @@ using namespace Cm;
 	#define SQ_PRUNER_EPSILON	0.005f
 	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
 
-AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode) :
+AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode, PxCpuDispatcher* buildDispatcher, bool quantizedTree) :
 	mAABBTree			(NULL),
 	mNewTree			(NULL),
 	mNbCachedBoxes		(0),
@@ -61,8 +61,11 @@ AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPruner
 	mAdaptiveRebuildTerm(0),
 	mNbObjectsPerNode	(nbObjectsPerNode),
 	mBuildStrategy		(buildStrategy),
+	mBuildDispatcher	(buildDispatcher),
+	mTaskDispatcher		(NULL),
 	mPool				(contextID, TRANSFORM_CACHE_GLOBAL),
 	mIncrementalRebuild	(incrementalRebuild),
+	mUseQuantizedTree	(quantizedTree && !incrementalRebuild),
 	mUncommittedChanges	(false),
 	mNeedsNewTree		(false),
 	mNewTreeFixups		("AABBPruner::mNewTreeFixups")
@@ -209,13 +212,60 @@ void AABBPruner::removeObjects(const PrunerHandle* handles, PxU32 count, PrunerP
 	}
 }
 
+// same as the regular tree version in AABBPruner::overlap(), for the quantized tree
+static bool quantizedOverlap(const AABBTreeBounds& treeBounds, const QuantizedAABBTree& tree, const ShapeData& queryVolume, OverlapCallbackAdapter& pcb)
+{
+	switch(queryVolume.getType())
+	{
+		case PxGeometryType::eBOX:
+		{
+			if(queryVolume.isOBB())
+			{	
+				const DefaultOBBAABBTest test(queryVolume);
+				return QuantizedAABBTreeOverlap<OBBAABBTest, OverlapCallbackAdapter>()(treeBounds, tree, test, pcb);
+			}
+			else
+			{
+				const DefaultAABBAABBTest test(queryVolume);
+				return QuantizedAABBTreeOverlap<AABBAABBTest, OverlapCallbackAdapter>()(treeBounds, tree, test, pcb);
+			}
+		}
+
+		case PxGeometryType::eCAPSULE:
+		{
+			const DefaultCapsuleAABBTest test(queryVolume, SQ_PRUNER_INFLATION);
+			return QuantizedAABBTreeOverlap<CapsuleAABBTest, OverlapCallbackAdapter>()(treeBounds, tree, test, pcb);
+		}
+
+		case PxGeometryType::eSPHERE:
+		{
+			const DefaultSphereAABBTest test(queryVolume);
+			return QuantizedAABBTreeOverlap<SphereAABBTest, OverlapCallbackAdapter>()(treeBounds, tree, test, pcb);
+		}
+
+		case PxGeometryType::eCONVEXMESH:
+		{
+			const DefaultOBBAABBTest test(queryVolume);
+			return QuantizedAABBTreeOverlap<OBBAABBTest, OverlapCallbackAdapter>()(treeBounds, tree, test, pcb);
+		}
+	default:
+		PX_ALWAYS_ASSERT_MESSAGE("unsupported overlap query volume geometry type");
+	}
+	return true;
+}
+
 bool AABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pcbArgName) const
 {
 	PX_ASSERT(!mUncommittedChanges);
 
 	bool again = true;
 
-	if(mAABBTree)
+	if(mQuantizedTree.getNbNodes())
+	{
+		OverlapCallbackAdapter pcb(pcbArgName, mPool);
+		again = quantizedOverlap(mPool.getCurrentAABBTreeBounds(), mQuantizedTree, queryVolume, pcb);
+	}
+	else if(mAABBTree)
 	{
 		OverlapCallbackAdapter pcb(pcbArgName, mPool);
 
@@ -273,7 +323,13 @@ bool AABBPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxRe
 
 	bool again = true;
 
-	if(mAABBTree)
+	if(mQuantizedTree.getNbNodes())
+	{
+		RaycastCallbackAdapter pcb(pcbArgName, mPool);
+		const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
+		again = QuantizedAABBTreeRaycast<true, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), mQuantizedTree, aabb.getCenter(), unitDir, inOutDistance, aabb.getExtents(), pcb);
+	}
+	else if(mAABBTree)
 	{
 		RaycastCallbackAdapter pcb(pcbArgName, mPool);
 		const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
@@ -292,7 +348,12 @@ bool AABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& in
 
 	bool again = true;
 
-	if(mAABBTree)
+	if(mQuantizedTree.getNbNodes())
+	{
+		RaycastCallbackAdapter pcb(pcbArgName, mPool);
+		again = QuantizedAABBTreeRaycast<false, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), mQuantizedTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
+	}
+	else if(mAABBTree)
 	{
 		RaycastCallbackAdapter pcb(pcbArgName, mPool);
 		again = AABBTreeRaycast<false, true, AABBTree, BVHNode, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
@@ -304,6 +365,93 @@ bool AABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& in
 	return again;
 }
 
+PxU32 AABBPruner::raycastPacket(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, PxReal* inOutDistances, PrunerRaycastCallback* const* callbacks, PxU32 activeMask) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+	PX_ASSERT(nbRays<=GU_RAY_PACKET_SIZE);
+
+	if(mQuantizedTree.getNbNodes())
+	{
+		// no packet traversal for the quantized tree yet, we just do one ray at a time
+		PxU32 mask = activeMask;
+		while(mask)
+		{
+			const PxU32 i = PxLowestSetBit(mask);
+			mask &= mask - 1;
+			RaycastCallbackAdapter pcb(*callbacks[i], mPool);
+			if(!QuantizedAABBTreeRaycast<false, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), mQuantizedTree, origins[i], unitDirs[i], inOutDistances[i], PxVec3(0.0f), pcb))
+				activeMask &= ~(1<<i);
+		}
+	}
+	else if(mAABBTree && activeMask)
+	{
+		RaycastPacketCallbackAdapter pcb(callbacks, mPool);
+		activeMask = AABBTreeRaycastPacket<true, GU_RAY_PACKET_SIZE, AABBTree, BVHNode, RaycastPacketCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, nbRays, origins, unitDirs, inOutDistances, activeMask, pcb);
+	}
+
+	// the bucket pruner only contains the objects added since the last rebuild, so we just do one ray at a time there
+	if(activeMask && mIncrementalRebuild && mBucketPruner.getNbObjects())
+	{
+		PxU32 mask = activeMask;
+		while(mask)
+		{
+			const PxU32 i = PxLowestSetBit(mask);
+			mask &= mask - 1;
+			if(!mBucketPruner.raycast(origins[i], unitDirs[i], inOutDistances[i], *callbacks[i]))
+				activeMask &= ~(1<<i);
+		}
+	}
+
+	return activeMask;
+}
+
+bool AABBPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcbArgName) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+
+	bool again = true;
+
+	const PlanesAABBTest test(nbPlanes, planes);
+	if(mQuantizedTree.getNbNodes())
+	{
+		OverlapCallbackAdapter pcb(pcbArgName, mPool);
+		again = QuantizedAABBTreeCull<OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), mQuantizedTree, test, pcb, test.getInitialClipMask());
+	}
+	else if(mAABBTree)
+	{
+		OverlapCallbackAdapter pcb(pcbArgName, mPool);
+		again = AABBTreeCull<true, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb, test.getInitialClipMask());
+	}
+
+	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
+		again = mBucketPruner.cull(nbPlanes, planes, pcbArgName);
+
+	return again;
+}
+
+bool AABBPruner::nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback& pcbArgName) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+
+	bool again = true;
+
+	if(mQuantizedTree.getNbNodes())
+	{
+		RaycastCallbackAdapter pcb(pcbArgName, mPool);
+		again = QuantizedAABBTreeNearest<RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), mQuantizedTree, point, inOutDistance, pcb);
+	}
+	else if(mAABBTree)
+	{
+		RaycastCallbackAdapter pcb(pcbArgName, mPool);
+		again = AABBTreeNearest<true, AABBTree, BVHNode, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, point, inOutDistance, pcb);
+	}
+
+	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
+		again = mBucketPruner.nearest(point, inOutDistance, pcbArgName);
+
+	return again;
+}
+
 // This isn't part of the pruner virtual interface, but it is part of the public interface
 // of AABBPruner - it gets called by SqManager to force a rebuild, and requires a commit() before 
 // queries can take place
@@ -343,6 +491,7 @@ void AABBPruner::commit()
 			PxGetFoundation().error(PxErrorCode::ePERF_WARNING, PX_FL, "SceneQuery static AABB Tree rebuilt, because a shape attached to a static actor was added, removed or moved, and PxSceneQueryDesc::staticStructure is set to eSTATIC_AABB_TREE.");
 
 		fullRebuildAABBTree();
+		updateQuantizedTree();
 		return;
 	}
 
@@ -454,6 +603,8 @@ void AABBPruner::shiftOrigin(const PxVec3& shift)
 	if(mAABBTree)
 		mAABBTree->shiftOrigin(shift);
 
+	mQuantizedTree.shiftOrigin(shift);
+
 	if(mIncrementalRebuild)
 		mBucketPruner.shiftOrigin(shift);
 
@@ -464,7 +615,10 @@ void AABBPruner::shiftOrigin(const PxVec3& shift)
 void AABBPruner::visualize(PxRenderOutput& out, PxU32 primaryColor, PxU32 secondaryColor) const
 {
 	// getAABBTree() asserts when pruner is dirty. NpScene::visualization() does not enforce flushUpdate. see DE7834
-	visualizeTree(out, primaryColor, mAABBTree);
+	if(mQuantizedTree.getNbNodes())
+		visualizeTree(out, primaryColor, &mQuantizedTree);
+	else
+		visualizeTree(out, primaryColor, mAABBTree);
 
 	// Render added objects not yet in the tree
 	out << PxTransform(PxIdentity);
@@ -486,6 +640,17 @@ bool AABBPruner::buildStep(bool synchronousCall)
 			if(!synchronousCall || !prepareBuild())
 				return false;
 		}
+		else if(mProgress==BUILD_INIT && mBuildDispatcher)
+		{
+			// parallel build. The dispatcher's workers and the calling thread build the whole tree at once, so we skip the
+			// progressive BUILD_IN_PROGRESS frames. The remaining states still run as usual.
+			mNewTree->build(mBuilder, mNodeAllocator);
+			mProgress = BUILD_NEW_MAPPING;
+			mNbCalls = 0;
+#if PX_DEBUG
+			mNewTree->validate();
+#endif
+		}
 		else if(mProgress==BUILD_INIT)
 		{
 			mNewTree->progressiveBuild(mBuilder, mNodeAllocator, mBuildStats, 0, 0);
@@ -626,6 +791,7 @@ bool AABBPruner::prepareBuild()
 			mBuilder.mBounds		= &mCachedBoxes;
 			mBuilder.mLimit			= mNbObjectsPerNode;
 			mBuilder.mBuildStrategy	= mBuildStrategy;
+			mBuilder.mDispatcher	= mBuildDispatcher;
 
 			mBuildStats.reset();
 
@@ -662,7 +828,7 @@ bool AABBPruner::fullRebuildAABBTree()
 		// Create a new tree
 		mAABBTree = PX_NEW(AABBTree);
 
-		Status = mAABBTree->build(AABBTreeBuildParams(mNbObjectsPerNode, nbObjects, &mPool.getCurrentAABBTreeBounds(), mBuildStrategy), mNodeAllocator);
+		Status = mAABBTree->build(AABBTreeBuildParams(mNbObjectsPerNode, nbObjects, &mPool.getCurrentAABBTreeBounds(), mBuildStrategy, mBuildDispatcher), mNodeAllocator);
 	}
 
 	// No need for the tree map for static pruner
@@ -681,6 +847,31 @@ void AABBPruner::updateBucketPruner()
 	mBucketPruner.build();
 }
 
+// called after full rebuilds and merges of static pruners, replaces the tree's nodes with the quantized version
+void AABBPruner::updateQuantizedTree()
+{
+	if(!mUseQuantizedTree)
+		return;
+
+	PX_ASSERT(!mIncrementalRebuild);
+	PX_PROFILE_ZONE("SceneQuery.prunerUpdateQuantizedTree", mPool.mContextID);
+
+	if(!mAABBTree)
+	{
+		mQuantizedTree.release();
+		return;
+	}
+
+	// the nodes have already been released after the last update, nothing changed since then
+	if(!mAABBTree->getNodes())
+		return;
+
+	mQuantizedTree.build(*mAABBTree);
+
+	// static pruners never refit their tree so we only keep the quantized version. The indices are still owned by mAABBTree.
+	mAABBTree->releaseNodes();
+}
+
 void AABBPruner::release() // this can be called from purge()
 {
 	mBucketPruner.release();
@@ -695,6 +886,7 @@ void AABBPruner::release() // this can be called from purge()
 	mNodeAllocator.release();
 	PX_DELETE(mNewTree);
 	PX_DELETE(mAABBTree);
+	mQuantizedTree.release();
 
 	mNbCachedBoxes = 0;
 	mProgress = BUILD_NOT_STARTED;
@@ -724,7 +916,7 @@ void AABBPruner::refitUpdatedAndRemoved()
 		return;
 
 	mBucketPruner.refitMarkedNodes(mPool.getCurrentWorldBoxes());
-	tree->refitMarkedNodes(mPool.getCurrentWorldBoxes());
+	tree->refitMarkedNodes(mPool.getCurrentWorldBoxes(), mTaskDispatcher);
 }
 
 void AABBPruner::merge(const void* mergeParams)
@@ -745,8 +937,18 @@ void AABBPruner::merge(const void* mergeParams)
 
 		if(!mIncrementalRebuild)
 		{
-			// merge tree directly
-			mAABBTree->mergeTree(aabbTreeMergeParams);		
+			if(mAABBTree->getNodes())
+			{
+				// merge tree directly
+				mAABBTree->mergeTree(aabbTreeMergeParams);		
+				updateQuantizedTree();
+			}
+			else
+			{
+				// the nodes have been released after quantization so we cannot merge anymore. Rebuild from scratch instead.
+				fullRebuildAABBTree();
+				updateQuantizedTree();
+			}
 		}
 		else
 		{
@@ -757,7 +959,9 @@ void AABBPruner::merge(const void* mergeParams)
 
 void AABBPruner::getGlobalBounds(PxBounds3& bounds) const
 {
-	if(mAABBTree && mAABBTree->getNodes())
+	if(mQuantizedTree.getNbNodes())
+		bounds = mQuantizedTree.getRootBounds();
+	else if(mAABBTree && mAABBTree->getNodes())
 		bounds = mAABBTree->getNodes()->mBV;
 	else
 		bounds.setEmpty();
@@ -34,6 +34,7 @@
 #include "GuSqInternal.h"
 #include "GuPruningPool.h"
 #include "GuAABBTree.h"
+#include "GuQuantizedAABBTree.h"
 #include "GuAABBTreeUpdateMap.h"
 #include "GuAABBTreeBuildStats.h"
 
@@ -126,7 +127,7 @@ namespace Gu
 	{
 												PX_NOCOPY(AABBPruner)
 		public:
-		PX_PHYSX_COMMON_API						AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy=BVH_SPLATTER_POINTS, PxU32 nbObjectsPerNode=4); // true is equivalent to former dynamic pruner
+		PX_PHYSX_COMMON_API						AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy=BVH_SPLATTER_POINTS, PxU32 nbObjectsPerNode=4, PxCpuDispatcher* buildDispatcher=NULL, bool quantizedTree=false); // true is equivalent to former dynamic pruner
 		virtual									~AABBPruner();
 
 		// BasePruner
@@ -135,6 +136,7 @@ namespace Gu
 
 		// Pruner
 												DECLARE_PRUNER_API_COMMON
+		virtual			PxU32					raycastPacket(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, PxReal* inOutDistances, PrunerRaycastCallback* const* callbacks, PxU32 activeMask)	const;
 		virtual			bool					isDynamic()			const		{ return mIncrementalRebuild;	}
 		//~Pruner
 
@@ -142,6 +144,7 @@ namespace Gu
 		virtual			void					setRebuildRateHint(PxU32 nbStepsForRebuild);	// Besides the actual rebuild steps, 3 additional steps are needed.
 		virtual			bool					buildStep(bool synchronousCall = true);	// returns true if finished
 		virtual			bool					prepareBuild();	// returns true if new tree is needed
+		virtual			void					setTaskDispatcher(PxCpuDispatcher* dispatcher)	{ mTaskDispatcher = dispatcher;	}
 		//~DynamicPruner
 
 		// direct access for test code
@@ -152,12 +155,15 @@ namespace Gu
 		PX_FORCE_INLINE	void					setAABBTree(AABBTree* tree)		{ mAABBTree = tree; }
 		PX_FORCE_INLINE	const AABBTree*			hasAABBTree()		const		{ return mAABBTree;	}
 		PX_FORCE_INLINE	BuildStatus				getBuildStatus()	const		{ return mProgress;	}
+		PX_FORCE_INLINE	const QuantizedAABBTree&	getQuantizedTree()	const		{ return mQuantizedTree;	}
 				
 		// local functions
 //		private:
 						NodeAllocator			mNodeAllocator;
 
 						AABBTree*				mAABBTree; // current active tree
+		// Optional compressed version of mAABBTree used by queries, static pruners only. The nodes of mAABBTree are released once this is built.
+						QuantizedAABBTree		mQuantizedTree;
 						AABBTreeBuildParams		mBuilder; // this class deals with the details of the actual tree building
 						BuildStats				mBuildStats;
 
@@ -200,6 +206,10 @@ namespace Gu
 
 			const		PxU32					mNbObjectsPerNode;
 			const		BVHBuildStrategy		mBuildStrategy;
+		// Optional dispatcher for parallel builds. When set, the new tree is built in one go in BUILD_INIT instead of progressively.
+						PxCpuDispatcher* const	mBuildDispatcher;
+		// Optional dispatcher for parallel refits in commit(), see DynamicPruner::setTaskDispatcher()
+						PxCpuDispatcher*		mTaskDispatcher;
 
 						PruningPool				mPool; // Pool of AABBs
 
@@ -218,6 +228,10 @@ namespace Gu
 		// bucket pruner is only used with incremental rebuild
 				const	bool					mIncrementalRebuild;
 
+		// Set once in the constructor, enables mQuantizedTree. Only used without incremental rebuild, since refits and
+		// incremental rebuilds need the regular nodes.
+				const	bool					mUseQuantizedTree;
+
 		// A rebuild can be triggered even when the Pruner is not dirty
 		// mUncommittedChanges is set to true in add, remove, update and buildStep
 		// mUncommittedChanges is set to false in commit
@@ -255,6 +269,7 @@ namespace Gu
 						void					release();
 						void					refitUpdatedAndRemoved();
 						void					updateBucketPruner();
+						void					updateQuantizedTree();
 	};
 
 }
@@ -35,6 +35,10 @@
 #include "foundation/PxMathUtils.h"
 #include "foundation/PxFPU.h"
 #include "foundation/PxInlineArray.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxBitUtils.h"
+#include "task/PxCpuDispatcher.h"
+#include "CmParallelJobs.h"
 
 using namespace physx;
 using namespace Gu;
@@ -106,6 +110,42 @@ void NodeAllocator::init(PxU32 nbPrimitives, PxU32 limit)
 	mTotalNbNodes = 1;
 }
 
+// allocator for a subtree built separately from the main tree (see buildHierarchyParallel). The subtree's root
+// node lives in the main allocator so the first slab starts empty, and only the root's descendants are allocated here.
+void NodeAllocator::initSubtree(PxU32 nbPrimitives, PxU32 limit)
+{
+	const PxU32 maxSize = nbPrimitives * 2 - 1;
+	const PxU32 estimatedFinalSize = PxMax<PxU32>(2, maxSize <= 1024 ? maxSize : maxSize / limit);
+	mPool = PX_NEW(AABBTreeBuildNode)[estimatedFinalSize];
+	PxMemZero(mPool, sizeof(AABBTreeBuildNode)*estimatedFinalSize);
+
+	mSlabs.pushBack(Slab(mPool, 0, estimatedFinalSize));
+	mCurrentSlabIndex = 0;
+	mTotalNbNodes = 0;
+}
+
+// transfers the slabs of a subtree allocator to this one. Nodes are not moved so children pointers remain valid,
+// and flattenTree() resolves them across all slabs.
+void NodeAllocator::merge(NodeAllocator& subtreeAllocator)
+{
+	const PxU32 nbSlabs = subtreeAllocator.mSlabs.size();
+	for(PxU32 i=0;i<nbSlabs;i++)
+	{
+		Slab& s = subtreeAllocator.mSlabs[i];
+		if(s.mNbUsedNodes)
+			mSlabs.pushBack(s);
+		else
+			PX_DELETE_ARRAY(s.mPool);
+	}
+	mTotalNbNodes += subtreeAllocator.mTotalNbNodes;
+	mCurrentSlabIndex = mSlabs.size() - 1;
+
+	subtreeAllocator.mSlabs.reset();
+	subtreeAllocator.mPool = NULL;
+	subtreeAllocator.mCurrentSlabIndex = 0;
+	subtreeAllocator.mTotalNbNodes = 0;
+}
+
 // PT: TODO: inline this?
 AABBTreeBuildNode* NodeAllocator::getBiNode()
 {
@@ -368,14 +408,8 @@ static PxU32* initAABBTreeBuild(const AABBTreeBuildParams& params, NodeAllocator
 #define DEFAULT_BUILD_STACK_SIZE	256
 typedef PxInlineArray<AABBTreeBuildNode*, DEFAULT_BUILD_STACK_SIZE>	BuildStack;
 
-static void buildHierarchy(AABBTreeBuildNode* root, const AABBTreeBuildParams& params, BuildStats& stats, NodeAllocator& nodeBase, PxU32* const indices, bool useSAH)
+namespace
 {
-	PxU32 nb = 1;
-	BuildStack stack;
-	stack.forceSize_Unsafe(DEFAULT_BUILD_STACK_SIZE);
-
-	stack[0] = root;
-
 	struct Local
 	{
 		static PX_FORCE_INLINE PxU32 pushBack(AABBTreeBuildNode* node, BuildStack& stack, PxU32 nb)
@@ -400,10 +434,20 @@ static void buildHierarchy(AABBTreeBuildNode* root, const AABBTreeBuildParams& p
 			return nb;
 		}
 	};
+}
+
+static void buildHierarchy(AABBTreeBuildNode* root, const AABBTreeBuildParams& params, BuildStats& stats, NodeAllocator& nodeBase, PxU32* const indices, bool useSAH)
+{
+	PxU32 nb = 1;
+	BuildStack stack;
+	stack.forceSize_Unsafe(DEFAULT_BUILD_STACK_SIZE);
+
+	stack[0] = root;
 
 	if(useSAH)
 	{
-		SAH_Buffers sah(params.mNbPrimitives);
+		// the root can be a subtree when called from buildHierarchyParallel, so we only need buffers for its primitives
+		SAH_Buffers sah(root->mNbPrimitives);
 
 		do
 		{
@@ -425,13 +469,132 @@ static void buildHierarchy(AABBTreeBuildNode* root, const AABBTreeBuildParams& p
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// parallel build. The top of the tree is subdivided on the calling thread until nodes are small enough, then these
+// nodes are built as independent subtrees by the dispatcher's workers and the calling thread. Each subtree only touches
+// its own range of the indices array and uses its own node allocator, whose slabs are merged into the main one at the end.
+#define PARALLEL_BUILD_MIN_NB_PRIMS			4096	// trees with less primitives are always built serially
+#define PARALLEL_BUILD_MIN_SUBTREE_SIZE		512		// don't create subtree jobs smaller than this
+#define PARALLEL_BUILD_NB_JOBS_PER_THREAD	4		// more jobs than threads, for load balancing
+
+namespace
+{
+	class ParallelBuildJobs : public Cm::ParallelJobs
+	{
+		PX_NOCOPY(ParallelBuildJobs)
+	public:
+							ParallelBuildJobs(const AABBTreeBuildParams& params, PxU32* indices, const PxArray<AABBTreeBuildNode*>& roots, bool useSAH) :
+								mParams(params), mIndices(indices), mRoots(roots), mUseSAH(useSAH)
+							{
+								const PxU32 nbJobs = roots.size();
+								mAllocators = PX_NEW(NodeAllocator)[nbJobs];
+								mStats = PX_ALLOCATE(BuildStats, nbJobs, "BuildStats");
+								PxMemZero(mStats, sizeof(BuildStats)*nbJobs);
+							}
+
+		virtual				~ParallelBuildJobs()
+							{
+								PX_FREE(mStats);
+								PX_DELETE_ARRAY(mAllocators);
+							}
+
+		virtual	void		processJob(PxU32 job, PxU32)	PX_OVERRIDE
+		{
+			AABBTreeBuildNode* root = mRoots[job];
+			mAllocators[job].initSubtree(root->mNbPrimitives, mParams.mLimit);
+			buildHierarchy(root, mParams, mStats[job], mAllocators[job], mIndices, mUseSAH);
+		}
+
+		const AABBTreeBuildParams&			mParams;
+		PxU32* const						mIndices;
+		const PxArray<AABBTreeBuildNode*>&	mRoots;
+		const bool							mUseSAH;
+		NodeAllocator*						mAllocators;
+		BuildStats*							mStats;
+	};
+
+	struct LargerSubtreeFirst
+	{
+		PX_FORCE_INLINE bool operator()(const AABBTreeBuildNode* a, const AABBTreeBuildNode* b) const
+		{
+			return a->mNbPrimitives > b->mNbPrimitives;
+		}
+	};
+}
+
+// top-down serial phase, until the remaining nodes are small enough to become subtree jobs
+static void buildTopLevelHierarchy(PxArray<AABBTreeBuildNode*>& roots, PxU32 subtreeSize, AABBTreeBuildNode* root, const AABBTreeBuildParams& params, BuildStats& stats, NodeAllocator& nodeBase, PxU32* const indices, SAH_Buffers* sah)
+{
+	PxU32 nb = 1;
+	BuildStack stack;
+	stack.forceSize_Unsafe(DEFAULT_BUILD_STACK_SIZE);
+
+	stack[0] = root;
+
+	do
+	{
+		AABBTreeBuildNode* node = stack[--nb];
+		if(node->mNbPrimitives <= subtreeSize)
+		{
+			roots.pushBack(node);
+			continue;
+		}
+
+		if(sah)
+			node->subdivideSAH(params, *sah, stats, nodeBase, indices);
+		else
+			node->subdivide(params, stats, nodeBase, indices);
+		nb = Local::processChildren(node, stack, nb, stats);
+
+	}while(nb);
+}
+
+static void buildHierarchyParallel(AABBTreeBuildNode* root, const AABBTreeBuildParams& params, BuildStats& stats, NodeAllocator& nodeBase, PxU32* const indices, bool useSAH)
+{
+	PxCpuDispatcher& dispatcher = *params.mDispatcher;
+	const PxU32 nbThreads = dispatcher.getWorkerCount() + 1;
+	const PxU32 subtreeSize = PxMax(root->mNbPrimitives / (nbThreads * PARALLEL_BUILD_NB_JOBS_PER_THREAD), PxMax<PxU32>(PARALLEL_BUILD_MIN_SUBTREE_SIZE, params.mLimit));
+
+	PxArray<AABBTreeBuildNode*> roots;
+	if(useSAH)
+	{
+		SAH_Buffers sah(root->mNbPrimitives);
+		buildTopLevelHierarchy(roots, subtreeSize, root, params, stats, nodeBase, indices, &sah);
+	}
+	else
+		buildTopLevelHierarchy(roots, subtreeSize, root, params, stats, nodeBase, indices, NULL);
+
+	const PxU32 nbJobs = roots.size();
+	if(!nbJobs)
+		return;
+
+	// start with the largest subtrees so that the smaller ones fill the gaps at the end
+	PxSort(roots.begin(), nbJobs, LargerSubtreeFirst());
+
+	ParallelBuildJobs jobs(params, indices, roots, useSAH);
+	Cm::ParallelJobsRunner runner("Gu.parallelBuildAABBTree");
+	runner.run(&dispatcher, jobs, nbJobs);
+
+	for(PxU32 i=0;i<nbJobs;i++)
+	{
+		stats.mCount += jobs.mStats[i].mCount;
+		stats.mTotalPrims += jobs.mStats[i].mTotalPrims;
+		nodeBase.merge(jobs.mAllocators[i]);
+	}
+}
+
 PxU32* Gu::buildAABBTree(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator, BuildStats& stats)
 {
 	PxU32* indices = initAABBTreeBuild(params, nodeAllocator, stats);
 	if(!indices)
 		return NULL;
 
-	buildHierarchy(nodeAllocator.mPool, params, stats, nodeAllocator, indices, params.mBuildStrategy==BVH_SAH);
+	const bool useSAH = params.mBuildStrategy==BVH_SAH;
+	if(params.mDispatcher && params.mDispatcher->getWorkerCount() && params.mNbPrimitives>=PARALLEL_BUILD_MIN_NB_PRIMS)
+		buildHierarchyParallel(nodeAllocator.mPool, params, stats, nodeAllocator, indices, useSAH);
+	else
+		buildHierarchy(nodeAllocator.mPool, params, stats, nodeAllocator, indices, useSAH);
 
 	return indices;
 }
@@ -859,7 +1022,150 @@ static void refitMarkedLoop(const PxBounds3* PX_RESTRICT boxes, BVHNode* const P
 	}
 }
 
-void BVHPartialRefitData::refitMarkedNodes(const PxBounds3* boxes)
+// parallel version of refitMarkedLoop. The marked nodes at the top of the tree are gathered breadth-first on the
+// calling thread until there are enough marked subtrees below them. These subtrees are independent and refit by the
+// dispatcher's workers and the calling thread, then the top nodes are refit last.
+#define PARALLEL_REFIT_MIN_NB_NODES			8192	// when the tree has less nodes, the serial version is used
+#define PARALLEL_REFIT_MIN_NB_MARKED_NODES	4096	// when less nodes are marked, the serial version is used
+#define PARALLEL_REFIT_NB_JOBS_PER_THREAD	4		// more jobs than threads, for load balancing
+
+namespace
+{
+	// per-thread scratch arrays, reused by all the jobs a thread processes
+	struct ParallelRefitScratch : public PxUserAllocated
+	{
+		PxArray<PxU32>	mStack;
+		PxArray<PxU32>	mMarked;
+	};
+
+	class ParallelRefitJobs : public Cm::ParallelJobs
+	{
+		PX_NOCOPY(ParallelRefitJobs)
+	public:
+							ParallelRefitJobs(const PxBounds3* boxes, BVHNode* nodes, const PxU32* indices, const PxU32* bits, const PxArray<PxU32>& roots, PxU32 nbThreads) :
+								mBoxes(boxes), mNodes(nodes), mIndices(indices), mBits(bits), mRoots(roots)
+							{
+								mScratch = PX_NEW(ParallelRefitScratch)[nbThreads];
+							}
+
+		virtual				~ParallelRefitJobs()
+							{
+								PX_DELETE_ARRAY(mScratch);
+							}
+
+		PX_FORCE_INLINE	PxU32	isMarked(PxU32 index)	const	{ return mBits[index>>5] & (1<<(index&31));	}
+
+		virtual	void		processJob(PxU32 job, PxU32 threadIndex)	PX_OVERRIDE
+		{
+			PxArray<PxU32>& stack = mScratch[threadIndex].mStack;
+			PxArray<PxU32>& marked = mScratch[threadIndex].mMarked;
+
+			// gather the subtree's marked nodes depth-first, then refit them in reverse order (children before parents).
+			// The bits are only read here, they're cleared by the calling thread once all jobs are done.
+			stack.pushBack(mRoots[job]);
+			while(stack.size())
+			{
+				const PxU32 index = stack.popBack();
+				marked.pushBack(index);
+				const BVHNode& node = mNodes[index];
+				if(!node.isLeaf())
+				{
+					const PxU32 posIndex = node.getPosIndex();
+					if(isMarked(posIndex))
+						stack.pushBack(posIndex);
+					if(isMarked(posIndex+1))
+						stack.pushBack(posIndex+1);
+				}
+			}
+
+			PxU32 nb = marked.size();
+			while(nb--)
+			{
+				if(mIndices)
+					refitNode<1>(mNodes + marked[nb], mBoxes, mIndices, mNodes);
+				else
+					refitNode<0>(mNodes + marked[nb], mBoxes, mIndices, mNodes);
+			}
+			marked.clear();
+		}
+
+		const PxBounds3*		mBoxes;
+		BVHNode*				mNodes;
+		const PxU32*			mIndices;
+		const PxU32*			mBits;
+		const PxArray<PxU32>&	mRoots;
+		ParallelRefitScratch*	mScratch;
+	};
+}
+
+static bool useParallelRefit(const PxCpuDispatcher* dispatcher, const PxU32* bits, PxU32 nbToGo)
+{
+	if(!dispatcher || !dispatcher->getWorkerCount() || nbToGo*32<PARALLEL_REFIT_MIN_NB_NODES)
+		return false;
+
+	// the parallel version has a fixed cost that only pays off when a lot of nodes have been marked
+	PxU32 nbMarked = 0;
+	for(PxU32 i=0;i<nbToGo;i++)
+		nbMarked += PxBitCount(bits[i]);
+	return nbMarked>=PARALLEL_REFIT_MIN_NB_MARKED_NODES;
+}
+
+static void refitMarkedParallel(PxCpuDispatcher& dispatcher, const PxBounds3* boxes, BVHNode* nodeBase, const PxU32* indices, PxU32* bits, PxU32 nbToGo)
+{
+	// markNodeForRefit() always marks the parents of a node, so nothing is marked if the root isn't
+	if(bits[0] & 1)
+	{
+		const PxU32 nbThreads = dispatcher.getWorkerCount() + 1;
+		const PxU32 nbWantedJobs = nbThreads * PARALLEL_REFIT_NB_JOBS_PER_THREAD;
+
+		PxArray<PxU32> top;
+		PxArray<PxU32> roots;
+		PxArray<PxU32> queue;
+		queue.pushBack(0);
+		PxU32 head = 0;
+		while(head<queue.size() && queue.size() - head + roots.size() < nbWantedJobs)
+		{
+			const PxU32 index = queue[head++];
+			const BVHNode& node = nodeBase[index];
+			if(node.isLeaf())
+			{
+				roots.pushBack(index);
+				continue;
+			}
+			top.pushBack(index);
+
+			const PxU32 posIndex = node.getPosIndex();
+			if(bits[posIndex>>5] & (1<<(posIndex&31)))
+				queue.pushBack(posIndex);
+			if(bits[(posIndex+1)>>5] & (1<<((posIndex+1)&31)))
+				queue.pushBack(posIndex+1);
+		}
+		for(PxU32 i=head;i<queue.size();i++)
+			roots.pushBack(queue[i]);
+
+		const PxU32 nbJobs = roots.size();
+		if(nbJobs)
+		{
+			ParallelRefitJobs jobs(boxes, nodeBase, indices, bits, roots, Cm::ParallelJobsRunner::getNbThreads(&dispatcher, nbJobs));
+			Cm::ParallelJobsRunner runner("Gu.parallelRefitAABBTree");
+			runner.run(&dispatcher, jobs, nbJobs);
+		}
+
+		// top nodes were gathered breadth-first so parents come before their children
+		PxU32 nb = top.size();
+		while(nb--)
+		{
+			if(indices)
+				refitNode<1>(nodeBase + top[nb], boxes, indices, nodeBase);
+			else
+				refitNode<0>(nodeBase + top[nb], boxes, indices, nodeBase);
+		}
+	}
+
+	PxMemZero(bits, nbToGo*sizeof(PxU32));
+}
+
+void BVHPartialRefitData::refitMarkedNodes(const PxBounds3* boxes, PxCpuDispatcher* dispatcher)
 {
 	if(!mRefitBitmask.getBits())
 		return;	// No refit needed
@@ -877,7 +1183,9 @@ void BVHPartialRefitData::refitMarkedNodes(const PxBounds3* boxes)
 			}
 		}
 #endif
-		if(mIndices)
+		if(useParallelRefit(dispatcher, bits, size))
+			refitMarkedParallel(*dispatcher, boxes, mNodes, mIndices, bits, size);
+		else if(mIndices)
 			refitMarkedLoop<1>(boxes, mNodes, mIndices, bits, size);
 		else
 			refitMarkedLoop<0>(boxes, mNodes, mIndices, bits, size);
@@ -972,6 +1280,12 @@ void AABBTree::release(bool clearRefitMap)
 	mNbIndices = 0;
 }
 
+void AABBTree::releaseNodes()
+{
+	PX_DELETE_ARRAY(mNodes);
+	mNbNodes = 0;
+}
+
 // Initialize nodes/indices from the input tree merge data
 void AABBTree::initTree(const AABBTreeMergeData& tree)
 {
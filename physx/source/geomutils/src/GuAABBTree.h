@@ -41,6 +41,8 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Gu
 {
 	struct BVHNode;
@@ -59,12 +61,13 @@ namespace Gu
 	class PX_PHYSX_COMMON_API AABBTreeBuildParams : public PxUserAllocated
 	{
 	public:
-								AABBTreeBuildParams(PxU32 limit = 1, PxU32 nb_prims = 0, const AABBTreeBounds* bounds = NULL, BVHBuildStrategy bs = BVH_SPLATTER_POINTS) :
+								AABBTreeBuildParams(PxU32 limit = 1, PxU32 nb_prims = 0, const AABBTreeBounds* bounds = NULL, BVHBuildStrategy bs = BVH_SPLATTER_POINTS, PxCpuDispatcher* dispatcher = NULL) :
 									mLimit			(limit),
 									mNbPrimitives	(nb_prims),
 									mBounds			(bounds),
 									mCache			(NULL),
-									mBuildStrategy	(bs)
+									mBuildStrategy	(bs),
+									mDispatcher		(dispatcher)
 								{
 								}
 								~AABBTreeBuildParams()
@@ -76,6 +79,7 @@ namespace Gu
 								{
 									mLimit = mNbPrimitives = 0;
 									mBounds = NULL;
+									mDispatcher = NULL;
 									PX_FREE(mCache);
 								}
 
@@ -84,6 +88,7 @@ namespace Gu
 		const AABBTreeBounds*	mBounds;		//!< Shortcut to an app-controlled array of AABBs.
 		mutable PxVec3*			mCache;			//!< Cache for AABB centers - managed by build code.
 		BVHBuildStrategy		mBuildStrategy;
+		PxCpuDispatcher*		mDispatcher;	//!< Optional dispatcher used to build large trees in parallel. NULL to build on the calling thread only.
 	};
 
 	//! AABB tree node used for building
@@ -130,6 +135,8 @@ namespace Gu
 
 		void						release();
 		void						init(PxU32 nbPrimitives, PxU32 limit);
+		void						initSubtree(PxU32 nbPrimitives, PxU32 limit);
+		void						merge(NodeAllocator& subtreeAllocator);
 		AABBTreeBuildNode*			getBiNode();
 
 		AABBTreeBuildNode*			mPool;
@@ -270,7 +277,8 @@ namespace Gu
 		// adds node[index] to a list of nodes to refit when refitMarkedNodes is called
 		// Note that this includes updating the hierarchy up the chain
 		PX_PHYSX_COMMON_API		void			markNodeForRefit(TreeNodeIndex nodeIndex);
-		PX_PHYSX_COMMON_API		void			refitMarkedNodes(const PxBounds3* boxes);
+		// the optional dispatcher is used to refit large trees in parallel
+		PX_PHYSX_COMMON_API		void			refitMarkedNodes(const PxBounds3* boxes, PxCpuDispatcher* dispatcher=NULL);
 
 		PX_FORCE_INLINE			PxU32*			getUpdateMap()	{ return mUpdateMap;	}
 
@@ -298,6 +306,8 @@ namespace Gu
 		PX_PHYSX_COMMON_API		PxU32			progressiveBuild(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator, BuildStats& stats, PxU32 progress, PxU32 limit);
 		//~Progressive building
 		PX_PHYSX_COMMON_API		void			release(bool clearRefitMap=true);
+		// Releases the nodes but keeps the indices, e.g. after the tree has been converted to another node format
+		PX_PHYSX_COMMON_API		void			releaseNodes();
 
 		// Merge tree with another one
 		PX_PHYSX_COMMON_API		void			mergeTree(const AABBTreeMergeData& tree);
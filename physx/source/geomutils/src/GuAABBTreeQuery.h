@@ -32,7 +32,9 @@
 #include "GuBVHTestsSIMD.h"
 #include "GuAABBTreeBounds.h"
 #include "foundation/PxInlineArray.h"
+#include "foundation/PxBitUtils.h"
 #include "GuAABBTreeNode.h"
+#include "GuQuantizedAABBTree.h"
 
 namespace physx
 {
@@ -129,6 +131,101 @@ namespace physx
 
 		//////////////////////////////////////////////////////////////////////////
 
+		template<const bool tHasIndices, typename Node, typename QueryCallback>
+		static PX_FORCE_INLINE bool doCullLeafTest(const PlanesAABBTest& test, PxU32 clipMask, const Node* node, const PxBounds3* bounds, const PxU32* indices, QueryCallback& visitor)
+		{
+			PxU32 nbPrims = node->getNbPrimitives();
+			// the leaf's bounds are the primitive's bounds when there's only one, and nothing to test when the leaf is fully inside
+			const bool doBoxTest = clipMask && nbPrims > 1;
+			const PxU32* prims = tHasIndices ? node->getPrimitives(indices) : NULL;
+			while(nbPrims--)
+			{
+				const PxU32 primIndex = tHasIndices ? *prims++ : node->getPrimitiveIndex();
+				if(doBoxTest)
+				{
+					Vec4V center2, extents2;
+					getBoundsTimesTwo(center2, extents2, bounds, primIndex);
+
+					const FloatV halfV = FLoad(0.5f);
+					const Vec4V extents_ = V4Scale(extents2, halfV);
+					const Vec4V center_ = V4Scale(center2, halfV);
+
+					PxU32 unused;
+					if(!test(Vec3V_From_Vec4V(center_), Vec3V_From_Vec4V(extents_), clipMask, unused))
+						continue;
+				}
+
+				if(!visitor.invoke(primIndex))
+					return false;
+			}
+			return true;
+		}
+
+		// frustum / k-DOP culling. Each stack entry carries the clip mask of its parent, so that planes the parent is fully
+		// inside of are not tested again for the children (coherency culling). Subtrees fully inside all the planes are reported
+		// without any further test. The results are conservative: primitive bounds close to the volume's corners can be reported
+		// even though they don't touch it.
+		template<const bool tHasIndices, typename Tree, typename Node, typename QueryCallback>
+		class AABBTreeCull
+		{
+			struct StackEntry
+			{
+				const Node*	mNode;
+				PxU32		mClipMask;
+			};
+		public:
+			bool operator()(const AABBTreeBounds& treeBounds, const Tree& tree, const PlanesAABBTest& test, QueryCallback& visitor, PxU32 clipMask)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+
+				PxInlineArray<StackEntry, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				const Node* const nodeBase = tree.getNodes();
+				stack[0].mNode = nodeBase;
+				stack[0].mClipMask = clipMask;
+				PxU32 stackIndex = 1;
+
+				while(stackIndex > 0)
+				{
+					const StackEntry& entry = stack[--stackIndex];
+					const Node* node = entry.mNode;
+					PxU32 parentClipMask = entry.mClipMask;
+
+					for(;;)
+					{
+						PxU32 nodeClipMask = 0;
+						if(parentClipMask)
+						{
+							Vec3V center, extents;
+							node->getAABBCenterExtentsV(&center, &extents);
+							if(!test(center, extents, parentClipMask, nodeClipMask))
+								break;
+						}
+
+						if(node->isLeaf())
+						{
+							if(!doCullLeafTest<tHasIndices, Node>(test, nodeClipMask, node, bounds, tree.getIndices(), visitor))
+								return false;
+							break;
+						}
+
+						const Node* children = node->getPos(nodeBase);
+
+						node = children;
+						parentClipMask = nodeClipMask;
+						stack[stackIndex].mNode = children + 1;
+						stack[stackIndex].mClipMask = nodeClipMask;
+						stackIndex++;
+						if(stackIndex == stack.capacity())
+							stack.resizeUninitialized(stack.capacity() * 2);
+					}
+				}
+				return true;
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
 		template <const bool tInflate, const bool tHasIndices, typename Node, typename QueryCallback> // use inflate=true for sweeps, inflate=false for raycasts
 		static PX_FORCE_INLINE bool doLeafTest(	const Node* node, Gu::RayAABBTest& test, const PxBounds3* bounds, const PxU32* indices, PxReal& maxDist, QueryCallback& pcb)
 		{
@@ -255,6 +352,637 @@ namespace physx
 		};
 
 
+		//////////////////////////////////////////////////////////////////////////
+
+		// packet version of doLeafTest (raycasts only). 'rayMask' is the set of rays that touched the leaf node.
+		// Rays stopped by their callback are removed from 'activeMask'.
+		template <const bool tHasIndices, PxU32 tMaxNbRays, typename Node, typename QueryCallback>
+		static PX_FORCE_INLINE void doPacketLeafTest(	const Node* node, Gu::RayAABBPacketTest<tMaxNbRays>& test, const PxBounds3* bounds, const PxU32* indices,
+														PxReal* maxDists, PxU32 rayMask, PxU32& activeMask, QueryCallback& pcb)
+		{
+			PxU32 nbPrims = node->getNbPrimitives();
+			const bool doBoxTest = nbPrims > 1;
+			const PxU32* prims = tHasIndices ? node->getPrimitives(indices) : NULL;
+			while(nbPrims-- && rayMask)
+			{
+				const PxU32 primIndex = tHasIndices ? *prims++ : node->getPrimitiveIndex();
+				PxU32 primMask = rayMask;
+				if(doBoxTest)
+				{
+					Vec4V center_, extents_;
+					getBoundsTimesTwo(center_, extents_, bounds, primIndex);
+
+					primMask = test.check(Vec3V_From_Vec4V(center_), Vec3V_From_Vec4V(extents_), primMask);
+				}
+
+				while(primMask)
+				{
+					const PxU32 rayIndex = PxLowestSetBit(primMask);
+					primMask &= primMask - 1;
+
+					// see doLeafTest for why we need both 'md' and 'oldMaxDist'
+					const PxReal oldMaxDist = maxDists[rayIndex];
+					PxReal md = oldMaxDist;
+					if(!pcb.invoke(rayIndex, md, primIndex))
+					{
+						activeMask &= ~(1<<rayIndex);
+						rayMask &= ~(1<<rayIndex);
+						continue;
+					}
+
+					if(md < oldMaxDist)
+					{
+						maxDists[rayIndex] = md;
+						test.setDistance(rayIndex, md);
+					}
+				}
+			}
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+
+		// traverses the tree once for a packet of rays. Each node is tested against all the rays that touched its parent,
+		// 4 rays at a time, and the traversal stack stores the corresponding ray mask along with the node. Each ray keeps its
+		// own max distance. Returns the mask of rays that were not stopped by the callback.
+		template <const bool tHasIndices, PxU32 tMaxNbRays, typename Tree, typename Node, typename QueryCallback>
+		class AABBTreeRaycastPacket
+		{
+			struct StackEntry
+			{
+				const Node*	mNode;
+				PxU32		mRayMask;
+			};
+
+		public:
+			PxU32 operator()(
+				const AABBTreeBounds& treeBounds, const Tree& tree,
+				PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, PxReal* maxDists, PxU32 activeMask,
+				QueryCallback& pcb)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+
+				Gu::RayAABBPacketTest<tMaxNbRays> test(nbRays, origins, unitDirs, maxDists);
+
+				PxInlineArray<StackEntry, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				const Node* const nodeBase = tree.getNodes();
+				stack[0].mNode = nodeBase;
+				stack[0].mRayMask = activeMask;
+				PxU32 stackIndex = 1;
+
+				while(stackIndex--)
+				{
+					const Node* node = stack[stackIndex].mNode;
+					// rays can have been stopped since the node was pushed
+					PxU32 rayMask = stack[stackIndex].mRayMask & activeMask;
+					if(!rayMask)
+						continue;
+
+					Vec3V center, extents;
+					node->getAABBCenterExtentsV2(&center, &extents);
+					rayMask = test.check(center, extents, rayMask);
+					if(rayMask)
+					{
+						while(!node->isLeaf())
+						{
+							const Node* children = node->getPos(nodeBase);
+
+							Vec3V c0, e0;
+							children[0].getAABBCenterExtentsV2(&c0, &e0);
+							const PxU32 m0 = test.check(c0, e0, rayMask);
+
+							Vec3V c1, e1;
+							children[1].getAABBCenterExtentsV2(&c1, &e1);
+							const PxU32 m1 = test.check(c1, e1, rayMask);
+
+							if(m0 && m1)	// if both intersect, push the one with the further center (along the packet's direction) on the stack for later
+							{
+								// & 1 because FAllGrtr behavior differs across platforms
+								const PxU32 bit = FAllGrtr(V3Dot(V3Sub(c1, c0), test.mPacketDir), FZero()) & 1;
+								stack[stackIndex].mNode = children + bit;
+								stack[stackIndex].mRayMask = bit ? m1 : m0;
+								stackIndex++;
+								node = children + (1 - bit);
+								rayMask = bit ? m0 : m1;
+								if(stackIndex == stack.capacity())
+									stack.resizeUninitialized(stack.capacity() * 2);
+							}
+							else if(m0)
+							{
+								node = children;
+								rayMask = m0;
+							}
+							else if(m1)
+							{
+								node = children + 1;
+								rayMask = m1;
+							}
+							else
+								goto skip_leaf_code;
+						}
+
+						doPacketLeafTest<tHasIndices, tMaxNbRays, Node>(node, test, bounds, tree.getIndices(), maxDists, rayMask, activeMask, pcb);
+						if(!activeMask)
+							return 0;
+					skip_leaf_code:;
+					}
+				}
+				return activeMask;
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
+		// leaves of quantized trees are stored in their parent's slots, this wraps a slot for the leaf functions above
+		struct QuantizedLeaf
+		{
+			PX_FORCE_INLINE					QuantizedLeaf(PxU32 data) : mData(data)	{}
+
+			PX_FORCE_INLINE	PxU32			getNbPrimitives()					const	{ return (mData>>1)&15;		}
+			PX_FORCE_INLINE	const PxU32*	getPrimitives(const PxU32* base)	const	{ return base + (mData>>5);	}
+			PX_FORCE_INLINE	PxU32			getPrimitiveIndex()					const	{ return mData>>5;			}
+
+			const PxU32	mData;
+		};
+
+		// traversal stack entry for quantized trees. We need the decoded bounds of a node to decode its children.
+		struct QuantizedStackEntry
+		{
+			PxU32	mData;
+			PxVec3	mMin;
+			PxVec3	mMax;
+		};
+
+		static PX_FORCE_INLINE PxU32 getQuantizedNodeMask(const QuantizedBVHNode* node)
+		{
+			return PxU32(node->mData[0]!=0) | (PxU32(node->mData[1]!=0)<<1) | (PxU32(node->mData[2]!=0)<<2) | (PxU32(node->mData[3]!=0)<<3);
+		}
+
+		template<typename Test, typename QueryCallback>
+		class QuantizedAABBTreeOverlap
+		{
+		public:
+			bool operator()(const AABBTreeBounds& treeBounds, const QuantizedAABBTree& tree, const Test& test, QueryCallback& visitor)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const PxU32* indices = tree.getIndices();
+				const QuantizedBVHNode* const nodeBase = tree.getNodes();
+
+				const PxBounds3& rootBounds = tree.getRootBounds();
+				if(!test(V3LoadU(rootBounds.getCenter()), V3LoadU(rootBounds.getExtents())))
+					return true;
+
+				PxInlineArray<QuantizedStackEntry, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				stack[0].mData = 0;
+				stack[0].mMin = rootBounds.minimum;
+				stack[0].mMax = rootBounds.maximum;
+				PxU32 stackIndex = 1;
+
+				const FloatV halfV = FLoad(0.5f);
+				while(stackIndex--)
+				{
+					const QuantizedStackEntry& entry = stack[stackIndex];
+					const QuantizedBVHNode* node = nodeBase + (entry.mData>>1);
+
+					QuantizedBVHChildren children;
+					decodeQuantizedChildren(children, *node, entry.mMin, entry.mMax);
+
+					PX_ALIGN(16, float minX[4]);	V4StoreA(children.mMinX, minX);
+					PX_ALIGN(16, float minY[4]);	V4StoreA(children.mMinY, minY);
+					PX_ALIGN(16, float minZ[4]);	V4StoreA(children.mMinZ, minZ);
+					PX_ALIGN(16, float maxX[4]);	V4StoreA(children.mMaxX, maxX);
+					PX_ALIGN(16, float maxY[4]);	V4StoreA(children.mMaxY, maxY);
+					PX_ALIGN(16, float maxZ[4]);	V4StoreA(children.mMaxZ, maxZ);
+
+					PxU32 mask = getQuantizedNodeMask(node);
+					while(mask)
+					{
+						const PxU32 i = PxLowestSetBit(mask);
+						mask &= mask - 1;
+
+						const PxVec3 childMin(minX[i], minY[i], minZ[i]);
+						const PxVec3 childMax(maxX[i], maxY[i], maxZ[i]);
+						const Vec3V minV = V3LoadU(childMin);
+						const Vec3V maxV = V3LoadU(childMax);
+						if(!test(V3Scale(V3Add(maxV, minV), halfV), V3Scale(V3Sub(maxV, minV), halfV)))
+							continue;
+
+						if(node->isLeaf(i))
+						{
+							const QuantizedLeaf leaf(node->mData[i]);
+							if(!doOverlapLeafTest<true, Test, QuantizedLeaf>(test, &leaf, bounds, indices, visitor))
+								return false;
+						}
+						else
+						{
+							QuantizedStackEntry& child = stack[stackIndex++];
+							child.mData = node->mData[i];
+							child.mMin = childMin;
+							child.mMax = childMax;
+							if(stackIndex == stack.capacity())
+								stack.resizeUninitialized(stack.capacity() * 2);
+						}
+					}
+				}
+				return true;
+			}
+		};
+
+		// culling version for quantized trees, same as AABBTreeCull. Children of nodes fully inside the volume are not decoded.
+		template<typename QueryCallback>
+		class QuantizedAABBTreeCull
+		{
+			struct StackEntry
+			{
+				PxU32	mData;
+				PxU32	mClipMask;
+				PxVec3	mMin;
+				PxVec3	mMax;
+			};
+		public:
+			bool operator()(const AABBTreeBounds& treeBounds, const QuantizedAABBTree& tree, const PlanesAABBTest& test, QueryCallback& visitor, PxU32 clipMask)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const PxU32* indices = tree.getIndices();
+				const QuantizedBVHNode* const nodeBase = tree.getNodes();
+
+				const PxBounds3& rootBounds = tree.getRootBounds();
+				PxU32 rootClipMask = 0;
+				if(clipMask && !test(V3LoadU(rootBounds.getCenter()), V3LoadU(rootBounds.getExtents()), clipMask, rootClipMask))
+					return true;
+
+				PxInlineArray<StackEntry, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				stack[0].mData = 0;
+				stack[0].mClipMask = rootClipMask;
+				stack[0].mMin = rootBounds.minimum;
+				stack[0].mMax = rootBounds.maximum;
+				PxU32 stackIndex = 1;
+
+				const FloatV halfV = FLoad(0.5f);
+				while(stackIndex--)
+				{
+					const StackEntry& entry = stack[stackIndex];
+					const QuantizedBVHNode* node = nodeBase + (entry.mData>>1);
+					const PxU32 parentClipMask = entry.mClipMask;
+
+					PX_ALIGN(16, float minX[4]);	PX_ALIGN(16, float minY[4]);	PX_ALIGN(16, float minZ[4]);
+					PX_ALIGN(16, float maxX[4]);	PX_ALIGN(16, float maxY[4]);	PX_ALIGN(16, float maxZ[4]);
+					if(parentClipMask)
+					{
+						QuantizedBVHChildren children;
+						decodeQuantizedChildren(children, *node, entry.mMin, entry.mMax);
+						V4StoreA(children.mMinX, minX);	V4StoreA(children.mMinY, minY);	V4StoreA(children.mMinZ, minZ);
+						V4StoreA(children.mMaxX, maxX);	V4StoreA(children.mMaxY, maxY);	V4StoreA(children.mMaxZ, maxZ);
+					}
+
+					PxU32 mask = getQuantizedNodeMask(node);
+					while(mask)
+					{
+						const PxU32 i = PxLowestSetBit(mask);
+						mask &= mask - 1;
+
+						PxU32 childClipMask = 0;
+						PxVec3 childMin(0.0f), childMax(0.0f);
+						if(parentClipMask)
+						{
+							childMin = PxVec3(minX[i], minY[i], minZ[i]);
+							childMax = PxVec3(maxX[i], maxY[i], maxZ[i]);
+							const Vec3V minV = V3LoadU(childMin);
+							const Vec3V maxV = V3LoadU(childMax);
+							if(!test(V3Scale(V3Add(maxV, minV), halfV), V3Scale(V3Sub(maxV, minV), halfV), parentClipMask, childClipMask))
+								continue;
+						}
+
+						if(node->isLeaf(i))
+						{
+							const QuantizedLeaf leaf(node->mData[i]);
+							if(!doCullLeafTest<true, QuantizedLeaf>(test, childClipMask, &leaf, bounds, indices, visitor))
+								return false;
+						}
+						else
+						{
+							StackEntry& child = stack[stackIndex++];
+							child.mData = node->mData[i];
+							child.mClipMask = childClipMask;
+							child.mMin = childMin;
+							child.mMax = childMax;
+							if(stackIndex == stack.capacity())
+								stack.resizeUninitialized(stack.capacity() * 2);
+						}
+					}
+				}
+				return true;
+			}
+		};
+
+		// raycast/sweep version for quantized trees. The 4 children of a node are tested at once, and the ones that
+		// are touched are pushed on the stack so that the closest one (along the ray) gets processed first. Entries are
+		// tested again when popped since the max distance can have shrunk in the meantime.
+		template <const bool tInflate, typename QueryCallback> // use inflate=true for sweeps, inflate=false for raycasts
+		class QuantizedAABBTreeRaycast
+		{
+		public:
+			bool operator()(
+				const AABBTreeBounds& treeBounds, const QuantizedAABBTree& tree,
+				const PxVec3& origin, const PxVec3& unitDir, PxReal& maxDist, const PxVec3& inflation,
+				QueryCallback& pcb)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const PxU32* indices = tree.getIndices();
+				const QuantizedBVHNode* const nodeBase = tree.getNodes();
+
+				// same as in AABBTreeRaycast, we pass center*2 and extents*2 to the ray-box code
+				Gu::RayAABBTest test(origin*2.0f, unitDir*2.0f, maxDist, inflation*2.0f);
+
+				const PxBounds3& rootBounds = tree.getRootBounds();
+
+				PxInlineArray<QuantizedStackEntry, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				stack[0].mData = 0;
+				stack[0].mMin = rootBounds.minimum;
+				stack[0].mMax = rootBounds.maximum;
+				PxU32 stackIndex = 1;
+
+				const Vec4V dir = Vec4V_From_Vec3V(test.mDir);
+				const Vec4V dirX = V4SplatElement<0>(dir);
+				const Vec4V dirY = V4SplatElement<1>(dir);
+				const Vec4V dirZ = V4SplatElement<2>(dir);
+
+				while(stackIndex--)
+				{
+					const QuantizedStackEntry entry = stack[stackIndex];
+					{
+						const Vec3V minV = V3LoadU(entry.mMin);
+						const Vec3V maxV = V3LoadU(entry.mMax);
+						if(!test.check<tInflate>(V3Add(maxV, minV), V3Sub(maxV, minV)))
+							continue;
+					}
+
+					if(entry.mData & 1)
+					{
+						const QuantizedLeaf leaf(entry.mData);
+						if(!doLeafTest<tInflate, true, QuantizedLeaf>(&leaf, test, bounds, indices, maxDist, pcb))
+							return false;
+						continue;
+					}
+
+					const QuantizedBVHNode* node = nodeBase + (entry.mData>>1);
+
+					QuantizedBVHChildren children;
+					decodeQuantizedChildren(children, *node, entry.mMin, entry.mMax);
+
+					const Vec4V cx = V4Add(children.mMaxX, children.mMinX);
+					const Vec4V cy = V4Add(children.mMaxY, children.mMinY);
+					const Vec4V cz = V4Add(children.mMaxZ, children.mMinZ);
+					PxU32 mask = test.check4<tInflate>(cx, cy, cz, V4Sub(children.mMaxX, children.mMinX), V4Sub(children.mMaxY, children.mMinY), V4Sub(children.mMaxZ, children.mMinZ));
+					mask &= getQuantizedNodeMask(node);
+					if(!mask)
+						continue;
+
+					PX_ALIGN(16, float minX[4]);	V4StoreA(children.mMinX, minX);
+					PX_ALIGN(16, float minY[4]);	V4StoreA(children.mMinY, minY);
+					PX_ALIGN(16, float minZ[4]);	V4StoreA(children.mMinZ, minZ);
+					PX_ALIGN(16, float maxX[4]);	V4StoreA(children.mMaxX, maxX);
+					PX_ALIGN(16, float maxY[4]);	V4StoreA(children.mMaxY, maxY);
+					PX_ALIGN(16, float maxZ[4]);	V4StoreA(children.mMaxZ, maxZ);
+					PX_ALIGN(16, float keys[4]);	V4StoreA(V4MulAdd(cz, dirZ, V4MulAdd(cy, dirY, V4Mul(cx, dirX))), keys);
+
+					// sort touched children by decreasing distance along the ray, so that the closest one is pushed last
+					PxU32 order[4];
+					PxU32 nb = 0;
+					while(mask)
+					{
+						const PxU32 i = PxLowestSetBit(mask);
+						mask &= mask - 1;
+						PxU32 j = nb++;
+						while(j && keys[order[j-1]] < keys[i])
+						{
+							order[j] = order[j-1];
+							j--;
+						}
+						order[j] = i;
+					}
+
+					if(stackIndex + nb >= stack.capacity())
+						stack.resizeUninitialized(stack.capacity() * 2);
+
+					for(PxU32 j=0;j<nb;j++)
+					{
+						const PxU32 i = order[j];
+						QuantizedStackEntry& child = stack[stackIndex++];
+						child.mData = node->mData[i];
+						child.mMin = PxVec3(minX[i], minY[i], minZ[i]);
+						child.mMax = PxVec3(maxX[i], maxY[i], maxZ[i]);
+					}
+				}
+				return true;
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
+		template<typename Node>
+		static PX_FORCE_INLINE float nodeDistance2(const Vec3V point, const Node* node)
+		{
+			Vec3V center, extents;
+			node->getAABBCenterExtentsV(&center, &extents);
+			return pointAABBDistance2(point, V3Sub(center, extents), V3Add(center, extents));
+		}
+
+		// binary min-heap used by the best-first traversals below. Entries need a mDist2 member.
+		template<typename Entry>
+		class NearestQueue
+		{
+		public:
+			PX_FORCE_INLINE	bool	isEmpty()	const	{ return mEntries.empty();	}
+
+			void push(const Entry& entry)
+			{
+				PxU32 i = mEntries.size();
+				mEntries.pushBack(entry);
+				while(i)
+				{
+					const PxU32 parent = (i-1)>>1;
+					if(mEntries[parent].mDist2 <= entry.mDist2)
+						break;
+					mEntries[i] = mEntries[parent];
+					i = parent;
+				}
+				mEntries[i] = entry;
+			}
+
+			Entry pop()
+			{
+				const Entry top = mEntries[0];
+				const Entry last = mEntries.popBack();
+				const PxU32 size = mEntries.size();
+				if(size)
+				{
+					PxU32 i = 0;
+					for(;;)
+					{
+						PxU32 child = i*2+1;
+						if(child>=size)
+							break;
+						if(child+1<size && mEntries[child+1].mDist2 < mEntries[child].mDist2)
+							child++;
+						if(last.mDist2 <= mEntries[child].mDist2)
+							break;
+						mEntries[i] = mEntries[child];
+						i = child;
+					}
+					mEntries[i] = last;
+				}
+				return top;
+			}
+
+		private:
+			PxInlineArray<Entry, RAW_TRAVERSAL_STACK_SIZE>	mEntries;
+		};
+
+		template<const bool tHasIndices, typename Node, typename QueryCallback>
+		static PX_FORCE_INLINE bool doNearestLeafTest(const Node* node, const Vec3V point, const PxBounds3* bounds, const PxU32* indices, PxReal& maxDist, QueryCallback& pcb)
+		{
+			PxU32 nbPrims = node->getNbPrimitives();
+			const PxU32* prims = tHasIndices ? node->getPrimitives(indices) : NULL;
+			while(nbPrims--)
+			{
+				const PxU32 primIndex = tHasIndices ? *prims++ : node->getPrimitiveIndex();
+
+				const PxBounds3& primBounds = bounds[primIndex];
+				if(pointAABBDistance2(point, V3LoadU(primBounds.minimum), V3LoadU(primBounds.maximum)) > maxDist*maxDist)
+					continue;
+
+				// the callback computes the exact distance to the primitive and can shrink maxDist
+				if(!pcb.invoke(maxDist, primIndex))
+					return false;
+			}
+			return true;
+		}
+
+		// best-first nearest-neighbour traversal. Nodes are visited in order of increasing distance to the query point,
+		// and the traversal stops as soon as the closest remaining node is further than maxDist. The callback computes the
+		// exact distance to each primitive and shrinks maxDist as it sees fit (e.g. to the K-th closest distance found so far
+		// for K-nearest-neighbour queries).
+		template<const bool tHasIndices, typename Tree, typename Node, typename QueryCallback>
+		class AABBTreeNearest
+		{
+			struct QueueEntry
+			{
+				const Node*	mNode;
+				float		mDist2;
+			};
+		public:
+			bool operator()(const AABBTreeBounds& treeBounds, const Tree& tree, const PxVec3& point, PxReal& maxDist, QueryCallback& pcb)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const PxU32* indices = tree.getIndices();
+				const Node* const nodeBase = tree.getNodes();
+				const Vec3V p = V3LoadU(point);
+
+				NearestQueue<QueueEntry> queue;
+				const QueueEntry root = { nodeBase, nodeDistance2(p, nodeBase) };
+				queue.push(root);
+
+				while(!queue.isEmpty())
+				{
+					const QueueEntry entry = queue.pop();
+					// maxDist can have shrunk since the entry was pushed
+					if(entry.mDist2 > maxDist*maxDist)
+						break;
+
+					const Node* node = entry.mNode;
+					if(node->isLeaf())
+					{
+						if(!doNearestLeafTest<tHasIndices>(node, p, bounds, indices, maxDist, pcb))
+							return false;
+						continue;
+					}
+
+					const Node* children = node->getPos(nodeBase);
+					for(PxU32 i=0;i<2;i++)
+					{
+						const QueueEntry child = { children + i, nodeDistance2(p, children + i) };
+						if(child.mDist2 <= maxDist*maxDist)
+							queue.push(child);
+					}
+				}
+				return true;
+			}
+		};
+
+		// nearest-neighbour version for quantized trees, same as AABBTreeNearest. Leaves are pushed to the queue with
+		// the decoded bounds of their slot, so that they are also processed in order.
+		template<typename QueryCallback>
+		class QuantizedAABBTreeNearest
+		{
+			struct QueueEntry
+			{
+				PxU32	mData;
+				float	mDist2;
+				PxVec3	mMin;
+				PxVec3	mMax;
+			};
+		public:
+			bool operator()(const AABBTreeBounds& treeBounds, const QuantizedAABBTree& tree, const PxVec3& point, PxReal& maxDist, QueryCallback& pcb)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const PxU32* indices = tree.getIndices();
+				const QuantizedBVHNode* const nodeBase = tree.getNodes();
+				const Vec3V p = V3LoadU(point);
+
+				const PxBounds3& rootBounds = tree.getRootBounds();
+				const QueueEntry root = { 0, pointAABBDistance2(p, V3LoadU(rootBounds.minimum), V3LoadU(rootBounds.maximum)), rootBounds.minimum, rootBounds.maximum };
+
+				NearestQueue<QueueEntry> queue;
+				queue.push(root);
+
+				while(!queue.isEmpty())
+				{
+					const QueueEntry entry = queue.pop();
+					if(entry.mDist2 > maxDist*maxDist)
+						break;
+
+					if(entry.mData & 1)
+					{
+						const QuantizedLeaf leaf(entry.mData);
+						if(!doNearestLeafTest<true, QuantizedLeaf>(&leaf, p, bounds, indices, maxDist, pcb))
+							return false;
+						continue;
+					}
+
+					const QuantizedBVHNode* node = nodeBase + (entry.mData>>1);
+
+					QuantizedBVHChildren children;
+					decodeQuantizedChildren(children, *node, entry.mMin, entry.mMax);
+					PX_ALIGN(16, float minX[4]);	PX_ALIGN(16, float minY[4]);	PX_ALIGN(16, float minZ[4]);
+					PX_ALIGN(16, float maxX[4]);	PX_ALIGN(16, float maxY[4]);	PX_ALIGN(16, float maxZ[4]);
+					V4StoreA(children.mMinX, minX);	V4StoreA(children.mMinY, minY);	V4StoreA(children.mMinZ, minZ);
+					V4StoreA(children.mMaxX, maxX);	V4StoreA(children.mMaxY, maxY);	V4StoreA(children.mMaxZ, maxZ);
+
+					PxU32 mask = getQuantizedNodeMask(node);
+					while(mask)
+					{
+						const PxU32 i = PxLowestSetBit(mask);
+						mask &= mask - 1;
+
+						QueueEntry child;
+						child.mData = node->mData[i];
+						child.mMin = PxVec3(minX[i], minY[i], minZ[i]);
+						child.mMax = PxVec3(maxX[i], maxY[i], maxZ[i]);
+						child.mDist2 = pointAABBDistance2(p, V3LoadU(child.mMin), V3LoadU(child.mMax));
+						if(child.mDist2 <= maxDist*maxDist)
+							queue.push(child);
+					}
+				}
+				return true;
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
 		struct TraversalControl
 		{
 			enum Enum {
@@ -31,6 +31,8 @@
 
 #include "foundation/PxTransform.h"
 #include "foundation/PxBounds3.h"
+#include "foundation/PxPlane.h"
+#include "foundation/PxBitUtils.h"
 #include "geometry/PxBoxGeometry.h"
 #include "geometry/PxSphereGeometry.h"
 #include "geometry/PxCapsuleGeometry.h"
@@ -93,12 +95,163 @@ struct RayAABBTest
 		return BAllEqTTTT(andABCMasks);
 	}
 
+	// SoA version of check() for 4 boxes at a time. Returns a bitmask (bit i for box i).
+	template<bool TInflate>
+	PX_FORCE_INLINE PxU32 check4(const Vec4V cx, const Vec4V cy, const Vec4V cz, const Vec4V extentsX, const Vec4V extentsY, const Vec4V extentsZ) const
+	{
+		const Vec4V inflation = Vec4V_From_Vec3V(mInflation);
+		const Vec4V ex = TInflate ? V4Add(extentsX, V4SplatElement<0>(inflation)) : extentsX;
+		const Vec4V ey = TInflate ? V4Add(extentsY, V4SplatElement<1>(inflation)) : extentsY;
+		const Vec4V ez = TInflate ? V4Add(extentsZ, V4SplatElement<2>(inflation)) : extentsZ;
+
+		// coordinate axes
+		const Vec4V rayMin = Vec4V_From_Vec3V(mRayMin);
+		const Vec4V rayMax = Vec4V_From_Vec3V(mRayMax);
+		BoolV m = BAnd(V4IsGrtrOrEq(V4Add(cx, ex), V4SplatElement<0>(rayMin)), V4IsGrtrOrEq(V4SplatElement<0>(rayMax), V4Sub(cx, ex)));
+		m = BAnd(m, BAnd(V4IsGrtrOrEq(V4Add(cy, ey), V4SplatElement<1>(rayMin)), V4IsGrtrOrEq(V4SplatElement<1>(rayMax), V4Sub(cy, ey))));
+		m = BAnd(m, BAnd(V4IsGrtrOrEq(V4Add(cz, ez), V4SplatElement<2>(rayMin)), V4IsGrtrOrEq(V4SplatElement<2>(rayMax), V4Sub(cz, ez))));
+
+		// cross axes
+		const Vec4V origin = Vec4V_From_Vec3V(mOrigin);
+		const Vec4V dir = Vec4V_From_Vec3V(mDir);
+		const Vec4V absDir = Vec4V_From_Vec3V(mAbsDir);
+		const Vec4V offsetX = V4Sub(V4SplatElement<0>(origin), cx);
+		const Vec4V offsetY = V4Sub(V4SplatElement<1>(origin), cy);
+		const Vec4V offsetZ = V4Sub(V4SplatElement<2>(origin), cz);
+		const Vec4V dirX = V4SplatElement<0>(dir);
+		const Vec4V dirY = V4SplatElement<1>(dir);
+		const Vec4V dirZ = V4SplatElement<2>(dir);
+		const Vec4V absDirX = V4SplatElement<0>(absDir);
+		const Vec4V absDirY = V4SplatElement<1>(absDir);
+		const Vec4V absDirZ = V4SplatElement<2>(absDir);
+
+		const Vec4V fx = V4NegMulSub(dirY, offsetX, V4Mul(dirX, offsetY));
+		const Vec4V fy = V4NegMulSub(dirZ, offsetY, V4Mul(dirY, offsetZ));
+		const Vec4V fz = V4NegMulSub(dirX, offsetZ, V4Mul(dirZ, offsetX));
+		const Vec4V gx = V4MulAdd(ex, absDirY, V4Mul(ey, absDirX));
+		const Vec4V gy = V4MulAdd(ey, absDirZ, V4Mul(ez, absDirY));
+		const Vec4V gz = V4MulAdd(ez, absDirX, V4Mul(ex, absDirZ));
+		m = BAnd(m, BAnd(V4IsGrtrOrEq(gx, V4Abs(fx)), BAnd(V4IsGrtrOrEq(gy, V4Abs(fy)), V4IsGrtrOrEq(gz, V4Abs(fz)))));
+
+		return BGetBitMask(m);
+	}
+
 	const Vec3V mOrigin, mDir, mDirYZX, mInflation, mAbsDir, mAbsDirYZX;
 	Vec3V mRayMin, mRayMax;
 protected:
 	RayAABBTest& operator=(const RayAABBTest&);
 };
 
+// SoA version of RayAABBTest for packets of up to tMaxNbRays rays. Rays are tested 4 at a time against the same
+// box, using the same math as RayAABBTest. Results are returned as bitmasks (bit i for ray i). As with RayAABBTest,
+// boxes are passed as center*2 and extents*2, so origins and directions are scaled by 2 in the constructor.
+template<PxU32 tMaxNbRays>
+struct RayAABBPacketTest
+{
+	PX_FORCE_INLINE RayAABBPacketTest(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* maxDists) :
+		mNbGroups	((nbRays+3)>>2)
+	{
+		PX_ASSERT(nbRays && nbRays<=tMaxNbRays);
+
+		PxVec3 packetDir(0.0f);
+		for(PxU32 i=0;i<mNbGroups*4;i++)
+		{
+			// unused lanes get a degenerate ray, they are masked out anyway
+			const PxVec3 origin = i<nbRays ? origins[i]*2.0f : PxVec3(0.0f);
+			const PxVec3 dir = i<nbRays ? unitDirs[i]*2.0f : PxVec3(0.0f);
+			mOriginX[i] = origin.x;	mOriginY[i] = origin.y;	mOriginZ[i] = origin.z;
+			mDirX[i] = dir.x;		mDirY[i] = dir.y;		mDirZ[i] = dir.z;
+			mAbsDirX[i] = PxAbs(dir.x);	mAbsDirY[i] = PxAbs(dir.y);	mAbsDirZ[i] = PxAbs(dir.z);
+			setDistance(i, i<nbRays ? maxDists[i] : 0.0f);
+			packetDir += dir;
+		}
+		mPacketDir = V3LoadU(packetDir);
+	}
+
+	PX_FORCE_INLINE void setDistance(PxU32 i, PxReal distance)
+	{
+		const PxVec3 origin(mOriginX[i], mOriginY[i], mOriginZ[i]);
+		const PxVec3 dir(mDirX[i], mDirY[i], mDirZ[i]);
+		const PxVec3 ext = distance >= PX_MAX_F32 ? PxVec3(	dir.x == 0 ? origin.x : PxSign(dir.x)*PX_MAX_F32,
+															dir.y == 0 ? origin.y : PxSign(dir.y)*PX_MAX_F32,
+															dir.z == 0 ? origin.z : PxSign(dir.z)*PX_MAX_F32)
+												  : origin + dir * distance;
+		mRayMinX[i] = PxMin(origin.x, ext.x);	mRayMaxX[i] = PxMax(origin.x, ext.x);
+		mRayMinY[i] = PxMin(origin.y, ext.y);	mRayMaxY[i] = PxMax(origin.y, ext.y);
+		mRayMinZ[i] = PxMin(origin.z, ext.z);	mRayMaxZ[i] = PxMax(origin.z, ext.z);
+	}
+
+	// Returns the subset of rays from 'mask' that touch the box
+	PX_FORCE_INLINE PxU32 check(const Vec3V center, const Vec3V extents, PxU32 mask) const
+	{
+		const Vec4V c = Vec4V_From_Vec3V(center);
+		const Vec4V e = Vec4V_From_Vec3V(extents);
+		const Vec4V cx = V4SplatElement<0>(c);
+		const Vec4V cy = V4SplatElement<1>(c);
+		const Vec4V cz = V4SplatElement<2>(c);
+		const Vec4V ex = V4SplatElement<0>(e);
+		const Vec4V ey = V4SplatElement<1>(e);
+		const Vec4V ez = V4SplatElement<2>(e);
+
+		PxU32 hits = 0;
+		for(PxU32 g=0;g<mNbGroups;g++)
+		{
+			const PxU32 o = g*4;
+			if(!((mask>>o) & 15))
+				continue;
+
+			// coordinate axes
+			BoolV m = BAnd(V4IsGrtrOrEq(V4Add(cx, ex), V4LoadA(mRayMinX + o)), V4IsGrtrOrEq(V4LoadA(mRayMaxX + o), V4Sub(cx, ex)));
+			m = BAnd(m, BAnd(V4IsGrtrOrEq(V4Add(cy, ey), V4LoadA(mRayMinY + o)), V4IsGrtrOrEq(V4LoadA(mRayMaxY + o), V4Sub(cy, ey))));
+			m = BAnd(m, BAnd(V4IsGrtrOrEq(V4Add(cz, ez), V4LoadA(mRayMinZ + o)), V4IsGrtrOrEq(V4LoadA(mRayMaxZ + o), V4Sub(cz, ez))));
+
+			// cross axes
+			const Vec4V offsetX = V4Sub(V4LoadA(mOriginX + o), cx);
+			const Vec4V offsetY = V4Sub(V4LoadA(mOriginY + o), cy);
+			const Vec4V offsetZ = V4Sub(V4LoadA(mOriginZ + o), cz);
+			const Vec4V dirX = V4LoadA(mDirX + o);
+			const Vec4V dirY = V4LoadA(mDirY + o);
+			const Vec4V dirZ = V4LoadA(mDirZ + o);
+			const Vec4V absDirX = V4LoadA(mAbsDirX + o);
+			const Vec4V absDirY = V4LoadA(mAbsDirY + o);
+			const Vec4V absDirZ = V4LoadA(mAbsDirZ + o);
+
+			const Vec4V fx = V4NegMulSub(dirY, offsetX, V4Mul(dirX, offsetY));
+			const Vec4V fy = V4NegMulSub(dirZ, offsetY, V4Mul(dirY, offsetZ));
+			const Vec4V fz = V4NegMulSub(dirX, offsetZ, V4Mul(dirZ, offsetX));
+			const Vec4V gx = V4MulAdd(ex, absDirY, V4Mul(ey, absDirX));
+			const Vec4V gy = V4MulAdd(ey, absDirZ, V4Mul(ez, absDirY));
+			const Vec4V gz = V4MulAdd(ez, absDirX, V4Mul(ex, absDirZ));
+			m = BAnd(m, BAnd(V4IsGrtrOrEq(gx, V4Abs(fx)), BAnd(V4IsGrtrOrEq(gy, V4Abs(fy)), V4IsGrtrOrEq(gz, V4Abs(fz)))));
+
+			hits |= BGetBitMask(m)<<o;
+		}
+		return hits & mask;
+	}
+
+	PX_ALIGN(16, PxReal	mOriginX[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mOriginY[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mOriginZ[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mDirX[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mDirY[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mDirZ[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mAbsDirX[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mAbsDirY[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mAbsDirZ[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mRayMinX[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mRayMinY[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mRayMinZ[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mRayMaxX[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mRayMaxY[tMaxNbRays]);
+	PX_ALIGN(16, PxReal	mRayMaxZ[tMaxNbRays]);
+	Vec3V				mPacketDir;	// sum of ray directions, used to order the traversal
+	const PxU32			mNbGroups;
+
+	PX_COMPILE_TIME_ASSERT(tMaxNbRays<=32 && !(tMaxNbRays & 3));
+protected:
+	RayAABBPacketTest& operator=(const RayAABBPacketTest&);
+};
+
 // probably not worth having a SIMD version of this unless the traversal passes Vec3Vs
 struct AABBAABBTest
 {
@@ -154,6 +307,47 @@ private:
 	const FloatV mRadius2;
 };
 
+// plane-masks test for frustum / k-DOP culling. Planes point outward, i.e. a box is culled when it is fully on the
+// positive side of one of them. Bit i of a clip mask is set when the box straddles plane i: planes the box is fully
+// inside of don't need to be tested again for its children, and a box with a null clip mask is fully inside the volume.
+struct PlanesAABBTest
+{
+	PX_FORCE_INLINE PlanesAABBTest(PxU32 nbPlanes, const PxPlane* planes) : mPlanes(planes), mMask(nbPlanes>=32 ? 0xffffffff : (1<<nbPlanes)-1)
+	{
+		PX_ASSERT(nbPlanes<=32);
+	}
+
+	// returns false if the box is outside the volume, otherwise the box's clip mask is written to outClipMask
+	PX_FORCE_INLINE bool operator()(const Vec3V boxCenter, const Vec3V boxExtents, PxU32 inClipMask, PxU32& outClipMask) const
+	{
+		PxU32 clipMask = 0;
+		PxU32 mask = inClipMask;
+		while(mask)
+		{
+			const PxU32 i = PxLowestSetBit(mask);
+			mask &= mask - 1;
+
+			const PxPlane& plane = mPlanes[i];
+			const Vec3V n = V3LoadU(plane.n);
+			const FloatV NP = V3Dot(boxExtents, V3Abs(n));
+			const FloatV MP = FAdd(V3Dot(boxCenter, n), FLoad(plane.d));
+			if(FAllGrtr(MP, NP))
+				return false;
+			if(FAllGrtr(MP, FNeg(NP)))
+				clipMask |= PxU32(1)<<i;
+		}
+		outClipMask = clipMask;
+		return true;
+	}
+
+	PX_FORCE_INLINE	PxU32	getInitialClipMask()	const	{ return mMask;	}
+
+private:
+	PlanesAABBTest& operator=(const PlanesAABBTest&);
+	const PxPlane*	mPlanes;
+	const PxU32		mMask;
+};
+
 // The Opcode capsule-AABB traversal test seems to be *exactly* the same as the ray-box test inflated by the capsule radius (so not a true capsule/box test)
 // and the code for the ray-box test is better. TODO: check the zero length case and use the sphere traversal if this one fails.
 // (OTOH it's not that hard to adapt the Ray-AABB test to a capsule test)
@@ -252,6 +446,15 @@ struct OBBAABBTests
 
 typedef OBBAABBTests<true> OBBAABBTest;
 
+// squared distance between a point and an AABB, 0 if the point is inside. Used by nearest-neighbour queries.
+static PX_FORCE_INLINE float pointAABBDistance2(const Vec3V point, const Vec3V minV, const Vec3V maxV)
+{
+	const Vec3V d = V3Max(V3Max(V3Sub(minV, point), V3Sub(point, maxV)), V3Zero());
+	float dist2;
+	FStore(V3Dot(d, d), &dist2);
+	return dist2;
+}
+
 }
 }
 #endif
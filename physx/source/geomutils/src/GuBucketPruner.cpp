@@ -30,6 +30,7 @@
 #include "foundation/PxBitUtils.h"
 #include "GuBucketPruner.h"
 #include "GuInternal.h"
+#include "GuBVHTestsSIMD.h"
 #include "CmVisualization.h"
 #include "CmRadixSort.h"
 
@@ -2184,6 +2185,193 @@ bool BucketPrunerCore::overlap(const ShapeData& queryVolume, PrunerOverlapCallba
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static PX_FORCE_INLINE bool cullBucketBox(const PlanesAABBTest& test, const BucketBox& box, PxU32 inClipMask, PxU32& outClipMask)
+{
+	// the parent box is fully inside the volume, nothing to test
+	if(!inClipMask)
+	{
+		outClipMask = 0;
+		return true;
+	}
+	return test(V3LoadU(box.mCenter), V3LoadU(box.mExtents), inClipMask, outClipMask);
+}
+
+// frustum / k-DOP culling. Each bucket is tested against the planes its parent bucket straddles, and the
+// contents of buckets fully inside the volume are reported without further tests.
+bool BucketPrunerCore::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcbArgName) const
+{
+	PX_ASSERT(!mDirty);
+
+	const PlanesAABBTest test(nbPlanes, planes);
+	const PxU32 clipMask = test.getInitialClipMask();
+
+#ifdef FREE_PRUNER_SIZE
+	{
+		BucketPrunerOverlapAdapter pcb(pcbArgName, mFreeObjects, mFreeTransforms);
+
+		for(PxU32 i=0;i<mNbFree;i++)
+		{
+			PxU32 unused;
+			if(test(V3LoadU(mFreeBounds[i].getCenter()), V3LoadU(mFreeBounds[i].getExtents()), clipMask, unused))
+			{
+				if(!pcb.invoke(i))
+					return false;
+			}
+		}
+	}
+#endif
+	if(!mSortedNb)
+		return true;
+
+	PxU32 globalClipMask;
+	if(!cullBucketBox(test, mGlobalBox, clipMask, globalClipMask))
+		return true;
+
+	for(PxU32 i=0;i<5;i++)
+	{
+		PxU32 clipMask1;
+		if(!mLevel1.mCounters[i] || !cullBucketBox(test, mLevel1.mBucketBox[i], globalClipMask, clipMask1))
+			continue;
+
+		for(PxU32 j=0;j<5;j++)
+		{
+			PxU32 clipMask2;
+			if(!mLevel2[i].mCounters[j] || !cullBucketBox(test, mLevel2[i].mBucketBox[j], clipMask1, clipMask2))
+				continue;
+
+			for(PxU32 k=0;k<5;k++)
+			{
+				const PxU32 nbInBucket = mLevel3[i][j].mCounters[k];
+				PxU32 clipMask3;
+				if(!nbInBucket || !cullBucketBox(test, mLevel3[i][j].mBucketBox[k], clipMask2, clipMask3))
+					continue;
+
+				const PxU32 offset = mLevel1.mOffsets[i] + mLevel2[i].mOffsets[j] + mLevel3[i][j].mOffsets[k];
+				const BucketBox* PX_RESTRICT boxes = mSortedWorldBoxes + offset;
+				BucketPrunerOverlapAdapter pcb(pcbArgName, mSortedObjects + offset, mSortedTransforms + offset);
+
+				for(PxU32 n=0;n<nbInBucket;n++)
+				{
+					PxU32 unused;
+					if(!cullBucketBox(test, boxes[n], clipMask3, unused))
+						continue;
+
+					if(!pcb.invoke(n))
+						return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static PX_FORCE_INLINE float bucketBoxDistance2(const Vec3V point, const BucketBox& box)
+{
+	const Vec3V center = V3LoadU(box.mCenter);
+	const Vec3V extents = V3LoadU(box.mExtents);
+	return pointAABBDistance2(point, V3Sub(center, extents), V3Add(center, extents));
+}
+
+// sorts the non-empty children of a bucket by distance to the query point, discarding the ones further than maxDist
+static PX_FORCE_INLINE PxU32 sortBucketChildren(const Vec3V point, const BucketPrunerNode& node, float maxDist, PxU32* order)
+{
+	float dist2[5];
+	PxU32 nb = 0;
+	for(PxU32 i=0;i<5;i++)
+	{
+		if(!node.mCounters[i])
+			continue;
+
+		const float d2 = bucketBoxDistance2(point, node.mBucketBox[i]);
+		if(d2 > maxDist*maxDist)
+			continue;
+
+		PxU32 j = nb++;
+		while(j && dist2[j-1] > d2)
+		{
+			dist2[j] = dist2[j-1];
+			order[j] = order[j-1];
+			j--;
+		}
+		dist2[j] = d2;
+		order[j] = i;
+	}
+	return nb;
+}
+
+// nearest-neighbour query. Buckets are visited closest first, and skipped when they are further than the current
+// max distance, which the callback can shrink while we go.
+bool BucketPrunerCore::nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback& pcbArgName) const
+{
+	PX_ASSERT(!mDirty);
+
+	const Vec3V p = V3LoadU(point);
+
+#ifdef FREE_PRUNER_SIZE
+	{
+		BucketPrunerRaycastAdapter pcb(pcbArgName, mFreeObjects, mFreeTransforms);
+
+		for(PxU32 i=0;i<mNbFree;i++)
+		{
+			if(pointAABBDistance2(p, V3LoadU(mFreeBounds[i].minimum), V3LoadU(mFreeBounds[i].maximum)) > inOutDistance*inOutDistance)
+				continue;
+
+			if(!pcb.invoke(inOutDistance, i))
+				return false;
+		}
+	}
+#endif
+	if(!mSortedNb || bucketBoxDistance2(p, mGlobalBox) > inOutDistance*inOutDistance)
+		return true;
+
+	PxU32 order1[5];
+	const PxU32 nb1 = sortBucketChildren(p, mLevel1, inOutDistance, order1);
+	for(PxU32 ii=0;ii<nb1;ii++)
+	{
+		const PxU32 i = order1[ii];
+		// the distance may have shrunk since the children were sorted
+		if(bucketBoxDistance2(p, mLevel1.mBucketBox[i]) > inOutDistance*inOutDistance)
+			continue;
+
+		PxU32 order2[5];
+		const PxU32 nb2 = sortBucketChildren(p, mLevel2[i], inOutDistance, order2);
+		for(PxU32 jj=0;jj<nb2;jj++)
+		{
+			const PxU32 j = order2[jj];
+			if(bucketBoxDistance2(p, mLevel2[i].mBucketBox[j]) > inOutDistance*inOutDistance)
+				continue;
+
+			PxU32 order3[5];
+			const PxU32 nb3 = sortBucketChildren(p, mLevel3[i][j], inOutDistance, order3);
+			for(PxU32 kk=0;kk<nb3;kk++)
+			{
+				const PxU32 k = order3[kk];
+				if(bucketBoxDistance2(p, mLevel3[i][j].mBucketBox[k]) > inOutDistance*inOutDistance)
+					continue;
+
+				const PxU32 nbInBucket = mLevel3[i][j].mCounters[k];
+				const PxU32 offset = mLevel1.mOffsets[i] + mLevel2[i].mOffsets[j] + mLevel3[i][j].mOffsets[k];
+				const BucketBox* PX_RESTRICT boxes = mSortedWorldBoxes + offset;
+				BucketPrunerRaycastAdapter pcb(pcbArgName, mSortedObjects + offset, mSortedTransforms + offset);
+
+				for(PxU32 n=0;n<nbInBucket;n++)
+				{
+					if(bucketBoxDistance2(p, boxes[n]) > inOutDistance*inOutDistance)
+						continue;
+
+					if(!pcb.invoke(inOutDistance, n))
+						return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void BucketPrunerCore::getGlobalBounds(PxBounds3& bounds) const
 {
 	// PT: TODO: refactor with similar code above in the file
@@ -2392,6 +2580,22 @@ bool BucketPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback&
 	return mCore.overlap(queryVolume, pcb);
 }
 
+bool BucketPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcb) const
+{
+	PX_ASSERT(!mCore.mDirty);
+	if(mCore.mDirty)
+		return true; // it may crash otherwise
+	return mCore.cull(nbPlanes, planes, pcb);
+}
+
+bool BucketPruner::nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback& pcb) const
+{
+	PX_ASSERT(!mCore.mDirty);
+	if(mCore.mDirty)
+		return true; // it may crash otherwise
+	return mCore.nearest(point, inOutDistance, pcb);
+}
+
 bool BucketPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcb) const
 {
 	PX_ASSERT(!mCore.mDirty);
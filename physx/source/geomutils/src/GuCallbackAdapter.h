@@ -50,6 +50,20 @@ namespace Gu
 		PX_NOCOPY(RaycastCallbackAdapter)
 	};
 
+	struct RaycastPacketCallbackAdapter
+	{
+		PX_FORCE_INLINE	RaycastPacketCallbackAdapter(PrunerRaycastCallback* const* pcbs, const PruningPool& pool) : mCallbacks(pcbs), mPool(pool)	{}
+
+		PX_FORCE_INLINE bool	invoke(PxU32 rayIndex, PxReal& distance, PxU32 primIndex)
+		{
+			return mCallbacks[rayIndex]->invoke(distance, primIndex, mPool.getObjects(), mPool.getTransforms());
+		}
+
+		PrunerRaycastCallback* const*	mCallbacks;
+		const PruningPool&				mPool;
+		PX_NOCOPY(RaycastPacketCallbackAdapter)
+	};
+
 	struct OverlapCallbackAdapter
 	{
 		PX_FORCE_INLINE	OverlapCallbackAdapter(PrunerOverlapCallback& pcb, const PruningPool& pool) : mCallback(pcb), mPool(pool)	{}
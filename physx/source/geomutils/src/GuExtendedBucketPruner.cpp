@@ -734,6 +734,89 @@ bool ExtendedBucketPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCa
 	return again;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// cull main tree callback
+struct MainTreeCullPrunerCallback
+{
+	MainTreeCullPrunerCallback(const PlanesAABBTest& test, PrunerOverlapCallback& prunerCallback, const PruningPool* pool, const MergedTree* mergedTrees)
+		: mTest(test), mPrunerCallback(prunerCallback), mPruningPool(pool), mMergedTrees(mergedTrees)
+	{
+	}
+
+	bool invoke(PxU32 primIndex)
+	{
+		const AABBTree* aabbTree = mMergedTrees[primIndex].mTree;
+		// cull the merged tree. The clip mask of the main tree's leaf isn't available here so we start again with all the planes.
+		OverlapCallbackAdapter pcb(mPrunerCallback, *mPruningPool);
+		return AABBTreeCull<true, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPruningPool->getCurrentAABBTreeBounds(), *aabbTree, mTest, pcb, mTest.getInitialClipMask());
+	}
+
+	PX_NOCOPY(MainTreeCullPrunerCallback)
+
+private:
+	const PlanesAABBTest&	mTest;
+	PrunerOverlapCallback&	mPrunerCallback;
+	const PruningPool*		mPruningPool;
+	const MergedTree*		mMergedTrees;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// cull implementation
+bool ExtendedBucketPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback) const
+{
+	bool again = mCompanion ? mCompanion->cull(nbPlanes, planes, prunerCallback) : true;
+
+	if(again && mExtendedBucketPrunerMap.size())
+	{
+		const PlanesAABBTest test(nbPlanes, planes);
+		MainTreeCullPrunerCallback pcb(test, prunerCallback, mPruningPool, mMergedTrees);
+		again = AABBTreeCull<true, AABBTree, BVHNode, MainTreeCullPrunerCallback>()(mBounds, *mMainTree, test, pcb, test.getInitialClipMask());
+	}
+
+	return again;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// nearest main tree callback
+struct MainTreeNearestPrunerCallback
+{
+	MainTreeNearestPrunerCallback(const PxVec3& point, PrunerRaycastCallback& prunerCallback, const PruningPool* pool, const MergedTree* mergedTrees)
+		: mPoint(point), mPrunerCallback(prunerCallback), mPruningPool(pool), mMergedTrees(mergedTrees)
+	{
+	}
+
+	bool invoke(PxReal& distance, PxU32 primIndex)
+	{
+		const AABBTree* aabbTree = mMergedTrees[primIndex].mTree;
+		// query the merged tree
+		RaycastCallbackAdapter pcb(mPrunerCallback, *mPruningPool);
+		return AABBTreeNearest<true, AABBTree, BVHNode, RaycastCallbackAdapter>()(mPruningPool->getCurrentAABBTreeBounds(), *aabbTree, mPoint, distance, pcb);
+	}
+
+	PX_NOCOPY(MainTreeNearestPrunerCallback)
+
+private:
+	const PxVec3&			mPoint;
+	PrunerRaycastCallback&	mPrunerCallback;
+	const PruningPool*		mPruningPool;
+	const MergedTree*		mMergedTrees;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// nearest implementation
+bool ExtendedBucketPruner::nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback) const
+{
+	bool again = mCompanion ? mCompanion->nearest(point, inOutDistance, prunerCallback) : true;
+
+	if(again && mExtendedBucketPrunerMap.size())
+	{
+		MainTreeNearestPrunerCallback pcb(point, prunerCallback, mPruningPool, mMergedTrees);
+		again = AABBTreeNearest<true, AABBTree, BVHNode, MainTreeNearestPrunerCallback>()(mBounds, *mMainTree, point, inOutDistance, pcb);
+	}
+
+	return again;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // sweep implementation 
 bool ExtendedBucketPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback) const
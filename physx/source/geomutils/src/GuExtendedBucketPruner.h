@@ -136,6 +136,8 @@ namespace Gu
 						bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&) const;
 						bool					overlap(const ShapeData& queryVolume, PrunerOverlapCallback&) const;
 						bool					sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&) const;
+						bool					cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback&) const;
+						bool					nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback&) const;
 
 		// origin shift
 						void					shiftOrigin(const PxVec3& shift);
@@ -318,6 +318,37 @@ bool IncrementalAABBPrunerCore::overlap(const ShapeData& queryVolume, PrunerOver
 	return again;
 }
 
+bool IncrementalAABBPrunerCore::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcbArgName) const
+{
+	bool again = true;
+	OverlapCallbackAdapter pcb(pcbArgName, *mPool);
+
+	const PlanesAABBTest test(nbPlanes, planes);
+	for(PxU32 i = 0; i < NUM_TREES; i++)
+	{
+		const CoreTree& tree = mAABBTree[i];
+		if(tree.tree && tree.tree->getNodes() && again)
+			again = AABBTreeCull<true, IncrementalAABBTree, IncrementalAABBTreeNode, OverlapCallbackAdapter>()(mPool->getCurrentAABBTreeBounds(), *tree.tree, test, pcb, test.getInitialClipMask());
+	}
+
+	return again;
+}
+
+bool IncrementalAABBPrunerCore::nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback& pcbArgName) const
+{
+	bool again = true;
+	RaycastCallbackAdapter pcb(pcbArgName, *mPool);
+
+	for(PxU32 i = 0; i < NUM_TREES; i++)
+	{
+		const CoreTree& tree = mAABBTree[i];
+		if(tree.tree && tree.tree->getNodes() && again)
+			again = AABBTreeNearest<true, IncrementalAABBTree, IncrementalAABBTreeNode, RaycastCallbackAdapter>()(mPool->getCurrentAABBTreeBounds(), *tree.tree, point, inOutDistance, pcb);
+	}
+
+	return again;
+}
+
 bool IncrementalAABBPrunerCore::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcbArgName) const
 {
 	bool again = true;
@@ -0,0 +1,236 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#include "GuQuantizedAABBTree.h"
+#include "GuAABBTree.h"
+#include "GuAABBTreeNode.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxArray.h"
+
+using namespace physx;
+using namespace Gu;
+
+QuantizedAABBTree::QuantizedAABBTree() : mNbNodes(0), mNodes(NULL), mIndices(NULL)
+{
+	mRootBounds.setEmpty();
+}
+
+QuantizedAABBTree::~QuantizedAABBTree()
+{
+	release();
+}
+
+void QuantizedAABBTree::release()
+{
+	PX_FREE(mNodes);
+	mNbNodes = 0;
+	mIndices = NULL;
+	mRootBounds.setEmpty();
+}
+
+namespace
+{
+	struct QuantizedBuildEntry
+	{
+		PxU32	mSrcNodeIndex;	// BVHNode whose children go to the quantized node
+		PxU32	mDstNodeIndex;	// Target QuantizedBVHNode
+		PxVec3	mMin;			// Decoded bounds of the target node
+		PxVec3	mMax;
+	};
+}
+
+// empty nodes appear when all the objects below them have been removed and the tree has been refit
+static PX_FORCE_INLINE bool isEmptyNode(const BVHNode& node)
+{
+	if(node.isLeaf() && !node.getNbPrimitives())
+		return true;
+	const PxBounds3& b = node.mBV;
+	return b.minimum.x > b.maximum.x || b.minimum.y > b.maximum.y || b.minimum.z > b.maximum.z;
+}
+
+// finds the smallest quantized distance from the parent's min such that the decoded value is <= 'value'. We don't
+// rely on the division alone: the result is checked against the same operations as in decodeQuantizedChildren().
+static PX_FORCE_INLINE PxU16 quantizeMin(float value, float parentMin, float scale, float& decoded)
+{
+	PxU32 q = 0;
+	if(scale!=0.0f)
+	{
+		const float fq = (value - parentMin) / scale;
+		q = fq <= 0.0f ? 0 : fq >= float(GU_QUANTIZED_BVH_MAX) ? GU_QUANTIZED_BVH_MAX : PxU32(fq);
+		while(q && parentMin + float(q)*scale > value)
+			q--;
+		// one extra step of margin, in case the traversal code's rounding differs (e.g. fused multiply-add)
+		if(q)
+			q--;
+	}
+	decoded = parentMin + float(q)*scale;
+	return PxU16(q);
+}
+
+// same for maxs, as a distance from the parent's max
+static PX_FORCE_INLINE PxU16 quantizeMax(float value, float parentMax, float scale, float& decoded)
+{
+	PxU32 q = 0;
+	if(scale!=0.0f)
+	{
+		const float fq = (parentMax - value) / scale;
+		q = fq <= 0.0f ? 0 : fq >= float(GU_QUANTIZED_BVH_MAX) ? GU_QUANTIZED_BVH_MAX : PxU32(fq);
+		while(q && parentMax - float(q)*scale < value)
+			q--;
+		if(q)
+			q--;
+	}
+	decoded = parentMax - float(q)*scale;
+	return PxU16(q);
+}
+
+void QuantizedAABBTree::build(const AABBTree& tree)
+{
+	release();
+
+	const BVHNode* PX_RESTRICT srcNodes = tree.getNodes();
+	const PxU32 nbSrcNodes = tree.getNbNodes();
+	if(!srcNodes || !nbSrcNodes)
+		return;
+
+	mRootBounds = srcNodes[0].mBV;
+	mIndices = tree.getIndices();
+
+	// each quantized node replaces at least one internal node of the binary tree (or the root leaf), so this is an
+	// upper bound. We compact the array at the end.
+	const PxU32 maxNbNodes = nbSrcNodes/2 + 1;
+	QuantizedBVHNode* nodes = PX_ALLOCATE(QuantizedBVHNode, maxNbNodes, "QuantizedBVHNode");
+	PxU32 nbNodes = 1;
+
+	PxArray<QuantizedBuildEntry> stack;
+	{
+		QuantizedBuildEntry root;
+		root.mSrcNodeIndex = 0;
+		root.mDstNodeIndex = 0;
+		root.mMin = mRootBounds.minimum;
+		root.mMax = mRootBounds.maximum;
+		stack.pushBack(root);
+	}
+
+	while(stack.size())
+	{
+		const QuantizedBuildEntry entry = stack.popBack();
+		const BVHNode& src = srcNodes[entry.mSrcNodeIndex];
+
+		// gather up to 4 children by collapsing the binary tree, always opening the largest internal child first
+		PxU32 children[4];
+		PxU32 nbChildren = 0;
+		if(src.isLeaf())
+		{
+			// can only happen for the root of a tree with a single leaf
+			if(!isEmptyNode(src))
+				children[nbChildren++] = entry.mSrcNodeIndex;
+		}
+		else
+		{
+			const PxU32 pos = src.getPosIndex();
+			if(!isEmptyNode(srcNodes[pos]))
+				children[nbChildren++] = pos;
+			if(!isEmptyNode(srcNodes[pos+1]))
+				children[nbChildren++] = pos+1;
+
+			while(nbChildren<4)
+			{
+				PxU32 best = 0xffffffff;
+				float bestArea = -1.0f;
+				for(PxU32 i=0;i<nbChildren;i++)
+				{
+					const BVHNode& child = srcNodes[children[i]];
+					if(child.isLeaf())
+						continue;
+					const PxVec3 d = child.mBV.getDimensions();
+					const float area = d.x*d.y + d.y*d.z + d.z*d.x;
+					if(area>bestArea)
+					{
+						bestArea = area;
+						best = i;
+					}
+				}
+				if(best==0xffffffff)
+					break;
+
+				const PxU32 pos = srcNodes[children[best]].getPosIndex();
+				children[best] = children[--nbChildren];
+				if(!isEmptyNode(srcNodes[pos]))
+					children[nbChildren++] = pos;
+				if(!isEmptyNode(srcNodes[pos+1]))
+					children[nbChildren++] = pos+1;
+			}
+		}
+
+		QuantizedBVHNode& dst = nodes[entry.mDstNodeIndex];
+		PxMemZero(&dst, sizeof(QuantizedBVHNode));
+
+		const float coeff = GU_QUANTIZED_BVH_COEFF;
+		const PxVec3 scale((entry.mMax.x - entry.mMin.x) * coeff, (entry.mMax.y - entry.mMin.y) * coeff, (entry.mMax.z - entry.mMin.z) * coeff);
+
+		for(PxU32 i=0;i<nbChildren;i++)
+		{
+			const BVHNode& child = srcNodes[children[i]];
+
+			QuantizedBuildEntry childEntry;
+			dst.mMinX[i] = quantizeMin(child.mBV.minimum.x, entry.mMin.x, scale.x, childEntry.mMin.x);
+			dst.mMinY[i] = quantizeMin(child.mBV.minimum.y, entry.mMin.y, scale.y, childEntry.mMin.y);
+			dst.mMinZ[i] = quantizeMin(child.mBV.minimum.z, entry.mMin.z, scale.z, childEntry.mMin.z);
+			dst.mMaxX[i] = quantizeMax(child.mBV.maximum.x, entry.mMax.x, scale.x, childEntry.mMax.x);
+			dst.mMaxY[i] = quantizeMax(child.mBV.maximum.y, entry.mMax.y, scale.y, childEntry.mMax.y);
+			dst.mMaxZ[i] = quantizeMax(child.mBV.maximum.z, entry.mMax.z, scale.z, childEntry.mMax.z);
+
+			if(child.isLeaf())
+			{
+				dst.mData[i] = child.mData;
+			}
+			else
+			{
+				PX_ASSERT(nbNodes<maxNbNodes);
+				childEntry.mSrcNodeIndex = children[i];
+				childEntry.mDstNodeIndex = nbNodes++;
+				dst.mData[i] = childEntry.mDstNodeIndex<<1;
+				stack.pushBack(childEntry);
+			}
+		}
+	}
+
+	if(nbNodes==maxNbNodes)
+	{
+		mNodes = nodes;
+	}
+	else
+	{
+		mNodes = PX_ALLOCATE(QuantizedBVHNode, nbNodes, "QuantizedBVHNode");
+		PxMemCopy(mNodes, nodes, sizeof(QuantizedBVHNode)*nbNodes);
+		PX_FREE(nodes);
+	}
+	mNbNodes = nbNodes;
+}
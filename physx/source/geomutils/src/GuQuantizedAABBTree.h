@@ -0,0 +1,136 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef GU_QUANTIZED_AABBTREE_H
+#define GU_QUANTIZED_AABBTREE_H
+
+#include "common/PxPhysXCommonConfig.h"
+#include "foundation/PxBounds3.h"
+#include "foundation/PxVecMath.h"
+#include "foundation/PxUserAllocated.h"
+
+namespace physx
+{
+using namespace aos;
+
+namespace Gu
+{
+	class AABBTree;
+
+	// 4-wide node with 16-bit bounds. Each child box is quantized relative to the (decoded) box of its parent: mins are
+	// stored as a distance from the parent's min, maxs as a distance from the parent's max, in units of parent extents/65535.
+	// Quantization is conservative, i.e. decoded boxes always contain the original ones. The 4 children are stored in SoA
+	// form so that they can be decoded & tested together. A node is exactly one 64-byte cache line.
+	struct QuantizedBVHNode
+	{
+		PxU16	mMinX[4];
+		PxU16	mMinY[4];
+		PxU16	mMinZ[4];
+		PxU16	mMaxX[4];
+		PxU16	mMaxY[4];
+		PxU16	mMaxZ[4];
+		PxU32	mData[4];	// 0 for empty slots, otherwise same encoding as BVHNode::mData (leaves point to the tree's indices, internal nodes to a QuantizedBVHNode)
+
+		PX_FORCE_INLINE	PxU32	isEmpty(PxU32 i)	const	{ return !mData[i];		}
+		PX_FORCE_INLINE	PxU32	isLeaf(PxU32 i)		const	{ return mData[i]&1;	}
+		PX_FORCE_INLINE	PxU32	getChildIndex(PxU32 i)	const	{ return mData[i]>>1;	}
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(QuantizedBVHNode)==64);
+
+	#define GU_QUANTIZED_BVH_MAX	65535
+	#define GU_QUANTIZED_BVH_COEFF	(1.0f/65535.0f)
+
+	// decoded bounds of a node's 4 children, SoA
+	struct QuantizedBVHChildren
+	{
+		Vec4V	mMinX, mMinY, mMinZ;
+		Vec4V	mMaxX, mMaxY, mMaxZ;
+	};
+
+	// 'parentMin' and 'parentMax' are the decoded bounds of the node itself. The build code relies on this exact
+	// sequence of operations, so don't change one without the other.
+	static PX_FORCE_INLINE void decodeQuantizedChildren(QuantizedBVHChildren& children, const QuantizedBVHNode& node, const PxVec3& parentMin, const PxVec3& parentMax)
+	{
+		PX_ALIGN(16, float q[24]);
+		const PxU16* PX_RESTRICT src = node.mMinX;
+		for(PxU32 i=0;i<24;i++)
+			q[i] = float(src[i]);
+
+		const FloatV coeff = FLoad(GU_QUANTIZED_BVH_COEFF);
+
+		const Vec4V minX = V4Load(parentMin.x);
+		const Vec4V minY = V4Load(parentMin.y);
+		const Vec4V minZ = V4Load(parentMin.z);
+		const Vec4V maxX = V4Load(parentMax.x);
+		const Vec4V maxY = V4Load(parentMax.y);
+		const Vec4V maxZ = V4Load(parentMax.z);
+
+		const Vec4V scaleX = V4Scale(V4Sub(maxX, minX), coeff);
+		const Vec4V scaleY = V4Scale(V4Sub(maxY, minY), coeff);
+		const Vec4V scaleZ = V4Scale(V4Sub(maxZ, minZ), coeff);
+
+		children.mMinX = V4Add(minX, V4Mul(V4LoadA(q + 0), scaleX));
+		children.mMinY = V4Add(minY, V4Mul(V4LoadA(q + 4), scaleY));
+		children.mMinZ = V4Add(minZ, V4Mul(V4LoadA(q + 8), scaleZ));
+		children.mMaxX = V4Sub(maxX, V4Mul(V4LoadA(q + 12), scaleX));
+		children.mMaxY = V4Sub(maxY, V4Mul(V4LoadA(q + 16), scaleY));
+		children.mMaxZ = V4Sub(maxZ, V4Mul(V4LoadA(q + 20), scaleZ));
+	}
+
+	// compressed, read-only version of an AABBTree, used to speed up queries. The binary tree is collapsed into a
+	// 4-wide tree, leaves are stored directly in their parent's slots, and nodes use 16-bit bounds. This is typically about
+	// half the size of the source BVHNode array. The tree doesn't own the indices, they remain in the source AABBTree.
+	class QuantizedAABBTree : public PxUserAllocated
+	{
+		public:
+		PX_PHYSX_COMMON_API							QuantizedAABBTree();
+		PX_PHYSX_COMMON_API							~QuantizedAABBTree();
+
+		PX_PHYSX_COMMON_API		void				build(const AABBTree& tree);
+		PX_PHYSX_COMMON_API		void				release();
+
+		// children bounds are relative to their parent so we only need to move the root
+		PX_FORCE_INLINE			void				shiftOrigin(const PxVec3& shift)	{ mRootBounds.minimum -= shift; mRootBounds.maximum -= shift;	}
+
+		PX_FORCE_INLINE			PxU32				getNbNodes()		const	{ return mNbNodes;		}
+		PX_FORCE_INLINE			const QuantizedBVHNode*	getNodes()		const	{ return mNodes;		}
+		PX_FORCE_INLINE			const PxU32*		getIndices()		const	{ return mIndices;		}
+		PX_FORCE_INLINE			const PxBounds3&	getRootBounds()		const	{ return mRootBounds;	}
+
+		private:
+								PxBounds3			mRootBounds;	//!< Bounds of the root node, the only ones stored as floats
+								PxU32				mNbNodes;
+								QuantizedBVHNode*	mNodes;
+								const PxU32*		mIndices;		//!< Shared with the source AABBTree
+	};
+
+} // namespace Gu
+}
+
+#endif // GU_QUANTIZED_AABBTREE_H
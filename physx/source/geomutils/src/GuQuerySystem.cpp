@@ -804,6 +804,25 @@ void QuerySystem::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, flo
 	}
 }
 
+void QuerySystem::nearest(const PxVec3& point, float& inOutDistance, PrunerRaycastCallback& cb, const PrunerFilter* prunerFilter) const
+{
+	// the tree of pruners has no nearest-neighbour query, but each pruner discards itself quickly when its root is too far
+	const PxU32 nb = mPrunerExt.size();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		PrunerExt* pe = mPrunerExt[i];	// Can be NULL if the pruner has been removed
+		if(!pe)
+			continue;
+
+		if(!prunerFilter || prunerFilter->processPruner(i))
+		{
+			Pruner* pruner = pe->mPruner;
+			if(!pruner->nearest(point, inOutDistance, cb))
+				return;
+		}
+	}
+}
+
 void QuerySystem::createTreeOfPruners()
 {
 	PX_PROFILE_ZONE("QuerySystem.createTreeOfPruners", mContextID);
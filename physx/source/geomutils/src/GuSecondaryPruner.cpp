@@ -95,6 +95,18 @@ class CompanionPrunerBucket : public CompanionPruner
 							return mPrunerCore.sweep(queryVolume, unitDir, inOutDistance, prunerCallback);
 						return true;
 					}
+	virtual	bool	cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)	const
+					{
+						if(mPrunerCore.getNbObjects())
+							return mPrunerCore.cull(nbPlanes, planes, prunerCallback);
+						return true;
+					}
+	virtual	bool	nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const
+					{
+						if(mPrunerCore.getNbObjects())
+							return mPrunerCore.nearest(point, inOutDistance, prunerCallback);
+						return true;
+					}
 	virtual	void	getGlobalBounds(PxBounds3& bounds)	const
 					{
 						mPrunerCore.getGlobalBounds(bounds);
@@ -161,6 +173,18 @@ class CompanionPrunerIncremental : public CompanionPruner
 							return mPrunerCore.sweep(queryVolume, unitDir, inOutDistance, prunerCallback);
 						return true;
 					}
+	virtual	bool	cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)	const
+					{
+						if(mPrunerCore.getNbObjects())
+							return mPrunerCore.cull(nbPlanes, planes, prunerCallback);
+						return true;
+					}
+	virtual	bool	nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const
+					{
+						if(mPrunerCore.getNbObjects())
+							return mPrunerCore.nearest(point, inOutDistance, prunerCallback);
+						return true;
+					}
 	virtual	void	getGlobalBounds(PxBounds3& bounds)	const
 					{
 						mPrunerCore.getGlobalBounds(bounds);
@@ -212,6 +236,8 @@ class CompanionPrunerAABBTree : public CompanionPruner
 	virtual			bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const;
 	virtual			bool					overlap(const ShapeData& queryVolume, PrunerOverlapCallback& prunerCallback)	const;
 	virtual			bool					sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const;
+	virtual			bool					cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)	const;
+	virtual			bool					nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const;
 	virtual			void					getGlobalBounds(PxBounds3& bounds)	const;
 
 	// PT: we have multiple options here, not sure which one is best:
@@ -978,6 +1004,57 @@ bool CompanionPrunerAABBTree::overlap(const ShapeData& queryVolume, PrunerOverla
 	return true;
 }
 
+bool CompanionPrunerAABBTree::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback) const
+{
+	PX_ASSERT(!mDirtyFlags);
+
+	const PlanesAABBTest test(nbPlanes, planes);
+
+#ifdef USE_MAVERICK_NODE
+	{
+		// we don't use doCullLeafTest here since the maverick node has no bounds of its own
+		const PxU32 nbFree = mMaverick.mNbFree;
+		for(PxU32 i=0;i<nbFree;i++)
+		{
+			const PxBounds3& bounds = mMaverick.mFreeBounds[i];
+			PxU32 unused;
+			if(test(V3LoadU(bounds.getCenter()), V3LoadU(bounds.getExtents()), test.getInitialClipMask(), unused))
+			{
+				if(!prunerCallback.invoke(i, mMaverick.mFreeObjects, mMaverick.mFreeTransforms))
+					return false;
+			}
+		}
+	}
+#endif
+
+	if(mBVH)
+	{
+		OverlapAdapter ra(*this, prunerCallback, mLastValidTimestamp);
+		return AABBTreeCull<true, BVHTree, BVHNode, OverlapAdapter>()(mBVH->getData().mBounds, BVHTree(mBVH->getData()), test, ra, test.getInitialClipMask());
+	}
+	return true;
+}
+
+bool CompanionPrunerAABBTree::nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback) const
+{
+	PX_ASSERT(!mDirtyFlags);
+
+#ifdef USE_MAVERICK_NODE
+	{
+		MaverickRaycastAdapter ra(mMaverick, prunerCallback);
+		if(!doNearestLeafTest<true, MaverickNode, MaverickRaycastAdapter>(&mMaverick, V3LoadU(point), mMaverick.mFreeBounds, NULL, inOutDistance, ra))
+			return false;
+	}
+#endif
+
+	if(mBVH)
+	{
+		RaycastAdapter ra(*this, prunerCallback, mLastValidTimestamp);
+		return AABBTreeNearest<true, BVHTree, BVHNode, RaycastAdapter>()(mBVH->getData().mBounds, BVHTree(mBVH->getData()), point, inOutDistance, ra);
+	}
+	return true;
+}
+
 bool CompanionPrunerAABBTree::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback) const
 {
 	PX_UNUSED(queryVolume);
@@ -60,6 +60,8 @@ namespace Gu
 		virtual	bool	raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)									const	= 0;
 		virtual	bool	overlap(const ShapeData& queryVolume, PrunerOverlapCallback& prunerCallback)																		const	= 0;
 		virtual	bool	sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)							const	= 0;
+		virtual	bool	cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)																	const	= 0;
+		virtual	bool	nearest(const PxVec3& point, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)															const	= 0;
 		virtual	void	getGlobalBounds(PxBounds3&)																															const	= 0;
 	};
 
@@ -30,8 +30,18 @@
 #include "CmVisualization.h"
 #include "GuAABBTree.h"
 #include "GuAABBTreeNode.h"
+#include "GuQuantizedAABBTree.h"
 #include "GuIncrementalAABBTree.h"
 #include "GuBVH.h"
+#include "GuPruner.h"
+#include "GuBounds.h"
+#include "geometry/PxGeometryQuery.h"
+#include "geometry/PxPlaneGeometry.h"
+#include "geometry/PxTriangleMeshGeometry.h"
+#include "geometry/PxTriangleMesh.h"
+#include "common/PxProfileZone.h"
+#include "task/PxCpuDispatcher.h"
+#include "CmParallelJobs.h"
 
 using namespace physx;
 using namespace Cm;
@@ -66,6 +76,42 @@ void visualizeTree(PxRenderOutput& out, PxU32 color, const AABBTree* tree)
 	}
 }
 
+static void drawQuantizedBVH(const QuantizedBVHNode* nodes, const QuantizedBVHNode* node, const PxVec3& nodeMin, const PxVec3& nodeMax, PxRenderOutput& out_)
+{
+	QuantizedBVHChildren children;
+	decodeQuantizedChildren(children, *node, nodeMin, nodeMax);
+
+	PX_ALIGN(16, float minX[4]);	V4StoreA(children.mMinX, minX);
+	PX_ALIGN(16, float minY[4]);	V4StoreA(children.mMinY, minY);
+	PX_ALIGN(16, float minZ[4]);	V4StoreA(children.mMinZ, minZ);
+	PX_ALIGN(16, float maxX[4]);	V4StoreA(children.mMaxX, maxX);
+	PX_ALIGN(16, float maxY[4]);	V4StoreA(children.mMaxY, maxY);
+	PX_ALIGN(16, float maxZ[4]);	V4StoreA(children.mMaxZ, maxZ);
+
+	for(PxU32 i=0;i<4;i++)
+	{
+		if(node->isEmpty(i))
+			continue;
+		const PxVec3 childMin(minX[i], minY[i], minZ[i]);
+		const PxVec3 childMax(maxX[i], maxY[i], maxZ[i]);
+		renderOutputDebugBox(out_, PxBounds3(childMin, childMax));
+		if(!node->isLeaf(i))
+			drawQuantizedBVH(nodes, nodes + node->getChildIndex(i), childMin, childMax, out_);
+	}
+}
+
+void visualizeTree(PxRenderOutput& out, PxU32 color, const QuantizedAABBTree* tree)
+{
+	if(tree && tree->getNbNodes())
+	{
+		out << PxTransform(PxIdentity);
+		out << color;
+		const PxBounds3& rootBounds = tree->getRootBounds();
+		renderOutputDebugBox(out, rootBounds);
+		drawQuantizedBVH(tree->getNodes(), tree->getNodes(), rootBounds.minimum, rootBounds.maximum, out);
+	}
+}
+
 void visualizeTree(PxRenderOutput& out, PxU32 color, const IncrementalAABBTree* tree, DebugVizCallback* cb)
 {
 	if(tree && tree->getNodes())
@@ -99,3 +145,103 @@ void visualizeTree(PxRenderOutput& out, PxU32 color, const IncrementalAABBTree*
 	}
 }
 
+static void updatePruner(Pruner* pruner, bool buildStep, bool commit)
+{
+	if(buildStep && pruner->isDynamic())
+		static_cast<DynamicPruner*>(pruner)->buildStep(true);
+
+	if(commit)
+		pruner->commit();
+}
+
+namespace
+{
+	class UpdatePrunersJobs : public Cm::ParallelJobs
+	{
+		PX_NOCOPY(UpdatePrunersJobs)
+	public:
+							UpdatePrunersJobs(Pruner* const* pruners, bool buildStep, bool commit) :
+								mPruners(pruners), mBuildStep(buildStep), mCommit(commit)
+							{
+							}
+
+		virtual	void		processJob(PxU32 index, PxU32)	PX_OVERRIDE
+		{
+			updatePruner(mPruners[index], mBuildStep, mCommit);
+		}
+
+		Pruner* const*		mPruners;
+		const bool			mBuildStep;
+		const bool			mCommit;
+	};
+}
+
+void updatePruners(Pruner* const* pruners, PxU32 nbPruners, bool buildStep, bool commit, PxCpuDispatcher* dispatcher, PxU64 contextID)
+{
+	PX_PROFILE_ZONE("SceneQuery.updatePruners", contextID);
+	PX_UNUSED(contextID);
+
+	if(ParallelJobsRunner::getNbThreads(dispatcher, nbPruners)==1)
+	{
+		for(PxU32 i=0;i<nbPruners;i++)
+			updatePruner(pruners[i], buildStep, commit);
+		return;
+	}
+
+	UpdatePrunersJobs jobs(pruners, buildStep, commit);
+	ParallelJobsRunner runner("Gu.updatePruners");
+	runner.run(dispatcher, jobs, nbPruners);
+}
+
+PxReal computeNearestDistance2(const PxVec3& point, const PxGeometry& geom, const PxTransform& pose, PxVec3& closestPoint, PxU32& faceIndex)
+{
+	faceIndex = 0xffffffff;
+	closestPoint = point;
+
+	bool supported = false;
+	switch(geom.getType())
+	{
+		case PxGeometryType::eSPHERE:
+		case PxGeometryType::eCAPSULE:
+		case PxGeometryType::eBOX:
+		case PxGeometryType::eCONVEXMESH:
+			supported = true;
+			break;
+
+		case PxGeometryType::eTRIANGLEMESH:
+			// point-mesh distance is not implemented for BVH33
+			supported = static_cast<const PxTriangleMeshGeometry&>(geom).triangleMesh->getConcreteType() == PxConcreteType::eTRIANGLE_MESH_BVH34;
+			break;
+
+		case PxGeometryType::ePLANE:
+		{
+			// the plane's normal is the local x axis, and the solid half-space is x<0
+			const PxReal d = pose.transformInv(point).x;
+			if(d<=0.0f)
+				return 0.0f;
+			closestPoint = point - pose.q.getBasisVector0() * d;
+			return d*d;
+		}
+
+		default:
+			break;
+	}
+
+	if(supported)
+	{
+		const PxReal dist2 = PxGeometryQuery::pointDistance(point, geom, pose, &closestPoint, geom.getType() == PxGeometryType::eTRIANGLEMESH ? &faceIndex : NULL);
+		if(dist2 >= 0.0f)
+		{
+			// the closest point is only valid for positive distances
+			if(dist2 == 0.0f)
+				closestPoint = point;
+			return dist2;
+		}
+	}
+
+	// conservative fallback for heightfields, custom geometries, etc
+	PxBounds3 bounds;
+	computeBounds(bounds, geom, pose, 0.0f, 1.0f);
+	closestPoint = bounds.closestPoint(point);
+	return (closestPoint - point).magnitudeSquared();
+}
@@ -39,6 +39,7 @@ namespace physx
 	class PxGeometry;
 	class PxRenderOutput;
 	class PxContactBuffer;
+	struct PxContactPoint;
 
 namespace Gu
 {
@@ -202,6 +203,34 @@ namespace Gu
 	PX_PHYSX_COMMON_API bool pcmContactConvexConvex(GU_CONTACT_METHOD_ARGS);
 
 	PX_PHYSX_COMMON_API bool pcmContactGeometryCustomGeometry(GU_CONTACT_METHOD_ARGS);
+
+	// input for the batched (SoA) versions of the simple PCM contact functions below. These are the pairs that don't use
+	// the persistent manifold and usually output a single contact, so they can be processed 4 at a time with the same code.
+	struct PCMBatchPair
+	{
+		const PxGeometry*		mShape0;
+		const PxGeometry*		mShape1;
+		const PxTransform32*	mTransform0;
+		const PxTransform32*	mTransform1;
+		PxReal					mContactDistance;
+	};
+
+	#define GU_PCM_BATCH_SIZE	4
+
+	// processes nbPairs (1 to GU_PCM_BATCH_SIZE) pairs of the same types. Returns a mask of the pairs that generated
+	// a contact: bit i is set if contacts[i] has been written for pairs[i]. Pairs that the batched function cannot handle
+	// (e.g. because they need more than one contact) are reported in fallbackMask and must go through the single-pair function.
+	#define GU_BATCH_CONTACT_METHOD_ARGS	\
+		const Gu::PCMBatchPair* pairs,		\
+		PxU32 nbPairs,						\
+		PxContactPoint* contacts,			\
+		PxU32& fallbackMask
+
+	PX_PHYSX_COMMON_API PxU32 pcmContactSphereSphere4(GU_BATCH_CONTACT_METHOD_ARGS);
+	PX_PHYSX_COMMON_API PxU32 pcmContactSpherePlane4(GU_BATCH_CONTACT_METHOD_ARGS);
+	PX_PHYSX_COMMON_API PxU32 pcmContactSphereCapsule4(GU_BATCH_CONTACT_METHOD_ARGS);
+	PX_PHYSX_COMMON_API PxU32 pcmContactSphereBox4(GU_BATCH_CONTACT_METHOD_ARGS);
+	PX_PHYSX_COMMON_API PxU32 pcmContactCapsuleCapsule4(GU_BATCH_CONTACT_METHOD_ARGS);
 }
 }
 
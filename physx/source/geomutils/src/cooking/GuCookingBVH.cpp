@@ -45,8 +45,12 @@ static bool buildBVH(const PxBVHDesc& desc, BVHData& data, const char* errorMess
 		bs = BVH_SPLATTER_POINTS;
 	else if(desc.buildStrategy==PxBVHBuildStrategy::eDEFAULT)
 		bs = BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER;
-	else //if(desc.buildStrategy==PxBVHBuildStrategy::eSAH)
+	else
+	{
+		// eSAH or eSAH_PARALLEL. PxCookBVH / PxCreateBVH have no CPU dispatcher, so eSAH_PARALLEL is built serially here.
+		PX_ASSERT(desc.buildStrategy==PxBVHBuildStrategy::eSAH || desc.buildStrategy==PxBVHBuildStrategy::eSAH_PARALLEL);
 		bs = BVH_SAH;
+	}
 
 	return data.build(desc.bounds.count, desc.bounds.data, desc.bounds.stride, desc.enlargement, desc.numPrimsPerLeaf, bs);
 }
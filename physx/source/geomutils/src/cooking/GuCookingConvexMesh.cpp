@@ -32,7 +32,12 @@
 #include "GuConvexMesh.h"
 #include "foundation/PxAlloca.h"
 #include "foundation/PxFPU.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxHashMap.h"
 #include "common/PxInsertionCallback.h"
+#include "CmParallelJobs.h"
+#include <string.h>
 
 using namespace physx;
 using namespace Gu;
@@ -130,7 +135,7 @@ static bool cookConvexMeshInternal(const PxCookingParams& params, const PxConvex
 	return true;
 }
 
-static ConvexHullLib* createHullLib(PxConvexMeshDesc& desc, const PxCookingParams& params)
+static ConvexHullLib* createHullLib(PxConvexMeshDesc& desc, const PxCookingParams& params, QuickHullScratchPool* scratchPool = NULL)
 {	
 	if(desc.flags & PxConvexFlag::eCOMPUTE_CONVEX)
 	{			
@@ -144,7 +149,7 @@ static ConvexHullLib* createHullLib(PxConvexMeshDesc& desc, const PxCookingParam
 			desc.polygonLimit = PxMin(desc.polygonLimit, gpuMaxFacesLimit);
 		}
 
-		return PX_NEW(QuickHullConvexHullLib) (desc, params);
+		return PX_NEW(QuickHullConvexHullLib) (desc, params, scratchPool);
 	}
 	return NULL;
 }
@@ -213,6 +218,277 @@ PxConvexMesh* immediateCooking::createConvexMesh(const PxCookingParams& params,
 	return convexMesh;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// batch cooking. Identical descriptors are detected up-front by hashing their input data, and each group of identical
+// descriptors is cooked once: the same builder is then saved to the stream of each member of the group. Groups are
+// independent jobs, processed by the dispatcher's workers and by the calling thread.
+#define BATCH_COOKING_INVALID_INDEX	0xffffffff
+
+static PX_FORCE_INLINE PxU32 hashBytes(PxU32 hash, const void* data, PxU32 size)
+{
+	// FNV-1a
+	const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+	for(PxU32 i=0;i<size;i++)
+		hash = (hash ^ bytes[i]) * 16777619u;
+	return hash;
+}
+
+static PxU32 hashStrided(PxU32 hash, const PxBoundedData& data, PxU32 elemSize)
+{
+	hash = hashBytes(hash, &data.count, sizeof(PxU32));
+	const PxU8* src = reinterpret_cast<const PxU8*>(data.data);
+	for(PxU32 i=0;i<data.count;i++)
+	{
+		hash = hashBytes(hash, src, elemSize);
+		src += data.stride;
+	}
+	return hash;
+}
+
+static bool equalStrided(const PxBoundedData& data0, const PxBoundedData& data1, PxU32 elemSize)
+{
+	if(data0.count!=data1.count)
+		return false;
+
+	const PxU8* src0 = reinterpret_cast<const PxU8*>(data0.data);
+	const PxU8* src1 = reinterpret_cast<const PxU8*>(data1.data);
+	if(src0==src1 && data0.stride==data1.stride)
+		return true;
+
+	for(PxU32 i=0;i<data0.count;i++)
+	{
+		if(memcmp(src0, src1, elemSize))
+			return false;
+		src0 += data0.stride;
+		src1 += data1.stride;
+	}
+	return true;
+}
+
+static PX_FORCE_INLINE PxU32 getIndexSize(const PxConvexMeshDesc& desc)
+{
+	return desc.flags & PxConvexFlag::e16_BIT_INDICES ? sizeof(PxU16) : sizeof(PxU32);
+}
+
+// user-provided polygons and indices are ignored when the hull is computed, so they don't take part in the hash
+static PxU32 hashConvexMeshDesc(const PxConvexMeshDesc& desc)
+{
+	const PxU32 flags = PxU32(desc.flags);
+	const PxU16 limits[3] = { desc.vertexLimit, desc.polygonLimit, desc.quantizedCount };
+
+	PxU32 hash = 2166136261u;
+	hash = hashBytes(hash, &flags, sizeof(PxU32));
+	hash = hashBytes(hash, limits, sizeof(PxU16)*3);
+	hash = hashStrided(hash, desc.points, sizeof(PxVec3));
+	if(!(desc.flags & PxConvexFlag::eCOMPUTE_CONVEX))
+	{
+		hash = hashStrided(hash, desc.polygons, sizeof(PxHullPolygon));
+		hash = hashStrided(hash, desc.indices, getIndexSize(desc));
+	}
+	return hash;
+}
+
+static bool equalConvexMeshDescs(const PxConvexMeshDesc& desc0, const PxConvexMeshDesc& desc1)
+{
+	if(desc0.flags!=desc1.flags || desc0.vertexLimit!=desc1.vertexLimit || desc0.polygonLimit!=desc1.polygonLimit
+		|| desc0.quantizedCount!=desc1.quantizedCount || desc0.sdfDesc!=desc1.sdfDesc)
+		return false;
+
+	if(!equalStrided(desc0.points, desc1.points, sizeof(PxVec3)))
+		return false;
+
+	if(!(desc0.flags & PxConvexFlag::eCOMPUTE_CONVEX))
+	{
+		if(!equalStrided(desc0.polygons, desc1.polygons, sizeof(PxHullPolygon)))
+			return false;
+		if(!equalStrided(desc0.indices, desc1.indices, getIndexSize(desc0)))
+			return false;
+	}
+	return true;
+}
+
+// cooks the first descriptor of a group and saves the result to the streams of all the group's descriptors
+static PxU32 cookConvexMeshGroup(const PxCookingParams& params, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions, const PxU32* nextInGroup, PxU32 first, QuickHullScratchPool* scratchPool)
+{
+	PX_FPU_GUARD;
+
+	// choose cooking library if needed
+	PxConvexMeshDesc desc = descs[first];
+	ConvexHullLib* hullLib = createHullLib(desc, params, scratchPool);
+
+	ConvexMeshBuilder meshBuilder(params.buildGPUData);
+	PxConvexMeshCookingResult::Enum condition;
+	const bool status = cookConvexMeshInternal(params, desc, meshBuilder, hullLib, &condition);
+
+	PxU32 nbCooked = 0;
+	for(PxU32 i=first; i!=BATCH_COOKING_INVALID_INDEX; i=nextInGroup[i])
+	{
+		PxConvexMeshCookingResult::Enum result = condition;
+		if(status)
+		{
+			// save the cooked results into stream
+			if(meshBuilder.save(*streams[i], immediateCooking::platformMismatch()))
+				nbCooked++;
+			else
+				result = PxConvexMeshCookingResult::eFAILURE;
+		}
+
+		if(conditions)
+			conditions[i] = result;
+	}
+
+	PX_DELETE(hullLib);
+	return nbCooked;
+}
+
+namespace
+{
+	class BatchCookingJobs : public Cm::ParallelJobs
+	{
+		PX_NOCOPY(BatchCookingJobs)
+	public:
+							BatchCookingJobs(const PxCookingParams& params, const PxConvexMeshDesc* descs, PxU32 count, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions) :
+								mParams(params), mDescs(descs), mStreams(streams), mConditions(conditions), mScratchPools(NULL), mNbCooked(0)
+							{
+								mNextInGroup.resize(count, BATCH_COOKING_INVALID_INDEX);
+							}
+
+		virtual				~BatchCookingJobs()
+							{
+								PX_DELETE_ARRAY(mScratchPools);
+							}
+
+		// one scratch pool per thread, the calling thread uses the first one (it is also thread 0 for the jobs)
+		void				allocateScratchPools(PxU32 nbThreads)
+		{
+			mScratchPools = PX_NEW(QuickHullScratchPool)[nbThreads];
+		}
+
+		PxU32				cookGroup(PxU32 first, PxU32 threadIndex)
+		{
+			return cookConvexMeshGroup(mParams, mDescs, mStreams, mConditions, mNextInGroup.begin(), first, &mScratchPools[threadIndex]);
+		}
+
+		virtual	void		processJob(PxU32 job, PxU32 threadIndex)	PX_OVERRIDE
+		{
+			PxAtomicAdd(&mNbCooked, PxI32(cookGroup(mJobs[job], threadIndex)));
+		}
+
+		const PxCookingParams&				mParams;
+		const PxConvexMeshDesc*				mDescs;
+		PxOutputStream* const*				mStreams;
+		PxConvexMeshCookingResult::Enum*	mConditions;
+		PxArray<PxU32>						mNextInGroup;	// next descriptor in the same group, or BATCH_COOKING_INVALID_INDEX
+		PxArray<PxU32>						mJobs;			// first descriptor of each group cooked by the jobs
+		PxArray<PxU32>						mSerialJobs;	// first descriptor of each group cooked by the calling thread
+		QuickHullScratchPool*				mScratchPools;	// hull scratch buffers reused within the batch, per thread
+		volatile PxI32						mNbCooked;
+	};
+
+	struct LargerDescFirst
+	{
+		const PxConvexMeshDesc*	mDescs;
+
+		PX_FORCE_INLINE bool operator()(PxU32 a, PxU32 b) const
+		{
+			return mDescs[a].points.count > mDescs[b].points.count;
+		}
+	};
+}
+
+PxU32 immediateCooking::cookConvexMeshes(const PxCookingParams& params, const PxConvexMeshDesc* descs, PxU32 count, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions)
+{
+	if(!count)
+		return 0;
+
+	if(!descs || !streams)
+	{
+		outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "Cooking::cookConvexMeshes: descriptors and output streams must be provided!");
+		return 0;
+	}
+
+	BatchCookingJobs jobs(params, descs, count, streams, conditions);
+
+	// group identical descriptors. Groups are linked lists through mNextInGroup, and groups with the same hash are
+	// chained through nextWithSameHash. Invalid descriptors are not hashed and are cooked alone, which reports the error.
+	{
+		PxHashMap<PxU32, PxU32> firstWithHash;
+		PxArray<PxU32> nextWithSameHash(count, BATCH_COOKING_INVALID_INDEX);
+		PxArray<PxU32> lastInGroup(count);
+
+		for(PxU32 i=0;i<count;i++)
+		{
+			const PxConvexMeshDesc& desc = descs[i];
+			lastInGroup[i] = i;
+
+			PxU32 group = BATCH_COOKING_INVALID_INDEX;
+			if(desc.isValid())
+			{
+				const PxU32 hash = hashConvexMeshDesc(desc);
+				const PxHashMap<PxU32, PxU32>::Entry* entry = firstWithHash.find(hash);
+				if(entry)
+				{
+					PxU32 candidate = entry->second;
+					PxU32 lastCandidate = candidate;
+					while(candidate!=BATCH_COOKING_INVALID_INDEX)
+					{
+						if(equalConvexMeshDescs(descs[candidate], desc))
+						{
+							group = candidate;
+							break;
+						}
+						lastCandidate = candidate;
+						candidate = nextWithSameHash[candidate];
+					}
+
+					if(group==BATCH_COOKING_INVALID_INDEX)
+						nextWithSameHash[lastCandidate] = i;
+				}
+				else
+					firstWithHash.insert(hash, i);
+			}
+
+			if(group!=BATCH_COOKING_INVALID_INDEX)
+			{
+				jobs.mNextInGroup[lastInGroup[group]] = i;
+				lastInGroup[group] = i;
+			}
+			// SDF construction writes back to the user's PxSDFDesc and already uses its own threads, so these groups
+			// are cooked on the calling thread.
+			else if(desc.sdfDesc)
+				jobs.mSerialJobs.pushBack(i);
+			else
+				jobs.mJobs.pushBack(i);
+		}
+	}
+
+	// start with the largest meshes so that the smaller ones fill the gaps at the end
+	const PxU32 nbJobs = jobs.mJobs.size();
+	if(nbJobs>1)
+	{
+		LargerDescFirst compare;
+		compare.mDescs = descs;
+		PxSort(jobs.mJobs.begin(), nbJobs, compare);
+	}
+
+	jobs.allocateScratchPools(Cm::ParallelJobsRunner::getNbThreads(params.cpuDispatcher, nbJobs));
+
+	Cm::ParallelJobsRunner runner("Gu.cookConvexMeshes");
+	runner.start(params.cpuDispatcher, jobs, nbJobs);
+
+	// the calling thread only processes jobs in finish(), so it can use the first scratch pool until then
+	PxU32 nbCooked = 0;
+	const PxU32 nbSerialJobs = jobs.mSerialJobs.size();
+	for(PxU32 i=0;i<nbSerialJobs;i++)
+		nbCooked += jobs.cookGroup(jobs.mSerialJobs[i], 0);
+
+	runner.finish();
+
+	nbCooked += PxU32(jobs.mNbCooked);
+	return nbCooked;	// the scratch pools are released with the jobs
+}
+
 bool immediateCooking::validateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc)
 {
 	ConvexMeshBuilder mesh(params.buildGPUData);
@@ -55,29 +55,50 @@ namespace local
 	class ConvexHull;
 	class HullPlanes;
 
+	//////////////////////////////////////////////////////////////////////////
+	// scratch buffers come from the pool when there is one (batch cooking), from the allocator otherwise
+	template<typename T>
+	static PX_FORCE_INLINE T* allocateScratch(QuickHullScratchPool* pool, PxU32 nb)
+	{
+		return pool ? reinterpret_cast<T*>(pool->allocate(sizeof(T)*nb)) : PX_ALLOCATE(T, nb, "QuickHull scratch");
+	}
+
+	template<typename T>
+	static PX_FORCE_INLINE void releaseScratch(QuickHullScratchPool* pool, T*& ptr)
+	{
+		if(pool)
+		{
+			pool->deallocate(ptr);
+			ptr = NULL;
+		}
+		else
+			PX_FREE(ptr);
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 	template<typename T, bool useIndexing>
 	class MemBlock
 	{
 	public:
-		MemBlock(PxU32 preallocateSize)
-			: mPreallocateSize(preallocateSize), mCurrentBlock(0), mCurrentIndex(0)
+		MemBlock(PxU32 preallocateSize, QuickHullScratchPool* pool)
+			: mPool(pool), mPreallocateSize(preallocateSize), mCurrentBlock(0), mCurrentIndex(0)
 		{
 			PX_ASSERT(preallocateSize);
-			T* block = PX_ALLOCATE(T, preallocateSize, "Quickhull MemBlock");
+			T* block = allocateScratch<T>(mPool, preallocateSize);
 			mBlocks.pushBack(block);
 		}
 
 		MemBlock()
-			: mPreallocateSize(0), mCurrentBlock(0), mCurrentIndex(0)
+			: mPool(NULL), mPreallocateSize(0), mCurrentBlock(0), mCurrentIndex(0)
 		{
 		}
 
-		void init(PxU32 preallocateSize)
+		void init(PxU32 preallocateSize, QuickHullScratchPool* pool)
 		{
 			PX_ASSERT(preallocateSize);
+			mPool = pool;
 			mPreallocateSize = preallocateSize;
-			T* block = PX_ALLOCATE(T, preallocateSize, "Quickhull MemBlock");
+			T* block = allocateScratch<T>(mPool, preallocateSize);
 			if(useIndexing)
 			{
 				for (PxU32 i = 0; i < mPreallocateSize; i++)
@@ -93,7 +114,7 @@ namespace local
 		{
 			for (PxU32 i = 0; i < mBlocks.size(); i++)
 			{
-				PX_FREE(mBlocks[i]);
+				releaseScratch(mPool, mBlocks[i]);
 			}
 			mBlocks.clear();
 		}
@@ -102,14 +123,14 @@ namespace local
 		{
 			for (PxU32 i = 0; i < mBlocks.size(); i++)
 			{
-				PX_FREE(mBlocks[i]);
+				releaseScratch(mPool, mBlocks[i]);
 			}
 			mBlocks.clear();
 
 			mCurrentBlock = 0;
 			mCurrentIndex = 0;
 
-			init(mPreallocateSize);
+			init(mPreallocateSize, mPool);
 		}
 
 		T* getItem(PxU32 index)
@@ -131,7 +152,7 @@ namespace local
 			}
 			else
 			{
-				T* block = PX_ALLOCATE(T, mPreallocateSize, "Quickhull MemBlock");
+				T* block = allocateScratch<T>(mPool, mPreallocateSize);
 				mCurrentBlock++;
 				if (useIndexing)
 				{
@@ -148,6 +169,7 @@ namespace local
 		}
 
 	private:
+		QuickHullScratchPool*	mPool;
 		PxU32			mPreallocateSize;
 		PxU32			mCurrentBlock;
 		PxU32			mCurrentIndex;
@@ -373,7 +395,7 @@ namespace local
 		PX_NOCOPY(QuickHull)
 	public:
 
-		QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc);
+		QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc, QuickHullScratchPool* scratchPool);
 
 		~QuickHull();
 
@@ -463,6 +485,7 @@ namespace local
 
 		const PxCookingParams&	mCookingParams;		// cooking params
 		const PxConvexMeshDesc& mConvexDesc;		// convex desc
+		QuickHullScratchPool*	mScratchPool;		// optional pool for the scratch buffers, NULL to use the allocator
 
 		PxVec3					mInteriorPoint;		// interior point for int/ext tests
 
@@ -693,8 +716,8 @@ namespace local
 
 	//////////////////////////////////////////////////////////////////////////
 
-	QuickHull::QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc)
-		: mCookingParams(params), mConvexDesc(desc), mOutputNumVertices(0), mTerminalVertex(0xFFFFFFFF), mVerticesList(NULL), mNumHullFaces(0), mPrecomputedMinMax(false),
+	QuickHull::QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc, QuickHullScratchPool* scratchPool)
+		: mCookingParams(params), mConvexDesc(desc), mScratchPool(scratchPool), mOutputNumVertices(0), mTerminalVertex(0xFFFFFFFF), mVerticesList(NULL), mNumHullFaces(0), mPrecomputedMinMax(false),
 		mTolerance(-1.0f), mPlaneTolerance(-1.0f)
 	{
 	}
@@ -729,15 +752,15 @@ namespace local
 
 		// max num vertices = numVertices
 		mMaxVertices = PxMax(PxU32(8), numVertices); // 8 is min, since we can expand to AABB during the clean vertices phase
-		mVerticesList = PX_ALLOCATE(QuickHullVertex, mMaxVertices, "QuickHullVertex");
+		mVerticesList = allocateScratch<QuickHullVertex>(mScratchPool, mMaxVertices);
 
 		// estimate the max half edges
 		PxU32 maxHalfEdges = (3 * mMaxVertices - 6) * 3;
-		mFreeHalfEdges.init(maxHalfEdges);
+		mFreeHalfEdges.init(maxHalfEdges, mScratchPool);
 
 		// estimate the max faces
 		PxU32 maxFaces = (2 * mMaxVertices - 4);
-		mFreeFaces.init(maxFaces*2);
+		mFreeFaces.init(maxFaces*2, mScratchPool);
 
 		mHullFaces.reserve(maxFaces);
 		mUnclaimedPoints.reserve(numVertices);
@@ -752,7 +775,7 @@ namespace local
 	// release internal buffers
 	void QuickHull::releaseHull()
 	{
-		PX_FREE(mVerticesList);
+		releaseScratch(mScratchPool, mVerticesList);
 		mHullFaces.clear();
 	}
 
@@ -1820,10 +1843,64 @@ namespace local
 
 //////////////////////////////////////////////////////////////////////////
 
-QuickHullConvexHullLib::QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params)
+// each buffer is preceded by a header storing its capacity, so that it can be reused for any request that fits
+static const PxU32 gScratchHeaderSize = 16;
+
+QuickHullScratchPool::~QuickHullScratchPool()
+{
+	release();
+}
+
+void* QuickHullScratchPool::allocate(PxU32 size)
+{
+	// best fit among the free buffers
+	PxU32 best = 0xffffffff;
+	PxU32 bestCapacity = 0xffffffff;
+	const PxU32 nbFree = mFreeBuffers.size();
+	for(PxU32 i=0;i<nbFree;i++)
+	{
+		const PxU32 capacity = *reinterpret_cast<const PxU32*>(mFreeBuffers[i]);
+		if(capacity>=size && capacity<bestCapacity)
+		{
+			best = i;
+			bestCapacity = capacity;
+		}
+	}
+
+	PxU8* buffer;
+	if(best!=0xffffffff)
+	{
+		buffer = mFreeBuffers[best];
+		mFreeBuffers.replaceWithLast(best);
+	}
+	else
+	{
+		buffer = PX_ALLOCATE(PxU8, gScratchHeaderSize + size, "QuickHullScratchPool");
+		*reinterpret_cast<PxU32*>(buffer) = size;
+	}
+	return buffer + gScratchHeaderSize;
+}
+
+void QuickHullScratchPool::deallocate(void* ptr)
+{
+	if(ptr)
+		mFreeBuffers.pushBack(reinterpret_cast<PxU8*>(ptr) - gScratchHeaderSize);
+}
+
+void QuickHullScratchPool::release()
+{
+	const PxU32 nbFree = mFreeBuffers.size();
+	for(PxU32 i=0;i<nbFree;i++)
+		PX_FREE(mFreeBuffers[i]);
+	mFreeBuffers.reset();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+QuickHullConvexHullLib::QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params, QuickHullScratchPool* scratchPool)
 	: ConvexHullLib(desc, params),mQuickHull(NULL), mCropedConvexHull(NULL), mOutMemoryBuffer(NULL), mFaceTranslateTable(NULL)
 {
-	mQuickHull = PX_NEW(local::QuickHull)(params, desc);
+	mQuickHull = PX_NEW(local::QuickHull)(params, desc, scratchPool);
 	mQuickHull->preallocate(desc.points.count);
 }
 
@@ -1856,7 +1933,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 	if ( vcount < 8 ) 
 		vcount = 8;
 
-	PxVec3* outvsource  = PX_ALLOCATE(PxVec3, vcount, "PxVec3");
+	PxVec3* outvsource  = local::allocateScratch<PxVec3>(mQuickHull->mScratchPool, vcount);
 	PxU32 outvcount;
 
 	// cleanup the vertices first
@@ -1865,7 +1942,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 		if(!shiftAndcleanupVertices(mConvexMeshDesc.points.count, reinterpret_cast<const PxVec3*> (mConvexMeshDesc.points.data), mConvexMeshDesc.points.stride,
 			outvcount, outvsource))
 		{
-			PX_FREE(outvsource);
+			local::releaseScratch(mQuickHull->mScratchPool, outvsource);
 			return res;
 		}
 	}
@@ -1874,7 +1951,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 		if(!cleanupVertices(mConvexMeshDesc.points.count, reinterpret_cast<const PxVec3*> (mConvexMeshDesc.points.data), mConvexMeshDesc.points.stride,
 			outvcount, outvsource))
 		{
-			PX_FREE(outvsource);
+			local::releaseScratch(mQuickHull->mScratchPool, outvsource);
 			return res;
 		}
 	}
@@ -1945,7 +2022,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 		}
 	}
 
-	PX_FREE(outvsource);
+	local::releaseScratch(mQuickHull->mScratchPool, outvsource);
 	return res;
 }
 
@@ -2184,7 +2261,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::expandHull()
 	}
 
 	// construct again the hull from the new points
-	local::QuickHull* newHull = PX_NEW(local::QuickHull)(mQuickHull->mCookingParams, mQuickHull->mConvexDesc);		
+	local::QuickHull* newHull = PX_NEW(local::QuickHull)(mQuickHull->mCookingParams, mQuickHull->mConvexDesc, mQuickHull->mScratchPool);		
 	newHull->preallocate(expandPoints.size());
 	newHull->parseInputVertices(vertices,expandPoints.size());
 
@@ -43,6 +43,23 @@ namespace physx
 {
 	class ConvexHull;
 
+	//////////////////////////////////////////////////////////////////////////
+	// Keeps the scratch buffers released by a hull, so that the next hulls cooked on the same thread reuse them instead of
+	// going back to the allocator. Used by batch cooking, with one pool per thread: the pool is not thread-safe.
+	class QuickHullScratchPool : public PxUserAllocated
+	{
+	public:
+		~QuickHullScratchPool();
+
+		void*			allocate(PxU32 size);
+		void			deallocate(void* ptr);
+
+		// frees the buffers kept by the pool. Buffers still in use are not affected.
+		void			release();
+	private:
+		PxArray<PxU8*>	mFreeBuffers;
+	};
+
 	//////////////////////////////////////////////////////////////////////////
 	// Quickhull lib constructs the hull from given input points. The resulting hull 
 	// will only contain a subset of the input points. The algorithm does incrementally
@@ -54,7 +71,7 @@ namespace physx
 	public:
 
 		// functions
-		QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params);
+		QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params, QuickHullScratchPool* scratchPool = NULL);
 
 		~QuickHullConvexHullLib();
 
@@ -2662,7 +2662,7 @@ bool TetrahedronMeshBuilder::createMidPhaseStructure(TetrahedronMeshData& collis
 
 	const PxU32 nbTetsPerLeaf = 15;
 
-	if (!BuildBV4Ex(collisionData.mBV4Tree, meshInterface, gBoxEpsilon, nbTetsPerLeaf, false))
+	if (!BuildBV4Ex(collisionData.mBV4Tree, meshInterface, gBoxEpsilon, nbTetsPerLeaf, false, BV4_SPLATTER_POINTS, params.cpuDispatcher))
 		return PxGetFoundation().error(PxErrorCode::eINTERNAL_ERROR, PX_FL, "BV4 tree failed to build.");
 			
 	const PxU32* order = meshInterface.getRemap();
@@ -2723,7 +2723,6 @@ void TetrahedronMeshBuilder::saveMidPhaseStructure(PxOutputStream& stream, bool
 
 bool BV32TetrahedronMeshBuilder::createMidPhaseStructure(const PxCookingParams& params, TetrahedronMeshData& collisionMesh, BV32Tree& bv32Tree, DeformableVolumeCollisionData& collisionData)
 {
-	PX_UNUSED(params);
 	PX_UNUSED(collisionMesh);
 	PX_UNUSED(bv32Tree);
 	const PxReal gBoxEpsilon = 2e-4f;
@@ -2745,7 +2744,7 @@ bool BV32TetrahedronMeshBuilder::createMidPhaseStructure(const PxCookingParams&
 
 	PxU32 nbTetrahedronPerLeaf = 32;
 
-	if (!BuildBV32Ex(bv32Tree, meshInterface, gBoxEpsilon, nbTetrahedronPerLeaf))
+	if (!BuildBV32Ex(bv32Tree, meshInterface, gBoxEpsilon, nbTetrahedronPerLeaf, params.cpuDispatcher))
 		return PxGetFoundation().error(PxErrorCode::eINTERNAL_ERROR, PX_FL, "BV32 tree failed to build.");
 
 	const PxU32* order = meshInterface.getRemap();
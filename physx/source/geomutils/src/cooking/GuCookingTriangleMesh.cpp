@@ -1057,7 +1057,7 @@ bool BV4TriangleMeshBuilder::createMidPhaseStructure()
 		gubs = BV4_SAH;
 	else if(strategy==PxBVH34BuildStrategy::eFAST)
 		gubs = BV4_SPLATTER_POINTS;
-	if(!BuildBV4Ex(mData.mBV4Tree, mData.mMeshInterface, gBoxEpsilon, nbTrisPerLeaf, quantized, gubs))
+	if(!BuildBV4Ex(mData.mBV4Tree, mData.mMeshInterface, gBoxEpsilon, nbTrisPerLeaf, quantized, gubs, mParams.cpuDispatcher))
 		return outputError<PxErrorCode::eINTERNAL_ERROR>(__LINE__, "BV4 tree failed to build.");
 
 	{
@@ -1151,7 +1151,7 @@ bool BV32TriangleMeshBuilder::createMidPhaseStructure(const PxCookingParams& par
 
 	const PxU32 nbTrisPerLeaf = 32;
 
-	if (!BuildBV32Ex(bv32Tree, meshInterface, gBoxEpsilon, nbTrisPerLeaf))
+	if (!BuildBV32Ex(bv32Tree, meshInterface, gBoxEpsilon, nbTrisPerLeaf, params.cpuDispatcher))
 		return outputError<PxErrorCode::eINTERNAL_ERROR>(__LINE__, "BV32 tree failed to build.");
 
 	{
@@ -44,6 +44,9 @@ HeightField::HeightField(MeshFactory* factory)
 , mMinHeight	(0.0f)
 , mMaxHeight	(0.0f)
 , mModifyCount	(0)
+, mTileBounds	(NULL)
+, mNbTileRows	(0)
+, mNbTileColumns(0)
 , mMeshFactory	(factory)
 {
 	mData.format				= PxHeightFieldFormat::eS16_TM;
@@ -63,10 +66,14 @@ HeightField::HeightField(MeshFactory* factory, HeightFieldData& data)
 , mMinHeight	(0.0f)
 , mMaxHeight	(0.0f)
 , mModifyCount	(0)
+, mTileBounds	(NULL)
+, mNbTileRows	(0)
+, mNbTileColumns(0)
 , mMeshFactory	(factory)
 {
 	mData = data;
 	data.samples = NULL; // set to null so that we don't release the memory
+	buildTileBounds();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -94,6 +101,8 @@ void HeightField::exportExtraData(PxSerializationContext& stream)
 void HeightField::importExtraData(PxDeserializationContext& context)
 {
 	mData.samples = context.readExtraData<PxHeightFieldSample, PX_SERIAL_ALIGN>(mData.rows * mData.columns);
+	// tile bounds are derived data, rebuilt instead of being serialized
+	buildTileBounds();
 }
 
 HeightField* HeightField::createObject(PxU8*& address, PxDeserializationContext& context)
@@ -137,11 +146,13 @@ bool HeightField::modifySamples(PxI32 startCol, PxI32 startRow, const PxHeightFi
 	// unless shrinkBounds is specified. then the bounds will be fully recomputed later
 	PxReal minHeight = mMinHeight;
 	PxReal maxHeight = mMaxHeight;
-	PxU32 hiRow = PxMin(PxU32(PxMax(0, startRow + PxI32(desc.nbRows))), nbRows);
-	PxU32 hiCol = PxMin(PxU32(PxMax(0, startCol + PxI32(desc.nbColumns))), nbCols);
-	for (PxU32 row = PxU32(PxMax(startRow, 0)); row < hiRow; row++)
+	const PxU32 loRow = PxU32(PxMax(startRow, 0));
+	const PxU32 loCol = PxU32(PxMax(startCol, 0));
+	const PxU32 hiRow = PxMin(PxU32(PxMax(0, startRow + PxI32(desc.nbRows))), nbRows);
+	const PxU32 hiCol = PxMin(PxU32(PxMax(0, startCol + PxI32(desc.nbColumns))), nbCols);
+	for (PxU32 row = loRow; row < hiRow; row++)
 	{
-		for (PxU32 col = PxU32(PxMax(startCol, 0)); col < hiCol; col++)
+		for (PxU32 col = loCol; col < hiCol; col++)
 		{
 			const PxU32 vertexIndex = col + row*nbCols;
 			PxHeightFieldSample* targetSample = &mData.samples[vertexIndex];
@@ -158,18 +169,40 @@ bool HeightField::modifySamples(PxI32 startCol, PxI32 startRow, const PxHeightFi
 		}
 	}
 
+	// only refresh the tiles touching the modified vertices. A vertex on a tile's first row/column is shared with
+	// the previous tile, hence the -1 on the lower bounds.
+	if (mTileBounds && loRow < hiRow && loCol < hiCol)
+	{
+		const PxU32 minTileRow = loRow ? (loRow - 1) >> GU_HF_TILE_SIZE_SHIFT : 0;
+		const PxU32 minTileColumn = loCol ? (loCol - 1) >> GU_HF_TILE_SIZE_SHIFT : 0;
+		const PxU32 maxTileRow = PxMin((hiRow - 1) >> GU_HF_TILE_SIZE_SHIFT, mNbTileRows - 1);
+		const PxU32 maxTileColumn = PxMin((hiCol - 1) >> GU_HF_TILE_SIZE_SHIFT, mNbTileColumns - 1);
+		updateTileBounds(minTileRow, maxTileRow, minTileColumn, maxTileColumn);
+	}
+
 	if (shrinkBounds)
 	{
-		// do a full recompute on vertical bounds to allow shrinking
-		minHeight = PX_MAX_REAL;
-		maxHeight = -PX_MAX_REAL;
-		// have to recompute the min&max from scratch...
-		for (PxU32 vertexIndex = 0; vertexIndex < nbRows * nbCols; vertexIndex ++)
+		if (mTileBounds)
 		{
-			// update height extents
-			const PxReal h = getHeight(vertexIndex);
-			minHeight = physx::intrinsics::selectMin(h, minHeight);
-			maxHeight = physx::intrinsics::selectMax(h, maxHeight);
+			// the tiles are up-to-date so there's no need to go over all the samples again
+			PxI16 minTileHeight, maxTileHeight;
+			computeHeightRangeFromTiles(minTileHeight, maxTileHeight);
+			minHeight = PxReal(minTileHeight);
+			maxHeight = PxReal(maxTileHeight);
+		}
+		else
+		{
+			// do a full recompute on vertical bounds to allow shrinking
+			minHeight = PX_MAX_REAL;
+			maxHeight = -PX_MAX_REAL;
+			// have to recompute the min&max from scratch...
+			for (PxU32 vertexIndex = 0; vertexIndex < nbRows * nbCols; vertexIndex ++)
+			{
+				// update height extents
+				const PxReal h = getHeight(vertexIndex);
+				minHeight = physx::intrinsics::selectMin(h, minHeight);
+				maxHeight = physx::intrinsics::selectMax(h, maxHeight);
+			}
 		}
 	}
 	mMinHeight = minHeight;
@@ -252,6 +285,9 @@ bool HeightField::load(PxInputStream& stream)
 				PX_ASSERT(sizeof(PxU16) == sizeof(s.height));
 				flip(s.height);
 			}
+
+		if(!buildTileBounds())
+			return false;
 	}
 
 	return true;
@@ -305,6 +341,9 @@ bool HeightField::loadFromDesc(const PxHeightFieldDesc& desc)
 		}
 		mMinHeight = PxReal(minHeight);
 		mMaxHeight = PxReal(maxHeight);
+
+		if(!buildTileBounds())
+			return false;
 	}
 
 	PX_ASSERT(mMaxHeight >= mMinHeight);
@@ -389,6 +428,96 @@ void HeightField::releaseMemory()
 	{
 		PX_FREE(mData.samples);
 	}
+	releaseTileBounds();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool HeightField::buildTileBounds()
+{
+	releaseTileBounds();
+
+	const PxU32 nbRows = mData.rows;
+	const PxU32 nbCols = mData.columns;
+	if(nbRows<2 || nbCols<2 || !mData.samples)
+		return true;
+
+	// tiles are defined over cells, i.e. there are (nbRows-1)*(nbCols-1) cells to cover
+	const PxU32 nbTileRows = (nbRows - 2 + GU_HF_TILE_SIZE) >> GU_HF_TILE_SIZE_SHIFT;
+	const PxU32 nbTileColumns = (nbCols - 2 + GU_HF_TILE_SIZE) >> GU_HF_TILE_SIZE_SHIFT;
+
+	mTileBounds = PX_ALLOCATE(HeightFieldTileBounds, nbTileRows * nbTileColumns, "HeightFieldTileBounds");
+	if(!mTileBounds)
+		return PxGetFoundation().error(PxErrorCode::eOUT_OF_MEMORY, PX_FL, "Gu::HeightField::buildTileBounds: PX_ALLOC failed!");
+
+	mNbTileRows = nbTileRows;
+	mNbTileColumns = nbTileColumns;
+	updateTileBounds(0, nbTileRows - 1, 0, nbTileColumns - 1);
+	return true;
+}
+
+void HeightField::releaseTileBounds()
+{
+	PX_FREE(mTileBounds);
+	mNbTileRows = 0;
+	mNbTileColumns = 0;
+}
+
+void HeightField::updateTileBounds(PxU32 minTileRow, PxU32 maxTileRow, PxU32 minTileColumn, PxU32 maxTileColumn)
+{
+	PX_ASSERT(maxTileRow<mNbTileRows && maxTileColumn<mNbTileColumns);
+
+	const PxU32 nbCols = mData.columns;
+	const PxU32 lastRow = mData.rows - 1;
+	const PxU32 lastColumn = nbCols - 1;
+	const PxHeightFieldSample* PX_RESTRICT samples = mData.samples;
+
+	for(PxU32 tileRow=minTileRow; tileRow<=maxTileRow; tileRow++)
+	{
+		// vertex ranges are inclusive, the last row/column of a tile is the first one of the next tile
+		const PxU32 row0 = tileRow << GU_HF_TILE_SIZE_SHIFT;
+		const PxU32 row1 = PxMin(row0 + GU_HF_TILE_SIZE, lastRow);
+
+		for(PxU32 tileColumn=minTileColumn; tileColumn<=maxTileColumn; tileColumn++)
+		{
+			const PxU32 col0 = tileColumn << GU_HF_TILE_SIZE_SHIFT;
+			const PxU32 col1 = PxMin(col0 + GU_HF_TILE_SIZE, lastColumn);
+
+			PxI16 minHeight = PX_MAX_I16;
+			PxI16 maxHeight = PX_MIN_I16;
+			for(PxU32 row=row0; row<=row1; row++)
+			{
+				const PxHeightFieldSample* PX_RESTRICT rowSamples = samples + row * nbCols;
+				for(PxU32 col=col0; col<=col1; col++)
+				{
+					const PxI16 height = rowSamples[col].height;
+					minHeight = height < minHeight ? height : minHeight;
+					maxHeight = height > maxHeight ? height : maxHeight;
+				}
+			}
+
+			HeightFieldTileBounds& tile = mTileBounds[tileRow * mNbTileColumns + tileColumn];
+			tile.mMinHeight = minHeight;
+			tile.mMaxHeight = maxHeight;
+		}
+	}
+}
+
+void HeightField::computeHeightRangeFromTiles(PxI16& minHeight, PxI16& maxHeight) const
+{
+	PX_ASSERT(mTileBounds);
+
+	PxI16 minH = PX_MAX_I16;
+	PxI16 maxH = PX_MIN_I16;
+	const PxU32 nbTiles = mNbTileRows * mNbTileColumns;
+	for(PxU32 i=0;i<nbTiles;i++)
+	{
+		const HeightFieldTileBounds& tile = mTileBounds[i];
+		minH = tile.mMinHeight < minH ? tile.mMinHeight : minH;
+		maxH = tile.mMaxHeight > maxH ? tile.mMaxHeight : maxH;
+	}
+	minHeight = minH;
+	maxHeight = maxH;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
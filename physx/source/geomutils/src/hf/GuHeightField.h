@@ -43,6 +43,11 @@
 //#define PX_HEIGHTFIELD_VERSION 1  // tiled version that was needed for PS3 only has been removed
 #define PX_HEIGHTFIELD_VERSION 2  // some floats are now integers
 
+// the heightfield keeps a coarse table of per-tile height ranges, used to cull whole runs of cells in overlap
+// queries and to recompute bounds locally when samples are modified. A tile covers (1<<GU_HF_TILE_SIZE_SHIFT)^2 cells.
+#define GU_HF_TILE_SIZE_SHIFT	6
+#define GU_HF_TILE_SIZE			(1<<GU_HF_TILE_SIZE_SHIFT)
+
 namespace physx
 {
 class PxHeightFieldDesc;
@@ -51,11 +56,19 @@ class PxInputStream;
 namespace Gu
 {
 class MeshFactory;
+
+// min/max sample heights over all vertices touched by a tile's cells. Tiles share their border vertices.
+struct HeightFieldTileBounds
+{
+	PxI16	mMinHeight;
+	PxI16	mMaxHeight;
+};
+
 class HeightField : public PxHeightField, public PxUserAllocated
 {
 public:
 // PX_SERIALIZATION
-																	HeightField(PxBaseFlags baseFlags) : PxHeightField(baseFlags), mData(PxEmpty), mModifyCount(0) {}
+																	HeightField(PxBaseFlags baseFlags) : PxHeightField(baseFlags), mData(PxEmpty), mModifyCount(0), mTileBounds(NULL), mNbTileRows(0), mNbTileColumns(0) {}
 
 										void						preExportDataReset() { Cm::RefCountable_preExportDataReset(*this); }
 							virtual		void						exportExtraData(PxSerializationContext& context);
@@ -223,6 +236,15 @@ public:
 						PX_FORCE_INLINE	PxReal						getMinHeight()					const	{ return mMinHeight; }
 						PX_FORCE_INLINE	PxReal						getMaxHeight()					const	{ return mMaxHeight; }
 
+						PX_FORCE_INLINE	PxU32						getNbTileRows()					const	{ return mNbTileRows;		}
+						PX_FORCE_INLINE	PxU32						getNbTileColumns()				const	{ return mNbTileColumns;	}
+						PX_FORCE_INLINE	const HeightFieldTileBounds*	getTileBounds()				const	{ return mTileBounds;		}
+						PX_FORCE_INLINE	const HeightFieldTileBounds&	getTileBounds(PxU32 tileRow, PxU32 tileColumn)	const
+																	{
+																		PX_ASSERT(tileRow<mNbTileRows && tileColumn<mNbTileColumns);
+																		return mTileBounds[tileRow * mNbTileColumns + tileColumn];
+																	}
+
 						PX_FORCE_INLINE	const Gu::HeightFieldData&	getData()						const	{ return mData; }
 	
 	PX_CUDA_CALLABLE	PX_FORCE_INLINE	void						getTriangleVertices(PxU32 triangleIndex, PxU32 row, PxU32 column, PxVec3& v0, PxVec3& v1, PxVec3& v2) const;
@@ -239,8 +261,15 @@ public:
 										PxReal						mMinHeight;
 										PxReal						mMaxHeight;
 										PxU32						mModifyCount;
+										HeightFieldTileBounds*		mTileBounds;	// always owned by the heightfield, not serialized
+										PxU32						mNbTileRows;
+										PxU32						mNbTileColumns;
 
 										void						releaseMemory();
+										bool						buildTileBounds();
+										void						releaseTileBounds();
+										void						updateTileBounds(PxU32 minTileRow, PxU32 maxTileRow, PxU32 minTileColumn, PxU32 maxTileColumn);
+										void						computeHeightRangeFromTiles(PxI16& minHeight, PxI16& maxHeight)	const;
 						virtual										~HeightField();
 
 private:
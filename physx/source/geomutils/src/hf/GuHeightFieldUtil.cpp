@@ -124,10 +124,32 @@ void Gu::HeightFieldUtil::overlapAABBTriangles(const PxBounds3& bounds, OverlapR
 	const PxReal maxy = localBounds.maximum.y;
 	const PxU32 columnStride = nbColumns - deltaColumn;
 
+	const HeightFieldTileBounds* tileBounds = mHeightField->getTileBounds();
+	const PxU32 nbTileColumns = mHeightField->getNbTileColumns();
+
 	for(PxU32 row=minRow; row<maxRow; row++)
 	{
+		const HeightFieldTileBounds* rowTiles = tileBounds ? tileBounds + (row >> GU_HF_TILE_SIZE_SHIFT) * nbTileColumns : NULL;
+
+		PxU32 tileEnd = minColumn;
 		for(PxU32 column=minColumn; column<maxColumn; column++)
 		{
+			// when entering a new tile, skip all its cells at once if its height range doesn't overlap the query.
+			// Such cells would fail the per-cell test below anyway so the reported triangles and their order are unchanged.
+			if(rowTiles && column==tileEnd)
+			{
+				const PxU32 tileColumn = column >> GU_HF_TILE_SIZE_SHIFT;
+				tileEnd = PxMin((tileColumn + 1) << GU_HF_TILE_SIZE_SHIFT, maxColumn);
+
+				const HeightFieldTileBounds& tile = rowTiles[tileColumn];
+				if(maxy < PxReal(tile.mMinHeight) || miny > PxReal(tile.mMaxHeight))
+				{
+					offset += tileEnd - column;
+					column = tileEnd - 1;
+					continue;
+				}
+			}
+
 			const PxReal h0 = mHeightField->getHeight(offset);
 			const PxReal h1 = mHeightField->getHeight(offset + 1);
 			const PxReal h2 = mHeightField->getHeight(offset + nbColumns);
@@ -34,6 +34,10 @@
 #include "GuBounds.h"
 #include "GuBV4Build.h"
 #include "GuBV4.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxArray.h"
+#include "task/PxCpuDispatcher.h"
+#include "CmParallelJobs.h"
 #include <stdio.h>
 
 using namespace physx;
@@ -325,7 +329,134 @@ static void local_BuildHierarchy_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats&
 	}
 }
 
-bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy)
+///////////////////////////////////////////////////////////////////////////////
+
+// parallel build. The top of the tree is subdivided on the calling thread until nodes are small enough, then these
+// nodes are built as independent subtrees by the dispatcher's workers and the calling thread. A subtree with N
+// primitives needs at most 2*N-2 nodes below its root, so each job is given its own range of the pool and the total stays
+// within the 2*N-1 nodes allocated for the serial build. Nodes are linked by pointers and each node is split exactly as in
+// the serial build, so the resulting tree (and the cooked data) is the same.
+#define BV4_PARALLEL_BUILD_MIN_NB_PRIMS			4096	// meshes with less primitives are always built serially
+#define BV4_PARALLEL_BUILD_MIN_SUBTREE_SIZE		512		// don't create subtree jobs smaller than this
+#define BV4_PARALLEL_BUILD_NB_JOBS_PER_THREAD	4		// more jobs than threads, for load balancing
+
+namespace
+{
+	struct SubtreeJob
+	{
+		AABBTreeNode*	mRoot;
+		AABBTreeNode*	mNodeBase;	// start of the pool range reserved for this subtree
+		PxU32			mNbNodes;	// number of nodes created by the job, excluding the root
+	};
+
+	struct LargerSubtreeFirst
+	{
+		PX_FORCE_INLINE bool operator()(const SubtreeJob& a, const SubtreeJob& b) const
+		{
+			return a.mRoot->mNbPrimitives > b.mRoot->mNbPrimitives;
+		}
+	};
+
+	class BV4BuildJobs : public Cm::ParallelJobs
+	{
+		PX_NOCOPY(BV4BuildJobs)
+	public:
+							BV4BuildJobs(const PxBounds3* boxes, const PxVec3* centers, PxU32 limit, const SourceMesh* mesh, bool useSAH, PxArray<SubtreeJob>& jobs) :
+								mBoxes(boxes), mCenters(centers), mLimit(limit), mMesh(mesh), mUseSAH(useSAH), mJobs(jobs)
+							{
+							}
+
+		virtual	void		processJob(PxU32 index, PxU32)	PX_OVERRIDE
+		{
+			SubtreeJob& job = mJobs[index];
+
+			BuildStats stats;
+			const BuildParams params(mBoxes, mCenters, job.mNodeBase, mLimit, mMesh);
+			if(mUseSAH)
+			{
+				SAH_Buffers sah(job.mRoot->mNbPrimitives);
+				local_BuildHierarchy_SAH(job.mRoot, stats, params, sah);
+			}
+			else
+				local_BuildHierarchy(job.mRoot, stats, params);
+
+			job.mNbNodes = stats.getCount();
+		}
+
+		const PxBounds3*		mBoxes;
+		const PxVec3*			mCenters;
+		const PxU32				mLimit;
+		const SourceMesh*		mMesh;
+		const bool				mUseSAH;
+		PxArray<SubtreeJob>&	mJobs;
+	};
+}
+
+// top-down serial phase, until the remaining nodes are small enough to become subtree jobs
+static void local_BuildTopLevelHierarchy(PxArray<SubtreeJob>& jobs, PxU32 subtreeSize, AABBTreeNode* PX_RESTRICT node, BuildStats& stats, const BuildParams& params, SAH_Buffers* sah)
+{
+	if(node->mNbPrimitives<=subtreeSize)
+	{
+		SubtreeJob job;
+		job.mRoot		= node;
+		job.mNodeBase	= NULL;
+		job.mNbNodes	= 0;
+		jobs.pushBack(job);
+		return;
+	}
+
+	const bool split = sah ? local_Subdivide_SAH(node, stats, params, *sah) : local_Subdivide(node, stats, params);
+	if(split)
+	{
+		AABBTreeNode* pos = const_cast<AABBTreeNode*>(node->getPos());
+		AABBTreeNode* neg = const_cast<AABBTreeNode*>(node->getNeg());
+		local_BuildTopLevelHierarchy(jobs, subtreeSize, pos, stats, params, sah);
+		local_BuildTopLevelHierarchy(jobs, subtreeSize, neg, stats, params, sah);
+	}
+}
+
+static void local_BuildHierarchyParallel(AABBTreeNode* PX_RESTRICT pool, PxU32 nbPrims, BuildStats& stats, const PxBounds3* boxes, const PxVec3* centers, PxU32 limit, const SourceMesh* mesh, bool useSAH, PxCpuDispatcher& dispatcher)
+{
+	const PxU32 nbThreads = dispatcher.getWorkerCount() + 1;
+	const PxU32 subtreeSize = PxMax(nbPrims / (nbThreads * BV4_PARALLEL_BUILD_NB_JOBS_PER_THREAD), PxMax<PxU32>(BV4_PARALLEL_BUILD_MIN_SUBTREE_SIZE, limit));
+
+	PxArray<SubtreeJob> jobs;
+	{
+		const BuildParams params(boxes, centers, pool, limit, mesh);
+		if(useSAH)
+		{
+			SAH_Buffers sah(nbPrims);
+			local_BuildTopLevelHierarchy(jobs, subtreeSize, pool, stats, params, &sah);
+		}
+		else
+			local_BuildTopLevelHierarchy(jobs, subtreeSize, pool, stats, params, NULL);
+	}
+
+	const PxU32 nbJobs = jobs.size();
+	if(!nbJobs)
+		return;
+
+	// start with the largest subtrees so that the smaller ones fill the gaps at the end
+	PxSort(jobs.begin(), nbJobs, LargerSubtreeFirst());
+
+	// reserve a pool range for each subtree, right after the nodes used by the top-level phase
+	PxU32 offset = stats.getCount();
+	for(PxU32 i=0;i<nbJobs;i++)
+	{
+		jobs[i].mNodeBase = pool + offset;
+		offset += jobs[i].mRoot->mNbPrimitives*2 - 2;
+	}
+	PX_ASSERT(offset<=nbPrims*2-1);
+
+	BV4BuildJobs buildJobs(boxes, centers, limit, mesh, useSAH, jobs);
+	Cm::ParallelJobsRunner runner("Gu.parallelBuildBV4");
+	runner.run(&dispatcher, buildJobs, nbJobs);
+
+	for(PxU32 i=0;i<nbJobs;i++)
+		stats.increaseCount(jobs[i].mNbNodes);
+}
+
+bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
 {
 	const PxU32 nbBoxes = mesh.getNbPrimitives();
 	if(!nbBoxes)
@@ -368,6 +499,8 @@ bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStr
 		mPool->mNodePrimitives = mIndices;
 		mPool->mNbPrimitives = nbBoxes;
 
+		const bool parallel = dispatcher && dispatcher->getWorkerCount() && nbBoxes>=BV4_PARALLEL_BUILD_MIN_NB_PRIMS;
+
 		// Build the hierarchy
 		if(strategy==BV4_SPLATTER_POINTS||strategy==BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER)
 		{
@@ -378,12 +511,20 @@ bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStr
 				if(mesh.getMeshType()==SourceMeshBase::TRI_MESH)
 					triMesh = static_cast<SourceMesh*>(&mesh);
 			}
-			local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
+			if(parallel)
+				local_BuildHierarchyParallel(mPool, nbBoxes, Stats, boxes, centers, limit, triMesh, false, *dispatcher);
+			else
+				local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
 		}
 		else if(strategy==BV4_SAH)
 		{
-			SAH_Buffers sah(nbBoxes);
-			local_BuildHierarchy_SAH(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sah);
+			if(parallel)
+				local_BuildHierarchyParallel(mPool, nbBoxes, Stats, boxes, centers, limit, NULL, true, *dispatcher);
+			else
+			{
+				SAH_Buffers sah(nbBoxes);
+				local_BuildHierarchy_SAH(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sah);
+			}
 		}
 		else
 			return false;
@@ -1820,7 +1961,7 @@ static bool gReorderCallback(const AABBTreeNode* current, PxU32 /*depth*/, void*
 	return true;
 }
 
-bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy)
+bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
 {
 	//either number of triangle or number of tetrahedron
 	const PxU32 nbPrimitives = mesh.getNbPrimitives();
@@ -1828,7 +1969,7 @@ bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, P
 	BV4_AABBTree Source;
 	{
 		GU_PROFILE_ZONE("..BuildBV4Ex_buildFromMesh")
-		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy))
+		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy, dispatcher))
 			return false;
 	}
 
@@ -0,0 +1,294 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxBitUtils.h"
+#include "GuBV4.h"
+#include "GuMidphaseInterface.h"
+using namespace physx;
+using namespace Gu;
+
+#include "foundation/PxVecMath.h"
+using namespace aos;
+
+#include "GuBV4_Common.h"
+
+#if PX_VC
+#pragma warning ( disable : 4324 )
+#endif
+
+// batched AABB overlap, used as a shared midphase for batched sweeps (see PxMeshQuery::sweepBatch). The tree is traversed
+// once for up to 32 vertex-space AABBs. Each stack entry carries the bitmask of the AABBs overlapping the node, so a subtree
+// is only tested against the AABBs that reached it, and the traversal stops as soon as no AABB is left. Each touched triangle
+// is reported only once, with the mask of the AABBs overlapping its bounds.
+
+namespace
+{
+	// AABB coordinates splatted once, so that each one can be tested against the 4 children of a swizzled node at once.
+	struct SplatAABB
+	{
+		Vec4V	mMinX;
+		Vec4V	mMinY;
+		Vec4V	mMinZ;
+		Vec4V	mMaxX;
+		Vec4V	mMaxY;
+		Vec4V	mMaxZ;
+	};
+
+	struct AABBBatchParams
+	{
+		const IndTri32*	PX_RESTRICT	mTris32;
+		const IndTri16*	PX_RESTRICT	mTris16;
+		const PxVec3*	PX_RESTRICT	mVerts;
+
+		BV4_ALIGN16(PxVec3p	mCenterOrMinCoeff_PaddedAligned);
+		BV4_ALIGN16(PxVec3p	mExtentsOrMaxCoeff_PaddedAligned);
+
+		const PxBounds3*	PX_RESTRICT	mBounds;
+		MeshBatchOverlapCallback		mCallback;
+		void*							mUserData;
+	};
+}
+
+static PX_FORCE_INLINE void doLeafTest(const AABBBatchParams* PX_RESTRICT params, PxU32 primIndex, PxU32 nodeMask)
+{
+	PxU32 nbToGo = getNbPrimitives(primIndex);
+	do
+	{
+		PxU32 VRef0, VRef1, VRef2;
+		getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+
+		const PxVec3& p0 = params->mVerts[VRef0];
+		const PxVec3& p1 = params->mVerts[VRef1];
+		const PxVec3& p2 = params->mVerts[VRef2];
+		const PxVec3 triMin = p0.minimum(p1.minimum(p2));
+		const PxVec3 triMax = p0.maximum(p1.maximum(p2));
+
+		// the leaf's bounds contain up to 16 triangles so we refine the mask per triangle, to save narrowphase calls later.
+		PxU32 triMask = 0;
+		PxU32 mask = nodeMask;
+		while(mask)
+		{
+			const PxU32 i = PxLowestSetBit(mask);
+			mask &= mask - 1;
+
+			const PxBounds3& b = params->mBounds[i];
+			if(		b.minimum.x <= triMax.x && b.maximum.x >= triMin.x
+				&&	b.minimum.y <= triMax.y && b.maximum.y >= triMin.y
+				&&	b.minimum.z <= triMax.z && b.maximum.z >= triMin.z)
+				triMask |= 1u<<i;
+		}
+
+		if(triMask)
+			(params->mCallback)(params->mUserData, primIndex, triMask);
+
+		primIndex++;
+	}while(nbToGo--);
+}
+
+#ifdef GU_BV4_USE_SLABS
+	#include "GuBV4_Slabs.h"
+
+	static PX_FORCE_INLINE void computeChildMasks(PxU32* PX_RESTRICT childMasks, PxU32 nodeMask, const SplatAABB* PX_RESTRICT aabbs,
+		const Vec4V minx4a, const Vec4V miny4a, const Vec4V minz4a, const Vec4V maxx4a, const Vec4V maxy4a, const Vec4V maxz4a)
+	{
+		childMasks[0] = childMasks[1] = childMasks[2] = childMasks[3] = 0;
+
+		while(nodeMask)
+		{
+			const PxU32 i = PxLowestSetBit(nodeMask);
+			nodeMask &= nodeMask - 1;
+
+			const SplatAABB& box = aabbs[i];
+
+			const BoolV overlapX = BAnd(V4IsGrtrOrEq(box.mMaxX, minx4a), V4IsGrtrOrEq(maxx4a, box.mMinX));
+			const BoolV overlapY = BAnd(V4IsGrtrOrEq(box.mMaxY, miny4a), V4IsGrtrOrEq(maxy4a, box.mMinY));
+			const BoolV overlapZ = BAnd(V4IsGrtrOrEq(box.mMaxZ, minz4a), V4IsGrtrOrEq(maxz4a, box.mMinZ));
+			const PxU32 code = BGetBitMask(BAnd(BAnd(overlapX, overlapY), overlapZ));
+
+			const PxU32 bit = 1u<<i;
+			if(code & 1)	childMasks[0] |= bit;
+			if(code & 2)	childMasks[1] |= bit;
+			if(code & 4)	childMasks[2] |= bit;
+			if(code & 8)	childMasks[3] |= bit;
+		}
+	}
+
+	template<class SwizzledNodeT>
+	static PX_FORCE_INLINE void processChildren(PxU32* PX_RESTRICT stack, PxU32* PX_RESTRICT maskStack, PxU32& nb, const SwizzledNodeT* PX_RESTRICT tn,
+		PxU32 nodeType, const PxU32* PX_RESTRICT childMasks, const AABBBatchParams* PX_RESTRICT params)
+	{
+		// nodeType+2 children are valid in a swizzled node
+		const PxU32 nbChildren = nodeType + 2;
+		for(PxU32 i=0;i<nbChildren;i++)
+		{
+			const PxU32 childMask = childMasks[i];
+			if(!childMask)
+				continue;
+
+			if(tn->isLeaf(i))
+				doLeafTest(params, tn->getPrimitive(i), childMask);
+			else
+			{
+				PX_ASSERT(nb<GU_BV4_STACK_SIZE);
+				stack[nb] = tn->getChildData(i);
+				maskStack[nb] = childMask;
+				nb++;
+			}
+		}
+	}
+
+	static void BV4_ProcessStreamAABBBatchQ(const BVDataPackedQ* PX_RESTRICT node, PxU32 initData, PxU32 rootMask, const SplatAABB* PX_RESTRICT aabbs, const AABBBatchParams* PX_RESTRICT params)
+	{
+		const BVDataPackedQ* root = node;
+
+		PxU32 nb=1;
+		PxU32 stack[GU_BV4_STACK_SIZE];
+		PxU32 maskStack[GU_BV4_STACK_SIZE];
+		stack[0] = initData;
+		maskStack[0] = rootMask;
+
+		const Vec4V minCoeffV = V4LoadA_Safe(&params->mCenterOrMinCoeff_PaddedAligned.x);
+		const Vec4V maxCoeffV = V4LoadA_Safe(&params->mExtentsOrMaxCoeff_PaddedAligned.x);
+		const Vec4V minCoeffxV = V4SplatElement<0>(minCoeffV);
+		const Vec4V minCoeffyV = V4SplatElement<1>(minCoeffV);
+		const Vec4V minCoeffzV = V4SplatElement<2>(minCoeffV);
+		const Vec4V maxCoeffxV = V4SplatElement<0>(maxCoeffV);
+		const Vec4V maxCoeffyV = V4SplatElement<1>(maxCoeffV);
+		const Vec4V maxCoeffzV = V4SplatElement<2>(maxCoeffV);
+
+		do
+		{
+			nb--;
+			const PxU32 childData = stack[nb];
+			const PxU32 nodeMask = maskStack[nb];
+			node = root + getChildOffset(childData);
+
+			const BVDataSwizzledQ* tn = reinterpret_cast<const BVDataSwizzledQ*>(node);
+
+			Vec4V minx4a;
+			Vec4V maxx4a;
+			OPC_DEQ4(maxx4a, minx4a, mX, minCoeffxV, maxCoeffxV)
+
+			Vec4V miny4a;
+			Vec4V maxy4a;
+			OPC_DEQ4(maxy4a, miny4a, mY, minCoeffyV, maxCoeffyV)
+
+			Vec4V minz4a;
+			Vec4V maxz4a;
+			OPC_DEQ4(maxz4a, minz4a, mZ, minCoeffzV, maxCoeffzV)
+
+			PxU32 childMasks[4];
+			computeChildMasks(childMasks, nodeMask, aabbs, minx4a, miny4a, minz4a, maxx4a, maxy4a, maxz4a);
+
+			processChildren(stack, maskStack, nb, tn, getChildType(childData), childMasks, params);
+
+		}while(nb);
+	}
+
+	static void BV4_ProcessStreamAABBBatchNQ(const BVDataPackedNQ* PX_RESTRICT node, PxU32 initData, PxU32 rootMask, const SplatAABB* PX_RESTRICT aabbs, const AABBBatchParams* PX_RESTRICT params)
+	{
+		const BVDataPackedNQ* root = node;
+
+		PxU32 nb=1;
+		PxU32 stack[GU_BV4_STACK_SIZE];
+		PxU32 maskStack[GU_BV4_STACK_SIZE];
+		stack[0] = initData;
+		maskStack[0] = rootMask;
+
+		do
+		{
+			nb--;
+			const PxU32 childData = stack[nb];
+			const PxU32 nodeMask = maskStack[nb];
+			node = root + getChildOffset(childData);
+
+			const BVDataSwizzledNQ* tn = reinterpret_cast<const BVDataSwizzledNQ*>(node);
+
+			const Vec4V minx4a = V4LoadA(tn->mMinX);
+			const Vec4V miny4a = V4LoadA(tn->mMinY);
+			const Vec4V minz4a = V4LoadA(tn->mMinZ);
+
+			const Vec4V maxx4a = V4LoadA(tn->mMaxX);
+			const Vec4V maxy4a = V4LoadA(tn->mMaxY);
+			const Vec4V maxz4a = V4LoadA(tn->mMaxZ);
+
+			PxU32 childMasks[4];
+			computeChildMasks(childMasks, nodeMask, aabbs, minx4a, miny4a, minz4a, maxx4a, maxy4a, maxz4a);
+
+			processChildren(stack, maskStack, nb, tn, getChildType(childData), childMasks, params);
+
+		}while(nb);
+	}
+#endif
+
+void BV4_OverlapAABBBatchCB(const BV4Tree& tree, PxU32 nbBounds, const PxBounds3* bounds, MeshBatchOverlapCallback callback, void* userData)
+{
+	PX_ASSERT(nbBounds && nbBounds<=32);
+
+	const SourceMesh* PX_RESTRICT mesh = static_cast<const SourceMesh*>(tree.mMeshInterface);
+
+	AABBBatchParams Params;
+	Params.mBounds		= bounds;
+	Params.mCallback	= callback;
+	Params.mUserData	= userData;
+	setupMeshPointersAndQuantizedCoeffs(&Params, mesh, &tree);
+
+	const PxU32 rootMask = nbBounds==32 ? 0xffffffff : (1u<<nbBounds)-1;
+
+	if(tree.mNodes)
+	{
+#ifdef GU_BV4_USE_SLABS
+		SplatAABB aabbs[32];
+		for(PxU32 i=0;i<nbBounds;i++)
+		{
+			aabbs[i].mMinX = V4Load(bounds[i].minimum.x);
+			aabbs[i].mMinY = V4Load(bounds[i].minimum.y);
+			aabbs[i].mMinZ = V4Load(bounds[i].minimum.z);
+			aabbs[i].mMaxX = V4Load(bounds[i].maximum.x);
+			aabbs[i].mMaxY = V4Load(bounds[i].maximum.y);
+			aabbs[i].mMaxZ = V4Load(bounds[i].maximum.z);
+		}
+
+		if(tree.mQuantized)
+			BV4_ProcessStreamAABBBatchQ(reinterpret_cast<const BVDataPackedQ*>(tree.mNodes), tree.mInitData, rootMask, aabbs, &Params);
+		else
+			BV4_ProcessStreamAABBBatchNQ(reinterpret_cast<const BVDataPackedNQ*>(tree.mNodes), tree.mInitData, rootMask, aabbs, &Params);
+#else
+		// the batched traversal is only implemented for the swizzled format. Fall back to brute-force tests otherwise.
+		const PxU32 nbTris = mesh->getNbPrimitives();
+		for(PxU32 i=0;i<nbTris;i+=15)
+			doLeafTest(&Params, (i<<4)|PxMin(nbTris-i, 15u), rootMask);
+#endif
+	}
+	else
+	{
+		const PxU32 nbTris = mesh->getNbPrimitives();
+		PX_ASSERT(nbTris<16);
+		doLeafTest(&Params, nbTris, rootMask);
+	}
+}
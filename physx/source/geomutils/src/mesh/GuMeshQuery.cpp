@@ -30,6 +30,8 @@
 #include "geometry/PxMeshQuery.h"
 #include "geometry/PxSphereGeometry.h"
 #include "geometry/PxGeometryQuery.h"
+#include "geometry/PxTriangleMeshGeometry.h"
+#include "foundation/PxArray.h"
 
 #include "GuInternal.h"
 #include "GuEntityReport.h"
@@ -39,6 +41,7 @@
 #include "CmScaling.h"
 #include "GuSweepTests.h"
 #include "GuMidphaseInterface.h"
+#include "GuBounds.h"
 #include "foundation/PxFPU.h"
 
 using namespace physx;
@@ -270,22 +273,12 @@ PxU32 physx::PxMeshQuery::findOverlapHeightField(	const PxGeometry& geom, const
 
 ///////////////////////////////////////////////////////////////////////////////
 
-bool physx::PxMeshQuery::sweep(	const PxVec3& unitDir, const PxReal maxDistance,
-								const PxGeometry& geom, const PxTransform& pose,
-								PxU32 triangleCount, const PxTriangle* triangles,
-								PxGeomSweepHit& sweepHit, PxHitFlags hitFlags,
-								const PxU32* cachedIndex, const PxReal inflation, bool doubleSided, PxGeometryQueryFlags queryFlags)
+static bool sweepTriangles(	const PxVec3& unitDir, const PxReal distance,
+							const PxGeometry& geom, const PxTransform& pose,
+							PxU32 triangleCount, const PxTriangle* triangles,
+							PxGeomSweepHit& sweepHit, PxHitFlags hitFlags,
+							const PxU32* cachedIndex, const PxReal inflation, bool doubleSided)
 {
-	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
-	PX_CHECK_AND_RETURN_VAL(pose.isValid(), "PxMeshQuery::sweep(): pose is not valid.", false);
-	PX_CHECK_AND_RETURN_VAL(unitDir.isFinite(), "PxMeshQuery::sweep(): unitDir is not valid.", false);
-	PX_CHECK_AND_RETURN_VAL(PxIsFinite(maxDistance), "PxMeshQuery::sweep(): distance is not valid.", false);
-	PX_CHECK_AND_RETURN_VAL(maxDistance > 0, "PxMeshQuery::sweep(): sweep distance must be greater than 0.", false);
-
-	PX_PROFILE_ZONE("MeshQuery.sweep", 0);
-
-	const PxReal distance = PxMin(maxDistance, PX_MAX_SWEEP_DISTANCE);
-
 	switch(geom.getType())
 	{
 		case PxGeometryType::eSPHERE:
@@ -329,3 +322,193 @@ bool physx::PxMeshQuery::sweep(	const PxVec3& unitDir, const PxReal maxDistance,
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool physx::PxMeshQuery::sweep(	const PxVec3& unitDir, const PxReal maxDistance,
+								const PxGeometry& geom, const PxTransform& pose,
+								PxU32 triangleCount, const PxTriangle* triangles,
+								PxGeomSweepHit& sweepHit, PxHitFlags hitFlags,
+								const PxU32* cachedIndex, const PxReal inflation, bool doubleSided, PxGeometryQueryFlags queryFlags)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(pose.isValid(), "PxMeshQuery::sweep(): pose is not valid.", false);
+	PX_CHECK_AND_RETURN_VAL(unitDir.isFinite(), "PxMeshQuery::sweep(): unitDir is not valid.", false);
+	PX_CHECK_AND_RETURN_VAL(PxIsFinite(maxDistance), "PxMeshQuery::sweep(): distance is not valid.", false);
+	PX_CHECK_AND_RETURN_VAL(maxDistance > 0, "PxMeshQuery::sweep(): sweep distance must be greater than 0.", false);
+
+	PX_PROFILE_ZONE("MeshQuery.sweep", 0);
+
+	const PxReal distance = PxMin(maxDistance, PX_MAX_SWEEP_DISTANCE);
+
+	return sweepTriangles(unitDir, distance, geom, pose, triangleCount, triangles, sweepHit, hitFlags, cachedIndex, inflation, doubleSided);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	// gathers the triangles touched by a bundle of sweeps. Each triangle is reported once by the batched midphase and moved to
+	// world space once, then shared by all the sweeps of the bundle that can touch it.
+	struct SweepBatchCollector
+	{
+		SweepBatchCollector(const TriangleMesh& mesh, const PxMat34& vertex2worldSkew, bool flipNormal) :
+			mMesh(mesh), mVertex2WorldSkew(vertex2worldSkew), mFlipNormal(flipNormal)	{}
+
+		const TriangleMesh&	mMesh;
+		const PxMat34		mVertex2WorldSkew;
+		const bool			mFlipNormal;
+		PxArray<PxTriangle>	mTris;			// World-space triangles touched by the bundle
+		PxArray<PxU32>		mTriIndices;	// Mesh indices of these triangles
+		PxArray<PxU32>		mSweepMasks;	// For each triangle, bitmask of the sweeps of the bundle that can touch it
+
+		PX_NOCOPY(SweepBatchCollector)
+	};
+}
+
+static void gSweepBatchCallback(void* userData, PxU32 triangleIndex, PxU32 sweepMask)
+{
+	SweepBatchCollector* collector = reinterpret_cast<SweepBatchCollector*>(userData);
+
+	collector->mMesh.computeWorldTriangle(collector->mTris.insert(), triangleIndex, collector->mVertex2WorldSkew, collector->mFlipNormal);
+	collector->mTriIndices.pushBack(triangleIndex);
+	collector->mSweepMasks.pushBack(sweepMask);
+}
+
+namespace
+{
+	// per-sweep version of the above, for meshes without batched midphase
+	struct SweepBatchOBBCallback : MeshHitCallback<PxGeomRaycastHit>
+	{
+		SweepBatchOBBCallback(SweepBatchCollector& collector, PxU32 sweepMask) :
+			MeshHitCallback<PxGeomRaycastHit>(CallbackMode::eMULTIPLE), mCollector(collector), mSweepMask(sweepMask)	{}
+
+		virtual PxAgain processHit(const PxGeomRaycastHit& hit, const PxVec3&, const PxVec3&, const PxVec3&, PxReal&, const PxU32*)
+		{
+			gSweepBatchCallback(&mCollector, hit.faceIndex, mSweepMask);
+			return true;
+		}
+
+		SweepBatchCollector&	mCollector;
+		const PxU32				mSweepMask;
+
+		PX_NOCOPY(SweepBatchOBBCallback)
+	};
+}
+
+// number of sweeps processed by a single traversal of the mesh's midphase structure. Limited by the size of the masks.
+#define SWEEP_BATCH_SIZE	32
+
+PxU32 physx::PxMeshQuery::sweepBatch(	const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshPose,
+										PxU32 nbSweeps, const PxMeshSweepDesc* sweeps, PxGeomSweepHit* sweepHits,
+										PxHitFlags hitFlags, PxGeometryQueryFlags queryFlags)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(meshGeom.isValid(), "PxMeshQuery::sweepBatch(): meshGeom is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(meshPose.isValid(), "PxMeshQuery::sweepBatch(): meshPose is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL((sweeps && sweepHits) || !nbSweeps, "PxMeshQuery::sweepBatch(): NULL sweeps or sweepHits array.", 0);
+
+	for(PxU32 i=0;i<nbSweeps;i++)
+	{
+		const PxMeshSweepDesc& desc = sweeps[i];
+		PX_CHECK_AND_RETURN_VAL(desc.geometry, "PxMeshQuery::sweepBatch(): NULL geometry.", 0);
+		PX_CHECK_AND_RETURN_VAL(desc.geometry->getType()==PxGeometryType::eSPHERE || desc.geometry->getType()==PxGeometryType::eCAPSULE || desc.geometry->getType()==PxGeometryType::eBOX,
+			"PxMeshQuery::sweepBatch(): geometry object parameter must be sphere, capsule or box geometry.", 0);
+		PX_CHECK_AND_RETURN_VAL(desc.pose.isValid(), "PxMeshQuery::sweepBatch(): pose is not valid.", 0);
+		PX_CHECK_AND_RETURN_VAL(desc.unitDir.isFinite(), "PxMeshQuery::sweepBatch(): unitDir is not valid.", 0);
+		PX_CHECK_AND_RETURN_VAL(PxIsFinite(desc.distance), "PxMeshQuery::sweepBatch(): distance is not valid.", 0);
+		PX_CHECK_AND_RETURN_VAL(desc.distance > 0, "PxMeshQuery::sweepBatch(): sweep distance must be greater than 0.", 0);
+	}
+
+	PX_PROFILE_ZONE("MeshQuery.sweepBatch", 0);
+
+	const TriangleMesh* tm = static_cast<const TriangleMesh*>(meshGeom.triangleMesh);
+	const bool doubleSided = meshGeom.meshFlags & PxMeshGeometryFlag::eDOUBLE_SIDED;
+
+	// the batched midphase is only implemented for BV4. Other meshes gather the triangles with one midphase query per sweep,
+	// but use the same narrowphase so that results do not depend on the mesh's midphase.
+	const bool batchedMidphase = tm->getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34;
+
+	const PxMat34 vertex2worldSkew = meshPose * meshGeom.scale;
+	const PxMat34 world2vertexSkew = meshGeom.scale.getInverse() * meshPose.getInverse();
+
+	PxArray<PxTriangle> sweepTris;
+	PxArray<PxU32> sweepTriIndices;
+
+	PxU32 nbHits = 0;
+	for(PxU32 batchStart=0; batchStart<nbSweeps; batchStart+=SWEEP_BATCH_SIZE)
+	{
+		const PxU32 batchSize = PxMin(nbSweeps - batchStart, PxU32(SWEEP_BATCH_SIZE));
+		const PxMeshSweepDesc* batchSweeps = sweeps + batchStart;
+		PxGeomSweepHit* batchHits = sweepHits + batchStart;
+
+		// compute vertex-space bounds around each swept volume. These are conservative: the mesh rotation and scale can make
+		// them much larger than the swept volume for long diagonal sweeps. The batch is designed for many short sweeps, for which
+		// this is not an issue.
+		PxBounds3 sweptBounds[SWEEP_BATCH_SIZE];
+		for(PxU32 i=0;i<batchSize;i++)
+		{
+			const PxMeshSweepDesc& desc = batchSweeps[i];
+			const PxVec3 motion = desc.unitDir * PxMin(desc.distance, PX_MAX_SWEEP_DISTANCE);
+
+			PxBounds3 worldBounds;
+			computeBounds(worldBounds, *desc.geometry, desc.pose, desc.inflation, 1.01f);
+			worldBounds.include(PxBounds3(worldBounds.minimum + motion, worldBounds.maximum + motion));
+
+			PxBounds3& localBounds = sweptBounds[i];
+			localBounds = PxBounds3::transformFast(world2vertexSkew.m, worldBounds);
+			localBounds.minimum += world2vertexSkew.p;
+			localBounds.maximum += world2vertexSkew.p;
+		}
+
+		SweepBatchCollector collector(*tm, vertex2worldSkew, meshGeom.scale.hasNegativeDeterminant());
+		if(batchedMidphase)
+		{
+			overlapAABBBatch_BV4(*tm, batchSize, sweptBounds, gSweepBatchCallback, &collector);
+		}
+		else
+		{
+			for(PxU32 i=0;i<batchSize;i++)
+			{
+				const Box vertexSpaceBox(sweptBounds[i].getCenter(), sweptBounds[i].getExtents(), PxMat33(PxIdentity));
+				SweepBatchOBBCallback callback(collector, 1u<<i);
+				Midphase::intersectOBB(tm, vertexSpaceBox, callback, true);
+			}
+		}
+
+		// narrowphase, per sweep, on the triangles gathered for the whole bundle
+		const PxU32 nbTris = collector.mTris.size();
+		for(PxU32 i=0;i<batchSize;i++)
+		{
+			const PxMeshSweepDesc& desc = batchSweeps[i];
+			PxGeomSweepHit& hit = batchHits[i];
+			hit = PxGeomSweepHit();
+
+			sweepTris.clear();
+			sweepTriIndices.clear();
+			const PxU32 sweepBit = 1u<<i;
+			for(PxU32 j=0;j<nbTris;j++)
+			{
+				if(collector.mSweepMasks[j] & sweepBit)
+				{
+					sweepTris.pushBack(collector.mTris[j]);
+					sweepTriIndices.pushBack(collector.mTriIndices[j]);
+				}
+			}
+
+			if(!sweepTris.size())
+				continue;
+
+			const PxReal distance = PxMin(desc.distance, PX_MAX_SWEEP_DISTANCE);
+			if(sweepTriangles(desc.unitDir, distance, *desc.geometry, desc.pose, sweepTris.size(), sweepTris.begin(), hit, hitFlags, NULL, desc.inflation, doubleSided))
+			{
+				// remap from the index in the gathered array to the index in the mesh
+				hit.faceIndex = sweepTriIndices[hit.faceIndex];
+				nbHits++;
+			}
+			else
+				hit = PxGeomSweepHit();
+		}
+	}
+	return nbHits;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
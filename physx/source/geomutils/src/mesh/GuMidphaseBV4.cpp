@@ -88,6 +88,8 @@ void		BV4_CapsuleSweepAACB	(const Capsule& capsule, const PxVec3& dir, float max
 void		BV4_GenericSweepCB_Old	(const PxVec3& origin, const PxVec3& extents, const PxVec3& dir, float maxDist, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, MeshSweepCallback callback, void* userData);
 void		BV4_GenericSweepCB		(const Box& box, const PxVec3& dir, float maxDist, const BV4Tree& tree, MeshSweepCallback callback, void* userData, bool anyHit);
 
+void		BV4_OverlapAABBBatchCB	(const BV4Tree& tree, PxU32 nbBounds, const PxBounds3* bounds, MeshBatchOverlapCallback callback, void* userData);
+
 static PX_FORCE_INLINE void setIdentity(PxMat44& m)
 {
 	m.column0 = PxVec4(1.0f, 0.0f, 0.0f, 0.0f);
@@ -1108,3 +1110,11 @@ bool physx::Gu::distanceMeshVsMesh_BV4(	PxReportCallback<PxGeomIndexClosePair>&
 
 	return BV4_OverlapMeshVsMeshDistance(callback, tree0, tree1, TM0to1, TM1to0, meshPose0, meshPose1, meshScale0, meshScale1, meshMeshFlags, tolerance)!=0;
 }
+
+void physx::Gu::overlapAABBBatch_BV4(const TriangleMesh& triMesh, PxU32 nbBounds, const PxBounds3* bounds, MeshBatchOverlapCallback callback, void* userData)
+{
+	PX_ASSERT(triMesh.getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34);
+	const BV4Tree& tree = static_cast<const BV4TriangleMesh&>(triMesh).getBV4Tree();
+
+	BV4_OverlapAABBBatchCB(tree, nbBounds, bounds, callback, userData);
+}
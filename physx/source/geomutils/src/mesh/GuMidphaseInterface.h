@@ -176,6 +176,11 @@ namespace Gu
 														const TriangleMesh& triMesh1, const PxTransform& meshPose1, const PxMeshScale& meshScale1,
 														PxMeshMeshQueryFlags meshMeshFlags, float tolerance);
 
+	// batched midphase for PxMeshQuery::sweepBatch(). Reports each triangle overlapping at least one of the input vertex-space
+	// bounds (at most 32 per call), along with the bitmask of the bounds it overlaps. Triangles are reported at most once per call.
+	typedef void (*MeshBatchOverlapCallback)(void* userData, PxU32 triangleIndex, PxU32 boundsMask);
+	PX_PHYSX_COMMON_API void overlapAABBBatch_BV4(const TriangleMesh& triMesh, PxU32 nbBounds, const PxBounds3* bounds, MeshBatchOverlapCallback callback, void* userData);
+
 	typedef PxU32 (*MidphaseRaycastFunction)(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
 												const PxVec3& rayOrigin, const PxVec3& rayDir, PxReal maxDist,
 												PxHitFlags hitFlags, PxU32 maxHits, PxGeomRaycastHit* PX_RESTRICT hits, PxU32 stride);
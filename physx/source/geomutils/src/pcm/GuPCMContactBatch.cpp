@@ -0,0 +1,557 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "geomutils/PxContactBuffer.h"
+#include "foundation/PxVecMath.h"
+#include "foundation/PxBitUtils.h"
+#include "GuContactMethodImpl.h"
+
+using namespace physx;
+using namespace Gu;
+using namespace aos;
+
+// SoA versions of pcmContactSphereSphere, pcmContactSpherePlane, pcmContactSphereCapsule, pcmContactSphereBox and
+// pcmContactCapsuleCapsule. Each function is a line-by-line port of the corresponding single-pair code, working on 4 pairs
+// at once. Divergent branches are computed for all lanes and merged with selects. Results match the single-pair versions
+// up to float rounding. The only exception is the parallel capsules case, which can output up to 4 contacts per pair: these
+// pairs are reported in fallbackMask and processed by pcmContactCapsuleCapsule instead.
+
+PX_COMPILE_TIME_ASSERT(GU_PCM_BATCH_SIZE==4);
+
+namespace
+{
+	// 4 vectors in SoA form
+	struct Vec3V4
+	{
+		Vec4V	x, y, z;
+	};
+
+	// gathers the per-pair data. Unused lanes replicate the last pair, so that we never compute garbage.
+	struct BatchInput
+	{
+		BatchInput(const PCMBatchPair* pairs, PxU32 nbPairs) : mLaneMask((1<<nbPairs)-1)
+		{
+			PX_ASSERT(nbPairs && nbPairs<=GU_PCM_BATCH_SIZE);
+			for(PxU32 i=0;i<GU_PCM_BATCH_SIZE;i++)
+			{
+				const PCMBatchPair& pair = pairs[PxMin(i, nbPairs-1)];
+				mPairs[i] = &pair;
+				mContactDistance[i] = pair.mContactDistance;
+			}
+		}
+
+		const PCMBatchPair*	mPairs[GU_PCM_BATCH_SIZE];
+		PX_ALIGN(16, PxReal	mContactDistance[GU_PCM_BATCH_SIZE]);
+		const PxU32			mLaneMask;
+	};
+}
+
+static PX_FORCE_INLINE Vec4V dot4(const Vec3V4& a, const Vec3V4& b)
+{
+	return V4MulAdd(a.x, b.x, V4MulAdd(a.y, b.y, V4Mul(a.z, b.z)));
+}
+
+static PX_FORCE_INLINE Vec3V4 sub4(const Vec3V4& a, const Vec3V4& b)
+{
+	const Vec3V4 r = { V4Sub(a.x, b.x), V4Sub(a.y, b.y), V4Sub(a.z, b.z) };
+	return r;
+}
+
+// returns a + b*s
+static PX_FORCE_INLINE Vec3V4 scaleAdd4(const Vec3V4& b, const Vec4V s, const Vec3V4& a)
+{
+	const Vec3V4 r = { V4MulAdd(b.x, s, a.x), V4MulAdd(b.y, s, a.y), V4MulAdd(b.z, s, a.z) };
+	return r;
+}
+
+// returns a - b*s
+static PX_FORCE_INLINE Vec3V4 negScaleSub4(const Vec3V4& b, const Vec4V s, const Vec3V4& a)
+{
+	const Vec3V4 r = { V4NegMulSub(b.x, s, a.x), V4NegMulSub(b.y, s, a.y), V4NegMulSub(b.z, s, a.z) };
+	return r;
+}
+
+static PX_FORCE_INLINE Vec3V4 sel4(const BoolV c, const Vec3V4& a, const Vec3V4& b)
+{
+	const Vec3V4 r = { V4Sel(c, a.x, b.x), V4Sel(c, a.y, b.y), V4Sel(c, a.z, b.z) };
+	return r;
+}
+
+static PX_FORCE_INLINE void loadPositions(const BatchInput& input, bool second, Vec3V4& p)
+{
+	Vec4V p0 = V4LoadA(&(second ? input.mPairs[0]->mTransform1 : input.mPairs[0]->mTransform0)->p.x);
+	Vec4V p1 = V4LoadA(&(second ? input.mPairs[1]->mTransform1 : input.mPairs[1]->mTransform0)->p.x);
+	Vec4V p2 = V4LoadA(&(second ? input.mPairs[2]->mTransform1 : input.mPairs[2]->mTransform0)->p.x);
+	Vec4V p3 = V4LoadA(&(second ? input.mPairs[3]->mTransform1 : input.mPairs[3]->mTransform0)->p.x);
+	PX_TRANSPOSE_44_34(p0, p1, p2, p3, p.x, p.y, p.z);
+}
+
+static PX_FORCE_INLINE void loadRotations(const BatchInput& input, bool second, Vec3V4& u, Vec4V& w)
+{
+	Vec4V q0 = V4LoadA(&(second ? input.mPairs[0]->mTransform1 : input.mPairs[0]->mTransform0)->q.x);
+	Vec4V q1 = V4LoadA(&(second ? input.mPairs[1]->mTransform1 : input.mPairs[1]->mTransform0)->q.x);
+	Vec4V q2 = V4LoadA(&(second ? input.mPairs[2]->mTransform1 : input.mPairs[2]->mTransform0)->q.x);
+	Vec4V q3 = V4LoadA(&(second ? input.mPairs[3]->mTransform1 : input.mPairs[3]->mTransform0)->q.x);
+	PX_TRANSPOSE_44(q0, q1, q2, q3, u.x, u.y, u.z, w);
+}
+
+// SoA version of QuatRotate (or QuatRotateInv), i.e. (v*(w*w-0.5) +/- (u.cross(v))*w + u*(u.dot(v)))*2
+template<bool inverse>
+static PX_FORCE_INLINE Vec3V4 rotate4(const Vec3V4& u, const Vec4V w, const Vec3V4& v)
+{
+	const Vec4V two = V4Load(2.0f);
+	const Vec4V w2 = V4MulAdd(w, w, V4Load(-0.5f));
+	const Vec4V sw = inverse ? V4Neg(w) : w;
+	const Vec4V uv = dot4(u, v);
+
+	const Vec4V cx = V4NegMulSub(u.z, v.y, V4Mul(u.y, v.z));
+	const Vec4V cy = V4NegMulSub(u.x, v.z, V4Mul(u.z, v.x));
+	const Vec4V cz = V4NegMulSub(u.y, v.x, V4Mul(u.x, v.y));
+
+	const Vec3V4 r = {
+		V4Mul(two, V4MulAdd(u.x, uv, V4MulAdd(cx, sw, V4Mul(v.x, w2)))),
+		V4Mul(two, V4MulAdd(u.y, uv, V4MulAdd(cy, sw, V4Mul(v.y, w2)))),
+		V4Mul(two, V4MulAdd(u.z, uv, V4MulAdd(cz, sw, V4Mul(v.z, w2))))
+	};
+	return r;
+}
+
+// SoA version of QuatGetBasisVector0
+static PX_FORCE_INLINE Vec3V4 getBasisVector0(const Vec3V4& u, const Vec4V w)
+{
+	const Vec4V two = V4Load(2.0f);
+	const Vec4V x2 = V4Mul(u.x, two);
+	const Vec4V w2 = V4Mul(w, two);
+
+	const Vec3V4 r = {
+		V4MulAdd(u.x, x2, V4MulAdd(w, w2, V4Neg(V4One()))),
+		V4MulAdd(u.y, x2, V4Mul(u.z, w2)),
+		V4NegMulSub(u.y, w2, V4Mul(u.z, x2))
+	};
+	return r;
+}
+
+// same as outputSimplePCMContact for each lane in mask
+static PX_FORCE_INLINE void storeContacts(PxU32 mask, Vec3V4& point, Vec3V4& normal, const Vec4V separation, PxContactPoint* contacts)
+{
+	Vec4V p[4], n[4];
+	PX_TRANSPOSE_34_44(point.x, point.y, point.z, p[0], p[1], p[2], p[3]);
+	PX_TRANSPOSE_34_44(normal.x, normal.y, normal.z, n[0], n[1], n[2], n[3]);
+
+	PX_ALIGN(16, PxReal sep[4]);
+	V4StoreA(separation, sep);
+
+	while(mask)
+	{
+		const PxU32 i = PxLowestSetBit(mask);
+		mask &= mask - 1;
+
+		PxContactPoint& contact = contacts[i];
+		V4StoreA(n[i], &contact.normal.x);
+		V4StoreA(p[i], &contact.point.x);
+		contact.separation = sep[i];
+		PX_ASSERT(contact.point.isFinite());
+		PX_ASSERT(contact.normal.isFinite());
+		PX_ASSERT(PxIsFinite(contact.separation));
+		contact.internalFaceIndex1 = PXC_CONTACT_NO_FACE_INDEX;
+	}
+}
+
+PxU32 Gu::pcmContactSphereSphere4(GU_BATCH_CONTACT_METHOD_ARGS)
+{
+	const BatchInput input(pairs, nbPairs);
+	fallbackMask = 0;
+
+	PX_ALIGN(16, PxReal radius0[4]);
+	PX_ALIGN(16, PxReal radius1[4]);
+	for(PxU32 i=0;i<4;i++)
+	{
+		radius0[i] = checkedCast<PxSphereGeometry>(*input.mPairs[i]->mShape0).radius;
+		radius1[i] = checkedCast<PxSphereGeometry>(*input.mPairs[i]->mShape1).radius;
+	}
+
+	Vec3V4 p0, p1;
+	loadPositions(input, false, p0);
+	loadPositions(input, true, p1);
+
+	const Vec4V cDist = V4LoadA(input.mContactDistance);
+	const Vec4V r0 = V4LoadA(radius0);
+	const Vec4V r1 = V4LoadA(radius1);
+
+	const Vec3V4 delta = sub4(p0, p1);
+	const Vec4V distanceSq = dot4(delta, delta);
+	const Vec4V radiusSum = V4Add(r0, r1);
+	const Vec4V inflatedSum = V4Add(radiusSum, cDist);
+
+	const PxU32 mask = BGetBitMask(V4IsGrtr(V4Mul(inflatedSum, inflatedSum), distanceSq)) & input.mLaneMask;
+	if(!mask)
+		return 0;
+
+	const Vec4V zero = V4Zero();
+	const Vec4V one = V4One();
+	const Vec4V dist = V4Sqrt(distanceSq);
+	const BoolV bCon = V4IsGrtrOrEq(V4Load(0.00001f), dist);
+	const Vec4V recipDist = V4Recip(V4Sel(bCon, one, dist));
+
+	Vec3V4 normal = { V4Sel(bCon, one, V4Mul(delta.x, recipDist)), V4Sel(bCon, zero, V4Mul(delta.y, recipDist)), V4Sel(bCon, zero, V4Mul(delta.z, recipDist)) };
+	Vec3V4 point = scaleAdd4(normal, r1, p1);
+	const Vec4V pen = V4Sub(dist, radiusSum);
+
+	storeContacts(mask, point, normal, pen, contacts);
+	return mask;
+}
+
+PxU32 Gu::pcmContactSpherePlane4(GU_BATCH_CONTACT_METHOD_ARGS)
+{
+	const BatchInput input(pairs, nbPairs);
+	fallbackMask = 0;
+
+	PX_ALIGN(16, PxReal radius0[4]);
+	for(PxU32 i=0;i<4;i++)
+		radius0[i] = checkedCast<PxSphereGeometry>(*input.mPairs[i]->mShape0).radius;
+
+	Vec3V4 p0, p1, u1;
+	Vec4V w1;
+	loadPositions(input, false, p0);
+	loadPositions(input, true, p1);
+	loadRotations(input, true, u1, w1);
+
+	const Vec4V radius = V4LoadA(radius0);
+	const Vec4V contactDist = V4LoadA(input.mContactDistance);
+
+	//Sphere in plane space, we only need the X coordinate
+	const Vec3V4 sphereCenterInPlaneSpace = rotate4<true>(u1, w1, sub4(p0, p1));
+
+	//Separation
+	const Vec4V separation = V4Sub(sphereCenterInPlaneSpace.x, radius);
+
+	const PxU32 mask = BGetBitMask(V4IsGrtrOrEq(contactDist, separation)) & input.mLaneMask;
+	if(!mask)
+		return 0;
+
+	//get the plane normal
+	Vec3V4 worldNormal = getBasisVector0(u1, w1);
+	Vec3V4 worldPoint = negScaleSub4(worldNormal, radius, p0);
+
+	storeContacts(mask, worldPoint, worldNormal, separation, contacts);
+	return mask;
+}
+
+PxU32 Gu::pcmContactSphereCapsule4(GU_BATCH_CONTACT_METHOD_ARGS)
+{
+	const BatchInput input(pairs, nbPairs);
+	fallbackMask = 0;
+
+	PX_ALIGN(16, PxReal radius0[4]);
+	PX_ALIGN(16, PxReal radius1[4]);
+	PX_ALIGN(16, PxReal halfHeight1[4]);
+	for(PxU32 i=0;i<4;i++)
+	{
+		const PxCapsuleGeometry& capsuleGeom = checkedCast<PxCapsuleGeometry>(*input.mPairs[i]->mShape1);
+		radius0[i] = checkedCast<PxSphereGeometry>(*input.mPairs[i]->mShape0).radius;
+		radius1[i] = capsuleGeom.radius;
+		halfHeight1[i] = capsuleGeom.halfHeight;
+	}
+
+	Vec3V4 sphereCenter, p1, u1;
+	Vec4V w1;
+	loadPositions(input, false, sphereCenter);
+	loadPositions(input, true, p1);
+	loadRotations(input, true, u1, w1);
+
+	const Vec4V sphereRadius = V4LoadA(radius0);
+	const Vec4V capsuleRadius = V4LoadA(radius1);
+	const Vec4V halfHeight = V4LoadA(halfHeight1);
+	const Vec4V cDist = V4LoadA(input.mContactDistance);
+
+	const Vec3V4 basisVector = getBasisVector0(u1, w1);
+	const Vec3V4 s = scaleAdd4(basisVector, halfHeight, p1);
+	const Vec3V4 e = negScaleSub4(basisVector, halfHeight, p1);
+
+	const Vec4V radiusSum = V4Add(sphereRadius, capsuleRadius);
+	const Vec4V inflatedSum = V4Add(radiusSum, cDist);
+
+	// Collision detection, see distancePointSegmentSquared
+	const Vec4V zero = V4Zero();
+	const Vec3V4 ap = sub4(sphereCenter, s);
+	const Vec3V4 ab = sub4(e, s);
+	const Vec4V nom = dot4(ap, ab);
+	const Vec4V denom = dot4(ab, ab);
+	const BoolV degenerate = V4IsEq(denom, zero);
+	const Vec4V tValue = V4Clamp(V4Div(nom, V4Sel(degenerate, V4One(), denom)), zero, V4One());
+	const Vec4V t = V4Sel(degenerate, zero, tValue);
+	const Vec3V4 v = negScaleSub4(ab, t, ap);
+	const Vec4V squareDist = dot4(v, v);
+
+	const PxU32 mask = BGetBitMask(V4IsGrtr(V4Mul(inflatedSum, inflatedSum), squareDist)) & input.mLaneMask;
+	if(!mask)
+		return 0;
+
+	// dir is the same as v, but we recompute it like the single-pair code does
+	const Vec3V4 p = scaleAdd4(ab, t, s);
+	const Vec3V4 dir = sub4(sphereCenter, p);
+
+	// see V3NormalizeSafe
+	const Vec4V length = V4Sqrt(dot4(dir, dir));
+	const BoolV isGreaterThanZero = V4IsGrtr(length, V4Eps());
+	const Vec4V recipLength = V4Recip(V4Sel(isGreaterThanZero, length, V4One()));
+	Vec3V4 normal = {	V4Sel(isGreaterThanZero, V4Mul(dir.x, recipLength), V4One()),
+						V4Sel(isGreaterThanZero, V4Mul(dir.y, recipLength), zero),
+						V4Sel(isGreaterThanZero, V4Mul(dir.z, recipLength), zero)	};
+
+	Vec3V4 point = negScaleSub4(normal, sphereRadius, sphereCenter);
+	const Vec4V dist = V4Sub(V4Sqrt(squareDist), radiusSum);
+
+	storeContacts(mask, point, normal, dist, contacts);
+	return mask;
+}
+
+PxU32 Gu::pcmContactSphereBox4(GU_BATCH_CONTACT_METHOD_ARGS)
+{
+	const BatchInput input(pairs, nbPairs);
+	fallbackMask = 0;
+
+	PX_ALIGN(16, PxReal radius0[4]);
+	PX_ALIGN(16, PxVec4 extents1[4]);
+	for(PxU32 i=0;i<4;i++)
+	{
+		radius0[i] = checkedCast<PxSphereGeometry>(*input.mPairs[i]->mShape0).radius;
+		extents1[i] = PxVec4(checkedCast<PxBoxGeometry>(*input.mPairs[i]->mShape1).halfExtents, 0.0f);
+	}
+
+	Vec3V4 sphereOrigin, p1, u1, boxExtents;
+	Vec4V w1;
+	loadPositions(input, false, sphereOrigin);
+	loadPositions(input, true, p1);
+	loadRotations(input, true, u1, w1);
+	{
+		Vec4V e0 = V4LoadA(&extents1[0].x);
+		Vec4V e1 = V4LoadA(&extents1[1].x);
+		Vec4V e2 = V4LoadA(&extents1[2].x);
+		Vec4V e3 = V4LoadA(&extents1[3].x);
+		PX_TRANSPOSE_44_34(e0, e1, e2, e3, boxExtents.x, boxExtents.y, boxExtents.z);
+	}
+
+	const Vec4V radius = V4LoadA(radius0);
+	const Vec4V cDist = V4LoadA(input.mContactDistance);
+
+	//translate sphere center into the box space
+	const Vec3V4 sphereCenter = rotate4<true>(u1, w1, sub4(sphereOrigin, p1));
+
+	const Vec3V4 p = {	V4Clamp(sphereCenter.x, V4Neg(boxExtents.x), boxExtents.x),
+						V4Clamp(sphereCenter.y, V4Neg(boxExtents.y), boxExtents.y),
+						V4Clamp(sphereCenter.z, V4Neg(boxExtents.z), boxExtents.z)	};
+	const Vec3V4 v = sub4(sphereCenter, p);
+	const Vec4V lengthSq = dot4(v, v);
+
+	const Vec4V inflatedSum = V4Add(radius, cDist);
+
+	const PxU32 mask = BGetBitMask(V4IsGrtr(V4Mul(inflatedSum, inflatedSum), lengthSq)) & input.mLaneMask;
+	if(!mask)
+		return 0;
+
+	const Vec4V zero = V4Zero();
+	const Vec4V one = V4One();
+
+	//check whether the sphere center is inside the box
+	const BoolV bInsideBox = BAnd(BAnd(	V4IsGrtrOrEq(boxExtents.x, V4Abs(sphereCenter.x)),
+										V4IsGrtrOrEq(boxExtents.y, V4Abs(sphereCenter.y))),
+										V4IsGrtrOrEq(boxExtents.z, V4Abs(sphereCenter.z)));
+
+	// sphere center inside the box: pick directions and sign
+	const Vec4V x = V4Sub(boxExtents.x, V4Abs(p.x));
+	const Vec4V y = V4Sub(boxExtents.y, V4Abs(p.y));
+	const Vec4V z = V4Sub(boxExtents.z, V4Abs(p.z));
+
+	//find smallest element of distToSurface
+	const BoolV con0 = BAnd(V4IsGrtrOrEq(x, z), V4IsGrtrOrEq(y, z));
+	const BoolV con1 = BAnd(V4IsGrtrOrEq(y, x), V4IsGrtrOrEq(z, x));
+	const Vec4V signX = V4Sel(V4IsGrtrOrEq(p.x, zero), one, V4Neg(one));
+	const Vec4V signY = V4Sel(V4IsGrtrOrEq(p.y, zero), one, V4Neg(one));
+	const Vec4V signZ = V4Sel(V4IsGrtrOrEq(p.z, zero), one, V4Neg(one));
+
+	const Vec3V4 locNormInside = {	V4Sel(con0, zero, V4Sel(con1, signX, zero)),
+									V4Sel(con0, zero, V4Sel(con1, zero, signY)),
+									V4Sel(con0, signZ, zero)	};
+	const Vec4V distInside = V4Neg(V4Sel(con0, z, V4Sel(con1, x, y)));
+
+	// sphere center outside the box: get the closest point from the center to the box surface
+	const Vec4V recipLength = V4Rsqrt(V4Sel(bInsideBox, one, lengthSq));
+	const Vec4V length = V4Recip(recipLength);
+	const Vec3V4 locNormOutside = { V4Mul(v.x, recipLength), V4Mul(v.y, recipLength), V4Mul(v.z, recipLength) };
+
+	Vec3V4 normal = rotate4<false>(u1, w1, sel4(bInsideBox, locNormInside, locNormOutside));
+	const Vec4V penetration = V4Sub(V4Sel(bInsideBox, distInside, length), radius);
+
+	const Vec3V4 pointInside = negScaleSub4(normal, distInside, sphereOrigin);
+	const Vec3V4 rotatedP = rotate4<false>(u1, w1, p);
+	const Vec3V4 pointOutside = { V4Add(rotatedP.x, p1.x), V4Add(rotatedP.y, p1.y), V4Add(rotatedP.z, p1.z) };
+	Vec3V4 point = sel4(bInsideBox, pointInside, pointOutside);
+
+	storeContacts(mask, point, normal, penetration, contacts);
+	return mask;
+}
+
+PxU32 Gu::pcmContactCapsuleCapsule4(GU_BATCH_CONTACT_METHOD_ARGS)
+{
+	const BatchInput input(pairs, nbPairs);
+	fallbackMask = 0;
+
+	PX_ALIGN(16, PxReal radius0[4]);
+	PX_ALIGN(16, PxReal radius1[4]);
+	PX_ALIGN(16, PxReal halfHeight0[4]);
+	PX_ALIGN(16, PxReal halfHeight1[4]);
+	for(PxU32 i=0;i<4;i++)
+	{
+		const PxCapsuleGeometry& capsuleGeom0 = checkedCast<PxCapsuleGeometry>(*input.mPairs[i]->mShape0);
+		const PxCapsuleGeometry& capsuleGeom1 = checkedCast<PxCapsuleGeometry>(*input.mPairs[i]->mShape1);
+		radius0[i] = capsuleGeom0.radius;
+		radius1[i] = capsuleGeom1.radius;
+		halfHeight0[i] = capsuleGeom0.halfHeight;
+		halfHeight1[i] = capsuleGeom1.halfHeight;
+	}
+
+	Vec3V4 _p0, _p1, u0, u1;
+	Vec4V w0, w1;
+	loadPositions(input, false, _p0);
+	loadPositions(input, true, _p1);
+	loadRotations(input, false, u0, w0);
+	loadRotations(input, true, u1, w1);
+
+	const Vec4V r0 = V4LoadA(radius0);
+	const Vec4V r1 = V4LoadA(radius1);
+	const Vec4V cDist = V4LoadA(input.mContactDistance);
+
+	const Vec4V zero = V4Zero();
+	const Vec4V one = V4One();
+	const Vec4V half = V4Load(0.5f);
+
+	const Vec3V4 positionOffset = { V4Mul(V4Add(_p0.x, _p1.x), half), V4Mul(V4Add(_p0.y, _p1.y), half), V4Mul(V4Add(_p0.z, _p1.z), half) };
+	const Vec3V4 p0 = sub4(_p0, positionOffset);
+	const Vec3V4 p1 = sub4(_p1, positionOffset);
+
+	const Vec3V4 basisVector0 = getBasisVector0(u0, w0);
+	const Vec4V hh0 = V4LoadA(halfHeight0);
+	const Vec3V4 s0 = scaleAdd4(basisVector0, hh0, p0);
+	const Vec3V4 e0 = negScaleSub4(basisVector0, hh0, p0);
+	const Vec3V4 d0 = sub4(e0, s0);
+
+	const Vec3V4 basisVector1 = getBasisVector0(u1, w1);
+	const Vec4V hh1 = V4LoadA(halfHeight1);
+	const Vec3V4 s1 = scaleAdd4(basisVector1, hh1, p1);
+	const Vec3V4 e1 = negScaleSub4(basisVector1, hh1, p1);
+	const Vec3V4 d1 = sub4(e1, s1);
+
+	const Vec4V sumRadius = V4Add(r0, r1);
+	const Vec4V inflatedSum = V4Add(sumRadius, cDist);
+	const Vec4V inflatedSumSquared = V4Mul(inflatedSum, inflatedSum);
+	const Vec4V a = dot4(d0, d0);//squared length of segment1
+	const Vec4V e = dot4(d1, d1);//squared length of segment2
+	const Vec4V eps = V4Load(1e-6f);
+
+	// see distanceSegmentSegmentSquared
+	Vec4V t0, t1;
+	Vec4V sqDist0;
+	{
+		const Vec4V segEps = V4Eps();
+		const Vec3V4 r = sub4(s0, s1);
+		const Vec4V b = dot4(d0, d1);
+		const Vec4V c = dot4(d0, r);
+		const Vec4V f = dot4(d1, r);
+		const BoolV validA = V4IsGrtr(a, segEps);
+		const BoolV validE = V4IsGrtr(e, segEps);
+		const Vec4V aRecip = V4Sel(validA, V4Recip(V4Sel(validA, a, one)), zero);
+		const Vec4V eRecip = V4Sel(validE, V4Recip(V4Sel(validE, e, one)), zero);
+
+		//if segments not parallel, the general non-degenerated case, compute closest point on two segments and clamp to segment1
+		const Vec4V denom = V4Sub(V4Mul(a, e), V4Mul(b, b));
+		const Vec4V temp = V4Sub(V4Mul(b, f), V4Mul(c, e));
+
+		//if segment is parallel, demon < eps
+		const BoolV con2 = V4IsGrtr(segEps, denom);
+		const Vec4V sTmp = V4Sel(con2, half, V4Clamp(V4Div(temp, V4Sel(con2, one, denom)), zero, one));
+
+		//compute point on segment2 closest to segment1
+		const Vec4V tTmp = V4Mul(V4MulAdd(b, sTmp, f), eRecip);
+
+		//if t is in [zero, one], done. otherwise clamp t
+		t1 = V4Clamp(tTmp, zero, one);
+
+		//recompute s for the new value
+		t0 = V4Clamp(V4Mul(V4Sub(V4Mul(b, t1), c), aRecip), zero, one);
+
+		const Vec3V4 closest1 = scaleAdd4(d0, t0, s0);
+		const Vec3V4 closest2 = scaleAdd4(d1, t1, s1);
+		const Vec3V4 vv = sub4(closest1, closest2);
+		sqDist0 = dot4(vv, vv);
+	}
+
+	PxU32 mask = BGetBitMask(V4IsGrtrOrEq(inflatedSumSquared, sqDist0)) & input.mLaneMask;
+	if(!mask)
+		return 0;
+
+	//check to see whether these two capsule are paralle
+	{
+		const Vec4V parallelTolerance = V4Load(0.9998f);
+		const BoolV con0 = V4IsGrtr(eps, a);
+		const BoolV con1 = V4IsGrtr(eps, e);
+		const Vec4V recipLength0 = V4Sel(con0, zero, V4Recip(V4Sqrt(V4Sel(con0, one, a))));
+		const Vec4V recipLength1 = V4Sel(con1, zero, V4Recip(V4Sqrt(V4Sel(con1, one, e))));
+		const Vec3V4 dir0 = { V4Mul(d0.x, recipLength0), V4Mul(d0.y, recipLength0), V4Mul(d0.z, recipLength0) };
+		const Vec3V4 dir1 = { V4Mul(d1.x, recipLength1), V4Mul(d1.y, recipLength1), V4Mul(d1.z, recipLength1) };
+		const Vec4V cos = V4Abs(dot4(dir0, dir1));
+
+		// the parallel case outputs up to 4 contacts, these pairs go through the single-pair function
+		fallbackMask = BGetBitMask(V4IsGrtr(cos, parallelTolerance)) & mask;
+		mask &= ~fallbackMask;
+		if(!mask)
+			return 0;
+	}
+
+	const Vec3V4 closestA = scaleAdd4(d0, t0, s0);
+	const Vec3V4 closestB = scaleAdd4(d1, t1, s1);
+
+	const BoolV con = V4IsGrtr(eps, sqDist0);
+	const BoolV aCon = V4IsGrtr(a, eps);
+	const Vec3V4 delta = sub4(closestA, closestB);
+	const Vec3V4 _normal = {	V4Sel(con, V4Sel(aCon, d0.x, one), delta.x),
+								V4Sel(con, V4Sel(aCon, d0.y, zero), delta.y),
+								V4Sel(con, V4Sel(aCon, d0.z, zero), delta.z)	};
+
+	// see V3Normalize
+	const Vec4V recipLength = V4Recip(V4Sqrt(dot4(_normal, _normal)));
+	Vec3V4 normal = { V4Mul(_normal.x, recipLength), V4Mul(_normal.y, recipLength), V4Mul(_normal.z, recipLength) };
+
+	const Vec3V4 _point = negScaleSub4(normal, r0, closestA);
+	Vec3V4 point = { V4Add(_point.x, positionOffset.x), V4Add(_point.y, positionOffset.y), V4Add(_point.z, positionOffset.z) };
+	const Vec4V dist = V4Sel(con, zero, V4Sqrt(sqDist0));
+	const Vec4V pen = V4Sub(dist, sumRadius);
+
+	storeContacts(mask, point, normal, pen, contacts);
+	return mask;
+}
@@ -45,6 +45,14 @@ extern const bool g_CanUseContactCache[][PxGeometryType::eGEOMETRY_COUNT];
 extern PxcContactMethod g_PCMContactMethodTable[][PxGeometryType::eGEOMETRY_COUNT];
 
 extern const bool gEnablePCMCaching[][PxGeometryType::eGEOMETRY_COUNT];
+
+/*!
+Method prototype for batched contact generation routines, see Gu::PCMBatchPair
+*/
+typedef PxU32 (*PxcBatchContactMethod) (GU_BATCH_CONTACT_METHOD_ARGS);
+
+// Matrix of types, NULL for pairs that don't have a batched version
+extern const PxcBatchContactMethod g_PCMBatchContactMethodTable[PxGeometryType::eGEOMETRY_COUNT][PxGeometryType::eGEOMETRY_COUNT];
 }
 
 #endif
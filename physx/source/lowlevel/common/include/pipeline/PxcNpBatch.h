@@ -30,6 +30,7 @@
 #define PXC_NP_BATCH_H
 
 #include "PxvConfig.h"
+#include "geometry/PxGeometry.h"
 
 namespace physx
 {
@@ -44,6 +45,12 @@ namespace physx
 
 	void PxcDiscreteNarrowPhase(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, Gu::Cache& cache, PxsContactManagerOutput& output, PxU64 contextID);
 	void PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, Gu::Cache& cache, PxsContactManagerOutput& output, PxU64 contextID);
+
+	// batched version of PxcDiscreteNarrowPhasePCM, for 1 to PXC_NP_PCM_BATCH_SIZE pairs of the same geometry types.
+	// Only valid for geometry types for which PxcCanBatchNarrowPhasePCM returns true.
+	#define PXC_NP_PCM_BATCH_SIZE	4
+	bool PxcCanBatchNarrowPhasePCM(PxGeometryType::Enum type0, PxGeometryType::Enum type1);
+	void PxcDiscreteNarrowPhasePCMBatch(PxcNpThreadContext& context, const PxcNpWorkUnit* const* cmInputs, Gu::Cache* const* caches, PxsContactManagerOutput* const* outputs, PxU32 nb, PxU64 contextID);
 }
 
 #endif
@@ -440,4 +440,29 @@ PxcContactMethod g_PCMContactMethodTable[][PxGeometryType::eGEOMETRY_COUNT] =
 };
 PX_COMPILE_TIME_ASSERT(sizeof(g_PCMContactMethodTable) / sizeof(g_PCMContactMethodTable[0]) == PxGeometryType::eGEOMETRY_COUNT);
 
+// batched versions of the PCM contact methods, used by the type-sorted narrowphase (see PxcDiscreteNarrowPhasePCMBatch).
+// Only the simple pairs that don't use the persistent manifold are supported for now, the other entries are NULL.
+const PxcBatchContactMethod g_PCMBatchContactMethodTable[PxGeometryType::eGEOMETRY_COUNT][PxGeometryType::eGEOMETRY_COUNT] = 
+{
+	//PxGeometryType::eSPHERE
+	{
+		Gu::pcmContactSphereSphere4,		//PxGeometryType::eSPHERE
+		Gu::pcmContactSpherePlane4,			//PxGeometryType::ePLANE
+		Gu::pcmContactSphereCapsule4,		//PxGeometryType::eCAPSULE
+		Gu::pcmContactSphereBox4,			//PxGeometryType::eBOX
+	},
+
+	//PxGeometryType::ePLANE
+	{
+		0,									//PxGeometryType::eSPHERE
+	},
+
+	//PxGeometryType::eCAPSULE
+	{
+		0,									//PxGeometryType::eSPHERE
+		0,									//PxGeometryType::ePLANE
+		Gu::pcmContactCapsuleCapsule4,		//PxGeometryType::eCAPSULE
+	},
+};
+
 }
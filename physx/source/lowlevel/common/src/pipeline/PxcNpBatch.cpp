@@ -510,3 +510,132 @@ void physx::PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, const PxcNpWo
 	LOCAL_PROFILE_ZONE("PxcDiscreteNarrowPhasePCM", contextID);
 	discreteNarrowPhase<false>(context, input, cache, output, contextID);
 }
+
+PX_COMPILE_TIME_ASSERT(PXC_NP_PCM_BATCH_SIZE==GU_PCM_BATCH_SIZE);
+
+bool physx::PxcCanBatchNarrowPhasePCM(PxGeometryType::Enum type0, PxGeometryType::Enum type1)
+{
+	if(type1<type0)
+		PxSwap(type0, type1);
+	return g_PCMBatchContactMethodTable[type0][type1] != NULL;
+}
+
+// same as discreteNarrowPhase<false> for each pair, except the contact generation itself which is done for all pairs at
+// once by the batched contact method. The pairs we support here don't use the cache/manifold. The batched method outputs at
+// most one contact per pair, the pairs it reports in its fallback mask are processed by the single-pair contact method.
+void physx::PxcDiscreteNarrowPhasePCMBatch(PxcNpThreadContext& context, const PxcNpWorkUnit* const* inputs, Gu::Cache* const* caches, PxsContactManagerOutput* const* outputs, PxU32 nb, PxU64 contextID)
+{
+	LOCAL_PROFILE_ZONE("PxcDiscreteNarrowPhasePCMBatch", contextID);
+	PX_ASSERT(nb && nb<=PXC_NP_PCM_BATCH_SIZE);
+
+	Gu::PCMBatchPair pairs[PXC_NP_PCM_BATCH_SIZE];
+	PxsShapeCore* shapes0[PXC_NP_PCM_BATCH_SIZE];
+	PxsShapeCore* shapes1[PXC_NP_PCM_BATCH_SIZE];
+	PxU32 indices[PXC_NP_PCM_BATCH_SIZE];
+	bool flips[PXC_NP_PCM_BATCH_SIZE];
+	PxU32 nbPairs = 0;
+
+	PxGeometryType::Enum type0 = inputs[0]->getGeomType0();
+	PxGeometryType::Enum type1 = inputs[0]->getGeomType1();
+	if(type1<type0)
+		PxSwap(type0, type1);
+
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxcNpWorkUnit& input = *inputs[i];
+
+		const PxGeometryType::Enum inputType0 = input.getGeomType0();
+		const PxGeometryType::Enum inputType1 = input.getGeomType1();
+		const bool flip = (inputType1<inputType0);
+		PX_ASSERT(flip ? (inputType1==type0 && inputType0==type1) : (inputType0==type0 && inputType1==type1));
+
+		const PxsCachedTransform* cachedTransform0 = &context.mTransformCache->getTransformCache(input.mTransformCache0);
+		const PxsCachedTransform* cachedTransform1 = &context.mTransformCache->getTransformCache(input.mTransformCache1);
+
+		if(!checkContactsMustBeGenerated<false>(context, input, *caches[i], *outputs[i], cachedTransform0, cachedTransform1, flip, inputType0, inputType1))
+			continue;
+
+		PxsShapeCore* shape0 = const_cast<PxsShapeCore*>(input.getShapeCore0());
+		PxsShapeCore* shape1 = const_cast<PxsShapeCore*>(input.getShapeCore1());
+
+		if(flip)
+		{
+			PxSwap(shape0, shape1);
+			PxSwap(cachedTransform0, cachedTransform1);
+		}
+
+		Gu::PCMBatchPair& pair = pairs[nbPairs];
+		pair.mShape0 = &shape0->mGeometry.getGeometry();
+		pair.mShape1 = &shape1->mGeometry.getGeometry();
+		pair.mTransform0 = reinterpret_cast<const PxTransform32*>(cachedTransform0);
+		pair.mTransform1 = reinterpret_cast<const PxTransform32*>(cachedTransform1);
+		pair.mContactDistance = context.mNarrowPhaseParams.mContactDistance;	// computed by checkContactsMustBeGenerated
+		PX_ASSERT(pair.mTransform0->isSane() && pair.mTransform1->isSane());
+
+		shapes0[nbPairs] = shape0;
+		shapes1[nbPairs] = shape1;
+		indices[nbPairs] = i;
+		flips[nbPairs] = flip;
+		nbPairs++;
+	}
+
+	if(!nbPairs)
+		return;
+
+	PxContactPoint contacts[PXC_NP_PCM_BATCH_SIZE];
+	PxU32 mask, fallbackMask;
+	{
+		LOCAL_PROFILE_ZONE("conMethod", contextID);
+		const PxcBatchContactMethod conMethod = g_PCMBatchContactMethodTable[type0][type1];
+		PX_ASSERT(conMethod);
+		mask = conMethod(pairs, nbPairs, contacts, fallbackMask);
+		PX_ASSERT(!(mask & fallbackMask));
+	}
+
+	const PxcGetMaterialMethod materialMethod = g_GetMaterialMethodTable[type0][type1];
+
+	for(PxU32 j=0;j<nbPairs;j++)
+	{
+		const PxU32 i = indices[j];
+		PxsContactManagerOutput& output = *outputs[i];
+
+		updateDiscreteContactStats(context, type0, type1);
+
+		startContacts(output, context);
+
+		PxsMaterialInfo materialInfo[PxContactBuffer::MAX_CONTACTS];
+		if(mask & (1<<j))
+		{
+			context.mContactBuffer.contact(contacts[j]);
+		}
+		else if(fallbackMask & (1<<j))
+		{
+			LOCAL_PROFILE_ZONE("conMethod", contextID);
+			const PxcContactMethod conMethod = g_PCMContactMethodTable[type0][type1];
+			PX_ASSERT(conMethod);
+
+			const Gu::PCMBatchPair& pair = pairs[j];
+			context.mNarrowPhaseParams.mContactDistance = pair.mContactDistance;
+			conMethod(*pair.mShape0, *pair.mShape1, *pair.mTransform0, *pair.mTransform1, context.mNarrowPhaseParams, *caches[i], context.mContactBuffer, &context.mRenderOutput);
+		}
+
+		if(context.mContactBuffer.count)
+		{
+			if(materialMethod)
+			{
+				LOCAL_PROFILE_ZONE("materialMethod", contextID);
+				materialMethod(shapes0[j], shapes1[j], context.mContactBuffer, materialInfo);
+			}
+
+			if(flips[j])
+			{
+				LOCAL_PROFILE_ZONE("flipContacts", contextID);
+				flipContacts(context, materialInfo);
+			}
+		}
+
+		const bool isMeshType = type1 > PxGeometryType::eCONVEXMESH;
+		PX_ASSERT(!isMeshType);
+		finishContacts(*inputs[i], output, context, materialInfo, isMeshType, contextID);
+	}
+}
@@ -108,6 +108,15 @@ void PxsCMUpdateTask::release()
 
 static const bool gUseNewTaskAllocationScheme = false;
 
+// process the contact managers of each task sorted by geometry types, instead of in the broadphase order. This keeps the
+// same contact functions hot in the icache and makes the indirect calls predictable. With PCM, runs of simple pairs (sphere vs
+// sphere/plane/capsule/box, capsule vs capsule) are also processed 4 at a time by SoA contact functions (see
+// g_PCMBatchContactMethodTable).
+// The modifiable and patch-changed contact managers are still recorded in the original order, so that the contact modification
+// callback and the code consuming mPatchChangedCms see the same order as without sorting.
+static const bool gSortContactManagersByType = true;
+static const PxU8 gInvalidSortKey = 0xff;
+
 class PxsCMDiscreteUpdateTask : public PxsCMUpdateTask
 {
 public:
@@ -399,7 +408,128 @@ public:
 		maxPatches_ = maxPatches;
 	}
 
-	template < void (*NarrowPhase)(PxcNpThreadContext&, const PxcNpWorkUnit&, Gu::Cache&, PxsContactManagerOutput&, PxU64)>
+	// buckets the contact managers by (sorted) geometry types, so that pairs using the same contact function are processed
+	// together (see gSortContactManagersByType). This is a counting sort, it preserves the initial order within each bucket.
+	// Returns the number of non-null contact managers, whose indices are written to sortedIndices. Null ones get gInvalidSortKey.
+	PxU32 sortByGeometryTypes(PxU32* PX_RESTRICT sortedIndices, PxU8* PX_RESTRICT keys) const
+	{
+		const PxU32 nbTypes = PxGeometryType::eGEOMETRY_COUNT;
+		PX_COMPILE_TIME_ASSERT(nbTypes*nbTypes < gInvalidSortKey);
+
+		PxU32 offsets[nbTypes*nbTypes];
+		PxMemZero(offsets, sizeof(offsets));
+
+		const PxU32 nb = mCmCount;
+		PxU32 nbValid = 0;
+		for(PxU32 i=0;i<nb;i++)
+		{
+			const PxsContactManager* cm = mCmArray[i];
+			if(!cm)
+			{
+				keys[i] = gInvalidSortKey;
+				continue;
+			}
+
+			const PxcNpWorkUnit& unit = cm->getWorkUnit();
+			const PxU32 type0 = unit.getGeomType0();
+			const PxU32 type1 = unit.getGeomType1();
+			const PxU8 key = PxTo8(PxMin(type0, type1) * nbTypes + PxMax(type0, type1));
+			keys[i] = key;
+			offsets[key]++;
+			nbValid++;
+		}
+
+		PxU32 offset = 0;
+		for(PxU32 i=0;i<nbTypes*nbTypes;i++)
+		{
+			const PxU32 count = offsets[i];
+			offsets[i] = offset;
+			offset += count;
+		}
+
+		for(PxU32 i=0;i<nb;i++)
+		{
+			if(keys[i]!=gInvalidSortKey)
+				sortedIndices[offsets[keys[i]]++] = i;
+		}
+		return nbValid;
+	}
+
+	PX_FORCE_INLINE void prefetchCm(PxcNpThreadContext* threadContext, PxU32 prefetch1, PxU32 prefetch2)
+	{
+		PxsContactManager** PX_RESTRICT cmArray = mCmArray;
+
+		PxPrefetchLine(cmArray[prefetch2]);
+		PxPrefetchLine(&mCmOutputs[prefetch2]);
+		if(cmArray[prefetch1])
+		{
+			const PxcNpWorkUnit& unit = cmArray[prefetch1]->getWorkUnit();
+			PxPrefetchLine(unit.getShapeCore0());
+			PxPrefetchLine(unit.getShapeCore1());
+			PxPrefetchLine(&threadContext->mTransformCache->getTransformCache(unit.mTransformCache0));
+			PxPrefetchLine(&threadContext->mTransformCache->getTransformCache(unit.mTransformCache1));
+		}
+	}
+
+	// per-CM work done after the narrowphase function has been called, recording the CMs whose contacts are modifiable or
+	// whose number of patches changed. The outputs depend on the order in which this is called, which must be the CM order.
+	// The local counters are passed by reference to avoid reading/writing class members N times.
+	PX_FORCE_INLINE void recordCmOutput(PxU32 i, PxU32* modifiableIndices, PxU32& modifiableCount, PxU32& maxPatches)
+	{
+		PxsContactManager* const cm = mCmArray[i];
+		const PxsContactManagerOutput& output = mCmOutputs[i];
+		const PxcNpWorkUnit& unit = cm->getWorkUnit();
+
+		const bool modifiable = output.nbPatches != 0 && unit.mFlags & PxcNpWorkUnitFlag::eMODIFIABLE_CONTACT;
+
+		if(modifiable)
+		{
+			modifiableIndices[modifiableCount++] = i;
+		}
+		else
+		{
+			maxPatches = PxMax(maxPatches, PxTo32(output.nbPatches));
+
+			if(output.prevPatches != output.nbPatches)
+			{
+				mPatchChangedCms[mNbPatchChanged] = cm;
+				PxsContactManagerOutputCounts& counts = mPatchChangedOutputCounts[mNbPatchChanged++];
+				counts.nbPatches = output.nbPatches;
+				counts.prevPatches = output.prevPatches;
+				counts.statusFlag = output.statusFlag;
+				//counts.nbContacts = output.nbContacts;
+			}
+		}
+	}
+
+	// per-CM work done after the narrowphase function has been called, updating the touch status. This does not depend on the
+	// order in which the CMs are processed.
+	PX_FORCE_INLINE void updateCmTouchStatus(PxU32 i, PxU8 oldStatusFlag, PxBitMap& localChangeTouchCM, PxU32& newTouchCMCount, PxU32& lostTouchCMCount)
+	{
+		PxsContactManager* const cm = mCmArray[i];
+		const PxsContactManagerOutput& output = mCmOutputs[i];
+		PxcNpWorkUnit& unit = cm->getWorkUnit();
+
+		const PxU8 oldTouch = PxTo8(oldStatusFlag & PxsContactManagerStatusFlag::eHAS_TOUCH);
+
+		const PxU16 newTouch = PxTo8(output.statusFlag & PxsContactManagerStatusFlag::eHAS_TOUCH);
+
+		if (newTouch ^ oldTouch)
+		{
+			unit.mStatusFlags = PxU8(output.statusFlag | (unit.mStatusFlags & PxcNpWorkUnitStatusFlag::eREFRESHED_WITH_TOUCH));  //KS - todo - remove the need to access the work unit at all!
+			localChangeTouchCM.growAndSet(cm->getIndex());
+			if(newTouch)
+				newTouchCMCount++;
+			else
+				lostTouchCMCount++;
+		}
+		else if (!(oldStatusFlag&PxsContactManagerStatusFlag::eTOUCH_KNOWN))
+		{
+			unit.mStatusFlags = PxU8(output.statusFlag | (unit.mStatusFlags & PxcNpWorkUnitStatusFlag::eREFRESHED_WITH_TOUCH));  //KS - todo - remove the need to access the work unit at all!
+		}
+	}
+
+	template < void (*NarrowPhase)(PxcNpThreadContext&, const PxcNpWorkUnit&, Gu::Cache&, PxsContactManagerOutput&, PxU64), bool batchedPCM>
 	void processCms(PxcNpThreadContext* threadContext)
 	{
 		const PxU64 contextID = mContext->getContextId();
@@ -417,70 +547,90 @@ public:
 		PX_ALLOCA(modifiableIndices, PxU32, nb);
 		PxU32 modifiableCount = 0;
 
-		for(PxU32 i=0;i<nb;i++)
+		if(gSortContactManagersByType)
 		{
-			const PxU32 prefetch1 = PxMin(i + 1, nb - 1);
-			const PxU32 prefetch2 = PxMin(i + 2, nb - 1);
+			PX_ASSERT(nb<=BATCH_SIZE);
+			PxU32 sortedIndices[BATCH_SIZE];
+			PxU8 keys[BATCH_SIZE];
+			const PxU32 nbSorted = sortByGeometryTypes(sortedIndices, keys);
 
-			PxPrefetchLine(cmArray[prefetch2]);
-			PxPrefetchLine(&mCmOutputs[prefetch2]);
-			PxPrefetchLine(cmArray[prefetch1]->getWorkUnit().getShapeCore0());
-			PxPrefetchLine(cmArray[prefetch1]->getWorkUnit().getShapeCore1());
-			PxPrefetchLine(&threadContext->mTransformCache->getTransformCache(cmArray[prefetch1]->getWorkUnit().mTransformCache0));
-			PxPrefetchLine(&threadContext->mTransformCache->getTransformCache(cmArray[prefetch1]->getWorkUnit().mTransformCache1));
+			for(PxU32 k=0;k<nbSorted;)
+			{
+				const PxU32 i = sortedIndices[k];
 
-			PxsContactManager* const cm = cmArray[i];			
+				if(batchedPCM)
+				{
+					// gather a run of pairs with the same types and process them with the batched contact method, if any
+					const PxcNpWorkUnit& unit = cmArray[i]->getWorkUnit();
+					if(PxcCanBatchNarrowPhasePCM(unit.getGeomType0(), unit.getGeomType1()))
+					{
+						PxU32 n = 1;
+						while(n<PXC_NP_PCM_BATCH_SIZE && k+n<nbSorted && keys[sortedIndices[k+n]]==keys[i])
+							n++;
 
-			if(cm)
-			{
-				PxsContactManagerOutput& output = mCmOutputs[i];
-				PxcNpWorkUnit& unit = cm->getWorkUnit();
+						prefetchCm(threadContext, sortedIndices[PxMin(k + n, nbSorted - 1)], sortedIndices[PxMin(k + n + 1, nbSorted - 1)]);
 
-				output.prevPatches = output.nbPatches;
+						const PxcNpWorkUnit* units[PXC_NP_PCM_BATCH_SIZE];
+						Gu::Cache* caches[PXC_NP_PCM_BATCH_SIZE];
+						PxsContactManagerOutput* outputs[PXC_NP_PCM_BATCH_SIZE];
+						PxU8 oldStatusFlags[PXC_NP_PCM_BATCH_SIZE];
+						for(PxU32 j=0;j<n;j++)
+						{
+							const PxU32 index = sortedIndices[k+j];
+							PxsContactManagerOutput& output = mCmOutputs[index];
+							output.prevPatches = output.nbPatches;
+							oldStatusFlags[j] = output.statusFlag;
+
+							units[j] = &cmArray[index]->getWorkUnit();
+							caches[j] = &mCaches[index];
+							outputs[j] = &output;
+						}
+
+						PxcDiscreteNarrowPhasePCMBatch(*threadContext, units, caches, outputs, n, contextID);
+
+						for(PxU32 j=0;j<n;j++)
+							updateCmTouchStatus(sortedIndices[k+j], oldStatusFlags[j], localChangeTouchCM, newTouchCMCount, lostTouchCMCount);
 
+						k += n;
+						continue;
+					}
+				}
+
+				prefetchCm(threadContext, sortedIndices[PxMin(k + 1, nbSorted - 1)], sortedIndices[PxMin(k + 2, nbSorted - 1)]);
+
+				PxsContactManagerOutput& output = mCmOutputs[i];
+				output.prevPatches = output.nbPatches;
 				const PxU8 oldStatusFlag = output.statusFlag;
 
-				const PxU8 oldTouch = PxTo8(oldStatusFlag & PxsContactManagerStatusFlag::eHAS_TOUCH);
+				NarrowPhase(*threadContext, cmArray[i]->getWorkUnit(), mCaches[i], output, contextID);
 
-				Gu::Cache& cache = mCaches[i];
+				updateCmTouchStatus(i, oldStatusFlag, localChangeTouchCM, newTouchCMCount, lostTouchCMCount);
+				k++;
+			}
 
-				NarrowPhase(*threadContext, unit, cache, output, contextID);
-				
-				const PxU16 newTouch = PxTo8(output.statusFlag & PxsContactManagerStatusFlag::eHAS_TOUCH);
-				
-				const bool modifiable = output.nbPatches != 0 && unit.mFlags & PxcNpWorkUnitFlag::eMODIFIABLE_CONTACT;
+			// sortedIndices only contains the non-null CMs, so go back to the CM order and skip the null ones
+			for(PxU32 i=0;i<nb;i++)
+			{
+				if(keys[i]!=gInvalidSortKey)
+					recordCmOutput(i, modifiableIndices, modifiableCount, maxPatches);
+			}
+		}
+		else
+		{
+			for(PxU32 i=0;i<nb;i++)
+			{
+				prefetchCm(threadContext, PxMin(i + 1, nb - 1), PxMin(i + 2, nb - 1));
 
-				if(modifiable)
-				{
-					modifiableIndices[modifiableCount++] = i;
-				}
-				else
+				if(cmArray[i])
 				{
-					maxPatches = PxMax(maxPatches, PxTo32(output.nbPatches));
+					PxsContactManagerOutput& output = mCmOutputs[i];
+					output.prevPatches = output.nbPatches;
+					const PxU8 oldStatusFlag = output.statusFlag;
 
-					if(output.prevPatches != output.nbPatches)
-					{
-						mPatchChangedCms[mNbPatchChanged] = cm;
-						PxsContactManagerOutputCounts& counts = mPatchChangedOutputCounts[mNbPatchChanged++];
-						counts.nbPatches = output.nbPatches;
-						counts.prevPatches = output.prevPatches;
-						counts.statusFlag = output.statusFlag;
-						//counts.nbContacts = output.nbContacts;
-					}
-				}
+					NarrowPhase(*threadContext, cmArray[i]->getWorkUnit(), mCaches[i], output, contextID);
 
-				if (newTouch ^ oldTouch)
-				{
-					unit.mStatusFlags = PxU8(output.statusFlag | (unit.mStatusFlags & PxcNpWorkUnitStatusFlag::eREFRESHED_WITH_TOUCH));  //KS - todo - remove the need to access the work unit at all!
-					localChangeTouchCM.growAndSet(cmArray[i]->getIndex());
-					if(newTouch)
-						newTouchCMCount++;
-					else
-						lostTouchCMCount++;
-				}
-				else if (!(oldStatusFlag&PxsContactManagerStatusFlag::eTOUCH_KNOWN))
-				{
-					unit.mStatusFlags = PxU8(output.statusFlag | (unit.mStatusFlags & PxcNpWorkUnitStatusFlag::eREFRESHED_WITH_TOUCH));  //KS - todo - remove the need to access the work unit at all!
+					recordCmOutput(i, modifiableIndices, modifiableCount, maxPatches);
+					updateCmTouchStatus(i, oldStatusFlag, localChangeTouchCM, newTouchCMCount, lostTouchCMCount);
 				}
 			}
 		}
@@ -510,9 +660,9 @@ public:
 		threadContext->mContactDistances = mContext->getContactDistances();
 
 		if(pcm)
-			processCms<PxcDiscreteNarrowPhasePCM>(threadContext);
+			processCms<PxcDiscreteNarrowPhasePCM, true>(threadContext);
 		else
-			processCms<PxcDiscreteNarrowPhase>(threadContext);
+			processCms<PxcDiscreteNarrowPhase, false>(threadContext);
 
 		mContext->putNpThreadContext(threadContext);
 	}
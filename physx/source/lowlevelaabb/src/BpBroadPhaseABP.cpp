@@ -42,15 +42,22 @@
 #include "foundation/PxThread.h"
 #include "foundation/PxSync.h"
 #include "task/PxTask.h"
+#include "task/PxTaskManager.h"
 
 using namespace physx;
 using namespace aos;
 using namespace Bp;
 using namespace Cm;
 
+// dispatcher used to sort large updates in parallel, NULL when running single-threaded
+static PX_FORCE_INLINE PxCpuDispatcher* getCpuDispatcher(PxBaseTask* continuation)
+{
+	return continuation ? continuation->getTaskManager()->getCpuDispatcher() : NULL;
+}
+
 /*
 PT: to try:
-- prepare data: sort & compute bounds in parallel? or just MT the last loop?
+- prepare data: compute bounds in parallel? or just MT the last loop?
 - switch post update & add delayed pairs?
 - MT computeCreatedDeletedPairs
 
@@ -988,7 +995,7 @@ void ABP_SharedData::resize(BpHandle userID)
 						void				removeObject(ABPEntry& object, BpHandle userID);
 						void				updateObject(ABPEntry& object, BpHandle userID);
 
-						void				prepareData(RadixSortBuffered& rs, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxU64 contextID);
+						void				prepareData(RadixSortMT& sorterMT, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxCpuDispatcher* dispatcher, PxU64 contextID);
 
 //		PX_FORCE_INLINE	PxU32				isThereWorkToDo()		const	{ return mNbUpdated;	}
 		PX_FORCE_INLINE	bool				isThereWorkToDo()		const	{ return mNbUpdated || mNbRemovedSleeping;	}	// PT: temp & test, maybe we do that differently in the end
@@ -1341,7 +1348,7 @@ static PX_FORCE_INLINE PosXType2 getNextCandidateNonSorted(PxU32 offsetNonSorted
 }
 
 PX_COMPILE_TIME_ASSERT(sizeof(BpHandle)==sizeof(float));
-void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxU64 contextID)
+void BoxManager::prepareData(RadixSortMT& sorterMT, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxCpuDispatcher* dispatcher, PxU64 contextID)
 {
 	PX_UNUSED(contextID);
 
@@ -1656,12 +1663,21 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 		CHECKPOINT("Create updated objects\n");
 
 		// PT: we need to sort here because we reuse the "keys" buffer just afterwards
-		PxU32* ranks0 = reinterpret_cast<PxU32*>(memoryManager.frameAlloc(sizeof(PxU32)*nbUpdated));
-		PxU32* ranks1 = reinterpret_cast<PxU32*>(memoryManager.frameAlloc(sizeof(PxU32)*nbUpdated));
-
-		StackRadixSort(rs, ranks0, ranks1);
+		// large updates are sorted in parallel with the persistent sorter, small ones with the usual stack sorter.
+		PxU32* ranks0 = NULL;
+		PxU32* ranks1 = NULL;
 		const PxU32* sorted;
+		if(dispatcher && nbUpdated>=RADIX_SORT_MT_MIN_SIZE)
 		{
+			PX_PROFILE_ZONE("SortMT", contextID);
+			sorted = sorterMT.Sort(keys, nbUpdated, dispatcher).GetRanks();
+		}
+		else
+		{
+			ranks0 = reinterpret_cast<PxU32*>(memoryManager.frameAlloc(sizeof(PxU32)*nbUpdated));
+			ranks1 = reinterpret_cast<PxU32*>(memoryManager.frameAlloc(sizeof(PxU32)*nbUpdated));
+
+			StackRadixSort(rs, ranks0, ranks1);
 			PX_PROFILE_ZONE("Sort", contextID);
 			sorted = rs.Sort(keys, nbUpdated).GetRanks();
 		}
@@ -1732,8 +1748,11 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 		StoreBounds(mUpdatedBounds, minV, maxV)
 #endif
 #ifndef TEST_PERSISTENT_MEMORY
-		memoryManager.frameFree(ranks1);
-		memoryManager.frameFree(ranks0);
+		if(ranks0)
+		{
+			memoryManager.frameFree(ranks1);
+			memoryManager.frameFree(ranks0);
+		}
 #endif
 	}
 	else
@@ -1799,6 +1818,34 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 	};
 
 	class ABP_CompleteBoxPruningStartTask;
+	class ABP_CompleteBoxPruningTask;
+
+	// large box pruning tasks are split into this many ranges at most, each range being at least ABP_MIN_RANGE_SIZE
+	// boxes. The ranges are sorted-index ranges of the outer loop, with their own pair buffers. The tasks for the
+	// extra ranges are allocated from the frame's scratch memory when needed, and released once their pairs are added.
+	#define ABP_MAX_NB_RANGES	16
+	#define ABP_MIN_RANGE_SIZE	2048
+
+	class ABP_BoxPruningRangeTask : public PxLightCpuTask
+	{
+	public:
+							ABP_BoxPruningRangeTask() : mParent(NULL), mRangeIndex(0)	{}
+
+		virtual	const char* getName()	const	PX_OVERRIDE
+		{
+			return "ABP_BoxPruningRangeTask";
+		}
+
+		virtual void run()	PX_OVERRIDE;
+
+		virtual bool	isHighPriority()	const	PX_OVERRIDE	{ return true; }
+
+		ABP_CompleteBoxPruningTask*	mParent;
+		PxU32						mRangeIndex;
+
+		PairManagerMT				mPairs;
+		PairManagerMT				mPairsSwapped;
+	};
 
 	class ABP_CompleteBoxPruningTask : public PxLightCpuTask
 	{
@@ -1806,7 +1853,10 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 							ABP_CompleteBoxPruningTask() :
 								mStartTask(NULL),
 								mType(0),
-								mID(0)
+								mID(0),
+								mMM(NULL),
+								mNbRanges(1),
+								mRangeTasks(NULL)
 							{
 							}
 
@@ -1835,6 +1885,10 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 		const PxU32*			mRemap4;
 
 		PairManagerMT			mPairs;
+		PairManagerMT			mPairsSwapped;	// Pairs from the second bipartite pass, kept apart to preserve the pair order
+		ABP_MM*					mMM;
+		PxU32					mNbRanges;
+		ABP_BoxPruningRangeTask*	mRangeTasks;	// mNbRanges-1 tasks for the extra ranges, or NULL
 
 		PX_FORCE_INLINE	bool	isThereWorkToDo()	const
 		{
@@ -1846,6 +1900,13 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 
 			return true;
 		}
+
+				void			runRange(PairManagerMT& pairs, PairManagerMT& pairsSwapped, PxU32 rangeIndex);
+				void			releaseRangeTasks();
+				void			resetDelayedPairs();
+				PxU32			getNbDelayedPairs()	const;
+				void			addDelayedPairs(ABP_PairManager& pairManager)	const;
+				void			addDelayedPairs2(ABP_PairManager& pairManager, PxArray<BroadPhasePair>& createdPairs)	const;
 	};
 
 	class ABP_CompleteBoxPruningEndTask : public PxLightCpuTask
@@ -1887,6 +1948,7 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 
 		void	addDelayedPairs();
 		void	addDelayedPairs2(PxArray<BroadPhasePair>& createdPairs);
+		void	releaseRangeTasks();
 		
 		virtual void run()	PX_OVERRIDE;
 
@@ -1937,12 +1999,12 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 
 						void					setTransientData(const PxBounds3* bounds, const PxReal* contactDistance);
 
-						void					Region_prepareOverlaps();
+						void					Region_prepareOverlaps(PxCpuDispatcher* dispatcher);
 
 						ABP_MM					mMM;
 						BoxManager				mSBM;
 						DynamicManager			mDBM;
-						RadixSortBuffered		mRS;
+						RadixSortMT				mRS;
 						DynamicManager			mKBM;
 						ABP_SharedData			mShared;
 						ABP_PairManager			mPairManager;
@@ -1956,6 +2018,7 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 
 						void					addDelayedPairs();
 						void					addDelayedPairs2(PxArray<BroadPhasePair>& createdPairs);
+						void					releaseRangeTasks();
 #endif
 	};
 
@@ -2268,8 +2331,10 @@ static PX_FORCE_INLINE void outputPair(ABP_PairManager& pairManager, PxU32 index
 	pairManager.addPair(index0, index1);
 }
 
+// the outer loop runs over [start0, nb0[ so that it can be split into ranges processed in parallel. The inner running
+// index only depends on the current outer box, so each range finds the same pairs as the corresponding part of a full run.
 template<const int codepath, class ABP_PairManagerT>
-static void boxPruningKernel(	PxU32 nb0, PxU32 nb1,
+static void boxPruningKernel(	PxU32 start0, PxU32 nb0, PxU32 nb1,
 								const SIMD_AABB_X4* PX_RESTRICT boxes0_X, const SIMD_AABB_X4* PX_RESTRICT boxes1_X,
 								const SIMD_AABB_YZ4* PX_RESTRICT boxes0_YZ, const SIMD_AABB_YZ4* PX_RESTRICT boxes1_YZ,
 								const ABP_Index* PX_RESTRICT inToOut0, const ABP_Index* PX_RESTRICT inToOut1,
@@ -2278,7 +2343,7 @@ static void boxPruningKernel(	PxU32 nb0, PxU32 nb1,
 	pairManager->mInToOut0 = inToOut0;
 	pairManager->mInToOut1 = inToOut1;
 
-	PxU32 index0 = 0;
+	PxU32 index0 = start0;
 	PxU32 runningIndex1 = 0;
 
 	while(runningIndex1<nb1 && index0<nb0)
@@ -2435,8 +2500,8 @@ static /*PX_FORCE_INLINE*/ void doBipartiteBoxPruning_Leaf(
 {
 	PX_ASSERT(boxes0_X[nb0].isSentinel());
 	PX_ASSERT(boxes1_X[nb1].isSentinel());
-	boxPruningKernel<0>(nb0, nb1, boxes0_X, boxes1_X, boxes0_YZ, boxes1_YZ, remap0, remap1, pairManager);
-	boxPruningKernel<1>(nb1, nb0, boxes1_X, boxes0_X, boxes1_YZ, boxes0_YZ, remap1, remap0, pairManager);
+	boxPruningKernel<0>(0, nb0, nb1, boxes0_X, boxes1_X, boxes0_YZ, boxes1_YZ, remap0, remap1, pairManager);
+	boxPruningKernel<1>(0, nb1, nb0, boxes1_X, boxes0_X, boxes1_YZ, boxes0_YZ, remap1, remap0, pairManager);
 }
 
 template<class ABP_PairManagerT>
@@ -2446,18 +2511,29 @@ static PX_FORCE_INLINE void doBipartiteBoxPruning_Leaf(ABP_PairManagerT* PX_REST
 	doBipartiteBoxPruning_Leaf(pairManager, nb0, nb1, boxes0.getBoxes_X(), boxes1.getBoxes_X(), boxes0.getBoxes_YZ(), boxes1.getBoxes_YZ(), remap0, remap1);
 }
 
+// processes boxes [start, end[ against all boxes. Unlike in the bipartite kernel, the running index here depends on
+// the whole history of the loop when several boxes share the same min, so for a range that does not start at 0 we first
+// replay the running index updates of the previous boxes. This is cheap compared to the overlap tests and guarantees
+// that splitting the loop into ranges finds exactly the same pairs as a single run, i.e. no pair is reported twice.
 template<class ABP_PairManagerT>
-static void doCompleteBoxPruning_Leaf(	ABP_PairManagerT* PX_RESTRICT pairManager, PxU32 nb,
+static void doCompleteBoxPruning_Range(	ABP_PairManagerT* PX_RESTRICT pairManager, PxU32 nb,
 										const SIMD_AABB_X4* PX_RESTRICT boxes_X,
 										const SIMD_AABB_YZ4* PX_RESTRICT boxes_YZ,
-										const ABP_Index* PX_RESTRICT remap)
+										const ABP_Index* PX_RESTRICT remap,
+										PxU32 start, PxU32 end)
 {
 	pairManager->mInToOut0 = remap;
 	pairManager->mInToOut1 = remap;
 
-	PxU32 index0 = 0;
 	PxU32 runningIndex = 0;
-	while(runningIndex<nb && index0<nb)
+	for(PxU32 i=0;i<start && runningIndex<nb;i++)
+	{
+		const PosXType2 minLimit = boxes_X[i].mMinX;
+		while(boxes_X[runningIndex++].mMinX<minLimit);
+	}
+
+	PxU32 index0 = start;
+	while(runningIndex<nb && index0<end)
 	{
 		const SIMD_AABB_X4& box0_X = boxes_X[index0];
 		const PosXType2 maxLimit = box0_X.mMaxX;
@@ -2592,6 +2668,15 @@ StartLoop:
 	}
 }
 
+template<class ABP_PairManagerT>
+static PX_FORCE_INLINE void doCompleteBoxPruning_Leaf(	ABP_PairManagerT* PX_RESTRICT pairManager, PxU32 nb,
+														const SIMD_AABB_X4* PX_RESTRICT boxes_X,
+														const SIMD_AABB_YZ4* PX_RESTRICT boxes_YZ,
+														const ABP_Index* PX_RESTRICT remap)
+{
+	doCompleteBoxPruning_Range(pairManager, nb, boxes_X, boxes_YZ, remap, 0, nb);
+}
+
 #ifdef USE_ABP_BUCKETS
 static const PxU8 gCodes[] = {	4, 4, 4, 255, 4, 3, 2, 255,
 								4, 1, 0, 255, 255, 255, 255, 255 };
@@ -2753,6 +2838,11 @@ static void CompleteBoxPruning_Recursive(
 #endif
 
 #ifdef ABP_MT2
+static PX_FORCE_INLINE PxU32 getRangeStart(PxU32 nb, PxU32 rangeIndex, PxU32 nbRanges)
+{
+	return PxU32((PxU64(nb)*rangeIndex)/nbRanges);
+}
+
 void ABP_CompleteBoxPruningTask::run()
 {
 //	printf("Running ABP_CompleteBoxPruningTask\n");
@@ -2760,23 +2850,118 @@ void ABP_CompleteBoxPruningTask::run()
 	//printf("ABP_Task_%d - thread ID %d\n", mID, PxU32(PxThread::getId()));
 	//printf("Count: %d\n", mCounter);
 
-	bool runComplete = false;
-	bool runBipartite = false;
+	// split large tasks so that one big pass (e.g. active dynamics vs sleeping statics) does not end up on a single
+	// thread. Each range writes to its own buffers and the buffers are merged in range order, so the final pairs and
+	// their order do not depend on the number of ranges.
+	PxU32 nbRanges = 1;
+	{
+		const PxU32 nbBoxes = mType ? PxMax(mCounter, mCounter4) : mCounter;
+		const PxU32 nbThreads = getTaskManager()->getCpuDispatcher()->getWorkerCount() + 1;
+		nbRanges = PxMax(PxMin(PxMin(nbBoxes/ABP_MIN_RANGE_SIZE, nbThreads), PxU32(ABP_MAX_NB_RANGES)), PxU32(1));
+	}
+	PX_ASSERT(!mRangeTasks);
+	if(nbRanges>1)
+	{
+		mRangeTasks = reinterpret_cast<ABP_BoxPruningRangeTask*>(mMM->frameAlloc(sizeof(ABP_BoxPruningRangeTask)*(nbRanges-1)));
+		for(PxU32 i=1;i<nbRanges;i++)
+			PX_PLACEMENT_NEW(&mRangeTasks[i-1], ABP_BoxPruningRangeTask)();
+	}
+	mNbRanges = nbRanges;
+
+	mPairsSwapped.mSharedPM = mPairs.mSharedPM;
+
+	for(PxU32 i=1;i<nbRanges;i++)
+	{
+		ABP_BoxPruningRangeTask& task = mRangeTasks[i-1];
+		task.mParent = this;
+		task.mRangeIndex = i;
+		task.mPairs.mSharedPM = mPairs.mSharedPM;
+		task.mPairsSwapped.mSharedPM = mPairs.mSharedPM;
+		task.setContextId(getContextId());
+		task.setContinuation(getContinuation());
+	}
+
+	for(PxU32 i=1;i<nbRanges;i++)
+		mRangeTasks[i-1].removeReference();
+
+	runRange(mPairs, mPairsSwapped, 0);
+}
+
+void ABP_CompleteBoxPruningTask::runRange(PairManagerMT& pairs, PairManagerMT& pairsSwapped, PxU32 rangeIndex)
+{
+	const PxU32 nbRanges = mNbRanges;
 
 	if(mType==0)
-		runComplete = true;
+	{
+		const PxU32 start = getRangeStart(mCounter, rangeIndex, nbRanges);
+		const PxU32 end = getRangeStart(mCounter, rangeIndex+1, nbRanges);
+		doCompleteBoxPruning_Range(&pairs, mCounter, mBoxListX, mBoxListYZ, mRemap, start, end);
+	}
 	else
-		runBipartite = true;
+	{
+		PX_ASSERT(mBoxListX[mCounter].isSentinel());
+		PX_ASSERT(mBoxListX4[mCounter4].isSentinel());
+
+		const PxU32 start0 = getRangeStart(mCounter, rangeIndex, nbRanges);
+		const PxU32 end0 = getRangeStart(mCounter, rangeIndex+1, nbRanges);
+		boxPruningKernel<0>(start0, end0, mCounter4, mBoxListX, mBoxListX4, mBoxListYZ, mBoxListYZ4, mRemap, mRemap4, &pairs);
 
-	if(runComplete)
-		doCompleteBoxPruning_Leaf(&mPairs, mCounter, mBoxListX, mBoxListYZ, mRemap);
+		const PxU32 start1 = getRangeStart(mCounter4, rangeIndex, nbRanges);
+		const PxU32 end1 = getRangeStart(mCounter4, rangeIndex+1, nbRanges);
+		boxPruningKernel<1>(start1, end1, mCounter, mBoxListX4, mBoxListX, mBoxListYZ4, mBoxListYZ, mRemap4, mRemap, &pairsSwapped);
+	}
+}
 
-	if(runBipartite)
-		doBipartiteBoxPruning_Leaf(&mPairs,
-									mCounter, mCounter4,
-									mBoxListX, mBoxListX4,
-									mBoxListYZ, mBoxListYZ4,
-									mRemap, mRemap4);
+void ABP_CompleteBoxPruningTask::releaseRangeTasks()
+{
+	if(mRangeTasks)
+	{
+		for(PxU32 i=1;i<mNbRanges;i++)
+			mRangeTasks[i-1].~ABP_BoxPruningRangeTask();
+		mMM->frameFree(mRangeTasks);
+		mRangeTasks = NULL;
+	}
+	mNbRanges = 1;
+}
+
+void ABP_CompleteBoxPruningTask::resetDelayedPairs()
+{
+	mPairs.mDelayedPairs.resetOrClear();
+	mPairsSwapped.mDelayedPairs.resetOrClear();
+	releaseRangeTasks();
+}
+
+PxU32 ABP_CompleteBoxPruningTask::getNbDelayedPairs() const
+{
+	PxU32 nb = mPairs.mDelayedPairs.size() + mPairsSwapped.mDelayedPairs.size();
+	for(PxU32 i=1;i<mNbRanges;i++)
+		nb += mRangeTasks[i-1].mPairs.mDelayedPairs.size() + mRangeTasks[i-1].mPairsSwapped.mDelayedPairs.size();
+	return nb;
+}
+
+void ABP_CompleteBoxPruningTask::addDelayedPairs(ABP_PairManager& pairManager) const
+{
+	pairManager.addDelayedPairs(mPairs.mDelayedPairs);
+	for(PxU32 i=1;i<mNbRanges;i++)
+		pairManager.addDelayedPairs(mRangeTasks[i-1].mPairs.mDelayedPairs);
+	pairManager.addDelayedPairs(mPairsSwapped.mDelayedPairs);
+	for(PxU32 i=1;i<mNbRanges;i++)
+		pairManager.addDelayedPairs(mRangeTasks[i-1].mPairsSwapped.mDelayedPairs);
+}
+
+void ABP_CompleteBoxPruningTask::addDelayedPairs2(ABP_PairManager& pairManager, PxArray<BroadPhasePair>& createdPairs) const
+{
+	pairManager.addDelayedPairs2(createdPairs, mPairs.mDelayedPairs);
+	for(PxU32 i=1;i<mNbRanges;i++)
+		pairManager.addDelayedPairs2(createdPairs, mRangeTasks[i-1].mPairs.mDelayedPairs);
+	pairManager.addDelayedPairs2(createdPairs, mPairsSwapped.mDelayedPairs);
+	for(PxU32 i=1;i<mNbRanges;i++)
+		pairManager.addDelayedPairs2(createdPairs, mRangeTasks[i-1].mPairsSwapped.mDelayedPairs);
+}
+
+void ABP_BoxPruningRangeTask::run()
+{
+	mParent->runRange(mPairs, mPairsSwapped, mRangeIndex);
 }
 
 void ABP_CompleteBoxPruningEndTask::run()
@@ -2988,7 +3173,7 @@ void ABP_CompleteBoxPruningStartTask::addDelayedPairs()
 
 	PxU32 nbDelayedPairs = 0;
 	for(PxU32 k=0; k<9; k++)
-		nbDelayedPairs += mTasks[k].mPairs.mDelayedPairs.size();
+		nbDelayedPairs += mTasks[k].getNbDelayedPairs();
 
 	if(nbDelayedPairs)
 	{
@@ -2998,7 +3183,7 @@ void ABP_CompleteBoxPruningStartTask::addDelayedPairs()
 		}
 
 		for(PxU32 k=0; k<9; k++)
-			mPairManager->addDelayedPairs(mTasks[k].mPairs.mDelayedPairs);
+			mTasks[k].addDelayedPairs(*mPairManager);
 	}
 }
 
@@ -3008,7 +3193,7 @@ void ABP_CompleteBoxPruningStartTask::addDelayedPairs2(PxArray<BroadPhasePair>&
 
 	PxU32 nbDelayedPairs = 0;
 	for(PxU32 k=0; k<9; k++)
-		nbDelayedPairs += mTasks[k].mPairs.mDelayedPairs.size();
+		nbDelayedPairs += mTasks[k].getNbDelayedPairs();
 
 	if(nbDelayedPairs)
 	{
@@ -3018,9 +3203,15 @@ void ABP_CompleteBoxPruningStartTask::addDelayedPairs2(PxArray<BroadPhasePair>&
 		}
 
 		for(PxU32 k=0; k<9; k++)
-			mPairManager->addDelayedPairs2(createdPairs, mTasks[k].mPairs.mDelayedPairs);
+			mTasks[k].addDelayedPairs2(*mPairManager, createdPairs);
 	}
 }
+
+void ABP_CompleteBoxPruningStartTask::releaseRangeTasks()
+{
+	for(PxU32 k=0; k<9; k++)
+		mTasks[k].releaseRangeTasks();
+}
 #endif
 
 #ifndef USE_ALTERNATIVE_VERSION
@@ -3411,7 +3602,7 @@ static void doCompleteBoxPruning_(
 	}
 }
 
-void ABP::Region_prepareOverlaps()
+void ABP::Region_prepareOverlaps(PxCpuDispatcher* dispatcher)
 {
 	PX_PROFILE_ZONE("ABP - Region_prepareOverlaps", mContextID);
 
@@ -3422,10 +3613,10 @@ void ABP::Region_prepareOverlaps()
 		return;
 
 	if(mSBM.isThereWorkToDo())
-		mSBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, mContextID);
+		mSBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, dispatcher, mContextID);
 
-	mDBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, mContextID);
-	mKBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, mContextID);
+	mDBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, dispatcher, mContextID);
+	mKBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, dispatcher, mContextID);
 
 	mRS.reset();
 }
@@ -3593,10 +3784,15 @@ ABP::ABP(PxU64 contextID) :
 	{
 		mCompleteBoxPruningTask0.mTasks[k].setContextId(mContextID);
 		mCompleteBoxPruningTask1.mTasks[k].setContextId(mContextID);
+		mCompleteBoxPruningTask0.mTasks[k].mMM = &mMM;
+		mCompleteBoxPruningTask1.mTasks[k].mMM = &mMM;
 	}
 
 	for(PxU32 k=0; k<NB_BIP_TASKS; k++)
+	{
 		mBipTasks[k].setContextId(mContextID);
+		mBipTasks[k].mMM = &mMM;
+	}
 #endif
 }
 
@@ -3802,7 +3998,7 @@ void ABP::findOverlaps(PxBaseTask* continuation, const Bp::FilterGroup::Enum* PX
 	mPairManager.mLUT = lut;
 
 	if(!gPrepareOverlapsFlag)
-		Region_prepareOverlaps();
+		Region_prepareOverlaps(getCpuDispatcher(continuation));
 
 	bool doKineKine = true;
 	bool doStaticKine = true;
@@ -3911,7 +4107,7 @@ void ABP::addDelayedPairs()
 
 	PxU32 nbDelayedPairs = 0;
 	for(PxU32 k=0; k<NB_BIP_TASKS; k++)
-		nbDelayedPairs += mBipTasks[k].mPairs.mDelayedPairs.size();
+		nbDelayedPairs += mBipTasks[k].getNbDelayedPairs();
 
 	if(nbDelayedPairs)
 	{
@@ -3921,8 +4117,10 @@ void ABP::addDelayedPairs()
 		}
 
 		for(PxU32 k=0; k<NB_BIP_TASKS; k++)
-			mPairManager.addDelayedPairs(mBipTasks[k].mPairs.mDelayedPairs);
+			mBipTasks[k].addDelayedPairs(mPairManager);
 	}
+
+	releaseRangeTasks();
 }
 
 void ABP::addDelayedPairs2(PxArray<BroadPhasePair>& createdPairs)
@@ -3934,7 +4132,7 @@ void ABP::addDelayedPairs2(PxArray<BroadPhasePair>& createdPairs)
 
 	PxU32 nbDelayedPairs = 0;
 	for(PxU32 k=0; k<NB_BIP_TASKS; k++)
-		nbDelayedPairs += mBipTasks[k].mPairs.mDelayedPairs.size();
+		nbDelayedPairs += mBipTasks[k].getNbDelayedPairs();
 
 	if(nbDelayedPairs)
 	{
@@ -3944,8 +4142,18 @@ void ABP::addDelayedPairs2(PxArray<BroadPhasePair>& createdPairs)
 		}
 
 		for(PxU32 k=0; k<NB_BIP_TASKS; k++)
-			mPairManager.addDelayedPairs2(createdPairs, mBipTasks[k].mPairs.mDelayedPairs);
+			mBipTasks[k].addDelayedPairs2(mPairManager, createdPairs);
 	}
+
+	releaseRangeTasks();
+}
+
+void ABP::releaseRangeTasks()
+{
+	mCompleteBoxPruningTask0.releaseRangeTasks();
+	mCompleteBoxPruningTask1.releaseRangeTasks();
+	for(PxU32 k=0; k<NB_BIP_TASKS; k++)
+		mBipTasks[k].releaseRangeTasks();
 }
 #endif
 
@@ -4079,7 +4287,7 @@ void BroadPhaseABP::update(PxcScratchAllocator* scratchAllocator, const BroadPha
 			PX_ASSERT(!mDeleted.size());
 
 			if(gPrepareOverlapsFlag)
-				mABP->Region_prepareOverlaps();
+				mABP->Region_prepareOverlaps(getCpuDispatcher(continuation));
 		}
 
 		{
@@ -4114,7 +4322,7 @@ void ABP_InternalTask::run()
 			PX_ASSERT(!mBP->mDeleted.size());
 
 			if(gPrepareOverlapsFlag)
-				abp->Region_prepareOverlaps();
+				abp->Region_prepareOverlaps(getCpuDispatcher(getContinuation()));
 		}
 
 		{
@@ -4122,12 +4330,12 @@ void ABP_InternalTask::run()
 
 			for(PxU32 k=0;k<9;k++)
 			{
-				abp->mCompleteBoxPruningTask0.mTasks[k].mPairs.mDelayedPairs.resetOrClear();
-				abp->mCompleteBoxPruningTask1.mTasks[k].mPairs.mDelayedPairs.resetOrClear();
+				abp->mCompleteBoxPruningTask0.mTasks[k].resetDelayedPairs();
+				abp->mCompleteBoxPruningTask1.mTasks[k].resetDelayedPairs();
 			}
 
 			for(PxU32 k=0;k<NB_BIP_TASKS;k++)
-				abp->mBipTasks[k].mPairs.mDelayedPairs.resetOrClear();
+				abp->mBipTasks[k].resetDelayedPairs();
 
 			abp->findOverlaps(getContinuation(), mBP->mGroups, mBP->mFilter->getLUT());
 		}
@@ -701,11 +701,230 @@ void BroadPhaseSap::update()
 	PX_ASSERT(0==mBatchUpdateTasks[1].getPairsSize());
 	PX_ASSERT(0==mBatchUpdateTasks[2].getPairsSize());
 
+	// the incremental update is a per-axis insertion sort, whose cost grows with the number of endpoints each updated
+	// box moves past. This is small in coherent scenes but large when objects teleport or after a long frame, in which
+	// case sorting everything from scratch is cheaper.
+	if(isFullResortNeeded())
+	{
+		batchUpdateFullResort();
+		return;
+	}
+
 	mBatchUpdateTasks[0].runInternal();
 	mBatchUpdateTasks[1].runInternal();
 	mBatchUpdateTasks[2].runInternal();
 }
 
+static PX_FORCE_INLINE bool Intersect3D(const ValType bDir1Min, const ValType bDir1Max, const ValType bDir2Min, const ValType bDir2Max, const ValType bDir3Min, const ValType bDir3Max,
+										const ValType cDir1Min, const ValType cDir1Max, const ValType cDir2Min, const ValType cDir2Max, const ValType cDir3Min, const ValType cDir3Max)
+{
+	return (bDir1Max >= cDir1Min && cDir1Max >= bDir1Min && 
+			bDir2Max >= cDir2Min && cDir2Max >= bDir2Min &&
+			bDir3Max >= cDir3Min && cDir3Max >= bDir3Min);       
+}
+
+// Returns the position an endpoint with the given value would have in the sorted array. Only updated endpoints can be
+// out of order at this point, so this is an estimate, which is all we need.
+static PX_FORCE_INLINE PxU32 findEndPointIndex(const ValType* PX_RESTRICT values, PxU32 nbEndPoints, ValType value)
+{
+	PxU32 low = 1;
+	PxU32 high = nbEndPoints + 1;
+	while(low<high)
+	{
+		const PxU32 middle = (low + high)>>1;
+		if(values[middle]<value)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low;
+}
+
+bool BroadPhaseSap::isFullResortNeeded() const
+{
+	if(!mUpdatedSize)
+		return false;
+
+	// boxes from the create list are not in the sorted arrays yet
+	const PxU32 nbEndPoints = (mBoxesSize - mCreatedSize)*2;
+	if(!nbEndPoints)
+		return false;
+
+	// the displacement of an endpoint is the number of endpoints it moves past, i.e. the number of swaps the
+	// insertion sort will do for it. We sum this over all updated endpoints of all axes and stop as soon as the
+	// full re-sort becomes cheaper.
+	const PxU64 limit = PxU64(nbEndPoints) * 3 * BP_SAP_FULL_RESORT_DISPLACEMENT;
+	PxU64 displacement = 0;
+	for(PxU32 Axis=0;Axis<3;Axis++)
+	{
+		const ValType* PX_RESTRICT values = mEndPointValues[Axis];
+		const SapBox1D* PX_RESTRICT boxes = mBoxEndPts[Axis];
+		for(PxU32 i=0;i<mUpdatedSize;i++)
+		{
+			const BpHandle handle = mUpdated[i];
+			const SapBox1D& box = boxes[handle];
+			PX_ASSERT(box.mMinMax[0]!=BP_INVALID_BP_HANDLE && box.mMinMax[0]!=PX_REMOVED_BP_HANDLE);
+
+			const PxU32 newMin = findEndPointIndex(values, nbEndPoints, encodeMin(mBoxBoundsMinMax[handle], Axis, mContactDistance[handle]));
+			const PxU32 newMax = findEndPointIndex(values, nbEndPoints, encodeMax(mBoxBoundsMinMax[handle], Axis, mContactDistance[handle]));
+			displacement += PxU32(PxAbs(PxI32(newMin) - PxI32(box.mMinMax[0])));
+			displacement += PxU32(PxAbs(PxI32(newMax) - PxI32(box.mMinMax[1])));
+		}
+
+		if(displacement>limit)
+			return true;
+	}
+	return false;
+}
+
+void BroadPhaseSap::batchUpdateFullResort()
+{
+	PX_PROFILE_ZONE("BroadPhaseSap.batchUpdateFullResort", mContextID);
+
+	const PxU32 numOldBoxes = mBoxesSize - mCreatedSize;
+	const PxU32 nbEndPoints = numOldBoxes*2;
+
+	//Write the new values of updated boxes and sort each axis from scratch. The radix sort is stable, so endpoints
+	//with equal values remain in the order the incremental update would have left them in.
+	{
+		TmpMem<ValType, 32> sortedValuesMem(nbEndPoints);
+		TmpMem<BpHandle, 32> sortedDatasMem(nbEndPoints);
+		ValType* PX_RESTRICT sortedValues = sortedValuesMem.getBase();
+		BpHandle* PX_RESTRICT sortedDatas = sortedDatasMem.getBase();
+
+		PxU32* ranks0 = reinterpret_cast<PxU32*>(mScratchAllocator->alloc(sizeof(PxU32)*nbEndPoints, true));
+		PxU32* ranks1 = reinterpret_cast<PxU32*>(mScratchAllocator->alloc(sizeof(PxU32)*nbEndPoints, true));
+		Cm::StackRadixSort(RS, ranks0, ranks1);
+
+		for(PxU32 Axis=0;Axis<3;Axis++)
+		{
+			ValType* PX_RESTRICT values = mEndPointValues[Axis];
+			BpHandle* PX_RESTRICT datas = mEndPointDatas[Axis];
+			SapBox1D* PX_RESTRICT boxes = mBoxEndPts[Axis];
+
+			for(PxU32 i=0;i<mUpdatedSize;i++)
+			{
+				const BpHandle handle = mUpdated[i];
+				values[boxes[handle].mMinMax[0]] = encodeMin(mBoxBoundsMinMax[handle], Axis, mContactDistance[handle]);
+				values[boxes[handle].mMinMax[1]] = encodeMax(mBoxBoundsMinMax[handle], Axis, mContactDistance[handle]);
+			}
+
+			RS.invalidateRanks();	// there's no coherence between axes
+			const PxU32* Sorted = RS.Sort(values + 1, nbEndPoints, Cm::RADIX_UNSIGNED).GetRanks();
+			for(PxU32 i=0;i<nbEndPoints;i++)
+			{
+				const PxU32 sortedIndex = Sorted[i] + 1;
+				sortedValues[i] = values[sortedIndex];
+				sortedDatas[i] = datas[sortedIndex];
+			}
+
+			for(PxU32 i=0;i<nbEndPoints;i++)
+			{
+				const BpHandle data = sortedDatas[i];
+				values[i+1] = sortedValues[i];
+				datas[i+1] = data;
+				boxes[getOwner(data)].mMinMax[isMax(data)] = BpHandle(i+1);
+			}
+		}
+
+		mScratchAllocator->free(ranks1);
+		mScratchAllocator->free(ranks0);
+	}
+
+	//Remove the current pairs of updated boxes that do not overlap anymore.
+	{
+		DataArray da(mData, mDataSize, mDataCapacity);
+
+		const SapBox1D* PX_RESTRICT boxes0 = mBoxEndPts[0];
+		const SapBox1D* PX_RESTRICT boxes1 = mBoxEndPts[1];
+		const SapBox1D* PX_RESTRICT boxes2 = mBoxEndPts[2];
+		const PxU8* PX_RESTRICT updated = mBoxesUpdated;
+
+		const PxU32 nbPairs = mPairs.mNbActivePairs;
+		for(PxU32 i=0;i<nbPairs;i++)
+		{
+			const BpHandle id0 = mPairs.mActivePairs[i].mVolA;
+			const BpHandle id1 = mPairs.mActivePairs[i].mVolB;
+			if(!updated[id0] && !updated[id1])
+				continue;
+
+			if(	boxes0[id0].mMinMax[0] > boxes0[id1].mMinMax[1] || boxes0[id1].mMinMax[0] > boxes0[id0].mMinMax[1] ||
+				!Intersect2D_Handle(boxes1[id0].mMinMax[0], boxes1[id0].mMinMax[1], boxes2[id0].mMinMax[0], boxes2[id0].mMinMax[1],
+									boxes1[id1].mMinMax[0], boxes1[id1].mMinMax[1], boxes2[id1].mMinMax[0], boxes2[id1].mMinMax[1]))
+				removePair(id0, id1, mScratchAllocator, mPairs, da);
+		}
+
+		mData = da.mData;
+		mDataSize = da.mSize;
+		mDataCapacity = da.mCapacity;
+	}
+
+	//Add the overlaps of updated boxes, with each other and with the other boxes. Pairs that already exist are kept.
+	{
+		TmpMem<BpHandle, 8> updatedBoxesIndicesSortedMem(mUpdatedSize);
+		TmpMem<BpHandle, 8> otherBoxesIndicesSortedMem(numOldBoxes);
+		BpHandle* updatedBoxesIndicesSorted = updatedBoxesIndicesSortedMem.getBase();
+		BpHandle* otherBoxesIndicesSorted = otherBoxesIndicesSortedMem.getBase();
+		PxU32 updatedBoxCount = 0;
+		PxU32 otherBoxCount = 0;
+		PxU32 updatedDynamicCount = 0;
+		PxU32 otherDynamicCount = 0;
+
+		// same as in ComputeSortedLists, other boxes are culled against the bounds (in sorted indices) of updated boxes
+		PxU32 globalMin[3] = { PX_MAX_U32, PX_MAX_U32, PX_MAX_U32 };
+		PxU32 globalMax[3] = { 0, 0, 0 };
+		for(PxU32 i=0;i<mUpdatedSize;i++)
+		{
+			const BpHandle handle = mUpdated[i];
+			for(PxU32 Axis=0;Axis<3;Axis++)
+			{
+				globalMin[Axis] = PxMin(globalMin[Axis], PxU32(mBoxEndPts[Axis][handle].mMinMax[0]));
+				globalMax[Axis] = PxMax(globalMax[Axis], PxU32(mBoxEndPts[Axis][handle].mMinMax[1]));
+			}
+		}
+
+		const BpHandle* PX_RESTRICT datas = mEndPointDatas[0];
+		for(PxU32 i=1;i<=nbEndPoints;i++)
+		{
+			const BpHandle data = datas[i];
+			if(isMax(data))
+				continue;
+
+			const BpHandle boxId = getOwner(data);
+			const bool isDynamic = mBoxGroups[boxId]!=FilterGroup::eSTATICS;
+			if(mBoxesUpdated[boxId])
+			{
+				updatedBoxesIndicesSorted[updatedBoxCount++] = boxId;
+				updatedDynamicCount += isDynamic ? 1 : 0;
+			}
+			else if(Intersect3D(globalMin[0], globalMax[0], globalMin[1], globalMax[1], globalMin[2], globalMax[2],
+								mBoxEndPts[0][boxId].mMinMax[0], mBoxEndPts[0][boxId].mMinMax[1],
+								mBoxEndPts[1][boxId].mMinMax[0], mBoxEndPts[1][boxId].mMinMax[1],
+								mBoxEndPts[2][boxId].mMinMax[0], mBoxEndPts[2][boxId].mMinMax[1]))
+			{
+				otherBoxesIndicesSorted[otherBoxCount++] = boxId;
+				otherDynamicCount += isDynamic ? 1 : 0;
+			}
+		}
+		PX_ASSERT(updatedBoxCount==mUpdatedSize);
+
+		if(updatedDynamicCount || otherDynamicCount)
+		{
+			const AuxData data0(updatedBoxCount, mBoxEndPts, updatedBoxesIndicesSorted, mBoxGroups);
+
+			if(updatedDynamicCount)
+				performBoxPruningNewNew(&data0, mScratchAllocator, mFilter->getLUT(), mPairs, mData, mDataSize, mDataCapacity);
+
+			if(otherBoxCount)
+			{
+				const AuxData data1(otherBoxCount, mBoxEndPts, otherBoxesIndicesSorted, mBoxGroups);
+
+				performBoxPruningNewOld(&data0, &data1, mScratchAllocator, mFilter->getLUT(), mPairs, mData, mDataSize, mDataCapacity);
+			}
+		}
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static PX_FORCE_INLINE void InsertEndPoints(const ValType* PX_RESTRICT newEndPointValues, const BpHandle* PX_RESTRICT newEndPointDatas, PxU32 numNewEndPoints,
@@ -757,14 +976,6 @@ static PX_FORCE_INLINE void InsertEndPoints(const ValType* PX_RESTRICT newEndPoi
 	}
 }
 
-static PX_FORCE_INLINE bool Intersect3D(const ValType bDir1Min, const ValType bDir1Max, const ValType bDir2Min, const ValType bDir2Max, const ValType bDir3Min, const ValType bDir3Max,
-										const ValType cDir1Min, const ValType cDir1Max, const ValType cDir2Min, const ValType cDir2Max, const ValType cDir3Min, const ValType cDir3Max)
-{
-	return (bDir1Max >= cDir1Min && cDir1Max >= bDir1Min && 
-			bDir2Max >= cDir2Min && cDir2Max >= bDir2Min &&
-			bDir3Max >= cDir3Min && cDir3Max >= bDir3Min);       
-}
-
 void BroadPhaseSap::ComputeSortedLists(	//const PxVec4& globalMin, const PxVec4& /*globalMax*/,
 										BpHandle* PX_RESTRICT newBoxIndicesSorted, PxU32& newBoxIndicesCount, BpHandle* PX_RESTRICT oldBoxIndicesSorted, PxU32& oldBoxIndicesCount,
 										bool& allNewBoxesStatics, bool& allOldBoxesStatics)
@@ -191,6 +191,10 @@ private:
 
 			void						batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pairs, PxU32& pairsSize, PxU32& pairsCapacity);
 
+	//Fallback for large displacements: re-sort all axes and recompute the pairs of updated boxes.
+			bool						isFullResortNeeded()	const;
+			void						batchUpdateFullResort();
+
 			void						ComputeSortedLists(	//const PxVec4& globalMin, const PxVec4& globalMax,
 															BpHandle* PX_RESTRICT newBoxIndicesSorted, PxU32& newBoxIndicesCount, BpHandle* PX_RESTRICT oldBoxIndicesSorted, PxU32& oldBoxIndicesCount,
 															bool& allNewBoxesStatics, bool& allOldBoxesStatics);
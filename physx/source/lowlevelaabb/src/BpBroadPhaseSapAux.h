@@ -49,6 +49,8 @@ namespace Bp
 
 #define BP_SAP_USE_OVERLAP_TEST_ON_REMOVES	1// "Useless" but faster overall because seriously reduces number of calls (from ~10000 to ~3 sometimes!)
 
+#define BP_SAP_FULL_RESORT_DISPLACEMENT	4// Re-sort all axes when updated endpoints would move past more than this many times the number of endpoints
+
 //Set 1 to test for group ids in batchCreate/batchUpdate so we can avoid group id test in ComputeCreatedDeletedPairsLists
 //Set 0 to neglect group id test in batchCreate/batchUpdate and delay test until ComputeCreatedDeletedPairsLists
 #define BP_SAP_TEST_GROUP_ID_CREATEUPDATE 1
@@ -59,6 +59,7 @@
 #include "DyContactPrepShared.h"
 #include "DySleep.h"
 #include "DyIslandManager.h"
+#include "DySolverContact8.h"
 
 //KS - used to turn on/off batched SIMD constraints.
 #define DY_BATCH_CONSTRAINTS 1
@@ -1452,6 +1453,10 @@ public:
 
 		PxU32 numBatches = 0;
 
+#if DY_BATCH_8
+		const bool batch8 = isBatch8Supported();
+#endif
+
 		PxU32 currIndex = 0;
 		for(PxU32 a = 0; a < mThreadContext.mConstraintsPerPartition.size(); ++a)
 		{
@@ -1479,6 +1484,20 @@ public:
 					}
 				}
 
+#if DY_BATCH_8
+				// merge two consecutive full blocks of dynamic contacts into a single 8-wide batch when their streams match
+				if(batch8 && newStride == 4 && numBatchesInPartition && *contactDescBegin[startIndex].constraint == DY_SC_TYPE_BLOCK_RB_CONTACT)
+				{
+					PxConstraintBatchHeader& prevHeader = mThreadContext.contactConstraintBatchHeaders[numBatches-1];
+					if(prevHeader.stride == 4 && prevHeader.constraintType == DY_SC_TYPE_BLOCK_RB_CONTACT
+						&& canBatchContact4Blocks(contactDescBegin[prevHeader.startIndex], contactDescBegin[startIndex]))
+					{
+						PX_ASSERT(prevHeader.startIndex + 4 == startIndex);
+						prevHeader.stride = 8;
+						continue;
+					}
+				}
+#endif
 				if(newStride != 0)
 				{
 					mThreadContext.contactConstraintBatchHeaders[numBatches].startIndex = startIndex;
@@ -1770,7 +1789,7 @@ static void createSolverTaskChain(	DynamicsContext& dynamicContext,
 									PxU32 solverBodyOffset, 
 									IG::SimpleIslandManager& islandManager, 
 									PxU32* bodyRemapTable, PxsMaterialManager* materialManager, PxBaseTask* continuation,
-									PxsContactManagerOutputIterator& iterator, bool useEnhancedDeterminism)
+									PxsContactManagerOutputIterator& iterator, bool useEnhancedDeterminism, PxU32 batchIndex)
 {
 	Cm::FlushPool& taskPool = dynamicContext.getTaskPool();
 	taskPool.lock();
@@ -1791,6 +1810,13 @@ static void createSolverTaskChain(	DynamicsContext& dynamicContext,
 
 	taskPool.unlock();
 
+	// all tasks of a batch work on the same islands, let topology-aware dispatchers keep them together
+	startTask->setLocalityHint(batchIndex);
+	endTask->setLocalityHint(batchIndex);
+	createFinalizeConstraintsTask->setLocalityHint(batchIndex);
+	setupSolveTask->setLocalityHint(batchIndex);
+	partitionConstraintsTask->setLocalityHint(batchIndex);
+
 	endTask->setContinuation(continuation);
 
 	// set up task chain in reverse order
@@ -2037,6 +2063,7 @@ void DynamicsContext::updatePostKinematic(IG::SimpleIslandManager& simpleIslandM
 	PxU32 currentBodyIndex = 0;
 	PxU32 currentArticulation = 0;
 	PxU32 currentContact = 0;
+	PxU32 batchIndex = 0;
 
 	while(currentIsland < islandCount)
 	{
@@ -2093,7 +2120,7 @@ void DynamicsContext::updatePostKinematic(IG::SimpleIslandManager& simpleIslandM
 		{
 			createSolverTaskChain(*this, objectStarts, counts, 
 				mKinematicCount + currentBodyIndex, simpleIslandManager, mSolverBodyRemapTable.begin(), mMaterialManager,
-				forceThresholdTask, mOutputIterator, mUseEnhancedDeterminism);
+				forceThresholdTask, mOutputIterator, mUseEnhancedDeterminism, batchIndex++);
 		}
 
 		currentBodyIndex += nbBodies;
@@ -33,10 +33,15 @@
 #include "DyConstraint.h"
 #include "foundation/PxAtomic.h"
 #include "DySolverContact4.h"
+#include "DySolverContact8.h"
 #include "DySolverConstraint1D4.h"
 #include "DyPGS.h"
 #include "DyResidualAccumulator.h"
 
+#if DY_BATCH_8 && PX_VC
+	#include <intrin.h>
+#endif
+
 namespace physx
 {
 namespace Dy
@@ -404,6 +409,73 @@ static void solveContact4_Block(const PxSolverConstraintDesc* PX_RESTRICT desc,
 		error.accumulateErrorGlobal(*cache.contactErrorAccumulator);
 }
 
+#if DY_BATCH_8
+// This file is not compiled for AVX2, so the check itself can run on any CPU. The OS must also save the AVX registers on
+// context switches, which is what the XGETBV test is for (__builtin_cpu_supports already includes it).
+static bool checkBatch8Support()
+{
+#if PX_VC
+	int info[4];
+	__cpuid(info, 1);
+	const bool hasFMA = (info[2] & (1<<12)) != 0;
+	const bool hasOSXSAVE = (info[2] & (1<<27)) != 0;
+	const bool hasAVX = (info[2] & (1<<28)) != 0;
+	if(!hasFMA || !hasOSXSAVE || !hasAVX)
+		return false;
+	if((_xgetbv(0) & 6) != 6)
+		return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1<<5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+bool isBatch8Supported()
+{
+	static const bool supported = checkBatch8Support();
+	return supported;
+}
+
+bool canBatchContact4Blocks(const PxSolverConstraintDesc& block0, const PxSolverConstraintDesc& block1)
+{
+	const PxU32 length = getConstraintLength(block0);
+	if(length != getConstraintLength(block1))
+		return false;
+
+	const PxU8* PX_RESTRICT currPtr0 = block0.constraint;
+	const PxU8* PX_RESTRICT currPtr1 = block1.constraint;
+	const PxU8* PX_RESTRICT last = currPtr0 + length;
+
+	while(currPtr0 < last)
+	{
+		const SolverContactHeader4* PX_RESTRICT hdr0 = reinterpret_cast<const SolverContactHeader4*>(currPtr0);
+		const SolverContactHeader4* PX_RESTRICT hdr1 = reinterpret_cast<const SolverContactHeader4*>(currPtr1);
+
+		if(hdr0->type != DY_SC_TYPE_BLOCK_RB_CONTACT || hdr1->type != DY_SC_TYPE_BLOCK_RB_CONTACT)
+			return false;
+
+		const PxU32 numNormalConstr = hdr0->numNormalConstr;
+		const PxU32 numFrictionConstr = hdr0->numFrictionConstr;
+		const PxU8 hasMaxImpulse = PxU8(hdr0->flag & SolverContactHeader4::eHAS_MAX_IMPULSE);
+
+		if(numNormalConstr != hdr1->numNormalConstr || numFrictionConstr != hdr1->numFrictionConstr
+			|| hasMaxImpulse != (hdr1->flag & SolverContactHeader4::eHAS_MAX_IMPULSE))
+			return false;
+
+		PxU32 size = sizeof(SolverContactHeader4) + numNormalConstr * (sizeof(Vec4V) + sizeof(SolverContactBatchPointDynamic4));
+		if(hasMaxImpulse)
+			size += sizeof(Vec4V) * numNormalConstr;
+		if(numFrictionConstr)
+			size += sizeof(SolverFrictionSharedData4) + numFrictionConstr * (sizeof(Vec4V) + sizeof(SolverContactFrictionDynamic4));
+
+		currPtr0 += size;
+		currPtr1 += size;
+	}
+	return currPtr0 == last;
+}
+#endif
+
 static void solveContact4_StaticBlock(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
 {
 	PxSolverBody& b00 = *desc[0].bodyA;
@@ -1218,6 +1290,13 @@ static void writeBack1D4(const PxSolverConstraintDesc* PX_RESTRICT desc, bool re
 
 void solveContactPreBlock(DY_PGS_SOLVE_METHOD_PARAMS)
 {
+#if DY_BATCH_8
+	if(constraintCount == 8)
+	{
+		solveContact8_Block(desc, cache);
+		return;
+	}
+#endif
 	PX_UNUSED(constraintCount);
 	solveContact4_Block(desc, cache);
 }
@@ -1230,9 +1309,12 @@ void solveContactPreBlock_Static(DY_PGS_SOLVE_METHOD_PARAMS)
 
 void solveContactPreBlock_Conclude(DY_PGS_SOLVE_METHOD_PARAMS)
 {
-	PX_UNUSED(constraintCount);
-	solveContact4_Block(desc, cache);
-	concludeContact4_Block(desc, sizeof(SolverContactBatchPointDynamic4), sizeof(SolverContactFrictionDynamic4));
+	// merged 8-wide batches are concluded (and written back below) one 4-wide half at a time
+	for(PxU32 i=0; i<constraintCount; i+=4)
+	{
+		solveContact4_Block(desc + i, cache);
+		concludeContact4_Block(desc + i, sizeof(SolverContactBatchPointDynamic4), sizeof(SolverContactFrictionDynamic4));
+	}
 }
 
 void solveContactPreBlock_ConcludeStatic(DY_PGS_SOLVE_METHOD_PARAMS)
@@ -1244,30 +1326,34 @@ void solveContactPreBlock_ConcludeStatic(DY_PGS_SOLVE_METHOD_PARAMS)
 
 void solveContactPreBlock_WriteBack(DY_PGS_SOLVE_METHOD_PARAMS)
 {
-	PX_UNUSED(constraintCount);
-	solveContact4_Block(desc, cache);
+	for(PxU32 i=0; i<constraintCount; i+=4)
+	{
+		const PxSolverConstraintDesc* PX_RESTRICT block = desc + i;
 
-	const PxSolverBodyData* bd0[4] = {	&cache.solverBodyArray[desc[0].bodyADataIndex], 
-										&cache.solverBodyArray[desc[1].bodyADataIndex],
-										&cache.solverBodyArray[desc[2].bodyADataIndex],
-										&cache.solverBodyArray[desc[3].bodyADataIndex]};
+		solveContact4_Block(block, cache);
 
-	const PxSolverBodyData* bd1[4] = {	&cache.solverBodyArray[desc[0].bodyBDataIndex], 
-										&cache.solverBodyArray[desc[1].bodyBDataIndex],
-										&cache.solverBodyArray[desc[2].bodyBDataIndex],
-										&cache.solverBodyArray[desc[3].bodyBDataIndex]};
+		const PxSolverBodyData* bd0[4] = {	&cache.solverBodyArray[block[0].bodyADataIndex], 
+											&cache.solverBodyArray[block[1].bodyADataIndex],
+											&cache.solverBodyArray[block[2].bodyADataIndex],
+											&cache.solverBodyArray[block[3].bodyADataIndex]};
 
-	writeBackContact4_Block(desc, cache, bd0, bd1);
+		const PxSolverBodyData* bd1[4] = {	&cache.solverBodyArray[block[0].bodyBDataIndex], 
+											&cache.solverBodyArray[block[1].bodyBDataIndex],
+											&cache.solverBodyArray[block[2].bodyBDataIndex],
+											&cache.solverBodyArray[block[3].bodyBDataIndex]};
 
-	if(cache.mThresholdStreamIndex > (cache.mThresholdStreamLength - 4))
-	{
-		//Write back to global buffer
-		PxI32 threshIndex = physx::PxAtomicAdd(cache.mSharedOutThresholdPairs, PxI32(cache.mThresholdStreamIndex)) - PxI32(cache.mThresholdStreamIndex);
-		for(PxU32 a = 0; a < cache.mThresholdStreamIndex; ++a)
+		writeBackContact4_Block(block, cache, bd0, bd1);
+
+		if(cache.mThresholdStreamIndex > (cache.mThresholdStreamLength - 4))
 		{
-			cache.mSharedThresholdStream[a + threshIndex] = cache.mThresholdStream[a];
+			//Write back to global buffer
+			PxI32 threshIndex = physx::PxAtomicAdd(cache.mSharedOutThresholdPairs, PxI32(cache.mThresholdStreamIndex)) - PxI32(cache.mThresholdStreamIndex);
+			for(PxU32 a = 0; a < cache.mThresholdStreamIndex; ++a)
+			{
+				cache.mSharedThresholdStream[a + threshIndex] = cache.mThresholdStream[a];
+			}
+			cache.mThresholdStreamIndex = 0;
 		}
-		cache.mThresholdStreamIndex = 0;
 	}
 }
 
@@ -0,0 +1,867 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "DySolverContact8.h"
+
+#if DY_BATCH_8
+
+// This file is compiled for AVX2/FMA (see DySolverContact8.h). Its functions are only called after isBatch8Supported()
+// returned true, so it must not contain anything that can run before that check, like static initializers.
+#include "foundation/PxPreprocessor.h"
+#include "foundation/PxVecMath.h"
+#include "DySolverBody.h"
+#include "DySolverContext.h"
+#include "DySolverConstraintDesc.h"
+#include "DySolverConstraintTypes.h"
+#include "DySolverContact4.h"
+#include "DySolverContactStep4.h"
+#include "DyResidualAccumulator.h"
+#include <immintrin.h>
+
+namespace physx
+{
+namespace Dy
+{
+	typedef __m256	Vec8V;
+	typedef __m256	BoolV8;
+
+	PX_FORCE_INLINE Vec8V V8Zero()										{ return _mm256_setzero_ps();								}
+	PX_FORCE_INLINE Vec8V V8Load(const PxF32 f)							{ return _mm256_set1_ps(f);									}
+	PX_FORCE_INLINE Vec8V V8Combine(const aos::Vec4V lo, const aos::Vec4V hi)	{ return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);	}
+	PX_FORCE_INLINE aos::Vec4V V8GetLo(const Vec8V v)					{ return _mm256_castps256_ps128(v);							}
+	PX_FORCE_INLINE aos::Vec4V V8GetHi(const Vec8V v)					{ return _mm256_extractf128_ps(v, 1);						}
+
+	PX_FORCE_INLINE Vec8V V8Add(const Vec8V a, const Vec8V b)			{ return _mm256_add_ps(a, b);								}
+	PX_FORCE_INLINE Vec8V V8Sub(const Vec8V a, const Vec8V b)			{ return _mm256_sub_ps(a, b);								}
+	PX_FORCE_INLINE Vec8V V8Mul(const Vec8V a, const Vec8V b)			{ return _mm256_mul_ps(a, b);								}
+	PX_FORCE_INLINE Vec8V V8Div(const Vec8V a, const Vec8V b)			{ return _mm256_div_ps(a, b);								}
+	PX_FORCE_INLINE Vec8V V8Sqrt(const Vec8V a)							{ return _mm256_sqrt_ps(a);									}
+	PX_FORCE_INLINE Vec8V V8Max(const Vec8V a, const Vec8V b)			{ return _mm256_max_ps(a, b);								}
+	PX_FORCE_INLINE Vec8V V8Min(const Vec8V a, const Vec8V b)			{ return _mm256_min_ps(a, b);								}
+	// same as V4Neg, i.e. 0-a rather than flipping the sign bit
+	PX_FORCE_INLINE Vec8V V8Neg(const Vec8V a)							{ return _mm256_sub_ps(_mm256_setzero_ps(), a);				}
+	PX_FORCE_INLINE Vec8V V8Abs(const Vec8V a)							{ return V8Max(a, V8Neg(a));								}
+
+	// the 8-wide kernels always use fused multiply-adds, this file is only compiled when the SDK is built with PX_AVX2_FMA
+	PX_FORCE_INLINE Vec8V V8MulAdd(const Vec8V a, const Vec8V b, const Vec8V c)		{ return _mm256_fmadd_ps(a, b, c);							}
+	PX_FORCE_INLINE Vec8V V8NegMulSub(const Vec8V a, const Vec8V b, const Vec8V c)	{ return _mm256_fnmadd_ps(a, b, c);						}
+
+	PX_FORCE_INLINE BoolV8 V8IsGrtr(const Vec8V a, const Vec8V b)		{ return _mm256_cmp_ps(a, b, _CMP_GT_OS);					}
+	PX_FORCE_INLINE BoolV8 B8FFFFFFFF()									{ return _mm256_setzero_ps();								}
+	PX_FORCE_INLINE BoolV8 B8Or(const BoolV8 a, const BoolV8 b)			{ return _mm256_or_ps(a, b);								}
+	PX_FORCE_INLINE Vec8V V8Sel(const BoolV8 c, const Vec8V a, const Vec8V b)	{ return _mm256_or_ps(_mm256_andnot_ps(c, b), _mm256_and_ps(c, a));	}
+
+	// Loads a Vec4V field of the first block and the same field of the second block, located 'delta' bytes further
+	PX_FORCE_INLINE Vec8V V8LoadPair(const aos::Vec4V& lo, const ptrdiff_t delta)
+	{
+		const aos::Vec4V& hi = *reinterpret_cast<const aos::Vec4V*>(reinterpret_cast<const PxU8*>(&lo) + delta);
+		return V8Combine(lo, hi);
+	}
+
+	PX_FORCE_INLINE void V8StorePair(aos::Vec4V& lo, const ptrdiff_t delta, const Vec8V v)
+	{
+		aos::Vec4V& hi = *reinterpret_cast<aos::Vec4V*>(reinterpret_cast<PxU8*>(&lo) + delta);
+		lo = V8GetLo(v);
+		hi = V8GetHi(v);
+	}
+
+	// Transposes 8 vectors (one per lane) into 4 Vec8V (x, y, z and w of each lane)
+	PX_FORCE_INLINE void V8LoadTransposed(const PxF32* const PX_RESTRICT src[8], Vec8V& x, Vec8V& y, Vec8V& z, Vec8V& w)
+	{
+		using namespace aos;
+
+		Vec4V v0 = V4LoadA(src[0]);
+		Vec4V v1 = V4LoadA(src[1]);
+		Vec4V v2 = V4LoadA(src[2]);
+		Vec4V v3 = V4LoadA(src[3]);
+		Vec4V v4 = V4LoadA(src[4]);
+		Vec4V v5 = V4LoadA(src[5]);
+		Vec4V v6 = V4LoadA(src[6]);
+		Vec4V v7 = V4LoadA(src[7]);
+
+		Vec4V x0, y0, z0, w0, x1, y1, z1, w1;
+		PX_TRANSPOSE_44(v0, v1, v2, v3, x0, y0, z0, w0);
+		PX_TRANSPOSE_44(v4, v5, v6, v7, x1, y1, z1, w1);
+
+		x = V8Combine(x0, x1);
+		y = V8Combine(y0, y1);
+		z = V8Combine(z0, z1);
+		w = V8Combine(w0, w1);
+	}
+
+	// Inverse of V8LoadTransposed
+	PX_FORCE_INLINE void V8Transpose(const Vec8V x, const Vec8V y, const Vec8V z, const Vec8V w, aos::Vec4V dst[8])
+	{
+		using namespace aos;
+
+		Vec4V x0 = V8GetLo(x), y0 = V8GetLo(y), z0 = V8GetLo(z), w0 = V8GetLo(w);
+		Vec4V x1 = V8GetHi(x), y1 = V8GetHi(y), z1 = V8GetHi(z), w1 = V8GetHi(w);
+
+		PX_TRANSPOSE_44(x0, y0, z0, w0, dst[0], dst[1], dst[2], dst[3]);
+		PX_TRANSPOSE_44(x1, y1, z1, w1, dst[4], dst[5], dst[6], dst[7]);
+	}
+
+
+// 8-wide version of the PGS solveContact4_Block (DySolverConstraintsBlock.cpp). The first 4 lanes come from the stream of desc[0],
+// the last 4 from the stream of desc[4]. Both streams have the same layout so we only walk the first one.
+void solveContact8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache)
+{
+	const PxF32* linVel0Ptrs[8];
+	const PxF32* linVel1Ptrs[8];
+	const PxF32* angState0Ptrs[8];
+	const PxF32* angState1Ptrs[8];
+	for(PxU32 i=0;i<8;i++)
+	{
+		linVel0Ptrs[i] = &desc[i].bodyA->linearVelocity.x;
+		linVel1Ptrs[i] = &desc[i].bodyB->linearVelocity.x;
+		angState0Ptrs[i] = &desc[i].bodyA->angularState.x;
+		angState1Ptrs[i] = &desc[i].bodyB->angularState.x;
+	}
+
+	const Vec8V vZero = V8Zero();
+
+	Vec8V linVel0T0, linVel0T1, linVel0T2, linVel0T3;
+	Vec8V linVel1T0, linVel1T1, linVel1T2, linVel1T3;
+	Vec8V angState0T0, angState0T1, angState0T2, angState0T3;
+	Vec8V angState1T0, angState1T1, angState1T2, angState1T3;
+
+	V8LoadTransposed(linVel0Ptrs, linVel0T0, linVel0T1, linVel0T2, linVel0T3);
+	V8LoadTransposed(linVel1Ptrs, linVel1T0, linVel1T1, linVel1T2, linVel1T3);
+	V8LoadTransposed(angState0Ptrs, angState0T0, angState0T1, angState0T2, angState0T3);
+	V8LoadTransposed(angState1Ptrs, angState1T0, angState1T1, angState1T2, angState1T3);
+
+	PX_ASSERT(canBatchContact4Blocks(desc[0], desc[4]));
+
+	const PxU8* PX_RESTRICT last = desc[0].constraint + getConstraintLength(desc[0]);
+
+	PxU8* PX_RESTRICT currPtr = desc[0].constraint;
+
+	// offset from any field of the first block to the same field of the second block
+	const ptrdiff_t delta = desc[4].constraint - desc[0].constraint;
+
+	const Vec8V vMax = V8Load(PX_MAX_REAL);
+
+	const SolverContactHeader4* PX_RESTRICT hdr = reinterpret_cast<SolverContactHeader4*>(currPtr);
+
+	const Vec8V invMassA = V8LoadPair(hdr->invMass0D0, delta);
+	const Vec8V invMassB = V8LoadPair(hdr->invMass1D1, delta);
+
+	const Vec8V sumInvMass = V8Add(invMassA, invMassB);
+
+	Dy::ErrorAccumulator error0, error1;
+	const bool residualReportingActive = cache.contactErrorAccumulator;
+
+	while(currPtr < last)
+	{
+		hdr = reinterpret_cast<const SolverContactHeader4*>(currPtr);
+
+		PX_ASSERT(hdr->type == DY_SC_TYPE_BLOCK_RB_CONTACT);
+
+		currPtr = reinterpret_cast<PxU8*>(const_cast<SolverContactHeader4*>(hdr) + 1);
+
+		const PxU32 numNormalConstr = hdr->numNormalConstr;
+		const PxU32	numFrictionConstr = hdr->numFrictionConstr;
+
+		const bool hasMaxImpulse = (hdr->flag & SolverContactHeader4::eHAS_MAX_IMPULSE) != 0;
+
+		Vec4V* appliedForces = reinterpret_cast<Vec4V*>(currPtr);
+		currPtr += sizeof(Vec4V)*numNormalConstr;
+
+		SolverContactBatchPointDynamic4* PX_RESTRICT contacts = reinterpret_cast<SolverContactBatchPointDynamic4*>(currPtr);
+
+		Vec4V* maxImpulses = NULL;
+		currPtr = reinterpret_cast<PxU8*>(contacts + numNormalConstr);
+		if(hasMaxImpulse)
+		{
+			maxImpulses = reinterpret_cast<Vec4V*>(currPtr);
+			currPtr += sizeof(Vec4V) * numNormalConstr;
+		}
+
+		SolverFrictionSharedData4* PX_RESTRICT fd = reinterpret_cast<SolverFrictionSharedData4*>(currPtr);
+		if(numFrictionConstr)
+			currPtr += sizeof(SolverFrictionSharedData4);
+
+		Vec4V* frictionAppliedForce = reinterpret_cast<Vec4V*>(currPtr);
+		currPtr += sizeof(Vec4V)*numFrictionConstr;
+
+		const SolverContactFrictionDynamic4* PX_RESTRICT frictions = reinterpret_cast<SolverContactFrictionDynamic4*>(currPtr);
+		currPtr += numFrictionConstr * sizeof(SolverContactFrictionDynamic4);
+
+		Vec8V accumulatedNormalImpulse = vZero;
+
+		const Vec8V angD0 = V8LoadPair(hdr->angDom0, delta);
+		const Vec8V angD1 = V8LoadPair(hdr->angDom1, delta);
+
+		const Vec8V _normalT0 = V8LoadPair(hdr->normalX, delta);
+		const Vec8V _normalT1 = V8LoadPair(hdr->normalY, delta);
+		const Vec8V _normalT2 = V8LoadPair(hdr->normalZ, delta);
+
+		Vec8V contactNormalVel1 = V8Mul(linVel0T0, _normalT0);
+		Vec8V contactNormalVel3 = V8Mul(linVel1T0, _normalT0);
+		contactNormalVel1 = V8MulAdd(linVel0T1, _normalT1, contactNormalVel1);
+		contactNormalVel3 = V8MulAdd(linVel1T1, _normalT1, contactNormalVel3);
+		contactNormalVel1 = V8MulAdd(linVel0T2, _normalT2, contactNormalVel1);
+		contactNormalVel3 = V8MulAdd(linVel1T2, _normalT2, contactNormalVel3);
+
+		Vec8V relVel1 = V8Sub(contactNormalVel1, contactNormalVel3);
+
+		Vec8V accumDeltaF = vZero;
+
+		for(PxU32 i=0;i<numNormalConstr;i++)
+		{
+			const SolverContactBatchPointDynamic4& c = contacts[i];
+
+			const Vec8V appliedForce = V8LoadPair(appliedForces[i], delta);
+			const Vec8V maxImpulse = hasMaxImpulse ? V8LoadPair(maxImpulses[i], delta) : vMax;
+
+			const Vec8V raXnX = V8LoadPair(c.raXnX, delta);
+			const Vec8V raXnY = V8LoadPair(c.raXnY, delta);
+			const Vec8V raXnZ = V8LoadPair(c.raXnZ, delta);
+			const Vec8V rbXnX = V8LoadPair(c.rbXnX, delta);
+			const Vec8V rbXnY = V8LoadPair(c.rbXnY, delta);
+			const Vec8V rbXnZ = V8LoadPair(c.rbXnZ, delta);
+			const Vec8V velMultiplier = V8LoadPair(c.velMultiplier, delta);
+
+			Vec8V contactNormalVel2 = V8Mul(raXnX, angState0T0);
+			Vec8V contactNormalVel4 = V8Mul(rbXnX, angState1T0);
+
+			contactNormalVel2 = V8MulAdd(raXnY, angState0T1, contactNormalVel2);
+			contactNormalVel4 = V8MulAdd(rbXnY, angState1T1, contactNormalVel4);
+
+			contactNormalVel2 = V8MulAdd(raXnZ, angState0T2, contactNormalVel2);
+			contactNormalVel4 = V8MulAdd(rbXnZ, angState1T2, contactNormalVel4);
+
+			const Vec8V normalVel = V8Add(relVel1, V8Sub(contactNormalVel2, contactNormalVel4));
+
+			Vec8V deltaF = V8NegMulSub(normalVel, velMultiplier, V8LoadPair(c.biasedErr, delta));
+
+			deltaF = V8Max(deltaF, V8Neg(appliedForce));
+			const Vec8V newAppliedForce = V8Min(V8MulAdd(V8LoadPair(c.impulseMultiplier, delta), appliedForce, deltaF), maxImpulse);
+			deltaF = V8Sub(newAppliedForce, appliedForce);
+
+			if(residualReportingActive)
+			{
+				error0.accumulateErrorLocalV4(V8GetLo(deltaF), V8GetLo(velMultiplier));
+				error1.accumulateErrorLocalV4(V8GetHi(deltaF), V8GetHi(velMultiplier));
+			}
+
+			accumDeltaF = V8Add(accumDeltaF, deltaF);
+
+			const Vec8V angDetaF0 = V8Mul(deltaF, angD0);
+			const Vec8V angDetaF1 = V8Mul(deltaF, angD1);
+
+			relVel1 = V8MulAdd(sumInvMass, deltaF, relVel1);
+
+			angState0T0 = V8MulAdd(raXnX, angDetaF0, angState0T0);
+			angState1T0 = V8NegMulSub(rbXnX, angDetaF1, angState1T0);
+
+			angState0T1 = V8MulAdd(raXnY, angDetaF0, angState0T1);
+			angState1T1 = V8NegMulSub(rbXnY, angDetaF1, angState1T1);
+
+			angState0T2 = V8MulAdd(raXnZ, angDetaF0, angState0T2);
+			angState1T2 = V8NegMulSub(rbXnZ, angDetaF1, angState1T2);
+
+			V8StorePair(appliedForces[i], delta, newAppliedForce);
+
+			accumulatedNormalImpulse = V8Add(accumulatedNormalImpulse, newAppliedForce);
+		}
+
+		const Vec8V accumDeltaF_IM0 = V8Mul(accumDeltaF, invMassA);
+		const Vec8V accumDeltaF_IM1 = V8Mul(accumDeltaF, invMassB);
+
+		linVel0T0 = V8MulAdd(_normalT0, accumDeltaF_IM0, linVel0T0);
+		linVel1T0 = V8NegMulSub(_normalT0, accumDeltaF_IM1, linVel1T0);
+		linVel0T1 = V8MulAdd(_normalT1, accumDeltaF_IM0, linVel0T1);
+		linVel1T1 = V8NegMulSub(_normalT1, accumDeltaF_IM1, linVel1T1);
+		linVel0T2 = V8MulAdd(_normalT2, accumDeltaF_IM0, linVel0T2);
+		linVel1T2 = V8NegMulSub(_normalT2, accumDeltaF_IM1, linVel1T2);
+
+		if(cache.doFriction && numFrictionConstr)
+		{
+			const Vec8V staticFric = V8LoadPair(hdr->staticFriction, delta);
+			const Vec8V dynamicFric = V8LoadPair(hdr->dynamicFriction, delta);
+
+			const Vec8V maxFrictionImpulse = V8Mul(staticFric, accumulatedNormalImpulse);
+			const Vec8V maxDynFrictionImpulse = V8Mul(dynamicFric, accumulatedNormalImpulse);
+			const Vec8V negMaxDynFrictionImpulse = V8Neg(maxDynFrictionImpulse);
+			BoolV8 broken = B8FFFFFFFF();
+
+			for(PxU32 i=0;i<numFrictionConstr;i++)
+			{
+				const SolverContactFrictionDynamic4& f = frictions[i];
+
+				const Vec8V appliedForce = V8LoadPair(frictionAppliedForce[i], delta);
+
+				const Vec8V normalT0 = V8LoadPair(fd->normalX[i&1], delta);
+				const Vec8V normalT1 = V8LoadPair(fd->normalY[i&1], delta);
+				const Vec8V normalT2 = V8LoadPair(fd->normalZ[i&1], delta);
+
+				const Vec8V raXnX = V8LoadPair(f.raXnX, delta);
+				const Vec8V raXnY = V8LoadPair(f.raXnY, delta);
+				const Vec8V raXnZ = V8LoadPair(f.raXnZ, delta);
+				const Vec8V rbXnX = V8LoadPair(f.rbXnX, delta);
+				const Vec8V rbXnY = V8LoadPair(f.rbXnY, delta);
+				const Vec8V rbXnZ = V8LoadPair(f.rbXnZ, delta);
+				const Vec8V velMultiplier = V8LoadPair(f.velMultiplier, delta);
+
+				Vec8V normalVel1 = V8Mul(linVel0T0, normalT0);
+				Vec8V normalVel2 = V8Mul(raXnX, angState0T0);
+				Vec8V normalVel3 = V8Mul(linVel1T0, normalT0);
+				Vec8V normalVel4 = V8Mul(rbXnX, angState1T0);
+
+				normalVel1 = V8MulAdd(linVel0T1, normalT1, normalVel1);
+				normalVel2 = V8MulAdd(raXnY, angState0T1, normalVel2);
+				normalVel3 = V8MulAdd(linVel1T1, normalT1, normalVel3);
+				normalVel4 = V8MulAdd(rbXnY, angState1T1, normalVel4);
+
+				normalVel1 = V8MulAdd(linVel0T2, normalT2, normalVel1);
+				normalVel2 = V8MulAdd(raXnZ, angState0T2, normalVel2);
+				normalVel3 = V8MulAdd(linVel1T2, normalT2, normalVel3);
+				normalVel4 = V8MulAdd(rbXnZ, angState1T2, normalVel4);
+
+				const Vec8V normalVel_tmp2 = V8Add(normalVel1, normalVel2);
+				const Vec8V normalVel_tmp1 = V8Add(normalVel3, normalVel4);
+
+				const Vec8V normalVel = V8Sub(normalVel_tmp2, normalVel_tmp1);
+
+				const Vec8V tmp1 = V8Sub(appliedForce, V8LoadPair(f.scaledBias, delta));
+
+				const Vec8V totalImpulse = V8NegMulSub(normalVel, velMultiplier, tmp1);
+
+				broken = B8Or(broken, V8IsGrtr(V8Abs(totalImpulse), maxFrictionImpulse));
+
+				const Vec8V newAppliedForce = V8Sel(broken, V8Min(maxDynFrictionImpulse, V8Max(negMaxDynFrictionImpulse, totalImpulse)), totalImpulse);
+
+				const Vec8V deltaF = V8Sub(newAppliedForce, appliedForce);
+
+				if(residualReportingActive)
+				{
+					error0.accumulateErrorLocalV4(V8GetLo(deltaF), V8GetLo(velMultiplier));
+					error1.accumulateErrorLocalV4(V8GetHi(deltaF), V8GetHi(velMultiplier));
+				}
+
+				V8StorePair(frictionAppliedForce[i], delta, newAppliedForce);
+
+				const Vec8V deltaFIM0 = V8Mul(deltaF, invMassA);
+				const Vec8V deltaFIM1 = V8Mul(deltaF, invMassB);
+
+				const Vec8V angDetaF0 = V8Mul(deltaF, angD0);
+				const Vec8V angDetaF1 = V8Mul(deltaF, angD1);
+
+				linVel0T0 = V8MulAdd(normalT0, deltaFIM0, linVel0T0);
+				linVel1T0 = V8NegMulSub(normalT0, deltaFIM1, linVel1T0);
+				angState0T0 = V8MulAdd(raXnX, angDetaF0, angState0T0);
+				angState1T0 = V8NegMulSub(rbXnX, angDetaF1, angState1T0);
+
+				linVel0T1 = V8MulAdd(normalT1, deltaFIM0, linVel0T1);
+				linVel1T1 = V8NegMulSub(normalT1, deltaFIM1, linVel1T1);
+				angState0T1 = V8MulAdd(raXnY, angDetaF0, angState0T1);
+				angState1T1 = V8NegMulSub(rbXnY, angDetaF1, angState1T1);
+
+				linVel0T2 = V8MulAdd(normalT2, deltaFIM0, linVel0T2);
+				linVel1T2 = V8NegMulSub(normalT2, deltaFIM1, linVel1T2);
+				angState0T2 = V8MulAdd(raXnZ, angDetaF0, angState0T2);
+				angState1T2 = V8NegMulSub(rbXnZ, angDetaF1, angState1T2);
+			}
+			V8StorePair(fd->broken, delta, broken);
+		}
+	}
+
+	PX_ALIGN(16, Vec4V linVel0[8]);
+	PX_ALIGN(16, Vec4V linVel1[8]);
+	PX_ALIGN(16, Vec4V angState0[8]);
+	PX_ALIGN(16, Vec4V angState1[8]);
+	V8Transpose(linVel0T0, linVel0T1, linVel0T2, linVel0T3, linVel0);
+	V8Transpose(linVel1T0, linVel1T1, linVel1T2, linVel1T3, linVel1);
+	V8Transpose(angState0T0, angState0T1, angState0T2, angState0T3, angState0);
+	V8Transpose(angState1T0, angState1T1, angState1T2, angState1T3, angState1);
+
+	// Write back
+	for(PxU32 i=0;i<8;i++)
+	{
+		PxSolverBody& b0 = *desc[i].bodyA;
+		V4StoreA(linVel0[i], &b0.linearVelocity.x);
+		V4StoreA(angState0[i], &b0.angularState.x);
+		PX_ASSERT(b0.linearVelocity.isFinite());
+		PX_ASSERT(b0.angularState.isFinite());
+
+		if(desc[i].bodyBDataIndex != 0)
+		{
+			PxSolverBody& b1 = *desc[i].bodyB;
+			V4StoreA(linVel1[i], &b1.linearVelocity.x);
+			V4StoreA(angState1[i], &b1.angularState.x);
+			PX_ASSERT(b1.linearVelocity.isFinite());
+			PX_ASSERT(b1.angularState.isFinite());
+		}
+	}
+
+	if(residualReportingActive)
+	{
+		error0.accumulateErrorGlobal(*cache.contactErrorAccumulator);
+		error1.accumulateErrorGlobal(*cache.contactErrorAccumulator);
+	}
+}
+
+// 8-wide version of the TGS solveContact4_Block (DyTGSContactPrepBlock.cpp). The first 4 lanes come from the stream of desc[0],
+// the last 4 from the stream of desc[4]. Both streams have the same layout so we only walk the first one.
+void solveContactStep8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, const bool doFriction, const PxReal minPenetration,
+	const PxReal elapsedTimeF32, SolverContext& cache)
+{
+	const PxF32* linVel0Ptrs[8];
+	const PxF32* linVel1Ptrs[8];
+	const PxF32* angState0Ptrs[8];
+	const PxF32* angState1Ptrs[8];
+	const PxF32* linDelta0Ptrs[8];
+	const PxF32* linDelta1Ptrs[8];
+	const PxF32* angDelta0Ptrs[8];
+	const PxF32* angDelta1Ptrs[8];
+	for(PxU32 i=0;i<8;i++)
+	{
+		linVel0Ptrs[i] = &desc[i].tgsBodyA->linearVelocity.x;
+		linVel1Ptrs[i] = &desc[i].tgsBodyB->linearVelocity.x;
+		angState0Ptrs[i] = &desc[i].tgsBodyA->angularVelocity.x;
+		angState1Ptrs[i] = &desc[i].tgsBodyB->angularVelocity.x;
+		linDelta0Ptrs[i] = &desc[i].tgsBodyA->deltaLinDt.x;
+		linDelta1Ptrs[i] = &desc[i].tgsBodyB->deltaLinDt.x;
+		angDelta0Ptrs[i] = &desc[i].tgsBodyA->deltaAngDt.x;
+		angDelta1Ptrs[i] = &desc[i].tgsBodyB->deltaAngDt.x;
+	}
+
+	const Vec8V minPen = V8Load(minPenetration);
+
+	const Vec8V elapsedTime = V8Load(elapsedTimeF32);
+
+	const Vec8V vZero = V8Zero();
+
+	Vec8V linVel0T0, linVel0T1, linVel0T2, linVel0T3;
+	Vec8V linVel1T0, linVel1T1, linVel1T2, linVel1T3;
+	Vec8V angState0T0, angState0T1, angState0T2, angState0T3;
+	Vec8V angState1T0, angState1T1, angState1T2, angState1T3;
+
+	V8LoadTransposed(linVel0Ptrs, linVel0T0, linVel0T1, linVel0T2, linVel0T3);
+	V8LoadTransposed(linVel1Ptrs, linVel1T0, linVel1T1, linVel1T2, linVel1T3);
+	V8LoadTransposed(angState0Ptrs, angState0T0, angState0T1, angState0T2, angState0T3);
+	V8LoadTransposed(angState1Ptrs, angState1T0, angState1T1, angState1T2, angState1T3);
+
+	Vec8V linDelta0T0, linDelta0T1, linDelta0T2, linDelta0T3;
+	Vec8V linDelta1T0, linDelta1T1, linDelta1T2, linDelta1T3;
+	Vec8V angDelta0T0, angDelta0T1, angDelta0T2, angDelta0T3;
+	Vec8V angDelta1T0, angDelta1T1, angDelta1T2, angDelta1T3;
+
+	V8LoadTransposed(linDelta0Ptrs, linDelta0T0, linDelta0T1, linDelta0T2, linDelta0T3);
+	V8LoadTransposed(linDelta1Ptrs, linDelta1T0, linDelta1T1, linDelta1T2, linDelta1T3);
+	V8LoadTransposed(angDelta0Ptrs, angDelta0T0, angDelta0T1, angDelta0T2, angDelta0T3);
+	V8LoadTransposed(angDelta1Ptrs, angDelta1T0, angDelta1T1, angDelta1T2, angDelta1T3);
+	PX_UNUSED(linDelta0T3);
+	PX_UNUSED(linDelta1T3);
+	PX_UNUSED(angDelta0T3);
+	PX_UNUSED(angDelta1T3);
+
+	PX_ASSERT(canBatchContact4BlocksStep(desc[0], desc[4]));
+
+	const PxU8* PX_RESTRICT last = desc[0].constraint + getConstraintLength(desc[0]);
+
+	PxU8* PX_RESTRICT currPtr = desc[0].constraint;
+
+	// offset from any field of the first block to the same field of the second block
+	const ptrdiff_t delta = desc[4].constraint - desc[0].constraint;
+
+	const Vec8V vMax = V8Load(PX_MAX_REAL);
+
+	SolverContactHeaderStepBlock* PX_RESTRICT hdr = reinterpret_cast<SolverContactHeaderStepBlock*>(currPtr);
+
+	const Vec8V invMassA = V8LoadPair(hdr->invMass0D0, delta);
+	const Vec8V invMassB = V8LoadPair(hdr->invMass1D1, delta);
+
+	const Vec8V sumInvMass = V8Add(invMassA, invMassB);
+
+	const Vec8V linDeltaX = V8Sub(linDelta0T0, linDelta1T0);
+	const Vec8V linDeltaY = V8Sub(linDelta0T1, linDelta1T1);
+	const Vec8V linDeltaZ = V8Sub(linDelta0T2, linDelta1T2);
+
+	Dy::ErrorAccumulator errorLo, errorHi;
+	const bool residualReportingActive = cache.contactErrorAccumulator;
+
+	while (currPtr < last)
+	{
+		hdr = reinterpret_cast<SolverContactHeaderStepBlock*>(currPtr);
+
+		PX_ASSERT(hdr->type == DY_SC_TYPE_BLOCK_RB_CONTACT);
+
+		currPtr = reinterpret_cast<PxU8*>(const_cast<SolverContactHeaderStepBlock*>(hdr) + 1);
+
+		const PxU32 numNormalConstr = hdr->numNormalConstr;
+		const PxU32	numFrictionConstr = hdr->numFrictionConstr;
+
+		const bool hasMaxImpulse = (hdr->flag & SolverContactHeaderStepBlock::eHAS_MAX_IMPULSE) != 0;
+
+		Vec4V* appliedForces = reinterpret_cast<Vec4V*>(currPtr);
+		currPtr += sizeof(Vec4V)*numNormalConstr;
+
+		SolverContactPointStepBlock* PX_RESTRICT contacts = reinterpret_cast<SolverContactPointStepBlock*>(currPtr);
+
+		Vec4V* maxImpulses = NULL;
+		currPtr = reinterpret_cast<PxU8*>(contacts + numNormalConstr);
+		if (hasMaxImpulse)
+		{
+			maxImpulses = reinterpret_cast<Vec4V*>(currPtr);
+			currPtr += sizeof(Vec4V) * numNormalConstr;
+		}
+
+		Vec4V* frictionAppliedForce = reinterpret_cast<Vec4V*>(currPtr);
+		currPtr += sizeof(Vec4V)*numFrictionConstr;
+
+		const SolverContactFrictionStepBlock* PX_RESTRICT frictions = reinterpret_cast<SolverContactFrictionStepBlock*>(currPtr);
+		currPtr += numFrictionConstr * sizeof(SolverContactFrictionStepBlock);
+
+		Vec8V accumulatedNormalImpulse = vZero;
+
+		const Vec8V angD0 = V8LoadPair(hdr->angDom0, delta);
+		const Vec8V angD1 = V8LoadPair(hdr->angDom1, delta);
+
+		const Vec8V _normalT0 = V8LoadPair(hdr->normalX, delta);
+		const Vec8V _normalT1 = V8LoadPair(hdr->normalY, delta);
+		const Vec8V _normalT2 = V8LoadPair(hdr->normalZ, delta);
+
+		Vec8V contactNormalVel1 = V8Mul(linVel0T0, _normalT0);
+		Vec8V contactNormalVel3 = V8Mul(linVel1T0, _normalT0);
+		contactNormalVel1 = V8MulAdd(linVel0T1, _normalT1, contactNormalVel1);
+		contactNormalVel3 = V8MulAdd(linVel1T1, _normalT1, contactNormalVel3);
+		contactNormalVel1 = V8MulAdd(linVel0T2, _normalT2, contactNormalVel1);
+		contactNormalVel3 = V8MulAdd(linVel1T2, _normalT2, contactNormalVel3);
+
+		const Vec8V maxPenBias = V8LoadPair(hdr->maxPenBias, delta);
+
+		Vec8V relVel1 = V8Sub(contactNormalVel1, contactNormalVel3);
+
+		Vec8V deltaNormalV = V8Mul(linDeltaX, _normalT0);
+		deltaNormalV = V8MulAdd(linDeltaY, _normalT1, deltaNormalV);
+		deltaNormalV = V8MulAdd(linDeltaZ, _normalT2, deltaNormalV);
+
+		Vec8V accumDeltaF = vZero;
+
+		for (PxU32 i = 0; i<numNormalConstr; i++)
+		{
+			const SolverContactPointStepBlock& c = contacts[i];
+
+			const Vec8V appliedForce = V8LoadPair(appliedForces[i], delta);
+			const Vec8V maxImpulse = hasMaxImpulse ? V8LoadPair(maxImpulses[i], delta) : vMax;
+
+			const Vec8V raXn0 = V8LoadPair(c.raXnI[0], delta);
+			const Vec8V raXn1 = V8LoadPair(c.raXnI[1], delta);
+			const Vec8V raXn2 = V8LoadPair(c.raXnI[2], delta);
+			const Vec8V rbXn0 = V8LoadPair(c.rbXnI[0], delta);
+			const Vec8V rbXn1 = V8LoadPair(c.rbXnI[1], delta);
+			const Vec8V rbXn2 = V8LoadPair(c.rbXnI[2], delta);
+
+			Vec8V contactNormalVel2 = V8Mul(raXn0, angState0T0);
+			Vec8V contactNormalVel4 = V8Mul(rbXn0, angState1T0);
+
+			contactNormalVel2 = V8MulAdd(raXn1, angState0T1, contactNormalVel2);
+			contactNormalVel4 = V8MulAdd(rbXn1, angState1T1, contactNormalVel4);
+
+			contactNormalVel2 = V8MulAdd(raXn2, angState0T2, contactNormalVel2);
+			contactNormalVel4 = V8MulAdd(rbXn2, angState1T2, contactNormalVel4);
+
+			const Vec8V normalVel = V8Add(relVel1, V8Sub(contactNormalVel2, contactNormalVel4));
+
+			Vec8V angDelta0 = V8Mul(angDelta0T0, raXn0);
+			Vec8V angDelta1 = V8Mul(angDelta1T0, rbXn0);
+			angDelta0 = V8MulAdd(angDelta0T1, raXn1, angDelta0);
+			angDelta1 = V8MulAdd(angDelta1T1, rbXn1, angDelta1);
+			angDelta0 = V8MulAdd(angDelta0T2, raXn2, angDelta0);
+			angDelta1 = V8MulAdd(angDelta1T2, rbXn2, angDelta1);
+
+			const Vec8V deltaAng = V8Sub(angDelta0, angDelta1);
+
+			const Vec8V targetVel = V8LoadPair(c.targetVelocity, delta);
+
+			const Vec8V deltaBias = V8Sub(V8Add(deltaNormalV, deltaAng), V8Mul(targetVel, elapsedTime));
+
+			const Vec8V biasCoefficient = V8LoadPair(c.biasCoefficient, delta);
+
+			const Vec8V sep = V8Max(minPen, V8Add(V8LoadPair(c.separation, delta), deltaBias));
+
+			const Vec8V bias = V8Min(V8Neg(maxPenBias), V8Mul(biasCoefficient, sep));
+
+			const Vec8V velMultiplier = V8LoadPair(c.velMultiplier, delta);
+
+			const Vec8V tVelBias = V8Mul(bias, V8LoadPair(c.recipResponse, delta));
+
+			const Vec8V _deltaF = V8Max(V8Sub(tVelBias, V8Mul(V8Sub(normalVel, targetVel), velMultiplier)), V8Neg(appliedForce));
+
+			const Vec8V newAppliedForce = V8Min(V8Add(appliedForce, _deltaF), maxImpulse);
+			const Vec8V deltaF = V8Sub(newAppliedForce, appliedForce);
+
+			if (residualReportingActive)
+			{
+				errorLo.accumulateErrorLocalV4(V8GetLo(deltaF), V8GetLo(velMultiplier));
+				errorHi.accumulateErrorLocalV4(V8GetHi(deltaF), V8GetHi(velMultiplier));
+			}
+
+			accumDeltaF = V8Add(accumDeltaF, deltaF);
+
+			const Vec8V angDetaF0 = V8Mul(deltaF, angD0);
+			const Vec8V angDetaF1 = V8Mul(deltaF, angD1);
+
+			relVel1 = V8MulAdd(sumInvMass, deltaF, relVel1);
+
+			angState0T0 = V8MulAdd(raXn0, angDetaF0, angState0T0);
+			angState1T0 = V8NegMulSub(rbXn0, angDetaF1, angState1T0);
+
+			angState0T1 = V8MulAdd(raXn1, angDetaF0, angState0T1);
+			angState1T1 = V8NegMulSub(rbXn1, angDetaF1, angState1T1);
+
+			angState0T2 = V8MulAdd(raXn2, angDetaF0, angState0T2);
+			angState1T2 = V8NegMulSub(rbXn2, angDetaF1, angState1T2);
+
+			V8StorePair(appliedForces[i], delta, newAppliedForce);
+
+			accumulatedNormalImpulse = V8Add(accumulatedNormalImpulse, newAppliedForce);
+		}
+
+		const Vec8V accumDeltaF_IM0 = V8Mul(accumDeltaF, invMassA);
+		const Vec8V accumDeltaF_IM1 = V8Mul(accumDeltaF, invMassB);
+
+		linVel0T0 = V8MulAdd(_normalT0, accumDeltaF_IM0, linVel0T0);
+		linVel1T0 = V8NegMulSub(_normalT0, accumDeltaF_IM1, linVel1T0);
+		linVel0T1 = V8MulAdd(_normalT1, accumDeltaF_IM0, linVel0T1);
+		linVel1T1 = V8NegMulSub(_normalT1, accumDeltaF_IM1, linVel1T1);
+		linVel0T2 = V8MulAdd(_normalT2, accumDeltaF_IM0, linVel0T2);
+		linVel1T2 = V8NegMulSub(_normalT2, accumDeltaF_IM1, linVel1T2);
+
+		if (doFriction && numFrictionConstr)
+		{
+			const Vec8V staticFric = V8LoadPair(hdr->staticFriction, delta);
+			const Vec8V dynamicFric = V8LoadPair(hdr->dynamicFriction, delta);
+
+			const Vec8V maxFrictionImpulse = V8Add(V8Mul(staticFric, accumulatedNormalImpulse), V8Load(1e-5f));
+			const Vec8V maxDynFrictionImpulse = V8Mul(dynamicFric, accumulatedNormalImpulse);
+			BoolV8 broken = B8FFFFFFFF();
+
+			for (PxU32 i = 0; i<numFrictionConstr; i+=2)
+			{
+				const SolverContactFrictionStepBlock& f0 = frictions[i];
+				const SolverContactFrictionStepBlock& f1 = frictions[i+1];
+
+				const Vec8V appliedForce0 = V8LoadPair(frictionAppliedForce[i], delta);
+				const Vec8V appliedForce1 = V8LoadPair(frictionAppliedForce[i+1], delta);
+
+				const Vec8V normalT00 = V8LoadPair(f0.normal[0], delta);
+				const Vec8V normalT10 = V8LoadPair(f0.normal[1], delta);
+				const Vec8V normalT20 = V8LoadPair(f0.normal[2], delta);
+
+				const Vec8V normalT01 = V8LoadPair(f1.normal[0], delta);
+				const Vec8V normalT11 = V8LoadPair(f1.normal[1], delta);
+				const Vec8V normalT21 = V8LoadPair(f1.normal[2], delta);
+
+				const Vec8V raXn00 = V8LoadPair(f0.raXnI[0], delta);
+				const Vec8V raXn10 = V8LoadPair(f0.raXnI[1], delta);
+				const Vec8V raXn20 = V8LoadPair(f0.raXnI[2], delta);
+				const Vec8V rbXn00 = V8LoadPair(f0.rbXnI[0], delta);
+				const Vec8V rbXn10 = V8LoadPair(f0.rbXnI[1], delta);
+				const Vec8V rbXn20 = V8LoadPair(f0.rbXnI[2], delta);
+
+				const Vec8V raXn01 = V8LoadPair(f1.raXnI[0], delta);
+				const Vec8V raXn11 = V8LoadPair(f1.raXnI[1], delta);
+				const Vec8V raXn21 = V8LoadPair(f1.raXnI[2], delta);
+				const Vec8V rbXn01 = V8LoadPair(f1.rbXnI[0], delta);
+				const Vec8V rbXn11 = V8LoadPair(f1.rbXnI[1], delta);
+				const Vec8V rbXn21 = V8LoadPair(f1.rbXnI[2], delta);
+
+				Vec8V normalVel10 = V8Mul(linVel0T0, normalT00);
+				Vec8V normalVel20 = V8Mul(raXn00, angState0T0);
+				Vec8V normalVel30 = V8Mul(linVel1T0, normalT00);
+				Vec8V normalVel40 = V8Mul(rbXn00, angState1T0);
+				Vec8V normalVel11 = V8Mul(linVel0T0, normalT01);
+				Vec8V normalVel21 = V8Mul(raXn01, angState0T0);
+				Vec8V normalVel31 = V8Mul(linVel1T0, normalT01);
+				Vec8V normalVel41 = V8Mul(rbXn01, angState1T0);
+
+				normalVel10 = V8MulAdd(linVel0T1, normalT10, normalVel10);
+				normalVel20 = V8MulAdd(raXn10, angState0T1, normalVel20);
+				normalVel30 = V8MulAdd(linVel1T1, normalT10, normalVel30);
+				normalVel40 = V8MulAdd(rbXn10, angState1T1, normalVel40);
+				normalVel11 = V8MulAdd(linVel0T1, normalT11, normalVel11);
+				normalVel21 = V8MulAdd(raXn11, angState0T1, normalVel21);
+				normalVel31 = V8MulAdd(linVel1T1, normalT11, normalVel31);
+				normalVel41 = V8MulAdd(rbXn11, angState1T1, normalVel41);
+
+				normalVel10 = V8MulAdd(linVel0T2, normalT20, normalVel10);
+				normalVel20 = V8MulAdd(raXn20, angState0T2, normalVel20);
+				normalVel30 = V8MulAdd(linVel1T2, normalT20, normalVel30);
+				normalVel40 = V8MulAdd(rbXn20, angState1T2, normalVel40);
+				normalVel11 = V8MulAdd(linVel0T2, normalT21, normalVel11);
+				normalVel21 = V8MulAdd(raXn21, angState0T2, normalVel21);
+				normalVel31 = V8MulAdd(linVel1T2, normalT21, normalVel31);
+				normalVel41 = V8MulAdd(rbXn21, angState1T2, normalVel41);
+
+				const Vec8V normalVel0_tmp1 = V8Add(normalVel10, normalVel20);
+				const Vec8V normalVel0_tmp2 = V8Add(normalVel30, normalVel40);
+				const Vec8V normalVel0 = V8Sub(normalVel0_tmp1, normalVel0_tmp2);
+				const Vec8V normalVel1_tmp1 = V8Add(normalVel11, normalVel21);
+				const Vec8V normalVel1_tmp2 = V8Add(normalVel31, normalVel41);
+				const Vec8V normalVel1 = V8Sub(normalVel1_tmp1, normalVel1_tmp2);
+
+				Vec8V deltaV0 = V8Mul(linDeltaX, normalT00);
+				deltaV0 = V8MulAdd(linDeltaY, normalT10, deltaV0);
+				deltaV0 = V8MulAdd(linDeltaZ, normalT20, deltaV0);
+				Vec8V deltaV1 = V8Mul(linDeltaX, normalT01);
+				deltaV1 = V8MulAdd(linDeltaY, normalT11, deltaV1);
+				deltaV1 = V8MulAdd(linDeltaZ, normalT21, deltaV1);
+
+				Vec8V angDelta00 = V8Mul(angDelta0T0, raXn00);
+				Vec8V angDelta10 = V8Mul(angDelta1T0, rbXn00);
+				angDelta00 = V8MulAdd(angDelta0T1, raXn10, angDelta00);
+				angDelta10 = V8MulAdd(angDelta1T1, rbXn10, angDelta10);
+				angDelta00 = V8MulAdd(angDelta0T2, raXn20, angDelta00);
+				angDelta10 = V8MulAdd(angDelta1T2, rbXn20, angDelta10);
+
+				Vec8V angDelta01 = V8Mul(angDelta0T0, raXn01);
+				Vec8V angDelta11 = V8Mul(angDelta1T0, rbXn01);
+				angDelta01 = V8MulAdd(angDelta0T1, raXn11, angDelta01);
+				angDelta11 = V8MulAdd(angDelta1T1, rbXn11, angDelta11);
+				angDelta01 = V8MulAdd(angDelta0T2, raXn21, angDelta01);
+				angDelta11 = V8MulAdd(angDelta1T2, rbXn21, angDelta11);
+
+				const Vec8V deltaAng0 = V8Sub(angDelta00, angDelta10);
+				const Vec8V deltaAng1 = V8Sub(angDelta01, angDelta11);
+
+				const Vec8V targetVel0 = V8LoadPair(f0.targetVel, delta);
+				const Vec8V targetVel1 = V8LoadPair(f1.targetVel, delta);
+
+				const Vec8V deltaBias0 = V8Sub(V8Add(deltaV0, deltaAng0), V8Mul(targetVel0, elapsedTime));
+				const Vec8V deltaBias1 = V8Sub(V8Add(deltaV1, deltaAng1), V8Mul(targetVel1, elapsedTime));
+
+				const Vec8V error0 = V8Add(V8LoadPair(f0.error, delta), deltaBias0);
+				const Vec8V error1 = V8Add(V8LoadPair(f1.error, delta), deltaBias1);
+
+				const Vec8V bias0 = V8Mul(error0, V8LoadPair(f0.biasCoefficient, delta));
+				const Vec8V bias1 = V8Mul(error1, V8LoadPair(f1.biasCoefficient, delta));
+
+				const Vec8V velMultiplier0 = V8LoadPair(f0.velMultiplier, delta);
+				const Vec8V velMultiplier1 = V8LoadPair(f1.velMultiplier, delta);
+
+				const Vec8V tmp10 = V8NegMulSub(V8Sub(bias0, targetVel0), velMultiplier0, appliedForce0);
+				const Vec8V tmp11 = V8NegMulSub(V8Sub(bias1, targetVel1), velMultiplier1, appliedForce1);
+
+				const Vec8V totalImpulse0 = V8NegMulSub(normalVel0, velMultiplier0, tmp10);
+				const Vec8V totalImpulse1 = V8NegMulSub(normalVel1, velMultiplier1, tmp11);
+
+				const Vec8V totalImpulse = V8Sqrt(V8MulAdd(totalImpulse0, totalImpulse0, V8Mul(totalImpulse1, totalImpulse1)));
+
+				const BoolV8 clamped = V8IsGrtr(totalImpulse, maxFrictionImpulse);
+
+				broken = B8Or(broken, clamped);
+
+				const Vec8V totalClamped = V8Sel(broken, V8Min(totalImpulse, maxDynFrictionImpulse), totalImpulse);
+				const Vec8V ratio = V8Sel(V8IsGrtr(totalImpulse, vZero), V8Div(totalClamped, totalImpulse), vZero);
+
+				const Vec8V newAppliedForce0 = V8Mul(totalImpulse0, ratio);
+				const Vec8V newAppliedForce1 = V8Mul(totalImpulse1, ratio);
+
+				const Vec8V deltaF0 = V8Sub(newAppliedForce0, appliedForce0);
+				const Vec8V deltaF1 = V8Sub(newAppliedForce1, appliedForce1);
+
+				if (residualReportingActive)
+				{
+					errorLo.accumulateErrorLocalV4(V8GetLo(deltaF0), V8GetLo(velMultiplier0), V8GetLo(deltaF1), V8GetLo(velMultiplier1));
+					errorHi.accumulateErrorLocalV4(V8GetHi(deltaF0), V8GetHi(velMultiplier0), V8GetHi(deltaF1), V8GetHi(velMultiplier1));
+				}
+
+				V8StorePair(frictionAppliedForce[i], delta, newAppliedForce0);
+				V8StorePair(frictionAppliedForce[i+1], delta, newAppliedForce1);
+
+				const Vec8V deltaFIM00 = V8Mul(deltaF0, invMassA);
+				const Vec8V deltaFIM10 = V8Mul(deltaF0, invMassB);
+				const Vec8V angDetaF00 = V8Mul(deltaF0, angD0);
+				const Vec8V angDetaF10 = V8Mul(deltaF0, angD1);
+
+				const Vec8V deltaFIM01 = V8Mul(deltaF1, invMassA);
+				const Vec8V deltaFIM11 = V8Mul(deltaF1, invMassB);
+				const Vec8V angDetaF01 = V8Mul(deltaF1, angD0);
+				const Vec8V angDetaF11 = V8Mul(deltaF1, angD1);
+
+				linVel0T0 = V8MulAdd(normalT00, deltaFIM00, V8MulAdd(normalT01, deltaFIM01, linVel0T0));
+				linVel1T0 = V8NegMulSub(normalT00, deltaFIM10, V8NegMulSub(normalT01, deltaFIM11, linVel1T0));
+				angState0T0 = V8MulAdd(raXn00, angDetaF00, V8MulAdd(raXn01, angDetaF01, angState0T0));
+				angState1T0 = V8NegMulSub(rbXn00, angDetaF10, V8NegMulSub(rbXn01, angDetaF11, angState1T0));
+
+				linVel0T1 = V8MulAdd(normalT10, deltaFIM00, V8MulAdd(normalT11, deltaFIM01, linVel0T1));
+				linVel1T1 = V8NegMulSub(normalT10, deltaFIM10, V8NegMulSub(normalT11, deltaFIM11, linVel1T1));
+				angState0T1 = V8MulAdd(raXn10, angDetaF00, V8MulAdd(raXn11, angDetaF01, angState0T1));
+				angState1T1 = V8NegMulSub(rbXn10, angDetaF10, V8NegMulSub(rbXn11, angDetaF11, angState1T1));
+
+				linVel0T2 = V8MulAdd(normalT20, deltaFIM00, V8MulAdd(normalT21, deltaFIM01, linVel0T2));
+				linVel1T2 = V8NegMulSub(normalT20, deltaFIM10, V8NegMulSub(normalT21, deltaFIM11, linVel1T2));
+				angState0T2 = V8MulAdd(raXn20, angDetaF00, V8MulAdd(raXn21, angDetaF01, angState0T2));
+				angState1T2 = V8NegMulSub(rbXn20, angDetaF10, V8NegMulSub(rbXn21, angDetaF11, angState1T2));
+			}
+			V8StorePair(hdr->broken, delta, broken);
+		}
+	}
+
+	PX_ALIGN(16, Vec4V linVel0[8]);
+	PX_ALIGN(16, Vec4V linVel1[8]);
+	PX_ALIGN(16, Vec4V angState0[8]);
+	PX_ALIGN(16, Vec4V angState1[8]);
+	V8Transpose(linVel0T0, linVel0T1, linVel0T2, linVel0T3, linVel0);
+	V8Transpose(linVel1T0, linVel1T1, linVel1T2, linVel1T3, linVel1);
+	V8Transpose(angState0T0, angState0T1, angState0T2, angState0T3, angState0);
+	V8Transpose(angState1T0, angState1T1, angState1T2, angState1T3, angState1);
+
+	// Write back
+	for(PxU32 i=0;i<8;i++)
+	{
+		PxTGSSolverBodyVel& b0 = *desc[i].tgsBodyA;
+		V4StoreA(linVel0[i], &b0.linearVelocity.x);
+		V4StoreA(angState0[i], &b0.angularVelocity.x);
+		PX_ASSERT(b0.linearVelocity.isFinite());
+		PX_ASSERT(b0.angularVelocity.isFinite());
+
+		if (desc[i].bodyBDataIndex != 0)
+		{
+			PxTGSSolverBodyVel& b1 = *desc[i].tgsBodyB;
+			V4StoreA(linVel1[i], &b1.linearVelocity.x);
+			V4StoreA(angState1[i], &b1.angularVelocity.x);
+			PX_ASSERT(b1.linearVelocity.isFinite());
+			PX_ASSERT(b1.angularVelocity.isFinite());
+		}
+	}
+
+	if (residualReportingActive)
+	{
+		errorLo.accumulateErrorGlobal(*cache.contactErrorAccumulator);
+		errorHi.accumulateErrorGlobal(*cache.contactErrorAccumulator);
+	}
+}
+
+}
+}
+
+#endif
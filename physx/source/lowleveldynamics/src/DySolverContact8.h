@@ -0,0 +1,76 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef DY_SOLVER_CONTACT8_H
+#define DY_SOLVER_CONTACT8_H
+
+#include "foundation/PxSimpleTypes.h"
+
+// 8-wide contact batches. Two 4-wide contact blocks from the same partition, whose constraint streams have exactly the
+// same layout, are merged into a single batch header with a stride of 8. The data of each half is left untouched (prep,
+// conclude and writeback still work on 4-wide blocks) but the solver iterations load both halves into 8-wide registers.
+// Since the corresponding field of the second half always lives at the same offset from the second stream, the 8-wide
+// kernels read and write the second half using a single constant delta between the two streams.
+//
+// The 8-wide kernels are compiled in DySolverContact8.cpp when the PX_AVX2_FMA CMake option is enabled. That file is the
+// only one compiled for AVX2/FMA, the rest of the SDK keeps targeting SSE2. Blocks are only merged when isBatch8Supported()
+// reports that the CPU and the OS support AVX2 and FMA, so the same binary still runs on older CPUs. The 8-wide kernels use
+// fused multiply-adds, so merged batches can differ in the last bits from the 4-wide path.
+#if PX_INTEL_FAMILY && !PX_SIMD_DISABLED && defined(PX_AVX2_FMA)
+	#define DY_BATCH_8	1
+#else
+	#define DY_BATCH_8	0
+#endif
+
+#if DY_BATCH_8
+
+namespace physx
+{
+struct PxSolverConstraintDesc;
+
+namespace Dy
+{
+	struct SolverContext;
+
+	// Returns true if the 8-wide kernels can run on this CPU. The result is computed once and cached.
+	bool isBatch8Supported();
+
+	// Returns true if two 4-wide rigid body contact blocks can be solved as a single 8-wide batch
+	bool canBatchContact4Blocks(const PxSolverConstraintDesc& block0, const PxSolverConstraintDesc& block1);
+	bool canBatchContact4BlocksStep(const PxSolverConstraintDesc& block0, const PxSolverConstraintDesc& block1);
+
+	// 8-wide versions of the PGS and TGS solveContact4_Block functions. Only call them when isBatch8Supported() is true.
+	void solveContact8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, SolverContext& cache);
+	void solveContactStep8_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, const bool doFriction, const PxReal minPenetration,
+		const PxReal elapsedTimeF32, SolverContext& cache);
+}
+}
+
+#endif
+
+#endif
@@ -0,0 +1,118 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+#ifndef DY_SOLVER_CONTACT_STEP4_H
+#define DY_SOLVER_CONTACT_STEP4_H
+
+#include "foundation/PxSimpleTypes.h"
+#include "foundation/PxVecMath.h"
+#include "DySolverContact.h"
+
+namespace physx
+{
+
+namespace Sc
+{
+	class ShapeInteraction;
+}
+
+namespace Dy
+{
+
+/**
+\brief Batched SOA contact data for the TGS solver.
+*/
+struct SolverContactHeaderStepBlock
+{
+	enum
+	{
+		eHAS_MAX_IMPULSE = 1 << 0,
+		eHAS_TARGET_VELOCITY = 1 << 1
+	};
+
+	PxU8	type;					//Note: mType should be first as the solver expects a type in the first byte.
+	PxU8	numNormalConstr;
+	PxU8	numFrictionConstr;
+	PxU8	flag;
+
+	PxU8	flags[4];
+
+	//KS - used for write-back only
+	PxU8	numNormalConstrs[4];
+	PxU8	numFrictionConstrs[4];
+
+	//Vec4V	restitution;
+	Vec4V   staticFriction;
+	Vec4V	dynamicFriction;
+	//Technically, these mass properties could be pulled out into a new structure and shared. For multi-manifold contacts,
+	//this would save 64 bytes per-manifold after the cost of the first manifold
+	Vec4V	invMass0D0;
+	Vec4V	invMass1D1;
+	Vec4V	angDom0;
+	Vec4V	angDom1;
+	//Normal is shared between all contacts in the batch. This will save some memory!
+	Vec4V normalX;
+	Vec4V normalY;
+	Vec4V normalZ;
+
+	Vec4V maxPenBias;
+
+	Sc::ShapeInteraction* shapeInteraction[4];		//192 or 208
+
+	BoolV broken;
+	PxU8* frictionBrokenWritebackByte[4];
+};
+
+struct SolverContactPointStepBlock
+{
+	Vec4V raXnI[3];
+	Vec4V rbXnI[3];
+	Vec4V separation;
+	Vec4V velMultiplier;
+	Vec4V targetVelocity;
+	Vec4V biasCoefficient;
+	Vec4V recipResponse;
+};
+
+//KS - technically, this friction constraint has identical data to the above contact constraint.
+//We make them separate structs for clarity
+struct SolverContactFrictionStepBlock
+{
+	Vec4V normal[3];
+	Vec4V raXnI[3];
+	Vec4V rbXnI[3];
+	Vec4V error;
+	Vec4V velMultiplier;
+	Vec4V targetVel;
+	Vec4V biasCoefficient;
+};
+
+}
+
+}
+
+#endif
@@ -42,6 +42,8 @@ using namespace Gu;
 #include "DyConstraintPrep.h"
 #include "DyTGS.h"
 #include "DySolverContext.h"
+#include "DySolverContactStep4.h"
+#include "DySolverContact8.h"
 
 namespace physx
 {
@@ -86,71 +88,6 @@ namespace Dy
 		rZ = V4Mul(V4MulAdd(qz, dotuv, tempZ), two);
 	}
 
-struct SolverContactHeaderStepBlock
-{
-	enum
-	{
-		eHAS_MAX_IMPULSE = 1 << 0,
-		eHAS_TARGET_VELOCITY = 1 << 1
-	};
-
-	PxU8	type;					//Note: mType should be first as the solver expects a type in the first byte.
-	PxU8	numNormalConstr;
-	PxU8	numFrictionConstr;
-	PxU8	flag;
-
-	PxU8	flags[4];
-
-	//KS - used for write-back only
-	PxU8	numNormalConstrs[4];
-	PxU8	numFrictionConstrs[4];
-
-	//Vec4V	restitution;
-	Vec4V   staticFriction;
-	Vec4V	dynamicFriction;
-	//Technically, these mass properties could be pulled out into a new structure and shared. For multi-manifold contacts,
-	//this would save 64 bytes per-manifold after the cost of the first manifold
-	Vec4V	invMass0D0;
-	Vec4V	invMass1D1;
-	Vec4V	angDom0;
-	Vec4V	angDom1;
-	//Normal is shared between all contacts in the batch. This will save some memory!
-	Vec4V normalX;
-	Vec4V normalY;
-	Vec4V normalZ;
-
-	Vec4V maxPenBias;
-
-	Sc::ShapeInteraction* shapeInteraction[4];		//192 or 208
-
-	BoolV broken;
-	PxU8* frictionBrokenWritebackByte[4];
-};
-
-struct SolverContactPointStepBlock
-{
-	Vec4V raXnI[3];
-	Vec4V rbXnI[3];
-	Vec4V separation;
-	Vec4V velMultiplier;
-	Vec4V targetVelocity;
-	Vec4V biasCoefficient;
-	Vec4V recipResponse;
-};
-
-//KS - technically, this friction constraint has identical data to the above contact constraint.
-//We make them separate structs for clarity
-struct SolverContactFrictionStepBlock
-{
-	Vec4V normal[3];
-	Vec4V raXnI[3];
-	Vec4V rbXnI[3];
-	Vec4V error;
-	Vec4V velMultiplier;
-	Vec4V targetVel;
-	Vec4V biasCoefficient;
-};
-
 struct SolverConstraint1DHeaderStep4
 {
 	PxU8	type;			// enum SolverConstraintType - must be first byte
@@ -2764,6 +2701,45 @@ static void solveContact4_Block(const PxSolverConstraintDesc* PX_RESTRICT desc,
 		error.accumulateErrorGlobal(*cache.contactErrorAccumulator);
 }
 
+#if DY_BATCH_8
+bool canBatchContact4BlocksStep(const PxSolverConstraintDesc& block0, const PxSolverConstraintDesc& block1)
+{
+	const PxU32 length = getConstraintLength(block0);
+	if (length != getConstraintLength(block1))
+		return false;
+
+	const PxU8* PX_RESTRICT currPtr0 = block0.constraint;
+	const PxU8* PX_RESTRICT currPtr1 = block1.constraint;
+	const PxU8* PX_RESTRICT last = currPtr0 + length;
+
+	while (currPtr0 < last)
+	{
+		const SolverContactHeaderStepBlock* PX_RESTRICT hdr0 = reinterpret_cast<const SolverContactHeaderStepBlock*>(currPtr0);
+		const SolverContactHeaderStepBlock* PX_RESTRICT hdr1 = reinterpret_cast<const SolverContactHeaderStepBlock*>(currPtr1);
+
+		if (hdr0->type != DY_SC_TYPE_BLOCK_RB_CONTACT || hdr1->type != DY_SC_TYPE_BLOCK_RB_CONTACT)
+			return false;
+
+		const PxU32 numNormalConstr = hdr0->numNormalConstr;
+		const PxU32 numFrictionConstr = hdr0->numFrictionConstr;
+		const PxU8 hasMaxImpulse = PxU8(hdr0->flag & SolverContactHeaderStepBlock::eHAS_MAX_IMPULSE);
+
+		if (numNormalConstr != hdr1->numNormalConstr || numFrictionConstr != hdr1->numFrictionConstr
+			|| hasMaxImpulse != (hdr1->flag & SolverContactHeaderStepBlock::eHAS_MAX_IMPULSE))
+			return false;
+
+		PxU32 size = sizeof(SolverContactHeaderStepBlock) + numNormalConstr * (sizeof(Vec4V) + sizeof(SolverContactPointStepBlock))
+			+ numFrictionConstr * (sizeof(Vec4V) + sizeof(SolverContactFrictionStepBlock));
+		if (hasMaxImpulse)
+			size += sizeof(Vec4V) * numNormalConstr;
+
+		currPtr0 += size;
+		currPtr1 += size;
+	}
+	return currPtr0 == last;
+}
+#endif
+
 // VR: used in both PGS and TGS
 void computeFrictionImpulseBlock(
 	const Vec4V& axis0X, const Vec4V& axis0Y, const Vec4V& axis0Z,
@@ -2941,12 +2917,21 @@ void solveContact4(DY_TGS_SOLVE_METHOD_PARAMS)
 	PX_UNUSED(txInertias);
 	//PX_UNUSED(cache);
 
+#if DY_BATCH_8
+	if (hdr.stride == 8)
+	{
+		solveContactStep8_Block(desc + hdr.startIndex, true, minPenetration, elapsedTime, cache);
+		return;
+	}
+#endif
 	solveContact4_Block(desc + hdr.startIndex, true, minPenetration, elapsedTime, cache);
 }
 
 void writeBackContact4(DY_TGS_WRITEBACK_METHOD_PARAMS)
 {
-	writeBackContact4_Block(desc + hdr.startIndex, cache);
+	// merged 8-wide batches are written back (and concluded below) one 4-wide half at a time
+	for (PxU32 i = 0; i < hdr.stride; i += 4)
+		writeBackContact4_Block(desc + hdr.startIndex + i, cache);
 }
 
 static PX_FORCE_INLINE Vec4V V4Dot3(const Vec4V& x0, const Vec4V& y0, const Vec4V& z0, const Vec4V& x1, const Vec4V& y1, const Vec4V& z1)
@@ -3621,8 +3606,11 @@ void solveConcludeContact4(DY_TGS_CONCLUDE_METHOD_PARAMS)
 	PX_UNUSED(txInertias);
 	//PX_UNUSED(cache);
 
-	solveContact4_Block(desc + hdr.startIndex, true, -PX_MAX_F32, elapsedTime, cache);
-	concludeContact4_Block(desc + hdr.startIndex);
+	for (PxU32 i = 0; i < hdr.stride; i += 4)
+	{
+		solveContact4_Block(desc + hdr.startIndex + i, true, -PX_MAX_F32, elapsedTime, cache);
+		concludeContact4_Block(desc + hdr.startIndex + i);
+	}
 }
 
 void solveConclude1D4(DY_TGS_CONCLUDE_METHOD_PARAMS)
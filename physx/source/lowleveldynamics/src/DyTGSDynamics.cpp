@@ -67,6 +67,7 @@
 #include "DyResidualAccumulator.h"
 #include "DyThreadContext.h"
 #include "DyIslandManager.h"
+#include "DySolverContact8.h"
 
 #define PX_USE_BLOCK_SOLVER 1
 #define PX_USE_BLOCK_1D 1
@@ -691,6 +692,8 @@ void DynamicsTGSContext::updatePostKinematic(IG::SimpleIslandManager& simpleIsla
 
 	const PxU32 articulationBatchSize = mSolverArticBatchSize;
 
+	PxU32 batchIndex = 0;
+
 	while (currentIsland < islandCount)
 	{
 		SolverIslandObjectsStep objectStarts;
@@ -742,7 +745,7 @@ void DynamicsTGSContext::updatePostKinematic(IG::SimpleIslandManager& simpleIsla
 		
 		solveIsland(objectStarts, counts,
 			mKinematicCount + currentBodyIndex, simpleIslandManager, mSolverBodyRemapTable.begin(), mMaterialManager, mOutputIterator,
-			mergeTask);
+			mergeTask, batchIndex++);
 
 		currentBodyIndex += nbBodies;
 		currentArticulation += nbArticulations;
@@ -2314,6 +2317,10 @@ public:
 		PxSolverConstraintDesc* contactDescBegin = mObjects.orderedConstraintDescs;
 		PxConstraintBatchHeader* headers = mObjects.constraintBatchHeaders;
 
+#if DY_BATCH_8
+		const bool batch8 = isBatch8Supported();
+#endif
+
 		PxU32 totalPartitions = 0;
 		for (PxU32 a = 0; a < mThreadContext.mConstraintsPerPartition.size(); ++a)
 		{
@@ -2341,6 +2348,22 @@ public:
 					}
 				}
 
+#if DY_BATCH_8
+				// merge two consecutive full blocks of dynamic contacts into a single 8-wide batch when their streams match.
+				// The overflow partition is skipped since processOverflowConstraints expects one constraint per header there.
+				if (batch8 && newStride == 4 && numBatchesInPartition && !(a == 0 && mThreadContext.mHasOverflowPartitions)
+					&& *contactDescBegin[startIndex].constraint == DY_SC_TYPE_BLOCK_RB_CONTACT)
+				{
+					PxConstraintBatchHeader& prevHeader = headers[numBatches - 1];
+					if (prevHeader.stride == 4 && prevHeader.constraintType == DY_SC_TYPE_BLOCK_RB_CONTACT
+						&& canBatchContact4BlocksStep(contactDescBegin[prevHeader.startIndex], contactDescBegin[startIndex]))
+					{
+						PX_ASSERT(prevHeader.startIndex + 4 == startIndex);
+						prevHeader.stride = 8;
+						continue;
+					}
+				}
+#endif
 				if (newStride != 0)
 				{
 					headers[numBatches].startIndex = startIndex;
@@ -3254,7 +3277,7 @@ void DynamicsTGSContext::solveIsland(const SolverIslandObjectsStep& objects,
 	IG::SimpleIslandManager& islandManager,
 	PxU32* bodyRemapTable, PxsMaterialManager* /*materialManager*/,
 	PxsContactManagerOutputIterator& iterator,
-	PxBaseTask* continuation)
+	PxBaseTask* continuation, PxU32 batchIndex)
 {
 	ThreadContext& mThreadContext = *getThreadContext();
 
@@ -3294,6 +3317,18 @@ void DynamicsTGSContext::solveIsland(const SolverIslandObjectsStep& objects,
 
 	EndIslandTask* endTask = PX_PLACEMENT_NEW(mTaskPool.allocate(sizeof(EndIslandTask)), EndIslandTask)(mThreadContext, *this);
 
+	// all tasks of a batch work on the same islands, let topology-aware dispatchers keep them together
+	descTask->setLocalityHint(batchIndex);
+	intTask->setLocalityHint(batchIndex);
+	articTask->setLocalityHint(batchIndex);
+	stepperTask->setLocalityHint(batchIndex);
+	articConTask->setLocalityHint(batchIndex);
+	partitionTask->setLocalityHint(batchIndex);
+	constraintTask->setLocalityHint(batchIndex);
+	solveTask->setLocalityHint(batchIndex);
+	finishTask->setLocalityHint(batchIndex);
+	endTask->setLocalityHint(batchIndex);
+
 	endTask->setContinuation(continuation);
 	finishTask->setContinuation(endTask);
 	solveTask->setContinuation(finishTask);
@@ -199,7 +199,7 @@ protected:
 				IG::SimpleIslandManager& islandManager,
 				PxU32* bodyRemapTable, PxsMaterialManager* materialManager,
 				PxsContactManagerOutputIterator& iterator,
-				PxBaseTask* continuation);
+				PxBaseTask* continuation, PxU32 batchIndex);
 
 			void prepareBodiesAndConstraints(const SolverIslandObjectsStep& objects,
 				IG::SimpleIslandManager& islandManager,
@@ -344,6 +344,12 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags) const	PX_OVERRIDE PX_FINAL;
 
+	virtual			void							raycastBatch(
+														PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,	// Ray data
+														PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const	PX_OVERRIDE PX_FINAL;
+
 	virtual			bool							sweep(
 														const PxGeometry& geometry, const PxTransform& pose,	// GeomObject data
 														const PxVec3& unitDir, const PxReal distance,	// Ray data
@@ -356,6 +362,18 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 														PxOverlapCallback& hitCall, 
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags) const	PX_OVERRIDE PX_FINAL;
+
+	virtual			bool							cull(
+														PxU32 nbPlanes, const PxPlane* planes,	// Culling volume
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const	PX_OVERRIDE PX_FINAL;
+
+	virtual			PxU32							nearest(
+														const PxVec3& point, PxReal maxDist,	// Query point & max distance
+														PxNearestHit* hits, PxU32 maxNbHits,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const	PX_OVERRIDE PX_FINAL;
 	//~PxSceneQuerySystemBase
 
 	// PxSceneSQSystem
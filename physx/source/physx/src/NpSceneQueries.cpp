@@ -207,7 +207,9 @@ namespace
 											mQueries(pvd, contextID, staticPruner, dynamicPruner, desc.dynamicTreeRebuildRateHint, SQ_PRUNER_EPSILON, desc.limits, mAdapter),
 											mUpdateMode	(desc.sceneQueryUpdateMode),
 											mRefCount	(1)
-										{}
+										{
+											SQ().setTaskDispatcher(desc.cpuDispatcher);
+										}
 		virtual							~InternalPxSQ(){}
 
 		PX_FORCE_INLINE	Sq::PrunerManager&			SQ()				{ return mQueries.mSQManager;	}
@@ -384,6 +386,14 @@ namespace
 			return mQueries._raycast(origin, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, flags);
 		}
 
+		virtual		void				raycastBatch(	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+														PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const
+		{
+			mQueries._raycastBatch(nbRays, origins, unitDirs, distances, hitCalls, hitFlags, filterData, filterCall, flags);
+		}
+
 		virtual		bool				sweep(	const PxGeometry& geometry, const PxTransform& pose,
 												const PxVec3& unitDir, const PxReal distance,
 												PxSweepCallback& hitCall, PxHitFlags hitFlags,
@@ -402,6 +412,20 @@ namespace
 			return mQueries._overlap( geometry, transform, hitCall, filterData, filterCall, cache, flags);
 		}
 
+		virtual		bool				cull(	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hitCall,
+												const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+												PxGeometryQueryFlags flags) const
+		{
+			return mQueries._cull(nbPlanes, planes, hitCall, filterData, filterCall, flags);
+		}
+
+		virtual		PxU32				nearest(const PxVec3& point, PxReal maxDist, PxNearestHit* hits, PxU32 maxNbHits,
+												const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+												PxGeometryQueryFlags flags) const
+		{
+			return mQueries._nearest(point, maxDist, hits, maxNbHits, filterData, filterCall, flags);
+		}
+
 		virtual	PxSQPrunerHandle		getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const
 		{
 			const NpActor& npActor = NpActor::getFromPxActor(actor);
@@ -455,12 +479,13 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 		case PxBVHBuildStrategy::eFAST:		return BVH_SPLATTER_POINTS;
 		case PxBVHBuildStrategy::eDEFAULT:	return BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER;
 		case PxBVHBuildStrategy::eSAH:		return BVH_SAH;
+		case PxBVHBuildStrategy::eSAH_PARALLEL:	return BVH_SAH;
 		case PxBVHBuildStrategy::eLAST:		return BVH_SPLATTER_POINTS;
 	}
 	return BVH_SPLATTER_POINTS;
 }
 
-static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
+static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode, PxCpuDispatcher* dispatcher, bool quantizedTree)
 {
 	// PT: to force testing the bucket pruner
 //	return createBucketPruner(contextID);
@@ -468,13 +493,15 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 
 	const CompanionPrunerType cpType = getCompanionType(secondaryType);
 	const BVHBuildStrategy bs = getBuildStrategy(buildStrategy);
+	// the scene's dispatcher is only used to build the trees when users opted in for parallel builds
+	PxCpuDispatcher* buildDispatcher = buildStrategy==PxBVHBuildStrategy::eSAH_PARALLEL ? dispatcher : NULL;
 
 	Pruner* pruner = NULL;
 	switch(type)
 	{
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
-		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
-		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode, buildDispatcher, quantizedTree);		break;	}
+		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode, buildDispatcher, quantizedTree);	break;	}
 		// PT: for tests
 		case PxPruningStructureType::eLAST:					{ pruner = createIncrementalPruner(contextID);									break;	}
 //		case PxPruningStructureType::eLAST:					break;
@@ -491,8 +518,8 @@ static PxSceneQuerySystem* getPxSQ(const PxSceneDesc& desc, PVDCapture* pvd, PxU
 	}
 	else
 	{
-		Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode);
-		Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode);
+		Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode, desc.cpuDispatcher, desc.staticQuantizedTree);
+		Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode, desc.cpuDispatcher, false);
 		return PX_NEW(InternalPxSQ)(desc, pvd, contextID, staticPruner, dynamicPruner);
 	}
 }
@@ -544,6 +571,15 @@ bool NpScene::raycast(
 	return mNpSQ.mSQ->raycast(origin, unitDir, distance, hits, hitFlags, filterData, filterCall, cache, flags);
 }
 
+void NpScene::raycastBatch(
+	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+	PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+	PxGeometryQueryFlags flags) const
+{
+	NP_READ_CHECK(this);
+	mNpSQ.mSQ->raycastBatch(nbRays, origins, unitDirs, distances, hitCalls, hitFlags, filterData, filterCall, flags);
+}
+
 bool NpScene::overlap(
 	const PxGeometry& geometry, const PxTransform& pose, PxOverlapCallback& hits,
 	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
@@ -562,6 +598,22 @@ bool NpScene::sweep(
 	return mNpSQ.mSQ->sweep(geometry, pose, unitDir, distance, hits, hitFlags, filterData, filterCall, cache, inflation, flags);
 }
 
+bool NpScene::cull(
+	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hits,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) const
+{
+	NP_READ_CHECK(this);
+	return mNpSQ.mSQ->cull(nbPlanes, planes, hits, filterData, filterCall, flags);
+}
+
+PxU32 NpScene::nearest(
+	const PxVec3& point, PxReal maxDist, PxNearestHit* hits, PxU32 maxNbHits,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) const
+{
+	NP_READ_CHECK(this);
+	return mNpSQ.mSQ->nearest(point, maxDist, hits, maxNbHits, filterData, filterCall, flags);
+}
+
 void NpScene::setUpdateMode(PxSceneQueryUpdateMode::Enum updateMode)
 {
 	NP_WRITE_CHECK(this);
@@ -83,6 +83,11 @@ bool PxCookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& des
 	return immediateCooking::cookConvexMesh(params, desc, stream, condition);
 }
 
+PxU32 PxCookConvexMeshes(const PxCookingParams& params, const PxConvexMeshDesc* descs, PxU32 count, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions)
+{
+	return immediateCooking::cookConvexMeshes(params, descs, count, streams, conditions);
+}
+
 PxConvexMesh* PxCreateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition)
 {
 	return immediateCooking::createConvexMesh(params, desc, insertionCallback, condition);
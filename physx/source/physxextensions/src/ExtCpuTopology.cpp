@@ -0,0 +1,123 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "ExtCpuTopology.h"
+
+#if PX_LINUX
+	#include <stdio.h>
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+using namespace physx;
+
+#if PX_LINUX
+// parses a sysfs CPU list such as "0-15,32-47"
+static void parseCpuList(const char* buffer, PxArray<PxU32>& cpus)
+{
+	const char* p = buffer;
+	while(*p >= '0' && *p <= '9')
+	{
+		PxU32 first = 0;
+		while(*p >= '0' && *p <= '9')
+			first = first * 10 + PxU32(*p++ - '0');
+
+		PxU32 last = first;
+		if(*p == '-')
+		{
+			p++;
+			last = 0;
+			while(*p >= '0' && *p <= '9')
+				last = last * 10 + PxU32(*p++ - '0');
+		}
+
+		for(PxU32 cpu=first; cpu<=last; cpu++)
+			cpus.pushBack(cpu);
+
+		if(*p == ',')
+			p++;
+	}
+}
+
+static bool readNodeCpus(PxU32 node, PxArray<PxU32>& cpus)
+{
+	char path[128];
+	snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+	FILE* fp = fopen(path, "r");
+	if(!fp)
+		return false;
+
+	char buffer[4096];
+	const bool success = fgets(buffer, sizeof(buffer), fp) != NULL;
+	fclose(fp);
+
+	if(success)
+		parseCpuList(buffer, cpus);
+	return success;
+}
+#endif
+
+Ext::CpuTopology::CpuTopology()
+{
+	mNodeStarts.pushBack(0);
+#if PX_LINUX
+	// node indices can have holes (e.g. offline nodes) so we scan a fixed range, skipping nodes without CPUs
+	const PxU32 maxNbNodes = 64;
+	for(PxU32 node=0; node<maxNbNodes; node++)
+	{
+		if(!readNodeCpus(node, mCpus))
+			continue;
+
+		if(mCpus.size() != mNodeStarts.back())
+			mNodeStarts.pushBack(mCpus.size());
+	}
+#endif
+	if(mNodeStarts.size() == 1)
+		mNodeStarts.pushBack(0);
+}
+
+bool Ext::CpuTopology::pinCurrentThread(const PxU32* cpus, PxU32 nbCpus)
+{
+#if PX_LINUX && !PX_EMSCRIPTEN
+	if(!nbCpus)
+		return false;
+
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for(PxU32 i=0; i<nbCpus; i++)
+	{
+		if(cpus[i] < CPU_SETSIZE)
+			CPU_SET(cpus[i], &set);
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+	PX_UNUSED(cpus);
+	PX_UNUSED(nbCpus);
+	return false;
+#endif
+}
@@ -0,0 +1,61 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef EXT_CPU_TOPOLOGY_H
+#define EXT_CPU_TOPOLOGY_H
+
+#include "foundation/PxArray.h"
+#include "foundation/PxUserAllocated.h"
+
+namespace physx
+{
+namespace Ext
+{
+	// CPU sets of each NUMA node, as reported by the OS. On platforms where the topology is unknown
+	// (or on single-node machines) this reports a single node with an empty CPU set.
+	class CpuTopology : public PxUserAllocated
+	{
+	public:
+						CpuTopology();
+
+		PX_FORCE_INLINE	PxU32			getNbNodes()					const	{ return mNodeStarts.size() - 1;								}
+		PX_FORCE_INLINE	PxU32			getNbNodeCpus(PxU32 node)		const	{ return mNodeStarts[node + 1] - mNodeStarts[node];			}
+		PX_FORCE_INLINE	const PxU32*	getNodeCpus(PxU32 node)			const	{ return mCpus.begin() + mNodeStarts[node];					}
+
+		// Pins the calling thread to the given CPUs. Returns false if not supported on this platform.
+		static			bool			pinCurrentThread(const PxU32* cpus, PxU32 nbCpus);
+	private:
+						PxArray<PxU32>	mCpus;
+						PxArray<PxU32>	mNodeStarts;
+	};
+
+} // namespace Ext
+
+}
+
+#endif
@@ -29,11 +29,12 @@
 #include "task/PxTask.h"
 #include "ExtCpuWorkerThread.h"
 #include "ExtDefaultCpuDispatcher.h"
+#include "ExtCpuTopology.h"
 #include "foundation/PxFPU.h"
 
 using namespace physx;
 
-Ext::CpuWorkerThread::CpuWorkerThread() : mOwner(NULL), mThreadId(0)
+Ext::CpuWorkerThread::CpuWorkerThread() : mOwner(NULL), mThreadId(0), mRandomState(1), mNode(0), mNodeCpus(NULL), mNbNodeCpus(0), mUseWorkStealing(false)
 {
 }
 
@@ -41,6 +42,16 @@ Ext::CpuWorkerThread::~CpuWorkerThread()
 {
 }
 
+void Ext::CpuWorkerThread::initialize(DefaultCpuDispatcher* ownerDispatcher, PxU32 index)
+{
+	mOwner = ownerDispatcher;
+	mUseWorkStealing = ownerDispatcher->getSchedulingMode() != PxDefaultCpuDispatcherSchedulingMode::eSHARED_QUEUE;
+	// xorshift state must be non-zero
+	mRandomState = (index + 1) * 2654435761u;
+	if(!mRandomState)
+		mRandomState = 1;
+}
+
 #define HighPriority	true
 #define RegularPriority	false
 
@@ -48,6 +59,9 @@ void Ext::CpuWorkerThread::execute()
 {
 	mThreadId = getId();
 
+	if(mNbNodeCpus)
+		CpuTopology::pinCurrentThread(mNodeCpus, mNbNodeCpus);
+
 	const PxDefaultCpuDispatcherWaitForWorkMode::Enum ownerWaitForWorkMode = mOwner->getWaitForWorkMode();
 
 	while(!quitIsSignalled())
@@ -60,12 +74,27 @@ void Ext::CpuWorkerThread::execute()
 		if(!task)
 			task = mOwner->fetchNextTask<HighPriority>();
 
-		// PT: then look for regular tasks
+		// then look for regular tasks, starting with the most recent ones we spawned ourselves
+		if(!task && mUseWorkStealing)
+			task = mDeque.pop();
 		if(!task)
 			task = getJob<RegularPriority>();
+		if(!task)
+			task = mOwner->fetchNodeTask(mNode);
 		if(!task)
 			task = mOwner->fetchNextTask<RegularPriority>();
 
+		// finally steal from a random victim, preferring workers from our own node
+		if(!task && mUseWorkStealing)
+		{
+			mRandomState ^= mRandomState << 13;
+			mRandomState ^= mRandomState >> 17;
+			mRandomState ^= mRandomState << 5;
+			task = mOwner->stealTask<true>(mRandomState, mNode);
+			if(!task)
+				task = mOwner->fetchRemoteTask(mRandomState, mNode);
+		}
+
 		if(task)
 		{
 			mOwner->runTask(*task);
@@ -32,6 +32,7 @@
 #include "foundation/PxThread.h"
 #include "ExtTaskQueueHelper.h"
 #include "ExtSharedQueueEntryPool.h"
+#include "ExtWorkStealingQueue.h"
 
 namespace physx
 {
@@ -50,24 +51,39 @@ class DefaultCpuDispatcher;
 												CpuWorkerThread();
 												~CpuWorkerThread();
 		
-		PX_FORCE_INLINE	void					initialize(DefaultCpuDispatcher* ownerDispatcher)		{ mOwner = ownerDispatcher;				}
+						void					initialize(DefaultCpuDispatcher* ownerDispatcher, PxU32 index);
 		PX_FORCE_INLINE	PxThread::Id			getWorkerThreadId()								const	{ return mThreadId;						}
+		PX_FORCE_INLINE	PxU32					getNode()										const	{ return mNode;							}
+		PX_FORCE_INLINE	void					setNode(PxU32 node, const PxU32* cpus, PxU32 nbCpus)	{ mNode = node; mNodeCpus = cpus; mNbNodeCpus = nbCpus;	}
 
 		template<const bool highPriorityT>
 		PX_FORCE_INLINE	PxBaseTask*				getJob()	{ return mHelper.fetchTask<highPriorityT>();	}
 
+		PX_FORCE_INLINE	PxBaseTask*				stealJob()	{ return mDeque.steal();	}
+
 						void					execute();
 
 		PX_FORCE_INLINE	bool					tryAcceptJobToLocalQueue(PxBaseTask& task, PxThread::Id taskSubmitionThread)
 												{
 													if(taskSubmitionThread == mThreadId)
+													{
+														// in work-stealing mode regular tasks go to our deque, unless it is full
+														if(mUseWorkStealing && !task.isHighPriority() && mDeque.push(task))
+															return true;
 														return mHelper.tryAcceptJobToQueue(task);
+													}
 													return false;
 												}
 	protected:
 						DefaultCpuDispatcher*	mOwner;
 						TaskQueueHelper			mHelper;
+						WorkStealingQueue		mDeque;
 						PxThread::Id			mThreadId;
+						PxU32					mRandomState;
+						PxU32					mNode;
+						const PxU32*			mNodeCpus;
+						PxU32					mNbNodeCpus;
+						bool					mUseWorkStealing;
 	};
 
 #if PX_VC
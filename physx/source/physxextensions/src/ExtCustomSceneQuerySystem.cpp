@@ -73,6 +73,7 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 		case PxBVHBuildStrategy::eFAST:		return BVH_SPLATTER_POINTS;
 		case PxBVHBuildStrategy::eDEFAULT:	return BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER;
 		case PxBVHBuildStrategy::eSAH:		return BVH_SAH;
+		case PxBVHBuildStrategy::eSAH_PARALLEL:	return BVH_SAH;
 		case PxBVHBuildStrategy::eLAST:		return BVH_SPLATTER_POINTS;
 	}
 	return BVH_SPLATTER_POINTS;
@@ -238,6 +239,10 @@ namespace
 														PxRaycastCallback& hitCall, PxHitFlags hitFlags,
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	void							raycastBatch(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+														PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const;
 		virtual	bool							sweep(	const PxGeometry& geometry, const PxTransform& pose,
 														const PxVec3& unitDir, const PxReal distance,
 														PxSweepCallback& hitCall, PxHitFlags hitFlags,
@@ -247,6 +252,12 @@ namespace
 														PxOverlapCallback& hitCall, 
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	bool							cull(	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const;
+		virtual	PxU32							nearest(const PxVec3& point, PxReal maxDist, PxNearestHit* hits, PxU32 maxNbHits,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const;
 		virtual	PxSQPrunerHandle				getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const;
 		virtual	void							sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
 													const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices);
@@ -440,6 +451,14 @@ bool CustomPxSQ::raycast(	const PxVec3& origin, const PxVec3& unitDir, const PxR
 	return mQueries._raycast(origin, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, flags);
 }
 
+void CustomPxSQ::raycastBatch(	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+								PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags,
+								const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+								PxGeometryQueryFlags flags) const
+{
+	mQueries._raycastBatch(nbRays, origins, unitDirs, distances, hitCalls, hitFlags, filterData, filterCall, flags);
+}
+
 bool CustomPxSQ::sweep(	const PxGeometry& geometry, const PxTransform& pose,
 						const PxVec3& unitDir, const PxReal distance,
 						PxSweepCallback& hitCall, PxHitFlags hitFlags,
@@ -457,6 +476,20 @@ bool CustomPxSQ::overlap(	const PxGeometry& geometry, const PxTransform& transfo
 	return mQueries._overlap( geometry, transform, hitCall, filterData, filterCall, cache, flags);
 }
 
+bool CustomPxSQ::cull(	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hitCall,
+				const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+				PxGeometryQueryFlags flags) const
+{
+	return mQueries._cull(nbPlanes, planes, hitCall, filterData, filterCall, flags);
+}
+
+PxU32 CustomPxSQ::nearest(	const PxVec3& point, PxReal maxDist, PxNearestHit* hits, PxU32 maxNbHits,
+				const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+				PxGeometryQueryFlags flags) const
+{
+	return mQueries._nearest(point, maxDist, hits, maxNbHits, filterData, filterCall, flags);
+}
+
 PxSQPrunerHandle CustomPxSQ::getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex) const
 {
 	const PxU32 actorIndex = actor.getInternalActorIndex();
@@ -498,10 +531,11 @@ void CustomPxSQ::finishCustomBuildstep()
 
 ///////////////////////////////////////////////////////////////////////////////
 
-PxCustomSceneQuerySystem* physx::PxCreateCustomSceneQuerySystem(PxSceneQueryUpdateMode::Enum sceneQueryUpdateMode, PxU64 contextID, const PxCustomSceneQuerySystemAdapter& adapter, bool usesTreeOfPruners)
+PxCustomSceneQuerySystem* physx::PxCreateCustomSceneQuerySystem(PxSceneQueryUpdateMode::Enum sceneQueryUpdateMode, PxU64 contextID, const PxCustomSceneQuerySystemAdapter& adapter, bool usesTreeOfPruners, PxCpuDispatcher* dispatcher)
 {
 	ExtPVDCapture* pvd = NULL;
 	CustomPxSQ* pxsq = PX_NEW(CustomPxSQ)(adapter, pvd, contextID, sceneQueryUpdateMode, usesTreeOfPruners);
+	pxsq->SQ().setTaskDispatcher(dispatcher);
 
 	addExternalSQ(pxsq);
 
@@ -30,12 +30,13 @@
 #include "ExtCpuWorkerThread.h"
 #include "ExtTaskQueueHelper.h"
 #include "foundation/PxString.h"
+#include "foundation/PxMath.h"
 
 using namespace physx;
 
-PxDefaultCpuDispatcher* physx::PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount)
+PxDefaultCpuDispatcher* physx::PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount, PxDefaultCpuDispatcherSchedulingMode::Enum schedulingMode)
 {
-	return PX_NEW(Ext::DefaultCpuDispatcher)(numThreads, affinityMasks, mode, yieldProcessorCount);
+	return PX_NEW(Ext::DefaultCpuDispatcher)(numThreads, affinityMasks, mode, yieldProcessorCount, schedulingMode);
 }
 
 #if !PX_SWITCH
@@ -48,7 +49,7 @@ void Ext::DefaultCpuDispatcher::getAffinityMasks(PxU32* affinityMasks, PxU32 thr
 }
 #endif
 
-Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount) : mNumThreads(numThreads), mShuttingDown(false)
+Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount, PxDefaultCpuDispatcherSchedulingMode::Enum schedulingMode) : mNodeQueues(NULL), mTopology(NULL), mNbNodes(1), mNumThreads(numThreads), mShuttingDown(false)
 #if PX_PROFILE
 	,mRunProfiled(true)
 #else
@@ -56,10 +57,14 @@ Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinit
 #endif
 	, mWaitForWorkMode(mode)
 	, mYieldProcessorCount(yieldProcessorCount)
+	, mSchedulingMode(schedulingMode)
 {
 	PX_CHECK_MSG((((PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_PROCESSOR == mWaitForWorkMode) && (mYieldProcessorCount > 0)) ||
 					(((PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == mWaitForWorkMode) || (PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)) && (0 == mYieldProcessorCount))), "Illegal yield processor count for chosen execute mode");
 
+	// in topology-aware mode, workers are pinned to the CPUs of their node unless users provided their own masks
+	const bool pinToNodes = PxDefaultCpuDispatcherSchedulingMode::eNUMA_AWARE == mSchedulingMode && !affinityMasks;
+
 	PxU32* defaultAffinityMasks = NULL;
 
 	if(!affinityMasks)
@@ -68,6 +73,18 @@ Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinit
 		getAffinityMasks(defaultAffinityMasks, numThreads);
 		affinityMasks = defaultAffinityMasks;
 	}
+
+	if(PxDefaultCpuDispatcherSchedulingMode::eNUMA_AWARE == mSchedulingMode && numThreads)
+	{
+		mTopology = PX_NEW(CpuTopology);
+		mNbNodes = PxMin(mTopology->getNbNodes(), numThreads);
+		if(mNbNodes > 1)
+		{
+			mNodeQueues = PX_ALLOCATE(TaskQueueHelper, mNbNodes, "NodeQueues");
+			for(PxU32 i = 0; i < mNbNodes; ++i)
+				PX_PLACEMENT_NEW(mNodeQueues+i, TaskQueueHelper)();
+		}
+	}
 	 
 	// initialize threads first, then start
 
@@ -80,7 +97,17 @@ Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinit
 		for(PxU32 i = 0; i < numThreads; ++i)
 		{
 			PX_PLACEMENT_NEW(mWorkerThreads+i, CpuWorkerThread)();
-			mWorkerThreads[i].initialize(this);
+			mWorkerThreads[i].initialize(this, i);
+
+			// workers are split into contiguous groups, one per node
+			if(mNbNodes > 1)
+			{
+				const PxU32 node = (i * mNbNodes) / numThreads;
+				if(pinToNodes)
+					mWorkerThreads[i].setNode(node, mTopology->getNodeCpus(node), mTopology->getNbNodeCpus(node));
+				else
+					mWorkerThreads[i].setNode(node, NULL, 0);
+			}
 		}
 
 		for(PxU32 i = 0; i < numThreads; ++i)
@@ -120,6 +147,11 @@ Ext::DefaultCpuDispatcher::~DefaultCpuDispatcher()
 
 	PX_FREE(mWorkerThreads);
 	PX_FREE(mThreadNames);
+
+	for(PxU32 i = 0; mNodeQueues && i < mNbNodes; ++i)
+		mNodeQueues[i].~TaskQueueHelper();
+	PX_FREE(mNodeQueues);
+	PX_DELETE(mTopology);
 }
 
 void Ext::DefaultCpuDispatcher::release()
@@ -140,23 +172,45 @@ void Ext::DefaultCpuDispatcher::submitTask(PxBaseTask& task)
 	// TODO: Could use TLS to make this more efficient
 	const PxThread::Id currentThread = PxThread::getId();
 	const PxU32 nbThreads = mNumThreads;
+
+	if(mNodeQueues && !task.isHighPriority())
+	{
+		// tasks with a locality hint go to their preferred node. They stay on the submitting worker's deque if
+		// it already runs on that node, otherwise they go to the node's queue.
+		const PxU32 hint = task.getLocalityHint();
+		if(hint != 0xffffffff)
+		{
+			const PxU32 node = hint % mNbNodes;
+			bool accepted = false;
+			for(PxU32 i=0; i<nbThreads; ++i)
+			{
+				if(mWorkerThreads[i].getWorkerThreadId() == currentThread)
+				{
+					if(mWorkerThreads[i].getNode() == node)
+						accepted = mWorkerThreads[i].tryAcceptJobToLocalQueue(task, currentThread);
+					break;
+				}
+			}
+
+			if(accepted || mNodeQueues[node].tryAcceptJobToQueue(task))
+			{
+				signalWork();
+				return;
+			}
+		}
+	}
+
 	for(PxU32 i=0; i<nbThreads; ++i)
 	{
 		if(mWorkerThreads[i].tryAcceptJobToLocalQueue(task, currentThread))
 		{
-			if(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)
-				mWorkReady.set();
-			else
-				PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_PROCESSOR == mWaitForWorkMode || PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == mWaitForWorkMode);
+			signalWork();
 			return;
 		}
 	}
 
 	if(mHelper.tryAcceptJobToQueue(task))
-	{
-		if(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)
-			mWorkReady.set();
-	}
+		signalWork();
 }
 
 void Ext::DefaultCpuDispatcher::resetWakeSignal()
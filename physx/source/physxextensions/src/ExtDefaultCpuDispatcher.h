@@ -38,6 +38,7 @@
 #include "ExtSharedQueueEntryPool.h"
 #include "ExtTaskQueueHelper.h"
 #include "ExtCpuWorkerThread.h"
+#include "ExtCpuTopology.h"
 
 namespace physx
 {
@@ -54,7 +55,7 @@ namespace Ext
 	private:
 																		~DefaultCpuDispatcher();
 	public:
-																		DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode = PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK, PxU32 yieldProcessorCount = 0);
+																		DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode = PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK, PxU32 yieldProcessorCount = 0, PxDefaultCpuDispatcherSchedulingMode::Enum schedulingMode = PxDefaultCpuDispatcherSchedulingMode::eSHARED_QUEUE);
 
 		// PxCpuDispatcher
 		virtual			void											submitTask(PxBaseTask& task)		PX_OVERRIDE;
@@ -86,6 +87,49 @@ namespace Ext
 																			return task;
 																		}
 
+		// regular tasks queued for a given NUMA node (topology-aware mode only)
+		PX_FORCE_INLINE	PxBaseTask*										fetchNodeTask(PxU32 node)
+																		{
+																			return mNodeQueues ? mNodeQueues[node].fetchTask<false>() : NULL;
+																		}
+
+		// steal the oldest task from the work-stealing deques, starting with a randomly chosen victim. With localNodeT
+		// we only consider workers from the given node, otherwise we only consider workers from other nodes.
+		template<const bool localNodeT>
+						PxBaseTask*										stealTask(PxU32 startIndex, PxU32 node)
+																		{
+																			const PxU32 nbThreads = mNumThreads;
+																			PxU32 index = startIndex % nbThreads;
+																			for(PxU32 i=0; i<nbThreads; ++i)
+																			{
+																				if(localNodeT == (mWorkerThreads[index].getNode() == node))
+																				{
+																					PxBaseTask* task = mWorkerThreads[index].stealJob();
+																					if(task)
+																						return task;
+																				}
+																				if(++index == nbThreads)
+																					index = 0;
+																			}
+																			return NULL;
+																		}
+
+		// last resort for topology-aware mode: take work from other nodes, first from their queues then from their workers
+						PxBaseTask*										fetchRemoteTask(PxU32 startIndex, PxU32 node)
+																		{
+																			if(!mNodeQueues)
+																				return NULL;
+
+																			const PxU32 nbNodes = mNbNodes;
+																			for(PxU32 i=1; i<nbNodes; ++i)
+																			{
+																				PxBaseTask* task = mNodeQueues[(node + i) % nbNodes].fetchTask<false>();
+																				if(task)
+																					return task;
+																			}
+																			return stealTask<false>(startIndex, node);
+																		}
+
 		PX_FORCE_INLINE	void											runTask(PxBaseTask& task)
 																		{
 																			if(mRunProfiled)
@@ -97,6 +141,14 @@ namespace Ext
 																				task.run();
 																		}
 
+						void											signalWork()
+																		{
+																			if(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)
+																				mWorkReady.set();
+																			else
+																				PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_PROCESSOR == mWaitForWorkMode || PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == mWaitForWorkMode);
+																		}
+
     					void											waitForWork()						{ PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode); mWorkReady.wait(); }
 						void											resetWakeSignal();
 
@@ -104,10 +156,14 @@ namespace Ext
 
 		PX_FORCE_INLINE	PxDefaultCpuDispatcherWaitForWorkMode::Enum		getWaitForWorkMode()		const	{ return mWaitForWorkMode;		}
 		PX_FORCE_INLINE	PxU32											getYieldProcessorCount()	const	{ return mYieldProcessorCount;	}
+		PX_FORCE_INLINE	PxDefaultCpuDispatcherSchedulingMode::Enum		getSchedulingMode()			const	{ return mSchedulingMode;		}
 
 	protected:
 						CpuWorkerThread*								mWorkerThreads;
 						TaskQueueHelper									mHelper;
+						TaskQueueHelper*								mNodeQueues;
+						CpuTopology*									mTopology;
+						PxU32											mNbNodes;
 						PxSync											mWorkReady;
 						PxU8*											mThreadNames;
 						PxU32											mNumThreads;
@@ -115,6 +171,7 @@ namespace Ext
 						bool											mRunProfiled;
 		const			PxDefaultCpuDispatcherWaitForWorkMode::Enum		mWaitForWorkMode;
 		const			PxU32											mYieldProcessorCount;
+		const			PxDefaultCpuDispatcherSchedulingMode::Enum		mSchedulingMode;
 	};
 
 #if PX_VC
@@ -38,6 +38,17 @@
 
 #include <errno.h>
 
+#if PX_WINDOWS_FAMILY
+	#include "foundation/windows/PxWindowsInclude.h"
+#elif PX_UNIX_FAMILY
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#else
+	#include "foundation/PxAlignedMalloc.h"
+#endif
+
 using namespace physx;
 
 PxDefaultMemoryOutputStream::PxDefaultMemoryOutputStream(PxAllocatorCallback &allocator) 
@@ -191,3 +202,90 @@ bool PxDefaultFileInputData::isValid() const
 {
 	return mFile != NULL;
 }
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxDefaultMemoryMappedFile::PxDefaultMemoryMappedFile(const char* filename) :
+	mAddress	(NULL),
+	mLength		(0),
+	mHandle		(NULL)
+{
+#if PX_WINDOWS_FAMILY
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(file == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER size;
+	if(GetFileSizeEx(file, &size) && size.QuadPart && size.QuadPart <= 0xffffffff)
+	{
+		// PAGE_WRITECOPY / FILE_MAP_COPY: written pages become private copies, the file is never modified
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+		if(mapping)
+		{
+			mAddress = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+			if(mAddress)
+			{
+				mLength = PxU32(size.QuadPart);
+				mHandle = mapping;
+			}
+			else
+				CloseHandle(mapping);
+		}
+	}
+	// the mapping keeps a reference to the file
+	CloseHandle(file);
+#elif PX_UNIX_FAMILY
+	const int fd = open(filename, O_RDONLY);
+	if(fd == -1)
+		return;
+
+	struct stat st;
+	if(!fstat(fd, &st) && st.st_size > 0 && PxU64(st.st_size) <= 0xffffffff)
+	{
+		// MAP_PRIVATE: written pages become private copies, the file is never modified
+		void* address = mmap(NULL, size_t(st.st_size), PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if(address != MAP_FAILED)
+		{
+			mAddress = address;
+			mLength = PxU32(st.st_size);
+		}
+	}
+	// the mapping keeps a reference to the file
+	close(fd);
+#else
+	PxDefaultFileInputData file(filename);
+	if(!file.isValid() || !file.getLength())
+		return;
+
+	const PxU32 length = file.getLength();
+	void* block = PxAlignedAllocator<128>().allocate(length, PX_FL);
+	if(file.read(block, length) == length)
+	{
+		mAddress = block;
+		mLength = length;
+		mHandle = block;
+	}
+	else
+		PxAlignedAllocator<128>().deallocate(block);
+#endif
+}
+
+PxDefaultMemoryMappedFile::~PxDefaultMemoryMappedFile()
+{
+	if(!mAddress)
+		return;
+
+#if PX_WINDOWS_FAMILY
+	UnmapViewOfFile(mAddress);
+	CloseHandle(mHandle);
+#elif PX_UNIX_FAMILY
+	munmap(mAddress, mLength);
+#else
+	PxAlignedAllocator<128>().deallocate(mHandle);
+#endif
+}
+
+bool PxDefaultMemoryMappedFile::isValid() const
+{
+	return mAddress != NULL;
+}
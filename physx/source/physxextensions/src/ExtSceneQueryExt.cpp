@@ -27,10 +27,14 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "extensions/PxSceneQueryExt.h"
+#include "extensions/PxShapeExt.h"
 #include "geometry/PxGeometryHelpers.h"
+#include "geometry/PxGeometryQuery.h"
 #include "foundation/PxAllocatorCallback.h"
 #include "CmUtils.h"
 #include "foundation/PxAllocator.h"
+#include "foundation/PxArray.h"
+#include "task/PxTask.h"
 
 using namespace physx;
 
@@ -287,8 +291,12 @@ public:
 
 	virtual void execute();
 
+	virtual void execute(PxBaseTask* completionTask, PxU32 nbQueriesPerTask);
+
 private:
 
+	template<typename HitType, typename QueryType> class QueryTask;
+
 	template<typename HitType, typename QueryType> struct Query
 	{
 		PxHitBuffer<HitType>* mBuffers;
@@ -375,6 +383,123 @@ private:
 				query.cache);
 		}
 
+		// consecutive raycasts without touch buffer and cache, and sharing the same flags and filtering, are
+		// passed to the scene as a batch, which lets the scene-query system traverse its pruners with ray packets.
+		// These queries do not consume any touches so the results are the same as when performing them one by one.
+		static PxU32 getBatchSize(const Raycast* queries, const PxHitBuffer<PxRaycastHit>* buffers, const PxU32 nbQueries)
+		{
+			const Raycast& first = queries[0];
+			PxU32 nb = 0;
+			while (nb < nbQueries)
+			{
+				const Raycast& query = queries[nb];
+				if (buffers[nb].maxNbTouches || query.cache || query.hitFlags != first.hitFlags
+					|| query.filterData.flags != first.filterData.flags || query.filterData.data != first.filterData.data)
+					break;
+				nb++;
+			}
+			return nb;
+		}
+
+		template<typename OtherQueryType>
+		static PxU32 getBatchSize(const OtherQueryType*, const PxHitBuffer<HitType>*, const PxU32)
+		{
+			return 0;
+		}
+
+		static void performQueries(const PxScene& scene, const Raycast* queries, PxHitBuffer<PxRaycastHit>* buffers, PxU32 nbQueries, PxQueryFilterCallback* qfcb)
+		{
+			const PxU32 maxBatchSize = 32;
+			PxVec3 origins[maxBatchSize];
+			PxVec3 unitDirs[maxBatchSize];
+			PxReal distances[maxBatchSize];
+			PxRaycastCallback* hitCalls[maxBatchSize];
+			PX_ALIGN(16, PxU8 overflowBuffersMemory[sizeof(NpOverflowBuffer<PxRaycastHit>)*maxBatchSize]);
+			NpOverflowBuffer<PxRaycastHit>* overflowBuffers = reinterpret_cast<NpOverflowBuffer<PxRaycastHit>*>(overflowBuffersMemory);
+
+			while (nbQueries)
+			{
+				const PxU32 nb = PxMin(nbQueries, maxBatchSize);
+				for (PxU32 i = 0; i < nb; i++)
+				{
+					origins[i] = queries[i].origin;
+					unitDirs[i] = queries[i].unitDir;
+					distances[i] = queries[i].distance;
+					hitCalls[i] = PX_PLACEMENT_NEW(overflowBuffers + i, NpOverflowBuffer<PxRaycastHit>)(NULL, 0);
+				}
+
+				scene.raycastBatch(nb, origins, unitDirs, distances, hitCalls, queries[0].hitFlags, queries[0].filterData, qfcb);
+
+				for (PxU32 i = 0; i < nb; i++)
+				{
+					PX_ASSERT(!overflowBuffers[i].overflow);
+					buffers[i].hasBlock = overflowBuffers[i].hasBlock;
+					buffers[i].block = overflowBuffers[i].block;
+					buffers[i].nbTouches = overflowBuffers[i].nbTouches;
+					overflowBuffers[i].~NpOverflowBuffer<PxRaycastHit>();
+				}
+
+				queries += nb;
+				buffers += nb;
+				nbQueries -= nb;
+			}
+		}
+
+		template<typename OtherQueryType>
+		static void performQueries(const PxScene&, const OtherQueryType*, PxHitBuffer<HitType>*, PxU32, PxQueryFilterCallback*)
+		{
+			PX_ASSERT(0);
+		}
+
+		void assignTouches(const PxU32 i, const PxU32 touchesTide)
+		{
+			if (mBuffers[i].maxNbTouches > 0)
+			{
+				if (touchesTide >= mMaxNbTouches)
+				{
+					//No resources left. This is detected and reported as an overflow in executeQuery().
+					mBuffers[i].touches = NULL;
+				}
+				else if ((touchesTide + mBuffers[i].maxNbTouches) > mMaxNbTouches)
+				{
+					//Some resources left but not enough to match requested number.
+					//This might be enough but it depends on the number of hits generated by the query.
+					mBuffers[i].maxNbTouches = mMaxNbTouches - touchesTide;
+					mBuffers[i].touches = mTouches + touchesTide;
+				}
+				else
+				{
+					//Enough resources left to match request.
+					mBuffers[i].touches = mTouches + touchesTide;
+				}
+			}
+		}
+
+		void executeQuery(const PxScene& scene, const PxU32 i, PxQueryFilterCallback* qfcb)
+		{
+			bool noTouchesRemaining = false;
+			if (mBuffers[i].maxNbTouches > 0 && !mBuffers[i].touches)
+			{
+				mBuffers[i].maxNbTouches = 0;
+				noTouchesRemaining = true;
+			}
+
+			bool overflow = false;
+			{
+				PX_ALIGN(16, NpOverflowBuffer<HitType> overflowBuffer)(mBuffers[i].touches, mBuffers[i].maxNbTouches);
+				performQuery(scene, mQueries[i], overflowBuffer, qfcb);
+				overflow = overflowBuffer.overflow || noTouchesRemaining;
+				mBuffers[i].hasBlock = overflowBuffer.hasBlock;
+				mBuffers[i].block = overflowBuffer.block;
+				mBuffers[i].nbTouches = overflowBuffer.nbTouches;
+			}
+
+			if(overflow)
+			{
+				mBuffers[i].maxNbTouches = 0xffffffff;
+			}
+		}
+
 		void execute(const PxScene& scene, PxQueryFilterCallback* qfcb)
 		{
 			PxU32 touchesTide = 0;
@@ -384,57 +509,118 @@ private:
 				PX_ASSERT(0xffffffff != mBuffers[i].maxNbTouches);
 				PX_ASSERT(!mBuffers[i].touches);
 
-				bool noTouchesRemaining = false;
-				if (mBuffers[i].maxNbTouches > 0)
+				const PxU32 batchSize = getBatchSize(mQueries + i, mBuffers + i, mBufferTide - i);
+				if (batchSize > 1)
 				{
-					if (touchesTide >= mMaxNbTouches)
-					{
-						//No resources left.
-						mBuffers[i].maxNbTouches = 0;
-						mBuffers[i].touches = NULL;
-						noTouchesRemaining = true;
-					}
-					else if ((touchesTide + mBuffers[i].maxNbTouches) > mMaxNbTouches)
-					{
-						//Some resources left but not enough to match requested number.
-						//This might be enough but it depends on the number of hits generated by the query.
-						mBuffers[i].maxNbTouches = mMaxNbTouches - touchesTide;
-						mBuffers[i].touches = mTouches + touchesTide;
-					}
-					else
-					{
-						//Enough resources left to match request.
-						mBuffers[i].touches = mTouches + touchesTide;
-					}
+					performQueries(scene, mQueries + i, mBuffers + i, batchSize, qfcb);
+					i += batchSize - 1;
+					continue;
 				}
 
-				bool overflow = false;
-				{
-					PX_ALIGN(16, NpOverflowBuffer<HitType> overflowBuffer)(mBuffers[i].touches, mBuffers[i].maxNbTouches);
-					performQuery(scene, mQueries[i], overflowBuffer, qfcb);
-					overflow = overflowBuffer.overflow || noTouchesRemaining;
-					mBuffers[i].hasBlock = overflowBuffer.hasBlock;
-					mBuffers[i].block = overflowBuffer.block;
-					mBuffers[i].nbTouches = overflowBuffer.nbTouches;
-				}
+				assignTouches(i, touchesTide);
+				executeQuery(scene, i, qfcb);
+				touchesTide += mBuffers[i].nbTouches;
+			}
 
-				if(overflow)
+			mBufferTide = 0;
+		}
+
+		// executes queries [start, end) once the touch buffers have been assigned by submitTasks(). Each query
+		// only writes to its own result buffer and to its own range of touches, so this can run on any thread.
+		void executeRange(const PxScene& scene, const PxU32 start, const PxU32 end, PxQueryFilterCallback* qfcb)
+		{
+			for (PxU32 i = start; i < end; i++)
+			{
+				const PxU32 batchSize = getBatchSize(mQueries + i, mBuffers + i, end - i);
+				if (batchSize > 1)
 				{
-					mBuffers[i].maxNbTouches = 0xffffffff;
+					performQueries(scene, mQueries + i, mBuffers + i, batchSize, qfcb);
+					i += batchSize - 1;
+					continue;
 				}
-				touchesTide += mBuffers[i].nbTouches;
+
+				executeQuery(scene, i, qfcb);
 			}
+		}
+
+		void submitTasks(const PxScene& scene, PxQueryFilterCallback* qfcb, PxBaseTask* continuation, const PxU32 nbQueriesPerTask, PxArray<QueryTask<HitType, QueryType> >& tasks)
+		{
+			// the queries complete in any order so the touches cannot be packed as in execute(). Instead each
+			// query reserves the number of touches it asked for, as long as there is room left in the touch buffer.
+			PxU32 touchesTide = 0;
+			for (PxU32 i = 0; i < mBufferTide; i++)
+			{
+				PX_ASSERT(0xffffffff == mBuffers[i].nbTouches);
+				PX_ASSERT(0xffffffff != mBuffers[i].maxNbTouches);
+				PX_ASSERT(!mBuffers[i].touches);
+
+				assignTouches(i, touchesTide);
+				if (mBuffers[i].touches)
+					touchesTide += mBuffers[i].maxNbTouches;
+			}
+
+			const PxU32 nbTasks = (mBufferTide + nbQueriesPerTask - 1) / nbQueriesPerTask;
+			tasks.clear();
+			tasks.resize(nbTasks);
+			for (PxU32 i = 0; i < nbTasks; i++)
+			{
+				const PxU32 start = i * nbQueriesPerTask;
+				const PxU32 end = PxMin(start + nbQueriesPerTask, mBufferTide);
+				tasks[i].setup(this, scene, qfcb, start, end);
+				tasks[i].setContinuation(continuation);
+			}
+			for (PxU32 i = 0; i < nbTasks; i++)
+				tasks[i].removeReference();
 
 			mBufferTide = 0;
 		}
 	};
 
+	template<typename HitType, typename QueryType>
+	class QueryTask : public PxLightCpuTask
+	{
+	public:
+		QueryTask() : mQuery(NULL), mScene(NULL), mQueryFilterCallback(NULL), mStart(0), mEnd(0)
+		{
+		}
+
+		void setup(Query<HitType, QueryType>* query, const PxScene& scene, PxQueryFilterCallback* qfcb, const PxU32 start, const PxU32 end)
+		{
+			mQuery = query;
+			mScene = &scene;
+			mQueryFilterCallback = qfcb;
+			mStart = start;
+			mEnd = end;
+		}
+
+		virtual void run()
+		{
+			mQuery->executeRange(*mScene, mStart, mEnd, mQueryFilterCallback);
+		}
+
+		virtual const char* getName() const
+		{
+			return "PxBatchQueryExt.execute";
+		}
+
+	private:
+		Query<HitType, QueryType>* mQuery;
+		const PxScene* mScene;
+		PxQueryFilterCallback* mQueryFilterCallback;
+		PxU32 mStart;
+		PxU32 mEnd;
+	};
+
 	const PxScene& mScene;
 	PxQueryFilterCallback* mQueryFilterCallback;
 
 	Query<PxRaycastHit, Raycast> mRaycasts;
 	Query<PxSweepHit, Sweep> mSweeps;
 	Query<PxOverlapHit, Overlap> mOverlaps;
+
+	PxArray<QueryTask<PxRaycastHit, Raycast> > mRaycastTasks;
+	PxArray<QueryTask<PxSweepHit, Sweep> > mSweepTasks;
+	PxArray<QueryTask<PxOverlapHit, Overlap> > mOverlapTasks;
 };
 
 template<typename HitType>
@@ -644,6 +830,8 @@ ExtBatchQuery::ExtBatchQuery
 
 void ExtBatchQuery::release()
 {
+	// the object lives in a single allocation created with placement new, but the task arrays still need to be destroyed
+	this->~ExtBatchQuery();
 	PxGetAllocatorCallback()->deallocate(this);
 }
 
@@ -694,3 +882,303 @@ void ExtBatchQuery::execute()
 	mSweeps.execute(mScene, mQueryFilterCallback);
 	mOverlaps.execute(mScene, mQueryFilterCallback);
 }
+
+void ExtBatchQuery::execute(PxBaseTask* completionTask, PxU32 nbQueriesPerTask)
+{
+	PX_CHECK_AND_RETURN(completionTask && completionTask->getTaskManager(), "PxBatchQueryExt::execute(): completion task must be associated with a task manager.");
+	PX_CHECK_AND_RETURN(nbQueriesPerTask > 0, "PxBatchQueryExt::execute(): nbQueriesPerTask must be greater than zero.");
+
+	mRaycasts.submitTasks(mScene, mQueryFilterCallback, completionTask, nbQueriesPerTask, mRaycastTasks);
+	mSweeps.submitTasks(mScene, mQueryFilterCallback, completionTask, nbQueriesPerTask, mSweepTasks);
+	mOverlaps.submitTasks(mScene, mQueryFilterCallback, completionTask, nbQueriesPerTask, mOverlapTasks);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	// reports hits to the user callback the same way scene queries do (see MultiQueryCallback in SqQuery.cpp)
+	class OverlapHitReporter
+	{
+	public:
+		OverlapHitReporter(PxOverlapCallback& hitCall, const PxQueryFilterData& filterData) :
+			mHitCall	(hitCall),
+			mAnyHit		((filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT),
+			mNoBlock	(filterData.flags & PxQueryFlag::eNO_BLOCK),
+			mAgain		(true)
+		{
+			hitCall.hasBlock = false;
+			hitCall.nbTouches = 0;
+		}
+
+		// returns false when the query should stop
+		bool report(const PxOverlapHit& hit, PxQueryHitType::Enum hitType)
+		{
+			if(hitType == PxQueryHitType::eNONE)
+				return true;
+
+			if(mAnyHit)
+			{
+				mHitCall.block = hit;
+				mHitCall.hasBlock = true;
+				mAgain = false;
+				return false;
+			}
+
+			if(mNoBlock && hitType == PxQueryHitType::eBLOCK)
+				hitType = PxQueryHitType::eTOUCH;
+
+			if(hitType == PxQueryHitType::eTOUCH)
+			{
+				if(!mHitCall.maxNbTouches)
+					return true;
+
+				if(mHitCall.nbTouches == mHitCall.maxNbTouches)
+				{
+					mAgain = mHitCall.processTouches(mHitCall.touches, mHitCall.nbTouches);
+					if(!mAgain)
+						return false;
+					mHitCall.nbTouches = 0;
+				}
+				mHitCall.touches[mHitCall.nbTouches++] = hit;
+			}
+			else
+			{
+				mHitCall.block = hit;
+				mHitCall.hasBlock = true;
+			}
+			return true;
+		}
+
+		bool finalize()
+		{
+			// touches are not reported again if the query was stopped by processTouches()
+			if(mAgain && mHitCall.nbTouches)
+			{
+				if(mHitCall.processTouches(mHitCall.touches, mHitCall.nbTouches))
+					mHitCall.nbTouches = 0;
+			}
+			mHitCall.finalizeQuery();
+			return mHitCall.hasAnyHits();
+		}
+
+		PX_FORCE_INLINE	bool	again()	const	{ return mAgain;	}
+
+	private:
+		PxOverlapCallback&	mHitCall;
+		const bool			mAnyHit;
+		const bool			mNoBlock;
+		bool				mAgain;
+
+		PX_NOCOPY(OverlapHitReporter)
+	};
+
+	#define OVERLAP_CACHE_BUFFER_SIZE	64
+
+	// collects the candidates touching the inflated query volume
+	struct CandidateCallback : PxOverlapCallback
+	{
+		CandidateCallback(PxArray<PxActorShape>& candidates) : PxOverlapCallback(mBuffer, OVERLAP_CACHE_BUFFER_SIZE), mCandidates(candidates)	{}
+
+		virtual PxAgain processTouches(const PxOverlapHit* hits, PxU32 nbHits)	PX_OVERRIDE
+		{
+			for(PxU32 i=0;i<nbHits;i++)
+				mCandidates.pushBack(PxActorShape(hits[i].actor, hits[i].shape));
+			return true;
+		}
+
+		PxOverlapHit			mBuffer[OVERLAP_CACHE_BUFFER_SIZE];
+		PxArray<PxActorShape>&	mCandidates;
+
+		PX_NOCOPY(CandidateCallback)
+	};
+
+	// forwards the results of the regular scene query for dynamic objects to the hit reporter
+	struct ForwardingCallback : PxOverlapCallback
+	{
+		ForwardingCallback(OverlapHitReporter& reporter, PxU32 maxNbTouches) :
+			PxOverlapCallback(mBuffer, PxMin(maxNbTouches, PxU32(OVERLAP_CACHE_BUFFER_SIZE))), mReporter(reporter)	{}
+
+		virtual PxAgain processTouches(const PxOverlapHit* hits, PxU32 nbHits)	PX_OVERRIDE
+		{
+			for(PxU32 i=0;i<nbHits;i++)
+			{
+				if(!mReporter.report(hits[i], PxQueryHitType::eTOUCH))
+					return false;
+			}
+			return true;
+		}
+
+		PxOverlapHit		mBuffer[OVERLAP_CACHE_BUFFER_SIZE];
+		OverlapHitReporter&	mReporter;
+
+		PX_NOCOPY(ForwardingCallback)
+	};
+
+	struct OverlapCacheEntry
+	{
+		OverlapCacheEntry() : mTimestamp(0), mValid(false)	{}
+
+		PxBounds3				mBounds;			// Inflated query volume the candidates have been gathered for
+		PxU32					mTimestamp;			// Static SQ timestamp when gathering candidates
+		bool					mValid;
+		PxArray<PxActorShape>	mCandidates;
+	};
+
+	class ExtOverlapCache : public PxOverlapCacheExt, public PxUserAllocated
+	{
+	public:
+		ExtOverlapCache(const PxScene& scene, PxU32 maxNbHandles, PxReal volumeGrowth) : mScene(scene), mVolumeGrowth(volumeGrowth)
+		{
+			mEntries.resize(maxNbHandles);
+		}
+
+		virtual ~ExtOverlapCache()	{}
+
+		virtual void release()	PX_OVERRIDE
+		{
+			PX_DELETE_THIS;
+		}
+
+		virtual bool overlap(
+			PxU32 handle, const PxGeometry& geometry, const PxTransform& pose, PxOverlapCallback& hitCall,
+			const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall)	PX_OVERRIDE;
+
+		virtual void invalidate(PxU32 handle)	PX_OVERRIDE
+		{
+			PX_CHECK_AND_RETURN(handle < mEntries.size(), "PxOverlapCacheExt::invalidate(): invalid handle.");
+			mEntries[handle].mValid = false;
+		}
+
+		virtual void invalidateAll()	PX_OVERRIDE
+		{
+			for(PxU32 i=0;i<mEntries.size();i++)
+				mEntries[i].mValid = false;
+		}
+
+		virtual PxU32 getNbCandidates(PxU32 handle) const	PX_OVERRIDE
+		{
+			PX_CHECK_AND_RETURN_VAL(handle < mEntries.size(), "PxOverlapCacheExt::getNbCandidates(): invalid handle.", 0);
+			const OverlapCacheEntry& entry = mEntries[handle];
+			return entry.mValid ? entry.mCandidates.size() : 0;
+		}
+
+	private:
+		void	gatherCandidates(OverlapCacheEntry& entry, const PxBounds3& queryBounds, PxU32 timestamp);
+
+		const PxScene&				mScene;
+		const PxReal				mVolumeGrowth;
+		PxArray<OverlapCacheEntry>	mEntries;
+	};
+}
+
+void ExtOverlapCache::gatherCandidates(OverlapCacheEntry& entry, const PxBounds3& queryBounds, PxU32 timestamp)
+{
+	// same idea as the CCT's temporal bounding volume: grow the query bounds so that small motions stay within the cached volume
+	const PxVec3 center = queryBounds.getCenter();
+	const PxVec3 extents = queryBounds.getExtents() * mVolumeGrowth;
+
+	entry.mBounds = PxBounds3::centerExtents(center, extents);
+	entry.mTimestamp = timestamp;
+	entry.mValid = true;
+	entry.mCandidates.clear();
+
+	// candidates are gathered unfiltered: shape query filter data can change without bumping the static timestamp,
+	// so the filter equation is applied for each query in overlap(), like the user callbacks.
+	const PxQueryFilterData gatherFilterData(PxFilterData(), PxQueryFlag::eSTATIC | PxQueryFlag::eNO_BLOCK);
+
+	CandidateCallback cb(entry.mCandidates);
+	mScene.overlap(PxBoxGeometry(extents), PxTransform(center), cb, gatherFilterData);
+}
+
+bool ExtOverlapCache::overlap(
+	PxU32 handle, const PxGeometry& geometry, const PxTransform& pose, PxOverlapCallback& hitCall,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall)
+{
+	PX_CHECK_AND_RETURN_VAL(handle < mEntries.size(), "PxOverlapCacheExt::overlap(): invalid handle.", false);
+	PX_CHECK_AND_RETURN_VAL(pose.isValid(), "PxOverlapCacheExt::overlap(): pose is not valid.", false);
+	PX_CHECK_AND_RETURN_VAL((filterData.flags & PxQueryFlag::eANY_HIT) || hitCall.maxNbTouches > 0,
+		"PxOverlapCacheExt::overlap(): calls without eANY_HIT flag require a touch hit buffer for return results.", false);
+
+	OverlapHitReporter reporter(hitCall, filterData);
+
+	if(filterData.flags & PxQueryFlag::eSTATIC)
+	{
+		PxBounds3 queryBounds;
+		PxGeometryQuery::computeGeomBounds(queryBounds, geometry, pose);
+
+		OverlapCacheEntry& entry = mEntries[handle];
+		const PxU32 timestamp = mScene.getSceneQueryStaticTimestamp();
+
+		if(!entry.mValid || entry.mTimestamp != timestamp || !queryBounds.isInside(entry.mBounds))
+			gatherCandidates(entry, queryBounds, timestamp);
+
+		// same filter equation as the scene queries (see applyFilterEquation in SqQuery.cpp)
+		const PxFilterData& queryFd = filterData.data;
+		const bool filterEquation = !(filterData.flags & PxQueryFlag::eBATCH_QUERY_LEGACY_BEHAVIOUR)
+			&& (queryFd.word0 | queryFd.word1 | queryFd.word2 | queryFd.word3);
+		const bool preFilter = filterCall && (filterData.flags & PxQueryFlag::ePREFILTER);
+		const bool postFilter = filterCall && (filterData.flags & PxQueryFlag::ePOSTFILTER);
+		const PxQueryHitType::Enum defaultHitType = hitCall.maxNbTouches ? PxQueryHitType::eTOUCH : PxQueryHitType::eBLOCK;
+
+		const PxU32 nbCandidates = entry.mCandidates.size();
+		const PxActorShape* candidates = entry.mCandidates.begin();
+		for(PxU32 i=0;i<nbCandidates;i++)
+		{
+			PxRigidActor* actor = candidates[i].actor;
+			PxShape* shape = candidates[i].shape;
+
+			if(filterEquation)
+			{
+				const PxFilterData objFd = shape->getQueryFilterData();
+				const PxU32 keep = (queryFd.word0 & objFd.word0) | (queryFd.word1 & objFd.word1) | (queryFd.word2 & objFd.word2) | (queryFd.word3 & objFd.word3);
+				if(!keep)
+					continue;
+			}
+
+			PxQueryHitType::Enum hitType = defaultHitType;
+			if(preFilter)
+			{
+				PxHitFlags unused;
+				hitType = filterCall->preFilter(filterData.data, shape, actor, unused);
+				if(hitType == PxQueryHitType::eNONE)
+					continue;
+			}
+
+			if(!PxGeometryQuery::overlap(geometry, pose, shape->getGeometry(), PxShapeExt::getGlobalPose(*shape, *actor)))
+				continue;
+
+			PxOverlapHit hit;
+			hit.actor = actor;
+			hit.shape = shape;
+
+			if(postFilter)
+				hitType = filterCall->postFilter(filterData.data, hit, shape, actor);
+
+			if(!reporter.report(hit, hitType))
+				break;
+		}
+	}
+
+	// dynamic objects move all the time, there's no point caching them
+	if(reporter.again() && (filterData.flags & PxQueryFlag::eDYNAMIC))
+	{
+		PxQueryFilterData dynamicFilterData = filterData;
+		dynamicFilterData.flags &= ~PxQueryFlag::eSTATIC;
+
+		ForwardingCallback cb(reporter, hitCall.maxNbTouches);
+		mScene.overlap(geometry, pose, cb, dynamicFilterData, filterCall);
+		if(cb.hasBlock)
+			reporter.report(cb.block, PxQueryHitType::eBLOCK);
+	}
+
+	return reporter.finalize();
+}
+
+PxOverlapCacheExt* physx::PxCreateOverlapCacheExt(const PxScene& scene, PxU32 maxNbHandles, PxReal volumeGrowth)
+{
+	PX_CHECK_AND_RETURN_NULL(maxNbHandles > 0, "PxCreateOverlapCacheExt - maxNbHandles must be greater than zero");
+	PX_CHECK_AND_RETURN_NULL(volumeGrowth >= 1.0f, "PxCreateOverlapCacheExt - volumeGrowth must be greater than or equal to 1.0");
+
+	return PX_NEW(ExtOverlapCache)(scene, maxNbHandles, volumeGrowth);
+}
@@ -179,6 +179,10 @@ namespace
 														PxRaycastCallback& hitCall, PxHitFlags hitFlags,
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	void							raycastBatch(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+											PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const;
 		virtual	bool							sweep(	const PxGeometry& geometry, const PxTransform& pose,
 														const PxVec3& unitDir, const PxReal distance,
 														PxSweepCallback& hitCall, PxHitFlags hitFlags,
@@ -188,6 +192,12 @@ namespace
 														PxOverlapCallback& hitCall, 
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	bool							cull(	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const;
+		virtual	PxU32							nearest(const PxVec3& point, PxReal maxDist, PxNearestHit* hits, PxU32 maxNbHits,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const;
 		virtual	PxSQPrunerHandle				getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const;
 		virtual	void							sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
 													const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices);
@@ -370,6 +380,14 @@ bool ExternalPxSQ::raycast(	const PxVec3& origin, const PxVec3& unitDir, const P
 	return mQueries._raycast(origin, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, flags);
 }
 
+void ExternalPxSQ::raycastBatch(	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+									PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags,
+									const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+									PxGeometryQueryFlags flags) const
+{
+	mQueries._raycastBatch(nbRays, origins, unitDirs, distances, hitCalls, hitFlags, filterData, filterCall, flags);
+}
+
 bool ExternalPxSQ::sweep(	const PxGeometry& geometry, const PxTransform& pose,
 							const PxVec3& unitDir, const PxReal distance,
 							PxSweepCallback& hitCall, PxHitFlags hitFlags,
@@ -387,6 +405,20 @@ bool ExternalPxSQ::overlap(	const PxGeometry& geometry, const PxTransform& trans
 	return mQueries._overlap( geometry, transform, hitCall, filterData, filterCall, cache, flags);
 }
 
+bool ExternalPxSQ::cull(	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hitCall,
+					const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+					PxGeometryQueryFlags flags) const
+{
+	return mQueries._cull(nbPlanes, planes, hitCall, filterData, filterCall, flags);
+}
+
+PxU32 ExternalPxSQ::nearest(	const PxVec3& point, PxReal maxDist, PxNearestHit* hits, PxU32 maxNbHits,
+					const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+					PxGeometryQueryFlags flags) const
+{
+	return mQueries._nearest(point, maxDist, hits, maxNbHits, filterData, filterCall, flags);
+}
+
 PxSQPrunerHandle ExternalPxSQ::getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex) const
 {
 	const PxU32 actorIndex = actor.getInternalActorIndex();
@@ -431,12 +463,13 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 		case PxBVHBuildStrategy::eFAST:		return BVH_SPLATTER_POINTS;
 		case PxBVHBuildStrategy::eDEFAULT:	return BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER;
 		case PxBVHBuildStrategy::eSAH:		return BVH_SAH;
+		case PxBVHBuildStrategy::eSAH_PARALLEL:	return BVH_SAH;
 		case PxBVHBuildStrategy::eLAST:		return BVH_SPLATTER_POINTS;
 	}
 	return BVH_SPLATTER_POINTS;
 }
 
-static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
+static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode, bool quantizedTree)
 {
 //	if(0)
 //		return createIncrementalPruner(contextID);
@@ -448,20 +481,21 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 	switch(type)
 	{
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
-		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
-		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode, NULL, quantizedTree);		break;	}
+		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode, NULL, quantizedTree);	break;	}
 		case PxPruningStructureType::eLAST:					break;
 	}
 	return pruner;
 }
 
-PxSceneQuerySystem* physx::PxCreateExternalSceneQuerySystem(const PxSceneQueryDesc& desc, PxU64 contextID)
+PxSceneQuerySystem* physx::PxCreateExternalSceneQuerySystem(const PxSceneQueryDesc& desc, PxU64 contextID, PxCpuDispatcher* dispatcher)
 {
 	PVDCapture* pvd = NULL;
-	Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode);
-	Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode);
+	Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode, desc.staticQuantizedTree);
+	Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode, false);
 
 	ExternalPxSQ* pxsq = PX_NEW(ExternalPxSQ)(pvd, contextID, staticPruner, dynamicPruner, desc.dynamicTreeRebuildRateHint, desc.sceneQueryUpdateMode, PxSceneLimits());
+	pxsq->SQ().setTaskDispatcher(dispatcher);
 
 	addExternalSQ(pxsq);
 
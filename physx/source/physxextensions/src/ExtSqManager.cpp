@@ -27,6 +27,7 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "ExtSqManager.h"
+#include "GuSqInternal.h"
 	#define SQ_DEBUG_VIZ_STATIC_COLOR	PxU32(PxDebugColor::eARGB_BLUE)
 	#define SQ_DEBUG_VIZ_DYNAMIC_COLOR	PxU32(PxDebugColor::eARGB_RED)
 	#define SQ_DEBUG_VIZ_STATIC_COLOR2	PxU32(PxDebugColor::eARGB_DARKBLUE)
@@ -56,6 +57,7 @@ ExtPrunerManager::ExtPrunerManager(PxU64 contextID, float inflation, const Adapt
 	mStaticTimestamp		(0),
 	mRebuildRateHint		(100),
 	mInflation				(inflation),
+	mTaskDispatcher			(NULL),
 	mPrunerNeedsUpdating	(false),
 	mTimestampNeedsUpdating	(false),
 	mUsesTreeOfPruners		(usesTreeOfPruners)
@@ -82,6 +84,8 @@ PxU32 ExtPrunerManager::addPruner(Pruner* pruner, PxU32 preallocated)
 	pe->init(pruner);
 	if(preallocated)
 		pe->preallocate(preallocated);
+	if(pruner && pruner->isDynamic())
+		static_cast<DynamicPruner*>(pruner)->setTaskDispatcher(mTaskDispatcher);
 	mPrunerExt.pushBack(pe);
 	return index;
 }
@@ -217,6 +221,34 @@ void ExtPrunerManager::setDynamicTreeRebuildRateHint(PxU32 rebuildRateHint)
 	}
 }
 
+void ExtPrunerManager::setTaskDispatcher(PxCpuDispatcher* dispatcher)
+{
+	mTaskDispatcher = dispatcher;
+
+	const PxU32 nb = mPrunerExt.size();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		Pruner* pruner = mPrunerExt[i]->pruner();
+		if(pruner && pruner->isDynamic())
+			static_cast<DynamicPruner*>(pruner)->setTaskDispatcher(dispatcher);
+	}
+}
+
+void ExtPrunerManager::updatePruners(bool buildStep, bool commit)
+{
+	mPrunersToUpdate.clear();
+
+	const PxU32 nb = mPrunerExt.size();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		Pruner* pruner = mPrunerExt[i]->pruner();
+		if(pruner)
+			mPrunersToUpdate.pushBack(pruner);
+	}
+
+	::updatePruners(mPrunersToUpdate.begin(), mPrunersToUpdate.size(), buildStep, commit, mTaskDispatcher, mContextID);
+}
+
 void ExtPrunerManager::afterSync(bool buildStep, bool commit)
 {
 	PX_PROFILE_ZONE("Sim.sceneQueryBuildStep", mContextID);
@@ -230,22 +262,7 @@ void ExtPrunerManager::afterSync(bool buildStep, bool commit)
 	// flush user modified objects
 	flushShapes();
 
-	// PT: TODO: with N pruners this part would be worth multi-threading
-
-	const PxU32 nb = mPrunerExt.size();
-	for(PxU32 i=0;i<nb;i++)
-	{
-		PrunerExt* pe = mPrunerExt[i];
-		Pruner* pruner = pe->pruner();
-		if(pruner)
-		{
-			if(pruner->isDynamic())
-				static_cast<DynamicPruner*>(pruner)->buildStep(true);
-
-			if(commit)
-				pruner->commit();
-		}
-	}
+	updatePruners(true, commit);
 
 	if(commit)
 	{
@@ -293,13 +310,7 @@ void ExtPrunerManager::flushUpdates()
 		{
 			flushShapes();
 
-			const PxU32 nb = mPrunerExt.size();
-			for(PxU32 i=0;i<nb;i++)
-			{
-				PrunerExt* pe = mPrunerExt[i];
-				if(pe->pruner())
-					pe->pruner()->commit();
-			}
+			updatePruners(false, true);
 
 			if(mUsesTreeOfPruners)
 				createTreeOfPruners();
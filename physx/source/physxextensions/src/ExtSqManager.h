@@ -52,6 +52,7 @@ namespace physx
 class PxRenderOutput;
 class PxBVH;
 class PxSceneLimits;
+class PxCpuDispatcher;
 
 namespace Gu
 {
@@ -85,6 +86,9 @@ namespace Sq
 
 						void							setDynamicTreeRebuildRateHint(PxU32 dynTreeRebuildRateHint);
 		PX_FORCE_INLINE	PxU32							getDynamicTreeRebuildRateHint()				const	{ return mRebuildRateHint;				}
+
+						// optional dispatcher used to update the pruners (and refit large dynamic trees) in parallel
+						void							setTaskDispatcher(PxCpuDispatcher* dispatcher);
 						
 						void							flushUpdates();
 						void							forceRebuildDynamicTree(PxU32 prunerIndex);
@@ -121,6 +125,8 @@ namespace Sq
 						PxU32							mStaticTimestamp;
 						PxU32							mRebuildRateHint;
 						const float						mInflation;	// SQ_PRUNER_EPSILON
+						PxCpuDispatcher*				mTaskDispatcher;
+						PxArray<Gu::Pruner*>			mPrunersToUpdate;	// scratch buffer for updatePruners()
 
 						PxMutex							mSQLock;  // to make sure only one query updates the dirty pruner structure if multiple queries run in parallel
 
@@ -129,6 +135,7 @@ namespace Sq
 						const bool						mUsesTreeOfPruners;
 
 						void							flushShapes();
+						void							updatePruners(bool buildStep, bool commit);
 		PX_FORCE_INLINE void							invalidateStaticTimestamp()		{ mStaticTimestamp++;		}
 
 						PX_NOCOPY(ExtPrunerManager)
@@ -37,12 +37,14 @@ using namespace Sq;
 #include "GuIntersectionRayBox.h"
 #include "GuIntersectionRay.h"
 #include "GuBVH.h"
+#include "GuSqInternal.h"
 #include "geometry/PxGeometryQuery.h"
 #include "geometry/PxSphereGeometry.h"
 #include "geometry/PxBoxGeometry.h"
 #include "geometry/PxCapsuleGeometry.h"
 #include "geometry/PxConvexMeshGeometry.h"
 #include "geometry/PxTriangleMeshGeometry.h"
+#include "foundation/PxPlane.h"
 //#include "geometry/PxBVH.h"
 
 #include "PxQueryFiltering.h"
@@ -141,6 +143,8 @@ namespace physx
 		const PxGeometry* geometry; // only valid for overlaps and sweeps
 		const PxTransform* pose; // only valid for overlaps and sweeps
 		PxReal inflation; // only valid for sweeps
+		const PxPlane* planes; // only valid for culling
+		PxU32 nbPlanes; // only valid for culling
 
 		// Raycast constructor
 		ExtMultiQueryInput(const PxVec3& aRayOrigin, const PxVec3& aUnitDir, PxReal aMaxDist)
@@ -151,6 +155,8 @@ namespace physx
 			geometry = NULL;
 			pose = NULL;
 			inflation = 0.0f;
+			planes = NULL;
+			nbPlanes = 0;
 		}
 
 		// Overlap constructor
@@ -160,6 +166,20 @@ namespace physx
 			pose = aPose;
 			inflation = 0.0f;
 			rayOrigin = unitDir = NULL;
+			planes = NULL;
+			nbPlanes = 0;
+		}
+
+		// Cull constructor
+		ExtMultiQueryInput(PxU32 aNbPlanes, const PxPlane* aPlanes)
+		{
+			rayOrigin = unitDir = NULL;
+			maxDistance = PX_MAX_REAL;
+			geometry = NULL;
+			pose = NULL;
+			inflation = 0.0f;
+			planes = aPlanes;
+			nbPlanes = aNbPlanes;
 		}
 
 		// Sweep constructor
@@ -173,6 +193,8 @@ namespace physx
 			geometry = aGeometry;
 			pose = aPose;
 			inflation = aInflation;
+			planes = NULL;
+			nbPlanes = 0;
 		}
 
 		PX_FORCE_INLINE const PxVec3& getDir() const { PX_ASSERT(unitDir); return *unitDir; }
@@ -314,6 +336,10 @@ struct ExtGeomQueryAny
 		// Handle overlaps
 		else if(HitTypeSupport<HitType>::IsOverlap)
 		{
+			// culling queries only test bounds, every shape reported by the pruners is a hit
+			if(input.planes)
+				return 1;
+
 			const GeomOverlapTable* overlapFuncs = funcs.mCachedOverlapFuncs;
 			return PxU32(Gu::overlap(geom0, pose0, geom1, pose1, overlapFuncs, context));
 		}
@@ -862,6 +888,26 @@ struct LocalOverlapCallback : LocalBaseCallback<HitType>, PxBVH::OverlapCallback
 	PX_NOCOPY(LocalOverlapCallback)
 };
 
+template<typename HitType>
+struct LocalCullCallback : LocalBaseCallback<HitType>, PxBVH::OverlapCallback
+{
+	LocalCullCallback(PxU32 nbPlanes, const PxPlane* planes, ExtMultiQueryCallback<HitType>& pcb, const Sq::ExtPrunerManager& manager, const ExtQueryAdapter& adapter, PxHitCallback<HitType>& hits, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall) :
+		LocalBaseCallback<HitType>(pcb, manager, adapter, hits, filterData, filterCall), mNbPlanes(nbPlanes), mPlanes(planes)	{}
+
+	virtual bool	reportHit(PxU32 boundsIndex)
+	{
+		const Pruner* pruner = LocalBaseCallback<HitType>::filtering(boundsIndex);
+		if(!pruner)
+			return true;
+		return pruner->cull(mNbPlanes, mPlanes, this->mPCB);
+	}
+
+	const PxU32		mNbPlanes;
+	const PxPlane*	mPlanes;
+
+	PX_NOCOPY(LocalCullCallback)
+};
+
 template<typename HitType>
 struct LocalSweepCallback : LocalBaseCallback<HitType>, PxBVH::RaycastCallback
 {
@@ -1115,6 +1161,170 @@ bool ExtSceneQueries::_raycast(
 
 //////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	// per-ray state for packet raycasts. This is the same setup as in multiQuery for a single raycast.
+	struct ExtRaycastPacketQuery
+	{
+		const ExtMultiQueryInput					mInput;
+#if PX_SUPPORT_PVD
+		ExtCapturePvdOnReturn<PxRaycastHit>			mPvdCapture;
+#endif
+		ExtIssueCallbacksOnReturn<PxRaycastHit>		mCallbacksOnReturn;
+		ExtMultiQueryCallback<PxRaycastHit>			mPCB;
+
+		ExtRaycastPacketQuery(	const ExtSceneQueries& sq, const PxVec3& origin, const PxVec3& unitDir, PxReal distance, bool anyHit,
+								PxRaycastCallback& hits, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall) :
+			mInput				(origin, unitDir, distance),
+#if PX_SUPPORT_PVD
+			mPvdCapture			(&sq, mInput, filterData, hits),
+#endif
+			mCallbacksOnReturn	(hits),
+			mPCB				(sq, mInput, anyHit, hits, hitFlags, filterData, filterCall, distance)
+		{
+			hits.hasBlock = false;
+			hits.nbTouches = 0;
+		}
+
+		PX_NOCOPY(ExtRaycastPacketQuery)
+	};
+}
+
+static PX_FORCE_INLINE bool isValidRay(const PxVec3& origin, const PxVec3& unitDir, PxReal distance)
+{
+	return origin.isFinite() && unitDir.isFinite() && unitDir.isNormalized() && distance > 0.0f;
+}
+
+// raycasts up to GU_RAY_PACKET_SIZE rays sharing the same flags and filtering. Each pruner is traversed once per packet,
+// while filtering, narrow-phase and hit reporting are done per ray exactly as in multiQuery.
+static void raycastPacket(	const ExtSceneQueries& sq, PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+							PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall)
+{
+	PX_ASSERT(nbRays<=GU_RAY_PACKET_SIZE);
+
+	const bool anyHit = (filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT;
+
+	const ExtPrunerManager& manager = sq.getPrunerManagerFast();
+	const_cast<ExtPrunerManager&>(manager).flushUpdates();
+
+	PX_ALIGN(16, PxU8 queryBuffer[sizeof(ExtRaycastPacketQuery)*GU_RAY_PACKET_SIZE]);
+	ExtRaycastPacketQuery* queries = reinterpret_cast<ExtRaycastPacketQuery*>(queryBuffer);
+	PrunerRaycastCallback* pcbs[GU_RAY_PACKET_SIZE];
+	PxReal shrunkDistances[GU_RAY_PACKET_SIZE];
+
+	PxU32 queryMask = 0;
+	for(PxU32 i=0;i<nbRays;i++)
+	{
+		// invalid rays go through the regular path, which reports the errors
+		if(!isValidRay(origins[i], unitDirs[i], distances[i]))
+		{
+			const ExtMultiQueryInput input(origins[i], unitDirs[i], distances[i]);
+			sq.multiQuery<PxRaycastHit>(input, *hitCalls[i], hitFlags, NULL, filterData, filterCall);
+			pcbs[i] = NULL;
+			continue;
+		}
+
+		PX_PLACEMENT_NEW(queries + i, ExtRaycastPacketQuery)(sq, origins[i], unitDirs[i], distances[i], anyHit, *hitCalls[i], hitFlags, filterData, filterCall);
+		pcbs[i] = &queries[i].mPCB;
+		queryMask |= 1<<i;
+	}
+
+	const ExtQueryAdapter& adapter = static_cast<const ExtQueryAdapter&>(manager.getAdapter());
+	const PxU32 nbPruners = manager.getNbPruners();
+	const CompoundPruner* compoundPruner = manager.getCompoundPruner();
+
+	const PxCompoundPrunerQueryFlags compoundPrunerQueryFlags = convertFlags(filterData.flags);
+
+	// rays stopped by a pruner still issue their final processTouches() call, like in multiQuery
+	PxU32 stoppedMask = 0;
+	PxU32 activeMask = queryMask;
+
+	if(manager.getTreeOfPruners())
+	{
+		// the tree of pruners is traversed per ray
+		PxU32 mask = activeMask;
+		while(mask)
+		{
+			const PxU32 i = PxLowestSetBit(mask);
+			mask &= mask - 1;
+			ExtRaycastPacketQuery& query = queries[i];
+			LocalRaycastCallback<PxRaycastHit> prunerRaycastCB(query.mInput, query.mPCB, manager, adapter, *hitCalls[i], filterData, filterCall);
+			if(!manager.getTreeOfPruners()->raycast(origins[i], unitDirs[i], query.mPCB.mShrunkDistance, prunerRaycastCB, PxGeometryQueryFlag::Enum(0)))
+				stoppedMask |= 1<<i;
+		}
+	}
+	else
+	{
+		for(PxU32 p=0;p<nbPruners && (activeMask & ~stoppedMask);p++)
+		{
+			// the pruner filter callback can reject a pruner for some rays only
+			PxU32 prunerMask = 0;
+			PxU32 mask = activeMask & ~stoppedMask;
+			while(mask)
+			{
+				const PxU32 i = PxLowestSetBit(mask);
+				mask &= mask - 1;
+				if(prunerFilter(adapter, p, hitCalls[i], filterData, filterCall))
+				{
+					prunerMask |= 1<<i;
+					shrunkDistances[i] = queries[i].mPCB.mShrunkDistance;
+				}
+			}
+
+			if(prunerMask)
+			{
+				const PxU32 survivors = manager.getPruner(p)->raycastPacket(nbRays, origins, unitDirs, shrunkDistances, pcbs, prunerMask);
+				stoppedMask |= prunerMask & ~survivors;
+			}
+		}
+	}
+	activeMask &= ~stoppedMask;
+
+	if(compoundPruner)
+	{
+		PxU32 mask = activeMask;
+		while(mask)
+		{
+			const PxU32 i = PxLowestSetBit(mask);
+			mask &= mask - 1;
+			ExtMultiQueryCallback<PxRaycastHit>& pcb = queries[i].mPCB;
+			if(!compoundPruner->raycast(origins[i], unitDirs[i], pcb.mShrunkDistance, pcb, compoundPrunerQueryFlags))
+				activeMask &= ~(1<<i);
+		}
+	}
+
+	PxU32 mask = queryMask;
+	while(mask)
+	{
+		const PxU32 i = PxLowestSetBit(mask);
+		mask &= mask - 1;
+		queries[i].mCallbacksOnReturn.again = (activeMask & (1<<i)) != 0;	// update the status to avoid duplicate processTouches()
+		queries[i].~ExtRaycastPacketQuery();
+	}
+}
+
+void ExtSceneQueries::_raycastBatch(
+	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+	PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+	PxGeometryQueryFlags flags) const
+{
+	PX_PROFILE_ZONE("SceneQuery.raycastBatch", getContextId());
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	while(nbRays)
+	{
+		const PxU32 nb = PxMin(nbRays, PxU32(GU_RAY_PACKET_SIZE));
+		raycastPacket(*this, nb, origins, unitDirs, distances, hitCalls, hitFlags, filterData, filterCall);
+		origins += nb;
+		unitDirs += nb;
+		distances += nb;
+		hitCalls += nb;
+		nbRays -= nb;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 bool ExtSceneQueries::_overlap(
 	const PxGeometry& geometry, const PxTransform& pose, PxOverlapCallback& hits,
 	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
@@ -1129,6 +1339,188 @@ bool ExtSceneQueries::_overlap(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool ExtSceneQueries::_cull(
+	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hits,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) const
+{
+	PX_PROFILE_ZONE("SceneQuery.cull", getContextId());
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	PX_CHECK_AND_RETURN_VAL(planes || !nbPlanes, "PxScene::cull(): planes pointer is NULL.", 0);
+	PX_CHECK_AND_RETURN_VAL(nbPlanes <= 32, "PxScene::cull(): at most 32 planes are supported.", 0);
+
+	const bool anyHit = (filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT;
+	PX_CHECK_AND_RETURN_VAL(anyHit || hits.maxNbTouches > 0, "PxScene::cull() calls without eANY_HIT flag require a touch hit buffer for return results.", 0);
+
+	const_cast<ExtSceneQueries*>(this)->mSQManager.flushUpdates();
+
+	// culling queries are not captured by PVD, which has no representation for them
+	ExtIssueCallbacksOnReturn<PxOverlapHit> cbr(hits); // destructor will execute callbacks on return from this function
+	hits.hasBlock = false;
+	hits.nbTouches = 0;
+
+	const ExtMultiQueryInput input(nbPlanes, planes);
+	ExtMultiQueryCallback<PxOverlapHit> pcb(*this, input, anyHit, hits, PxHitFlags(), filterData, filterCall, PX_MAX_REAL);
+
+	const ExtQueryAdapter& adapter = static_cast<const ExtQueryAdapter&>(mSQManager.getAdapter());
+	const PxU32 nbPruners = mSQManager.getNbPruners();
+	const CompoundPruner* compoundPruner = mSQManager.getCompoundPruner();
+	const BVH* treeOfPruners = mSQManager.getTreeOfPruners();
+
+	bool again = true;
+	if(treeOfPruners)
+	{
+		LocalCullCallback<PxOverlapHit> prunerCullCB(nbPlanes, planes, pcb, mSQManager, adapter, hits, filterData, filterCall);
+		again = treeOfPruners->cull(nbPlanes, planes, prunerCullCB, PxGeometryQueryFlag::Enum(0));
+	}
+	else
+	{
+		for(PxU32 i=0;i<nbPruners && again;i++)
+		{
+			if(prunerFilter(adapter, i, &hits, filterData, filterCall))
+				again = mSQManager.getPruner(i)->cull(nbPlanes, planes, pcb);
+		}
+	}
+
+	if(again && compoundPruner)
+		again = compoundPruner->cull(nbPlanes, planes, pcb, convertFlags(filterData.flags));
+
+	cbr.again = again; // update the status to avoid duplicate processTouches()
+	return hits.hasAnyHits();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// callback for nearest-neighbour queries. Candidates reported by the pruners are filtered, then their exact distance to
+// the query point is computed and they are inserted in the user buffer, sorted by increasing distance. Once the buffer is
+// full the query distance shrinks to the distance of the furthest hit, so that the pruners can discard further objects.
+struct ExtNearestQueryCallback : public PrunerRaycastCallback, public CompoundPrunerRaycastCallback, public PxQueryThreadContext
+{
+	const ExtSceneQueries&		mScene;
+	const PxVec3&				mPoint;
+	PxNearestHit*				mHits;
+	const PxU32					mMaxNbHits;
+	PxU32						mNbHits;
+	const PxQueryFilterData&	mFilterData;
+	PxQueryFilterCallback*		mFilterCall;
+	const bool					mAnyHit;
+	PxTransform					mCompoundShapeTransform;
+
+	ExtNearestQueryCallback(const ExtSceneQueries& scene, const PxVec3& point, PxNearestHit* hits, PxU32 maxNbHits, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall) :
+		mScene		(scene),
+		mPoint		(point),
+		mHits		(hits),
+		mMaxNbHits	(maxNbHits),
+		mNbHits		(0),
+		mFilterData	(filterData),
+		mFilterCall	(filterCall),
+		mAnyHit		((filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT)
+	{
+	}
+
+	bool _invoke(PxReal& aDist, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms, const PxTransform* compoundPose)
+	{
+		PX_ASSERT(payloads && transforms);
+		const PrunerPayload& payload = payloads[primIndex];
+		const ExtQueryAdapter& adapter = static_cast<const ExtQueryAdapter&>(mScene.mSQManager.getAdapter());
+
+		PxActorShape actorShape;
+		adapter.getActorShape(payload, actorShape);
+
+		// eTOUCH and eBLOCK are treated the same way, only eNONE discards the object
+		PxQueryHitType::Enum shapeHitType = PxQueryHitType::eTOUCH;
+		PxHitFlags unused;
+		if(!applyAllPreFiltersSQ(adapter, payload, actorShape, shapeHitType, mFilterData.flags, mFilterData, mFilterCall, unused))
+			return true;
+
+		const PxTransform* shapeTransform;
+		if(!compoundPose)
+		{
+			shapeTransform = transforms + primIndex;
+		}
+		else
+		{
+			computeCompoundShapeTransform(&mCompoundShapeTransform, compoundPose, transforms, primIndex);
+			shapeTransform = &mCompoundShapeTransform;
+		}
+
+		PxNearestHit hit;
+		hit.distance = PxSqrt(computeNearestDistance2(mPoint, adapter.getGeometry(payload), *shapeTransform, hit.position, hit.faceIndex));
+		if(hit.distance > aDist)
+			return true;
+
+		hit.actor = actorShape.actor;
+		hit.shape = actorShape.shape;
+
+		if(mFilterCall && (mFilterData.flags & PxQueryFlag::ePOSTFILTER))
+		{
+			if(mFilterCall->postFilter(mFilterData.data, hit, hit.shape, hit.actor) == PxQueryHitType::eNONE)
+				return true;
+		}
+
+		mNbHits = insertNearestHit(mHits, mNbHits, mMaxNbHits, hit);
+		if(mAnyHit)
+			return false;
+
+		if(mNbHits == mMaxNbHits)
+			aDist = mHits[mNbHits-1].distance;
+		return true;
+	}
+
+	virtual bool	invoke(PxReal& aDist, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms)	PX_OVERRIDE PX_FINAL
+	{
+		return _invoke(aDist, primIndex, payloads, transforms, NULL);
+	}
+
+	virtual bool	invoke(PxReal& aDist, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms, const PxTransform* compoundPose)	PX_OVERRIDE PX_FINAL
+	{
+		return _invoke(aDist, primIndex, payloads, transforms, compoundPose);
+	}
+
+	PX_NOCOPY(ExtNearestQueryCallback)
+};
+
+PxU32 ExtSceneQueries::_nearest(
+	const PxVec3& point, PxReal maxDist, PxNearestHit* hits, PxU32 maxNbHits,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) const
+{
+	PX_PROFILE_ZONE("SceneQuery.nearest", getContextId());
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	PX_CHECK_AND_RETURN_VAL(point.isFinite(), "PxScene::nearest(): point is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(maxDist >= 0.0f, "PxScene::nearest(): maxDist must be positive.", 0);
+	PX_CHECK_AND_RETURN_VAL(hits || !maxNbHits, "PxScene::nearest(): hits buffer is NULL.", 0);
+
+	if(!maxNbHits)
+		return 0;
+
+	const_cast<ExtSceneQueries*>(this)->mSQManager.flushUpdates();
+
+	// nearest-neighbour queries are not captured by PVD, which has no representation for them
+	ExtNearestQueryCallback pcb(*this, point, hits, maxNbHits, filterData, filterCall);
+
+	const ExtQueryAdapter& adapter = static_cast<const ExtQueryAdapter&>(mSQManager.getAdapter());
+	const PxU32 nbPruners = mSQManager.getNbPruners();
+	const CompoundPruner* compoundPruner = mSQManager.getCompoundPruner();
+
+	// the tree of pruners has no nearest-neighbour query, but each pruner discards itself quickly when its root is too far.
+	// The same distance is passed to all pruners, so that hits found in one of them also shrink the search in the others.
+	PxReal distance = maxDist;
+	bool again = true;
+	for(PxU32 i=0;i<nbPruners && again;i++)
+	{
+		if(prunerFilter(adapter, i, &pcb, filterData, filterCall))
+			again = mSQManager.getPruner(i)->nearest(point, distance, pcb);
+	}
+
+	if(again && compoundPruner)
+		compoundPruner->nearest(point, distance, pcb, convertFlags(filterData.flags));
+
+	return pcb.mNbHits;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool ExtSceneQueries::_sweep(
 	const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, const PxReal distance,
 	PxHitCallback<PxSweepHit>& hits, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
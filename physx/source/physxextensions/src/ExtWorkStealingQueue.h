@@ -0,0 +1,128 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef EXT_WORK_STEALING_QUEUE_H
+#define EXT_WORK_STEALING_QUEUE_H
+
+#include "task/PxTask.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxIntrinsics.h"
+#include "foundation/PxUserAllocated.h"
+
+namespace physx
+{
+
+#define EXT_WORK_STEALING_QUEUE_SIZE 4096	// must be a power of two
+
+namespace Ext
+{
+	// fixed-capacity Chase-Lev deque. The owner thread pushes & pops at the bottom (LIFO), other threads
+	// steal from the top (FIFO). Only steals and the last-item pop go through a CAS, so the owner's common path
+	// is contention-free. When the ring buffer is full push() fails and the caller must use another queue.
+	class WorkStealingQueue : public PxUserAllocated
+	{
+		PX_NOCOPY(WorkStealingQueue)
+	public:
+		WorkStealingQueue() : mTop(0), mBottom(0)
+		{
+			for(PxU32 i=0; i<EXT_WORK_STEALING_QUEUE_SIZE; i++)
+				mTasks[i] = NULL;
+		}
+
+		// Owner thread only
+		PX_FORCE_INLINE	bool	push(PxBaseTask& task)
+		{
+			const PxI64 b = mBottom;
+			const PxI64 t = mTop;
+			if(b - t >= EXT_WORK_STEALING_QUEUE_SIZE)
+				return false;
+
+			mTasks[b & (EXT_WORK_STEALING_QUEUE_SIZE-1)] = &task;
+			// make the task visible before publishing the new bottom
+			PxMemoryBarrier();
+			mBottom = b + 1;
+			return true;
+		}
+
+		// Owner thread only
+		PX_FORCE_INLINE	PxBaseTask*	pop()
+		{
+			const PxI64 b = mBottom - 1;
+			mBottom = b;
+			// the store to mBottom must be visible before we read mTop, otherwise a thief and the owner can both take the last task
+			PxMemoryBarrier();
+			const PxI64 t = mTop;
+
+			if(t > b)
+			{
+				// empty
+				mBottom = b + 1;
+				return NULL;
+			}
+
+			PxBaseTask* task = mTasks[b & (EXT_WORK_STEALING_QUEUE_SIZE-1)];
+			if(t == b)
+			{
+				// last task, race against thieves
+				if(PxAtomicCompareExchange(&mTop, t + 1, t) != t)
+					task = NULL;
+				mBottom = b + 1;
+			}
+			return task;
+		}
+
+		// Any thread
+		PX_FORCE_INLINE	PxBaseTask*	steal()
+		{
+			const PxI64 t = mTop;
+			PxMemoryBarrier();
+			const PxI64 b = mBottom;
+			if(t >= b)
+				return NULL;
+
+			PxBaseTask* task = mTasks[t & (EXT_WORK_STEALING_QUEUE_SIZE-1)];
+			if(PxAtomicCompareExchange(&mTop, t + 1, t) != t)
+				return NULL;	// lost the race against the owner or another thief
+			return task;
+		}
+
+		PX_FORCE_INLINE	bool	isEmpty()	const	{ return mTop >= mBottom;	}
+
+	private:
+		// top & bottom live on different cache lines to avoid false sharing between the owner and thieves
+		volatile PxI64					mTop;
+		PxU8							mPad[64 - sizeof(PxI64)];
+		volatile PxI64					mBottom;
+		PxBaseTask* volatile			mTasks[EXT_WORK_STEALING_QUEUE_SIZE];
+	};
+
+} // namespace Ext
+
+}
+
+#endif
@@ -376,6 +376,7 @@ PxSceneQueryDesc_StaticBVHBuildStrategy,
 PxSceneQueryDesc_DynamicBVHBuildStrategy,
 PxSceneQueryDesc_StaticNbObjectsPerNode,
 PxSceneQueryDesc_DynamicNbObjectsPerNode,
+PxSceneQueryDesc_StaticQuantizedTree,
 PxSceneQueryDesc_SceneQueryUpdateMode,
 PxSceneQueryDesc_PropertiesStop,
 PxSceneDesc_PropertiesStart,
@@ -418,6 +419,7 @@ PxSceneDesc_GpuMaxNumPartitions,
 PxSceneDesc_GpuMaxNumStaticPartitions,
 PxSceneDesc_GpuComputeVersion,
 PxSceneDesc_ContactPairSlabSize,
+PxSceneDesc_FrameArenaChunkSize,
 PxSceneDesc_PropertiesStop,
 PxBroadPhaseDesc_PropertiesStart,
 PxBroadPhaseDesc_IsValid,
@@ -480,6 +482,8 @@ PxSimulationStatistics_NbAxisSolverConstraints,
 PxSimulationStatistics_CompressedContactSize,
 PxSimulationStatistics_RequiredContactConstraintMemory,
 PxSimulationStatistics_PeakConstraintMemory,
+PxSimulationStatistics_FrameArenaHighWaterMark,
+PxSimulationStatistics_FrameArenaCapacity,
 PxSimulationStatistics_NbDiscreteContactPairsTotal,
 PxSimulationStatistics_NbDiscreteContactPairsWithCacheHits,
 PxSimulationStatistics_NbDiscreteContactPairsWithContacts,
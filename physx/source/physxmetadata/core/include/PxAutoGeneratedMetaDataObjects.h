@@ -3179,6 +3179,7 @@ template<> struct PxEnumTraits< physx::PxDynamicTreeSecondaryPruner::Enum > { Px
 		{ "eFAST", static_cast<PxU32>( physx::PxBVHBuildStrategy::eFAST ) },
 		{ "eDEFAULT", static_cast<PxU32>( physx::PxBVHBuildStrategy::eDEFAULT ) },
 		{ "eSAH", static_cast<PxU32>( physx::PxBVHBuildStrategy::eSAH ) },
+		{ "eSAH_PARALLEL", static_cast<PxU32>( physx::PxBVHBuildStrategy::eSAH_PARALLEL ) },
 		{ "eLAST", static_cast<PxU32>( physx::PxBVHBuildStrategy::eLAST ) },
 		{ NULL, 0 }
 	};
@@ -3196,6 +3197,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 		PxBVHBuildStrategy::Enum DynamicBVHBuildStrategy;
 		PxU32 StaticNbObjectsPerNode;
 		PxU32 DynamicNbObjectsPerNode;
+		_Bool StaticQuantizedTree;
 		PxSceneQueryUpdateMode::Enum SceneQueryUpdateMode;
 		 PX_PHYSX_CORE_API PxSceneQueryDescGeneratedValues( const PxSceneQueryDesc* inSource );
 	};
@@ -3208,6 +3210,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneQueryDesc, DynamicBVHBuildStrategy, PxSceneQueryDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneQueryDesc, StaticNbObjectsPerNode, PxSceneQueryDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneQueryDesc, DynamicNbObjectsPerNode, PxSceneQueryDescGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneQueryDesc, StaticQuantizedTree, PxSceneQueryDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneQueryDesc, SceneQueryUpdateMode, PxSceneQueryDescGeneratedValues)
 	struct PxSceneQueryDescGeneratedInfo
 
@@ -3222,6 +3225,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneQueryDesc_DynamicBVHBuildStrategy, PxSceneQueryDesc, PxBVHBuildStrategy::Enum, PxBVHBuildStrategy::Enum > DynamicBVHBuildStrategy;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneQueryDesc_StaticNbObjectsPerNode, PxSceneQueryDesc, PxU32, PxU32 > StaticNbObjectsPerNode;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneQueryDesc_DynamicNbObjectsPerNode, PxSceneQueryDesc, PxU32, PxU32 > DynamicNbObjectsPerNode;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneQueryDesc_StaticQuantizedTree, PxSceneQueryDesc, _Bool, _Bool > StaticQuantizedTree;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneQueryDesc_SceneQueryUpdateMode, PxSceneQueryDesc, PxSceneQueryUpdateMode::Enum, PxSceneQueryUpdateMode::Enum > SceneQueryUpdateMode;
 
 		PX_PHYSX_CORE_API PxSceneQueryDescGeneratedInfo();
@@ -3242,7 +3246,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 			PX_UNUSED(inStartIndex);
 			return inStartIndex;
 		}
-		static PxU32 instancePropertyCount() { return 10; }
+		static PxU32 instancePropertyCount() { return 11; }
 		static PxU32 totalPropertyCount() { return instancePropertyCount(); }
 		template<typename TOperator>
 		PxU32 visitInstanceProperties( TOperator inOperator, PxU32 inStartIndex = 0 ) const
@@ -3258,8 +3262,9 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 			inOperator( DynamicBVHBuildStrategy, inStartIndex + 6 );; 
 			inOperator( StaticNbObjectsPerNode, inStartIndex + 7 );; 
 			inOperator( DynamicNbObjectsPerNode, inStartIndex + 8 );; 
-			inOperator( SceneQueryUpdateMode, inStartIndex + 9 );; 
-			return 10 + inStartIndex;
+			inOperator( StaticQuantizedTree, inStartIndex + 9 );; 
+			inOperator( SceneQueryUpdateMode, inStartIndex + 10 );; 
+			return 11 + inStartIndex;
 		}
 	};
 	template<> struct PxClassInfoTraits<PxSceneQueryDesc>
@@ -3309,6 +3314,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 		PxU32 GpuMaxNumStaticPartitions;
 		PxU32 GpuComputeVersion;
 		PxU32 ContactPairSlabSize;
+		PxU32 FrameArenaChunkSize;
 		 PX_PHYSX_CORE_API PxSceneDescGeneratedValues( const PxSceneDesc* inSource );
 	};
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, Gravity, PxSceneDescGeneratedValues)
@@ -3349,6 +3355,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, GpuMaxNumStaticPartitions, PxSceneDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, GpuComputeVersion, PxSceneDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, ContactPairSlabSize, PxSceneDescGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, FrameArenaChunkSize, PxSceneDescGeneratedValues)
 	struct PxSceneDescGeneratedInfo
 		: PxSceneQueryDescGeneratedInfo
 	{
@@ -3392,6 +3399,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_GpuMaxNumStaticPartitions, PxSceneDesc, PxU32, PxU32 > GpuMaxNumStaticPartitions;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_GpuComputeVersion, PxSceneDesc, PxU32, PxU32 > GpuComputeVersion;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_ContactPairSlabSize, PxSceneDesc, PxU32, PxU32 > ContactPairSlabSize;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_FrameArenaChunkSize, PxSceneDesc, PxU32, PxU32 > FrameArenaChunkSize;
 
 		PX_PHYSX_CORE_API PxSceneDescGeneratedInfo();
 		template<typename TReturnType, typename TOperator>
@@ -3414,7 +3422,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 			inStartIndex = PxSceneQueryDescGeneratedInfo::visitInstanceProperties( inOperator, inStartIndex );
 			return inStartIndex;
 		}
-		static PxU32 instancePropertyCount() { return 39; }
+		static PxU32 instancePropertyCount() { return 40; }
 		static PxU32 totalPropertyCount() { return instancePropertyCount()
 				+ PxSceneQueryDescGeneratedInfo::totalPropertyCount(); }
 		template<typename TOperator>
@@ -3461,7 +3469,8 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 			inOperator( GpuMaxNumStaticPartitions, inStartIndex + 36 );; 
 			inOperator( GpuComputeVersion, inStartIndex + 37 );; 
 			inOperator( ContactPairSlabSize, inStartIndex + 38 );; 
-			return 39 + inStartIndex;
+			inOperator( FrameArenaChunkSize, inStartIndex + 39 );; 
+			return 40 + inStartIndex;
 		}
 	};
 	template<> struct PxClassInfoTraits<PxSceneDesc>
@@ -3830,6 +3839,8 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 		PxU32 CompressedContactSize;
 		PxU32 RequiredContactConstraintMemory;
 		PxU32 PeakConstraintMemory;
+		PxU64 FrameArenaHighWaterMark;
+		PxU64 FrameArenaCapacity;
 		PxU32 NbDiscreteContactPairsTotal;
 		PxU32 NbDiscreteContactPairsWithCacheHits;
 		PxU32 NbDiscreteContactPairsWithContacts;
@@ -3880,6 +3891,8 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, CompressedContactSize, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, RequiredContactConstraintMemory, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, PeakConstraintMemory, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, FrameArenaHighWaterMark, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, FrameArenaCapacity, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbDiscreteContactPairsTotal, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbDiscreteContactPairsWithCacheHits, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbDiscreteContactPairsWithContacts, PxSimulationStatisticsGeneratedValues)
@@ -3932,6 +3945,8 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_CompressedContactSize, PxSimulationStatistics, PxU32, PxU32 > CompressedContactSize;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_RequiredContactConstraintMemory, PxSimulationStatistics, PxU32, PxU32 > RequiredContactConstraintMemory;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_PeakConstraintMemory, PxSimulationStatistics, PxU32, PxU32 > PeakConstraintMemory;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_FrameArenaHighWaterMark, PxSimulationStatistics, PxU64, PxU64 > FrameArenaHighWaterMark;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_FrameArenaCapacity, PxSimulationStatistics, PxU64, PxU64 > FrameArenaCapacity;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbDiscreteContactPairsTotal, PxSimulationStatistics, PxU32, PxU32 > NbDiscreteContactPairsTotal;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbDiscreteContactPairsWithCacheHits, PxSimulationStatistics, PxU32, PxU32 > NbDiscreteContactPairsWithCacheHits;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbDiscreteContactPairsWithContacts, PxSimulationStatistics, PxU32, PxU32 > NbDiscreteContactPairsWithContacts;
@@ -3987,7 +4002,7 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 			PX_UNUSED(inStartIndex);
 			return inStartIndex;
 		}
-		static PxU32 instancePropertyCount() { return 48; }
+		static PxU32 instancePropertyCount() { return 50; }
 		static PxU32 totalPropertyCount() { return instancePropertyCount(); }
 		template<typename TOperator>
 		PxU32 visitInstanceProperties( TOperator inOperator, PxU32 inStartIndex = 0 ) const
@@ -4006,43 +4021,45 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 			inOperator( CompressedContactSize, inStartIndex + 9 );; 
 			inOperator( RequiredContactConstraintMemory, inStartIndex + 10 );; 
 			inOperator( PeakConstraintMemory, inStartIndex + 11 );; 
-			inOperator( NbDiscreteContactPairsTotal, inStartIndex + 12 );; 
-			inOperator( NbDiscreteContactPairsWithCacheHits, inStartIndex + 13 );; 
-			inOperator( NbDiscreteContactPairsWithContacts, inStartIndex + 14 );; 
-			inOperator( NbNewPairs, inStartIndex + 15 );; 
-			inOperator( NbLostPairs, inStartIndex + 16 );; 
-			inOperator( NbNewTouches, inStartIndex + 17 );; 
-			inOperator( NbLostTouches, inStartIndex + 18 );; 
-			inOperator( NbPartitions, inStartIndex + 19 );; 
-			inOperator( GpuMemParticles, inStartIndex + 20 );; 
-			inOperator( GpuMemDeformableSurfaces, inStartIndex + 21 );; 
-			inOperator( GpuMemDeformableVolumes, inStartIndex + 22 );; 
-			inOperator( GpuMemSoftBodies, inStartIndex + 23 );; 
-			inOperator( GpuMemHeap, inStartIndex + 24 );; 
-			inOperator( GpuMemHeapBroadPhase, inStartIndex + 25 );; 
-			inOperator( GpuMemHeapNarrowPhase, inStartIndex + 26 );; 
-			inOperator( GpuMemHeapSolver, inStartIndex + 27 );; 
-			inOperator( GpuMemHeapArticulation, inStartIndex + 28 );; 
-			inOperator( GpuMemHeapSimulation, inStartIndex + 29 );; 
-			inOperator( GpuMemHeapSimulationArticulation, inStartIndex + 30 );; 
-			inOperator( GpuMemHeapSimulationParticles, inStartIndex + 31 );; 
-			inOperator( GpuMemHeapSimulationDeformableSurface, inStartIndex + 32 );; 
-			inOperator( GpuMemHeapSimulationDeformableVolume, inStartIndex + 33 );; 
-			inOperator( GpuMemHeapSimulationSoftBody, inStartIndex + 34 );; 
-			inOperator( GpuMemHeapParticles, inStartIndex + 35 );; 
-			inOperator( GpuMemHeapDeformableSurfaces, inStartIndex + 36 );; 
-			inOperator( GpuMemHeapDeformableVolumes, inStartIndex + 37 );; 
-			inOperator( GpuMemHeapSoftBodies, inStartIndex + 38 );; 
-			inOperator( GpuMemHeapOther, inStartIndex + 39 );; 
-			inOperator( GpuDynamicsMemoryConfigStatistics, inStartIndex + 40 );; 
-			inOperator( NbBroadPhaseAdds, inStartIndex + 41 );; 
-			inOperator( NbBroadPhaseRemoves, inStartIndex + 42 );; 
-			inOperator( NbDiscreteContactPairs, inStartIndex + 43 );; 
-			inOperator( NbModifiedContactPairs, inStartIndex + 44 );; 
-			inOperator( NbCCDPairs, inStartIndex + 45 );; 
-			inOperator( NbTriggerPairs, inStartIndex + 46 );; 
-			inOperator( NbShapes, inStartIndex + 47 );; 
-			return 48 + inStartIndex;
+			inOperator( FrameArenaHighWaterMark, inStartIndex + 12 );; 
+			inOperator( FrameArenaCapacity, inStartIndex + 13 );; 
+			inOperator( NbDiscreteContactPairsTotal, inStartIndex + 14 );; 
+			inOperator( NbDiscreteContactPairsWithCacheHits, inStartIndex + 15 );; 
+			inOperator( NbDiscreteContactPairsWithContacts, inStartIndex + 16 );; 
+			inOperator( NbNewPairs, inStartIndex + 17 );; 
+			inOperator( NbLostPairs, inStartIndex + 18 );; 
+			inOperator( NbNewTouches, inStartIndex + 19 );; 
+			inOperator( NbLostTouches, inStartIndex + 20 );; 
+			inOperator( NbPartitions, inStartIndex + 21 );; 
+			inOperator( GpuMemParticles, inStartIndex + 22 );; 
+			inOperator( GpuMemDeformableSurfaces, inStartIndex + 23 );; 
+			inOperator( GpuMemDeformableVolumes, inStartIndex + 24 );; 
+			inOperator( GpuMemSoftBodies, inStartIndex + 25 );; 
+			inOperator( GpuMemHeap, inStartIndex + 26 );; 
+			inOperator( GpuMemHeapBroadPhase, inStartIndex + 27 );; 
+			inOperator( GpuMemHeapNarrowPhase, inStartIndex + 28 );; 
+			inOperator( GpuMemHeapSolver, inStartIndex + 29 );; 
+			inOperator( GpuMemHeapArticulation, inStartIndex + 30 );; 
+			inOperator( GpuMemHeapSimulation, inStartIndex + 31 );; 
+			inOperator( GpuMemHeapSimulationArticulation, inStartIndex + 32 );; 
+			inOperator( GpuMemHeapSimulationParticles, inStartIndex + 33 );; 
+			inOperator( GpuMemHeapSimulationDeformableSurface, inStartIndex + 34 );; 
+			inOperator( GpuMemHeapSimulationDeformableVolume, inStartIndex + 35 );; 
+			inOperator( GpuMemHeapSimulationSoftBody, inStartIndex + 36 );; 
+			inOperator( GpuMemHeapParticles, inStartIndex + 37 );; 
+			inOperator( GpuMemHeapDeformableSurfaces, inStartIndex + 38 );; 
+			inOperator( GpuMemHeapDeformableVolumes, inStartIndex + 39 );; 
+			inOperator( GpuMemHeapSoftBodies, inStartIndex + 40 );; 
+			inOperator( GpuMemHeapOther, inStartIndex + 41 );; 
+			inOperator( GpuDynamicsMemoryConfigStatistics, inStartIndex + 42 );; 
+			inOperator( NbBroadPhaseAdds, inStartIndex + 43 );; 
+			inOperator( NbBroadPhaseRemoves, inStartIndex + 44 );; 
+			inOperator( NbDiscreteContactPairs, inStartIndex + 45 );; 
+			inOperator( NbModifiedContactPairs, inStartIndex + 46 );; 
+			inOperator( NbCCDPairs, inStartIndex + 47 );; 
+			inOperator( NbTriggerPairs, inStartIndex + 48 );; 
+			inOperator( NbShapes, inStartIndex + 49 );; 
+			return 50 + inStartIndex;
 		}
 	};
 	template<> struct PxClassInfoTraits<PxSimulationStatistics>
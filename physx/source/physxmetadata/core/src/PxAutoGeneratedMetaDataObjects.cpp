@@ -1241,6 +1241,8 @@ inline PxU32 getPxSceneQueryDescStaticNbObjectsPerNode( const PxSceneQueryDesc*
 inline void setPxSceneQueryDescStaticNbObjectsPerNode( PxSceneQueryDesc* inOwner, PxU32 inData) { inOwner->staticNbObjectsPerNode = inData; }
 inline PxU32 getPxSceneQueryDescDynamicNbObjectsPerNode( const PxSceneQueryDesc* inOwner ) { return inOwner->dynamicNbObjectsPerNode; }
 inline void setPxSceneQueryDescDynamicNbObjectsPerNode( PxSceneQueryDesc* inOwner, PxU32 inData) { inOwner->dynamicNbObjectsPerNode = inData; }
+inline _Bool getPxSceneQueryDescStaticQuantizedTree( const PxSceneQueryDesc* inOwner ) { return inOwner->staticQuantizedTree; }
+inline void setPxSceneQueryDescStaticQuantizedTree( PxSceneQueryDesc* inOwner, _Bool inData) { inOwner->staticQuantizedTree = inData; }
 inline PxSceneQueryUpdateMode::Enum getPxSceneQueryDescSceneQueryUpdateMode( const PxSceneQueryDesc* inOwner ) { return inOwner->sceneQueryUpdateMode; }
 inline void setPxSceneQueryDescSceneQueryUpdateMode( PxSceneQueryDesc* inOwner, PxSceneQueryUpdateMode::Enum inData) { inOwner->sceneQueryUpdateMode = inData; }
 PX_PHYSX_CORE_API PxSceneQueryDescGeneratedInfo::PxSceneQueryDescGeneratedInfo()
@@ -1253,6 +1255,7 @@ PX_PHYSX_CORE_API PxSceneQueryDescGeneratedInfo::PxSceneQueryDescGeneratedInfo()
 	, DynamicBVHBuildStrategy( "DynamicBVHBuildStrategy", setPxSceneQueryDescDynamicBVHBuildStrategy, getPxSceneQueryDescDynamicBVHBuildStrategy )
 	, StaticNbObjectsPerNode( "StaticNbObjectsPerNode", setPxSceneQueryDescStaticNbObjectsPerNode, getPxSceneQueryDescStaticNbObjectsPerNode )
 	, DynamicNbObjectsPerNode( "DynamicNbObjectsPerNode", setPxSceneQueryDescDynamicNbObjectsPerNode, getPxSceneQueryDescDynamicNbObjectsPerNode )
+	, StaticQuantizedTree( "StaticQuantizedTree", setPxSceneQueryDescStaticQuantizedTree, getPxSceneQueryDescStaticQuantizedTree )
 	, SceneQueryUpdateMode( "SceneQueryUpdateMode", setPxSceneQueryDescSceneQueryUpdateMode, getPxSceneQueryDescSceneQueryUpdateMode )
 {}
 PX_PHYSX_CORE_API PxSceneQueryDescGeneratedValues::PxSceneQueryDescGeneratedValues( const PxSceneQueryDesc* inSource )
@@ -1265,6 +1268,7 @@ PX_PHYSX_CORE_API PxSceneQueryDescGeneratedValues::PxSceneQueryDescGeneratedValu
 		,DynamicBVHBuildStrategy( inSource->dynamicBVHBuildStrategy )
 		,StaticNbObjectsPerNode( inSource->staticNbObjectsPerNode )
 		,DynamicNbObjectsPerNode( inSource->dynamicNbObjectsPerNode )
+		,StaticQuantizedTree( inSource->staticQuantizedTree )
 		,SceneQueryUpdateMode( inSource->sceneQueryUpdateMode )
 {
 	PX_UNUSED(inSource);
@@ -1346,6 +1350,8 @@ inline PxU32 getPxSceneDescGpuComputeVersion( const PxSceneDesc* inOwner ) { ret
 inline void setPxSceneDescGpuComputeVersion( PxSceneDesc* inOwner, PxU32 inData) { inOwner->gpuComputeVersion = inData; }
 inline PxU32 getPxSceneDescContactPairSlabSize( const PxSceneDesc* inOwner ) { return inOwner->contactPairSlabSize; }
 inline void setPxSceneDescContactPairSlabSize( PxSceneDesc* inOwner, PxU32 inData) { inOwner->contactPairSlabSize = inData; }
+inline PxU32 getPxSceneDescFrameArenaChunkSize( const PxSceneDesc* inOwner ) { return inOwner->frameArenaChunkSize; }
+inline void setPxSceneDescFrameArenaChunkSize( PxSceneDesc* inOwner, PxU32 inData) { inOwner->frameArenaChunkSize = inData; }
 PX_PHYSX_CORE_API PxSceneDescGeneratedInfo::PxSceneDescGeneratedInfo()
 	: ToDefault( "ToDefault", setPxSceneDesc_ToDefault)
 	, Gravity( "Gravity", setPxSceneDescGravity, getPxSceneDescGravity )
@@ -1386,6 +1392,7 @@ PX_PHYSX_CORE_API PxSceneDescGeneratedInfo::PxSceneDescGeneratedInfo()
 	, GpuMaxNumStaticPartitions( "GpuMaxNumStaticPartitions", setPxSceneDescGpuMaxNumStaticPartitions, getPxSceneDescGpuMaxNumStaticPartitions )
 	, GpuComputeVersion( "GpuComputeVersion", setPxSceneDescGpuComputeVersion, getPxSceneDescGpuComputeVersion )
 	, ContactPairSlabSize( "ContactPairSlabSize", setPxSceneDescContactPairSlabSize, getPxSceneDescContactPairSlabSize )
+	, FrameArenaChunkSize( "FrameArenaChunkSize", setPxSceneDescFrameArenaChunkSize, getPxSceneDescFrameArenaChunkSize )
 {}
 PX_PHYSX_CORE_API PxSceneDescGeneratedValues::PxSceneDescGeneratedValues( const PxSceneDesc* inSource )
 		:PxSceneQueryDescGeneratedValues( inSource )
@@ -1427,6 +1434,7 @@ PX_PHYSX_CORE_API PxSceneDescGeneratedValues::PxSceneDescGeneratedValues( const
 		,GpuMaxNumStaticPartitions( inSource->gpuMaxNumStaticPartitions )
 		,GpuComputeVersion( inSource->gpuComputeVersion )
 		,ContactPairSlabSize( inSource->contactPairSlabSize )
+		,FrameArenaChunkSize( inSource->frameArenaChunkSize )
 {
 	PX_UNUSED(inSource);
 }
@@ -1636,6 +1644,10 @@ inline PxU32 getPxSimulationStatisticsRequiredContactConstraintMemory( const PxS
 inline void setPxSimulationStatisticsRequiredContactConstraintMemory( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->requiredContactConstraintMemory = inData; }
 inline PxU32 getPxSimulationStatisticsPeakConstraintMemory( const PxSimulationStatistics* inOwner ) { return inOwner->peakConstraintMemory; }
 inline void setPxSimulationStatisticsPeakConstraintMemory( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->peakConstraintMemory = inData; }
+inline PxU64 getPxSimulationStatisticsFrameArenaHighWaterMark( const PxSimulationStatistics* inOwner ) { return inOwner->frameArenaHighWaterMark; }
+inline void setPxSimulationStatisticsFrameArenaHighWaterMark( PxSimulationStatistics* inOwner, PxU64 inData) { inOwner->frameArenaHighWaterMark = inData; }
+inline PxU64 getPxSimulationStatisticsFrameArenaCapacity( const PxSimulationStatistics* inOwner ) { return inOwner->frameArenaCapacity; }
+inline void setPxSimulationStatisticsFrameArenaCapacity( PxSimulationStatistics* inOwner, PxU64 inData) { inOwner->frameArenaCapacity = inData; }
 inline PxU32 getPxSimulationStatisticsNbDiscreteContactPairsTotal( const PxSimulationStatistics* inOwner ) { return inOwner->nbDiscreteContactPairsTotal; }
 inline void setPxSimulationStatisticsNbDiscreteContactPairsTotal( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbDiscreteContactPairsTotal = inData; }
 inline PxU32 getPxSimulationStatisticsNbDiscreteContactPairsWithCacheHits( const PxSimulationStatistics* inOwner ) { return inOwner->nbDiscreteContactPairsWithCacheHits; }
@@ -1711,6 +1723,8 @@ PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedInfo::PxSimulationStatisticsGen
 	, CompressedContactSize( "CompressedContactSize", setPxSimulationStatisticsCompressedContactSize, getPxSimulationStatisticsCompressedContactSize )
 	, RequiredContactConstraintMemory( "RequiredContactConstraintMemory", setPxSimulationStatisticsRequiredContactConstraintMemory, getPxSimulationStatisticsRequiredContactConstraintMemory )
 	, PeakConstraintMemory( "PeakConstraintMemory", setPxSimulationStatisticsPeakConstraintMemory, getPxSimulationStatisticsPeakConstraintMemory )
+	, FrameArenaHighWaterMark( "FrameArenaHighWaterMark", setPxSimulationStatisticsFrameArenaHighWaterMark, getPxSimulationStatisticsFrameArenaHighWaterMark )
+	, FrameArenaCapacity( "FrameArenaCapacity", setPxSimulationStatisticsFrameArenaCapacity, getPxSimulationStatisticsFrameArenaCapacity )
 	, NbDiscreteContactPairsTotal( "NbDiscreteContactPairsTotal", setPxSimulationStatisticsNbDiscreteContactPairsTotal, getPxSimulationStatisticsNbDiscreteContactPairsTotal )
 	, NbDiscreteContactPairsWithCacheHits( "NbDiscreteContactPairsWithCacheHits", setPxSimulationStatisticsNbDiscreteContactPairsWithCacheHits, getPxSimulationStatisticsNbDiscreteContactPairsWithCacheHits )
 	, NbDiscreteContactPairsWithContacts( "NbDiscreteContactPairsWithContacts", setPxSimulationStatisticsNbDiscreteContactPairsWithContacts, getPxSimulationStatisticsNbDiscreteContactPairsWithContacts )
@@ -1756,6 +1770,8 @@ PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedValues::PxSimulationStatisticsG
 		,CompressedContactSize( inSource->compressedContactSize )
 		,RequiredContactConstraintMemory( inSource->requiredContactConstraintMemory )
 		,PeakConstraintMemory( inSource->peakConstraintMemory )
+		,FrameArenaHighWaterMark( inSource->frameArenaHighWaterMark )
+		,FrameArenaCapacity( inSource->frameArenaCapacity )
 		,NbDiscreteContactPairsTotal( inSource->nbDiscreteContactPairsTotal )
 		,NbDiscreteContactPairsWithCacheHits( inSource->nbDiscreteContactPairsWithCacheHits )
 		,NbDiscreteContactPairsWithContacts( inSource->nbDiscreteContactPairsWithContacts )
@@ -129,6 +129,7 @@ namespace physx
 class PxRenderOutput;
 class PxBVH;
 class PxSceneLimits;	// PT: TODO: decouple from PxSceneLimits
+class PxCpuDispatcher;
 
 namespace Sq
 {
@@ -154,6 +155,9 @@ namespace Sq
 
 						void							setDynamicTreeRebuildRateHint(PxU32 dynTreeRebuildRateHint);
 		PX_FORCE_INLINE	PxU32							getDynamicTreeRebuildRateHint()				const	{ return mRebuildRateHint;				}
+
+						// optional dispatcher used to update the pruners (and refit large dynamic trees) in parallel
+						void							setTaskDispatcher(PxCpuDispatcher* dispatcher);
 						
 						void							flushUpdates();
 						void							forceRebuildDynamicTree(PxU32 prunerIndex);
@@ -181,12 +185,14 @@ namespace Sq
 						PxU32							mStaticTimestamp;
 						PxU32							mRebuildRateHint;
 						const float						mInflation;	// SQ_PRUNER_EPSILON
+						PxCpuDispatcher*				mTaskDispatcher;
 
 						PxMutex							mSQLock;  // to make sure only one query updates the dirty pruner structure if multiple queries run in parallel
 
 						volatile bool					mPrunerNeedsUpdating;
 
 						void							flushShapes();
+						void							updatePruners(bool buildStep, bool commit);
 		PX_FORCE_INLINE void							invalidateStaticTimestamp()		{ mStaticTimestamp++;		}
 
 						PX_NOCOPY(PrunerManager)
@@ -150,6 +150,8 @@ class CompoundPruner : public Gu::BasePruner
 	virtual	bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, CompoundPrunerRaycastCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
 	virtual	bool					overlap(const Gu::ShapeData& queryVolume, CompoundPrunerOverlapCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
 	virtual	bool					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, CompoundPrunerRaycastCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
+	virtual	bool					cull(PxU32 nbPlanes, const PxPlane* planes, CompoundPrunerOverlapCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
+	virtual	bool					nearest(const PxVec3& point, PxReal& inOutDistance, CompoundPrunerRaycastCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
 
 	/**
 	\brief	Retrieves the object's payload and data associated with the handle.
@@ -46,6 +46,7 @@ class PxGeometry;
 struct PxQueryFilterData;
 struct PxFilterData;
 class PxQueryFilterCallback;
+class PxPlane;
 
 namespace Sq
 {
@@ -105,6 +106,12 @@ namespace Sq
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags) const;
 
+						void						_raycastBatch(
+														PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,	// Ray data
+														PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const;
+
 						bool						_sweep(
 														const PxGeometry& geometry, const PxTransform& pose,	// GeomObject data
 														const PxVec3& unitDir, const PxReal distance,			// Ray data
@@ -118,6 +125,18 @@ namespace Sq
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags) const;
 
+						bool						_cull(
+														PxU32 nbPlanes, const PxPlane* planes,	// Culling volume
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const;
+
+						PxU32						_nearest(
+														const PxVec3& point, PxReal maxDist,	// Query point & max distance
+														PxNearestHit* hits, PxU32 maxNbHits,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const;
+
 		PX_FORCE_INLINE	PxU64						getContextId()			const	{ return mSQManager.getContextId();	}
 						Sq::PrunerManager			mSQManager;
 		public:
@@ -487,6 +487,72 @@ struct MainTreeSphereOverlapCompoundPrunerCallback : public MainTreeOverlapCompo
 	PX_NOCOPY(MainTreeSphereOverlapCompoundPrunerCallback)
 };
 
+// Culling planes
+struct MainTreeCullCompoundPrunerCallback : MainTreeCompoundPrunerCallback<CompoundPrunerOverlapCallback>
+{
+	MainTreeCullCompoundPrunerCallback(PxU32 nbPlanes, const PxPlane* planes, CompoundPrunerOverlapCallback& prunerCallback, PxCompoundPrunerQueryFlags flags, const CompoundTree* compoundTrees)
+		: MainTreeCompoundPrunerCallback(prunerCallback, flags, compoundTrees), mNbPlanes(PxMin(nbPlanes, PxU32(32))), mPlanes(planes)
+	{
+	}
+
+	virtual ~MainTreeCullCompoundPrunerCallback() {}
+
+	bool invoke(PxU32 primIndex)
+	{
+		const CompoundTree& compoundTree = mCompoundTrees[primIndex];
+
+		if(filtering(compoundTree))
+			return true;
+
+		// transfer the planes to actor local space
+		PxPlane localPlanes[32];
+		for(PxU32 i=0;i<mNbPlanes;i++)
+			localPlanes[i] = mPlanes[i].inverseTransform(compoundTree.mGlobalPose);
+
+		// the main tree only tells us the compound touches the volume, so the local tree is culled with the full mask
+		const PlanesAABBTest localTest(mNbPlanes, localPlanes);
+		CompoundCallbackOverlapAdapter pcb(mPrunerCallback, compoundTree);
+		return AABBTreeCull<true, IncrementalAABBTree, IncrementalAABBTreeNode, CompoundCallbackOverlapAdapter>()
+			(compoundTree.mPruningPool->getCurrentAABBTreeBounds(), *compoundTree.mTree, localTest, pcb, localTest.getInitialClipMask());
+	}
+
+	PX_NOCOPY(MainTreeCullCompoundPrunerCallback)
+
+private:
+	const PxU32		mNbPlanes;
+	const PxPlane*	mPlanes;
+};
+
+// Nearest-neighbour callback for main AABB tree
+struct MainTreeNearestCompoundPrunerCallback : MainTreeCompoundPrunerCallback<CompoundPrunerRaycastCallback>
+{
+	MainTreeNearestCompoundPrunerCallback(const PxVec3& point, CompoundPrunerRaycastCallback& prunerCallback, PxCompoundPrunerQueryFlags flags, const CompoundTree* compoundTrees)
+		: MainTreeCompoundPrunerCallback(prunerCallback, flags, compoundTrees), mPoint(point)
+	{
+	}
+
+	virtual ~MainTreeNearestCompoundPrunerCallback() {}
+
+	bool invoke(PxReal& distance, PxU32 primIndex)
+	{
+		const CompoundTree& compoundTree = mCompoundTrees[primIndex];
+
+		if(filtering(compoundTree))
+			return true;
+
+		// transfer to actor local space, distances are not affected
+		const PxVec3 localPoint = compoundTree.mGlobalPose.transformInv(mPoint);
+
+		CompoundCallbackRaycastAdapter pcb(mPrunerCallback, compoundTree);
+		return AABBTreeNearest<true, IncrementalAABBTree, IncrementalAABBTreeNode, CompoundCallbackRaycastAdapter>()
+			(compoundTree.mPruningPool->getCurrentAABBTreeBounds(), *compoundTree.mTree, localPoint, distance, pcb);
+	}
+
+	PX_NOCOPY(MainTreeNearestCompoundPrunerCallback)
+
+private:
+	const PxVec3&	mPoint;
+};
 
 //////////////////////////////////////////////////////////////////////////
 // overlap implementation
@@ -547,6 +613,31 @@ bool BVHCompoundPruner::overlap(const ShapeData& queryVolume, CompoundPrunerOver
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
+bool BVHCompoundPruner::cull(PxU32 nbPlanes, const PxPlane* planes, CompoundPrunerOverlapCallback& prunerCallback, PxCompoundPrunerQueryFlags flags) const
+{
+	if(!mMainTree.getNodes())
+		return true;
+
+	const PlanesAABBTest test(nbPlanes, planes);
+	MainTreeCullCompoundPrunerCallback pcb(nbPlanes, planes, prunerCallback, flags, mCompoundTreePool.getCompoundTrees());
+	return AABBTreeCull<true, IncrementalAABBTree, IncrementalAABBTreeNode, MainTreeCullCompoundPrunerCallback>()
+		(mCompoundTreePool.getCurrentAABBTreeBounds(), mMainTree, test, pcb, test.getInitialClipMask());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+bool BVHCompoundPruner::nearest(const PxVec3& point, PxReal& inOutDistance, CompoundPrunerRaycastCallback& prunerCallback, PxCompoundPrunerQueryFlags flags) const
+{
+	if(!mMainTree.getNodes())
+		return true;
+
+	MainTreeNearestCompoundPrunerCallback pcb(point, prunerCallback, flags, mCompoundTreePool.getCompoundTrees());
+	return AABBTreeNearest<true, IncrementalAABBTree, IncrementalAABBTreeNode, MainTreeNearestCompoundPrunerCallback>()
+		(mCompoundTreePool.getCurrentAABBTreeBounds(), mMainTree, point, inOutDistance, pcb);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
 bool BVHCompoundPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, CompoundPrunerRaycastCallback& prunerCallback, PxCompoundPrunerQueryFlags flags) const
 {
 	bool again = true;
@@ -252,7 +252,8 @@ PrunerManager::PrunerManager(	PxU64 contextID, Pruner* staticPruner, Pruner* dyn
 	mAdapter			(adapter),
 	mContextID			(contextID),
 	mStaticTimestamp	(0),
-	mInflation			(inflation)
+	mInflation			(inflation),
+	mTaskDispatcher		(NULL)
 {
 	mPrunerExt[PruningIndex::eSTATIC].init(staticPruner);
 	mPrunerExt[PruningIndex::eDYNAMIC].init(dynamicPruner);
@@ -366,6 +367,31 @@ void PrunerManager::setDynamicTreeRebuildRateHint(PxU32 rebuildRateHint)
 	}
 }
 
+void PrunerManager::setTaskDispatcher(PxCpuDispatcher* dispatcher)
+{
+	mTaskDispatcher = dispatcher;
+
+	for(PxU32 i=0;i<PruningIndex::eCOUNT;i++)
+	{
+		Pruner* pruner = mPrunerExt[i].pruner();
+		if(pruner && pruner->isDynamic())
+			static_cast<DynamicPruner*>(pruner)->setTaskDispatcher(dispatcher);
+	}
+}
+
+void PrunerManager::updatePruners(bool buildStep, bool commit)
+{
+	Pruner* pruners[PruningIndex::eCOUNT];
+	PxU32 nbPruners = 0;
+	for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
+	{
+		if(mPrunerExt[i].pruner())
+			pruners[nbPruners++] = mPrunerExt[i].pruner();
+	}
+
+	::updatePruners(pruners, nbPruners, buildStep, commit, mTaskDispatcher, mContextID);
+}
+
 void PrunerManager::afterSync(bool buildStep, bool commit)
 {
 	PX_PROFILE_ZONE("Sim.sceneQueryBuildStep", mContextID);
@@ -379,18 +405,7 @@ void PrunerManager::afterSync(bool buildStep, bool commit)
 	// flush user modified objects
 	flushShapes();
 
-	for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
-	{
-		Pruner* pruner = mPrunerExt[i].pruner();
-		if(pruner)
-		{
-			if(pruner->isDynamic())
-				static_cast<DynamicPruner*>(pruner)->buildStep(true);
-
-			if(commit)
-				pruner->commit();
-		}
-	}
+	updatePruners(true, commit);
 
 	mPrunerNeedsUpdating = !commit;
 }
@@ -430,9 +445,7 @@ void PrunerManager::flushUpdates()
 		{
 			flushShapes();
 
-			for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
-				if(mPrunerExt[i].pruner())
-					mPrunerExt[i].pruner()->commit();
+			updatePruners(false, true);
 
 			PxMemoryBarrier();
 			mPrunerNeedsUpdating = false;
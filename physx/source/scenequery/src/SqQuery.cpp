@@ -38,6 +38,7 @@ using namespace Sq;
 #include "common/PxProfileZone.h"
 #include "foundation/PxFPU.h"
 #include "GuBounds.h"
+#include "GuSqInternal.h"
 #include "GuIntersectionRayBox.h"
 #include "GuIntersectionRay.h"
 #include "geometry/PxGeometryQuery.h"
@@ -46,6 +47,7 @@ using namespace Sq;
 #include "geometry/PxCapsuleGeometry.h"
 #include "geometry/PxConvexMeshGeometry.h"
 #include "geometry/PxTriangleMeshGeometry.h"
+#include "foundation/PxPlane.h"
 
 #include "PxQueryFiltering.h"
 
@@ -137,6 +139,8 @@ namespace physx
 		const PxGeometry* geometry; // only valid for overlaps and sweeps
 		const PxTransform* pose; // only valid for overlaps and sweeps
 		PxReal inflation; // only valid for sweeps
+		const PxPlane* planes; // only valid for culling
+		PxU32 nbPlanes; // only valid for culling
 
 		// Raycast constructor
 		MultiQueryInput(const PxVec3& aRayOrigin, const PxVec3& aUnitDir, PxReal aMaxDist)
@@ -147,6 +151,8 @@ namespace physx
 			geometry = NULL;
 			pose = NULL;
 			inflation = 0.0f;
+			planes = NULL;
+			nbPlanes = 0;
 		}
 
 		// Overlap constructor
@@ -156,6 +162,20 @@ namespace physx
 			pose = aPose;
 			inflation = 0.0f;
 			rayOrigin = unitDir = NULL;
+			planes = NULL;
+			nbPlanes = 0;
+		}
+
+		// Cull constructor
+		MultiQueryInput(PxU32 aNbPlanes, const PxPlane* aPlanes)
+		{
+			rayOrigin = unitDir = NULL;
+			maxDistance = PX_MAX_REAL;
+			geometry = NULL;
+			pose = NULL;
+			inflation = 0.0f;
+			planes = aPlanes;
+			nbPlanes = aNbPlanes;
 		}
 
 		// Sweep constructor
@@ -169,6 +189,8 @@ namespace physx
 			geometry = aGeometry;
 			pose = aPose;
 			inflation = aInflation;
+			planes = NULL;
+			nbPlanes = 0;
 		}
 
 		PX_FORCE_INLINE const PxVec3& getDir() const { PX_ASSERT(unitDir); return *unitDir; }
@@ -310,6 +332,10 @@ struct GeomQueryAny
 		// Handle overlaps
 		else if(HitTypeSupport<HitType>::IsOverlap)
 		{
+			// culling queries only test bounds, every shape reported by the pruners is a hit
+			if(input.planes)
+				return 1;
+
 			const GeomOverlapTable* overlapFuncs = funcs.mCachedOverlapFuncs;
 			return PxU32(Gu::overlap(geom0, pose0, geom1, pose1, overlapFuncs, context));
 		}
@@ -929,6 +955,147 @@ bool SceneQueries::_raycast(
 
 //////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	// per-ray state for packet raycasts. This is the same setup as in multiQuery for a single raycast.
+	struct RaycastPacketQuery
+	{
+		const MultiQueryInput					mInput;
+#if PX_SUPPORT_PVD
+		CapturePvdOnReturn<PxRaycastHit>		mPvdCapture;
+#endif
+		IssueCallbacksOnReturn<PxRaycastHit>	mCallbacksOnReturn;
+		MultiQueryCallback<PxRaycastHit>		mPCB;
+
+		RaycastPacketQuery(	const SceneQueries& sq, const PxVec3& origin, const PxVec3& unitDir, PxReal distance, bool anyHit,
+							PxRaycastCallback& hits, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall) :
+			mInput				(origin, unitDir, distance),
+#if PX_SUPPORT_PVD
+			mPvdCapture			(&sq, mInput, filterData, hits),
+#endif
+			mCallbacksOnReturn	(hits),
+			mPCB				(sq, mInput, anyHit, hits, hitFlags, filterData, filterCall, distance)
+		{
+			hits.hasBlock = false;
+			hits.nbTouches = 0;
+		}
+
+		PX_NOCOPY(RaycastPacketQuery)
+	};
+}
+
+static PX_FORCE_INLINE bool isValidRay(const PxVec3& origin, const PxVec3& unitDir, PxReal distance)
+{
+	return origin.isFinite() && unitDir.isFinite() && unitDir.isNormalized() && distance > 0.0f;
+}
+
+// raycasts up to GU_RAY_PACKET_SIZE rays sharing the same flags and filtering. The pruners are traversed once per packet,
+// while filtering, narrow-phase and hit reporting are done per ray exactly as in multiQuery.
+static void raycastPacket(	const SceneQueries& sq, PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+							PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall)
+{
+	PX_ASSERT(nbRays<=GU_RAY_PACKET_SIZE);
+
+	const bool anyHit = (filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT;
+
+	const PrunerManager& manager = sq.getPrunerManagerFast();
+	const_cast<PrunerManager&>(manager).flushUpdates();
+
+	PX_ALIGN(16, PxU8 queryBuffer[sizeof(RaycastPacketQuery)*GU_RAY_PACKET_SIZE]);
+	RaycastPacketQuery* queries = reinterpret_cast<RaycastPacketQuery*>(queryBuffer);
+	PrunerRaycastCallback* pcbs[GU_RAY_PACKET_SIZE];
+	PxReal shrunkDistances[GU_RAY_PACKET_SIZE];
+
+	PxU32 queryMask = 0;
+	for(PxU32 i=0;i<nbRays;i++)
+	{
+		// invalid rays go through the regular path, which reports the errors
+		if(!isValidRay(origins[i], unitDirs[i], distances[i]))
+		{
+			const MultiQueryInput input(origins[i], unitDirs[i], distances[i]);
+			sq.multiQuery<PxRaycastHit>(input, *hitCalls[i], hitFlags, NULL, filterData, filterCall);
+			pcbs[i] = NULL;
+			continue;
+		}
+
+		PX_PLACEMENT_NEW(queries + i, RaycastPacketQuery)(sq, origins[i], unitDirs[i], distances[i], anyHit, *hitCalls[i], hitFlags, filterData, filterCall);
+		pcbs[i] = &queries[i].mPCB;
+		queryMask |= 1<<i;
+	}
+
+	const Pruner* staticPruner = manager.getPruner(PruningIndex::eSTATIC);
+	const Pruner* dynamicPruner = manager.getPruner(PruningIndex::eDYNAMIC);
+	const CompoundPruner* compoundPruner = manager.getCompoundPruner();
+
+	const PxU32 doStatics = staticPruner && (filterData.flags & PxQueryFlag::eSTATIC);
+	const PxU32 doDynamics = dynamicPruner && (filterData.flags & PxQueryFlag::eDYNAMIC);
+
+	const PxCompoundPrunerQueryFlags compoundPrunerQueryFlags = convertFlags(filterData.flags);
+
+	PxU32 activeMask = queryMask;
+	if(doStatics && activeMask)
+	{
+		for(PxU32 i=0;i<nbRays;i++)
+			shrunkDistances[i] = pcbs[i] ? queries[i].mPCB.mShrunkDistance : 0.0f;
+		activeMask = staticPruner->raycastPacket(nbRays, origins, unitDirs, shrunkDistances, pcbs, activeMask);
+	}
+
+	// like in multiQuery, rays stopped by the static pruner still issue their final processTouches() call
+	const PxU32 stoppedByStatics = queryMask & ~activeMask;
+
+	if(doDynamics && activeMask)
+	{
+		for(PxU32 i=0;i<nbRays;i++)
+			shrunkDistances[i] = pcbs[i] ? queries[i].mPCB.mShrunkDistance : 0.0f;
+		activeMask = dynamicPruner->raycastPacket(nbRays, origins, unitDirs, shrunkDistances, pcbs, activeMask);
+	}
+
+	if(compoundPruner)
+	{
+		PxU32 mask = activeMask;
+		while(mask)
+		{
+			const PxU32 i = PxLowestSetBit(mask);
+			mask &= mask - 1;
+			MultiQueryCallback<PxRaycastHit>& pcb = queries[i].mPCB;
+			if(!compoundPruner->raycast(origins[i], unitDirs[i], pcb.mShrunkDistance, pcb, compoundPrunerQueryFlags))
+				activeMask &= ~(1<<i);
+		}
+	}
+
+	const PxU32 againMask = activeMask | stoppedByStatics;
+	PxU32 mask = queryMask;
+	while(mask)
+	{
+		const PxU32 i = PxLowestSetBit(mask);
+		mask &= mask - 1;
+		queries[i].mCallbacksOnReturn.again = (againMask & (1<<i)) != 0;	// update the status to avoid duplicate processTouches()
+		queries[i].~RaycastPacketQuery();
+	}
+}
+
+void SceneQueries::_raycastBatch(
+	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* distances,
+	PxRaycastCallback* const* hitCalls, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+	PxGeometryQueryFlags flags) const
+{
+	PX_PROFILE_ZONE("SceneQuery.raycastBatch", getContextId());
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	while(nbRays)
+	{
+		const PxU32 nb = PxMin(nbRays, PxU32(GU_RAY_PACKET_SIZE));
+		raycastPacket(*this, nb, origins, unitDirs, distances, hitCalls, hitFlags, filterData, filterCall);
+		origins += nb;
+		unitDirs += nb;
+		distances += nb;
+		hitCalls += nb;
+		nbRays -= nb;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 bool SceneQueries::_overlap(
 	const PxGeometry& geometry, const PxTransform& pose, PxOverlapCallback& hits,
 	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
@@ -948,6 +1115,182 @@ bool SceneQueries::_overlap(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool SceneQueries::_cull(
+	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hits,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) const
+{
+	PX_PROFILE_ZONE("SceneQuery.cull", getContextId());
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	PX_CHECK_AND_RETURN_VAL(planes || !nbPlanes, "PxScene::cull(): planes pointer is NULL.", 0);
+	PX_CHECK_AND_RETURN_VAL(nbPlanes <= 32, "PxScene::cull(): at most 32 planes are supported.", 0);
+
+	const bool anyHit = (filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT;
+	PX_CHECK_AND_RETURN_VAL(anyHit || hits.maxNbTouches > 0, "PxScene::cull() calls without eANY_HIT flag require a touch hit buffer for return results.", 0);
+
+	const_cast<SceneQueries*>(this)->mSQManager.flushUpdates();
+
+	// culling queries are not captured by PVD, which has no representation for them
+	IssueCallbacksOnReturn<PxOverlapHit> cbr(hits); // destructor will execute callbacks on return from this function
+	hits.hasBlock = false;
+	hits.nbTouches = 0;
+
+	const MultiQueryInput input(nbPlanes, planes);
+	MultiQueryCallback<PxOverlapHit> pcb(*this, input, anyHit, hits, PxHitFlags(), filterData, filterCall, PX_MAX_REAL);
+
+	const Pruner* staticPruner = mSQManager.getPruner(PruningIndex::eSTATIC);
+	const Pruner* dynamicPruner = mSQManager.getPruner(PruningIndex::eDYNAMIC);
+	const CompoundPruner* compoundPruner = mSQManager.getCompoundPruner();
+
+	const PxU32 doStatics = staticPruner && (filterData.flags & PxQueryFlag::eSTATIC);
+	const PxU32 doDynamics = dynamicPruner && (filterData.flags & PxQueryFlag::eDYNAMIC);
+
+	bool again = doStatics ? staticPruner->cull(nbPlanes, planes, pcb) : true;
+	if(!again)
+		return hits.hasAnyHits();
+
+	if(doDynamics)
+		again = dynamicPruner->cull(nbPlanes, planes, pcb);
+
+	if(again && compoundPruner)
+		again = compoundPruner->cull(nbPlanes, planes, pcb, convertFlags(filterData.flags));
+
+	cbr.again = again; // update the status to avoid duplicate processTouches()
+	return hits.hasAnyHits();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// callback for nearest-neighbour queries. Candidates reported by the pruners are filtered, then their exact distance to
+// the query point is computed and they are inserted in the user buffer, sorted by increasing distance. Once the buffer is
+// full the query distance shrinks to the distance of the furthest hit, so that the pruners can discard further objects.
+struct NearestQueryCallback : public PrunerRaycastCallback, public CompoundPrunerRaycastCallback
+{
+	const SceneQueries&			mScene;
+	const PxVec3&				mPoint;
+	PxNearestHit*				mHits;
+	const PxU32					mMaxNbHits;
+	PxU32						mNbHits;
+	const PxQueryFilterData&	mFilterData;
+	PxQueryFilterCallback*		mFilterCall;
+	const bool					mAnyHit;
+	PxTransform					mCompoundShapeTransform;
+
+	NearestQueryCallback(const SceneQueries& scene, const PxVec3& point, PxNearestHit* hits, PxU32 maxNbHits, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall) :
+		mScene		(scene),
+		mPoint		(point),
+		mHits		(hits),
+		mMaxNbHits	(maxNbHits),
+		mNbHits		(0),
+		mFilterData	(filterData),
+		mFilterCall	(filterCall),
+		mAnyHit		((filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT)
+	{
+	}
+
+	bool _invoke(PxReal& aDist, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms, const PxTransform* compoundPose)
+	{
+		PX_ASSERT(payloads && transforms);
+		const PrunerPayload& payload = payloads[primIndex];
+		const QueryAdapter& adapter = static_cast<const QueryAdapter&>(mScene.mSQManager.getAdapter());
+
+		PxActorShape actorShape;
+		adapter.getActorShape(payload, actorShape);
+
+		// eTOUCH and eBLOCK are treated the same way, only eNONE discards the object
+		PxQueryHitType::Enum shapeHitType = PxQueryHitType::eTOUCH;
+		PxHitFlags unused;
+		if(!applyAllPreFiltersSQ(adapter, payload, actorShape, shapeHitType, mFilterData.flags, mFilterData, mFilterCall, unused))
+			return true;
+
+		const PxTransform* shapeTransform;
+		if(!compoundPose)
+		{
+			shapeTransform = transforms + primIndex;
+		}
+		else
+		{
+			computeCompoundShapeTransform(&mCompoundShapeTransform, compoundPose, transforms, primIndex);
+			shapeTransform = &mCompoundShapeTransform;
+		}
+
+		PxNearestHit hit;
+		hit.distance = PxSqrt(computeNearestDistance2(mPoint, adapter.getGeometry(payload), *shapeTransform, hit.position, hit.faceIndex));
+		if(hit.distance > aDist)
+			return true;
+
+		hit.actor = actorShape.actor;
+		hit.shape = actorShape.shape;
+
+		if(mFilterCall && (mFilterData.flags & PxQueryFlag::ePOSTFILTER))
+		{
+			if(mFilterCall->postFilter(mFilterData.data, hit, hit.shape, hit.actor) == PxQueryHitType::eNONE)
+				return true;
+		}
+
+		mNbHits = insertNearestHit(mHits, mNbHits, mMaxNbHits, hit);
+		if(mAnyHit)
+			return false;
+
+		if(mNbHits == mMaxNbHits)
+			aDist = mHits[mNbHits-1].distance;
+		return true;
+	}
+
+	virtual bool	invoke(PxReal& aDist, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms)	PX_OVERRIDE PX_FINAL
+	{
+		return _invoke(aDist, primIndex, payloads, transforms, NULL);
+	}
+
+	virtual bool	invoke(PxReal& aDist, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms, const PxTransform* compoundPose)	PX_OVERRIDE PX_FINAL
+	{
+		return _invoke(aDist, primIndex, payloads, transforms, compoundPose);
+	}
+
+	PX_NOCOPY(NearestQueryCallback)
+};
+
+PxU32 SceneQueries::_nearest(
+	const PxVec3& point, PxReal maxDist, PxNearestHit* hits, PxU32 maxNbHits,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) const
+{
+	PX_PROFILE_ZONE("SceneQuery.nearest", getContextId());
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	PX_CHECK_AND_RETURN_VAL(point.isFinite(), "PxScene::nearest(): point is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(maxDist >= 0.0f, "PxScene::nearest(): maxDist must be positive.", 0);
+	PX_CHECK_AND_RETURN_VAL(hits || !maxNbHits, "PxScene::nearest(): hits buffer is NULL.", 0);
+
+	if(!maxNbHits)
+		return 0;
+
+	const_cast<SceneQueries*>(this)->mSQManager.flushUpdates();
+
+	// nearest-neighbour queries are not captured by PVD, which has no representation for them
+	NearestQueryCallback pcb(*this, point, hits, maxNbHits, filterData, filterCall);
+
+	const Pruner* staticPruner = mSQManager.getPruner(PruningIndex::eSTATIC);
+	const Pruner* dynamicPruner = mSQManager.getPruner(PruningIndex::eDYNAMIC);
+	const CompoundPruner* compoundPruner = mSQManager.getCompoundPruner();
+
+	const PxU32 doStatics = staticPruner && (filterData.flags & PxQueryFlag::eSTATIC);
+	const PxU32 doDynamics = dynamicPruner && (filterData.flags & PxQueryFlag::eDYNAMIC);
+
+	// the same distance is passed to all pruners, so that hits found in one of them also shrink the search in the others
+	PxReal distance = maxDist;
+	bool again = doStatics ? staticPruner->nearest(point, distance, pcb) : true;
+
+	if(again && doDynamics)
+		again = dynamicPruner->nearest(point, distance, pcb);
+
+	if(again && compoundPruner)
+		compoundPruner->nearest(point, distance, pcb, convertFlags(filterData.flags));
+
+	return pcb.mNbHits;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool SceneQueries::_sweep(
 	const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, const PxReal distance,
 	PxHitCallback<PxSweepHit>& hits, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
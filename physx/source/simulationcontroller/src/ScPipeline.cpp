@@ -2800,8 +2800,6 @@ void Sc::Scene::finalizationPhase(PxBaseTask* /*continuation*/)
 
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.rigidBodySolver", mContextId);
 
-	mTaskPool.clear();
-
 	mReportShapePairTimeStamp++;	// important to do this before fetchResults() is called to make sure that delayed deleted actors/shapes get
 									// separate pair entries in contact reports
 
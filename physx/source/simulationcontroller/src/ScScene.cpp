@@ -713,7 +713,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mBpSecondPass					(contextID, this, "ScScene.broadPhaseSecondPass"),
 	mBpUpdate						(contextID, this, "ScScene.updateBroadPhase"),
 	mPreIntegrate                   (contextID, this, "ScScene.preIntegrate"),
-	mTaskPool						(16384),
+	mTaskPool						(desc.frameArenaChunkSize),
 	mTaskManager					(NULL),
 	mCudaContextManager				(desc.cudaContextManager),
 	mContactReportsNeedPostSolverVelocity(false),
@@ -1608,6 +1608,7 @@ void Sc::Scene::flush(bool sendPendingReports)
 		mNPhaseCore->clearContactReportActorPairs(true);  // To clear the actor pair set
 	}
 	postReportsCleanup();
+	mTaskPool.clear();	// release the chunks kept around by the frame arena
 	mNPhaseCore->freeContactReportStreamMemory();
 
 	mTriggerBufferAPI.reset();
@@ -1884,6 +1885,10 @@ void Sc::Scene::postReportsCleanup()
 	mConstraintIDTracker->processPendingReleases();
 	mConstraintIDTracker->clearDeletedIDMap();
 
+	// end of frame for the per-frame task pool. All transient tasks & data allocated during the simulation
+	// step are released at once here, but the memory is kept for the next frame.
+	mTaskPool.resetFrame();
+
 #if PX_SUPPORT_GPU_PHYSX
 	// AD: if we use either GPU BP or GPU dynamics.
 	if (mHeapMemoryAllocationManager)
@@ -2204,6 +2209,9 @@ void Sc::Scene::getStats(PxSimulationStatistics& s) const
 	for(PxU32 i=0; i<PxGeometryType::eGEOMETRY_COUNT; i++)
 		s.nbShapes[i] = mNbGeometries[i];
 
+	s.frameArenaHighWaterMark = mTaskPool.getHighWaterMark();
+	s.frameArenaCapacity = mTaskPool.getCapacity();
+
 #if PX_SUPPORT_GPU_PHYSX
 	if (mHeapMemoryAllocationManager)
 	{
@@ -39,45 +39,150 @@
 namespace physx
 {
     const int EOL = -1;
+	const int SEALED = -2;	// dependency list of a resolved task, no dependency can be added anymore
+	const PxTaskID INVALID_TASK_ID = 0xffffffff;
 	typedef PxHashMap<const char *, PxTaskID> PxTaskNameToIDMap;
 
+	/*
+	 * Rows are stored in fixed-size pages which never move once allocated, so that existing rows can be
+	 * accessed while other threads submit new tasks, without taking a lock. Pages are referenced from
+	 * directories which are allocated on demand as well, so the table grows until the row indices run out.
+	 * Pages are recycled from one frame to the next, so there is no heap traffic once the task graph
+	 * reached its maximum size.
+	 */
+	#define PX_TASK_PAGE_SHIFT		10
+	#define PX_TASK_PAGE_SIZE		(1<<PX_TASK_PAGE_SHIFT)
+	#define PX_TASK_DIR_SHIFT		10
+	#define PX_TASK_DIR_SIZE		(1<<PX_TASK_DIR_SHIFT)
+	#define PX_TASK_MAX_NB_DIRS		(1<<(31-PX_TASK_PAGE_SHIFT-PX_TASK_DIR_SHIFT))	// row indices must fit in a positive int
+
+	template<class T>
+	class PxTaskPagedArray
+	{
+		PX_NOCOPY(PxTaskPagedArray)
+	public:
+		PxTaskPagedArray() : mSize(0)
+		{
+			for(uint32_t i=0; i<PX_TASK_MAX_NB_DIRS; i++)
+				mDirs[i] = NULL;
+		}
+
+		~PxTaskPagedArray()
+		{
+			for(uint32_t i=0; i<PX_TASK_MAX_NB_DIRS && mDirs[i]; i++)
+			{
+				for(uint32_t j=0; j<PX_TASK_DIR_SIZE && mDirs[i][j]; j++)
+					PX_FREE(mDirs[i][j]);
+				PX_FREE(mDirs[i]);
+			}
+		}
+
+		/* Thread-safe. Returns INVALID_TASK_ID when the row indices run out. */
+		uint32_t allocate()
+		{
+			const uint32_t index = uint32_t(PxAtomicIncrement(&mSize) - 1);
+			const uint32_t pageIndex = index >> PX_TASK_PAGE_SHIFT;
+			const uint32_t dirIndex = pageIndex >> PX_TASK_DIR_SHIFT;
+			if(dirIndex >= PX_TASK_MAX_NB_DIRS)
+			{
+				PxAtomicDecrement(&mSize);
+				return INVALID_TASK_ID;
+			}
+
+			// several threads can race to allocate the same directory or page, only one of them wins
+			if(!mDirs[dirIndex])
+			{
+				T** newDir = PX_ALLOCATE(T*, PX_TASK_DIR_SIZE, "PxTaskPageDirectory");
+				for(uint32_t i=0; i<PX_TASK_DIR_SIZE; i++)
+					newDir[i] = NULL;
+				if(PxAtomicCompareExchangePointer(static_cast<volatile void**>(static_cast<void*>(&mDirs[dirIndex])), newDir, NULL))
+					PX_FREE(newDir);
+			}
+
+			T** dir = mDirs[dirIndex];
+			const uint32_t pageInDir = pageIndex & (PX_TASK_DIR_SIZE-1);
+			if(!dir[pageInDir])
+			{
+				T* newPage = PX_ALLOCATE(T, PX_TASK_PAGE_SIZE, "PxTaskPage");
+				if(PxAtomicCompareExchangePointer(static_cast<volatile void**>(static_cast<void*>(&dir[pageInDir])), newPage, NULL))
+					PX_FREE(newPage);
+			}
+			return index;
+		}
+
+		PX_FORCE_INLINE T&			operator[](uint32_t index)			{ return getPage(index)[index & (PX_TASK_PAGE_SIZE-1)];	}
+		PX_FORCE_INLINE const T&	operator[](uint32_t index)	const	{ return getPage(index)[index & (PX_TASK_PAGE_SIZE-1)];	}
+		PX_FORCE_INLINE uint32_t	size()						const	{ return uint32_t(mSize);								}
+		PX_FORCE_INLINE void		reset()								{ mSize = 0;											}
+
+	private:
+		PX_FORCE_INLINE T*			getPage(uint32_t index)		const
+		{
+			const uint32_t pageIndex = index >> PX_TASK_PAGE_SHIFT;
+			return mDirs[pageIndex >> PX_TASK_DIR_SHIFT][pageIndex & (PX_TASK_DIR_SIZE-1)];
+		}
+
+		T**				mDirs[PX_TASK_MAX_NB_DIRS];
+		volatile int	mSize;
+	};
+
 	struct PxTaskDepTableRow
 	{
 		PxTaskID	mTaskID;
 		int			mNextDep;
 	};
-	typedef PxArray<PxTaskDepTableRow> PxTaskDepTable;
+	typedef PxTaskPagedArray<PxTaskDepTableRow> PxTaskDepTable;
 
 	class PxTaskTableRow
 	{
 	public:
-		PxTaskTableRow() : mRefCount( 1 ), mStartDep(EOL), mLastDep(EOL) {}
-		void addDependency( PxTaskDepTable& depTable, PxTaskID taskID )
+		void init( PxTask* task, PxTaskType::Enum type )
+		{
+			mTask = task;
+			mRefCount = 1;
+			mType = type;
+			mStartDep = EOL;
+		}
+
+		enum DepResult
 		{
-			int newDep = int(depTable.size());
-			PxTaskDepTableRow row;
+			eADDED,
+			eALREADY_RESOLVED,
+			eOUT_OF_MEMORY
+		};
+
+		/*
+		 * Lock-free insertion at the head of the dependency list. resolveRow() reverses the list so that
+		 * dependencies are still processed in insertion order. Fails if the task has already been resolved,
+		 * in which case the dependency is already satisfied.
+		 */
+		DepResult addDependency( PxTaskDepTable& depTable, PxTaskID taskID )
+		{
+			const uint32_t newDep = depTable.allocate();
+			if( newDep == INVALID_TASK_ID )
+				return eOUT_OF_MEMORY;
+
+			PxTaskDepTableRow& row = depTable[ newDep ];
 			row.mTaskID = taskID;
-			row.mNextDep = EOL;
-			depTable.pushBack( row );
 
-			if( mLastDep == EOL )
+			for(;;)
 			{
-				mStartDep = mLastDep = newDep;
-			}
-			else
-			{
-				depTable[ uint32_t(mLastDep) ].mNextDep = newDep;
-				mLastDep = newDep;
+				const int head = mStartDep;
+				if( head == SEALED )
+					return eALREADY_RESOLVED;
+
+				row.mNextDep = head;
+				if( PxAtomicCompareExchange( &mStartDep, int(newDep), head ) == head )
+					return eADDED;
 			}
 		}
 
-		PxTask *    mTask;
-		volatile int mRefCount;
-		PxTaskType::Enum mType;
-		int       mStartDep;
-		int       mLastDep;
+		PxTask *		mTask;
+		volatile int	mRefCount;
+		volatile int	mType;		// PxTaskType::Enum
+		volatile int	mStartDep;
 	};
-	typedef PxArray<PxTaskTableRow> PxTaskTable;
+	typedef PxTaskPagedArray<PxTaskTableRow> PxTaskTable;
 
 
 /* Implementation of PxTaskManager abstract API */
@@ -110,6 +215,8 @@ public:
 
 	void    dispatchTask( PxTaskID taskID );
 	void    resolveRow( PxTaskID taskID );
+	PxTaskID allocateRow( PxTask* task, PxTaskType::Enum type );
+	void	addDependency( PxTaskID fromTaskID, PxTaskID toTaskID );
 
 	void    release();
 
@@ -125,7 +232,7 @@ public:
 
 	PxErrorCallback&	mErrorCallback;
 	PxCpuDispatcher*	mCpuDispatcher;
-	PxTaskNameToIDMap	mName2IDmap;
+	PxTaskNameToIDMap	mName2IDmap;	// only the name map is protected by mMutex
 	volatile int		mPendingTasks;
     PxMutex				mMutex;
 
@@ -144,8 +251,6 @@ PxTaskMgr::PxTaskMgr(PxErrorCallback& errorCallback, PxCpuDispatcher* cpuDispatc
 	: mErrorCallback (errorCallback)
 	, mCpuDispatcher( cpuDispatcher )
 	, mPendingTasks( 0 )
-	, mDepTable("PxTaskDepTable")
-	, mTaskTable("PxTaskTable")
 	, mStartDispatch("StartDispatch")
 {
 }
@@ -190,8 +295,8 @@ void PxTaskMgr::resetDependencies()
 {
 	PX_ASSERT( !mPendingTasks ); // only valid if you don't resubmit named tasks, this is true for the SDK
     PX_ASSERT( mCpuDispatcher );
-    mTaskTable.clear();
-    mDepTable.clear();
+    mTaskTable.reset();
+    mDepTable.reset();
     mName2IDmap.clear();
     mPendingTasks = 0;
 }
@@ -208,7 +313,8 @@ void PxTaskMgr::startSimulation()
 	if( mPendingTasks == 0 )
 		return;
 
-    for( PxTaskID i = 0 ; i < mTaskTable.size() ; i++ )
+	const uint32_t nbTasks = mTaskTable.size();
+    for( PxTaskID i = 0 ; i < nbTasks ; i++ )
     {
 		if(	mTaskTable[ i ].mType == PxTaskType::eCOMPLETED )
 		{
@@ -251,10 +357,30 @@ PxTaskID PxTaskMgr::getNamedTask( const char *name )
 
 PxTask* PxTaskMgr::getTaskFromID( PxTaskID id )
 {
-	LOCK(); // todo: reader lock necessary?
 	return mTaskTable[ id ].mTask;
 }
 
+/*
+ * Add a new row to the task table. Thread-safe, lock-free.
+ */
+PxTaskID PxTaskMgr::allocateRow( PxTask* task, PxTaskType::Enum type )
+{
+	const PxTaskID id = mTaskTable.allocate();
+	if( task )
+	{
+		task->mTaskID = id;
+	}
+	if( id == INVALID_TASK_ID )
+	{
+		mErrorCallback.reportError(PxErrorCode::eOUT_OF_MEMORY, "PxTaskManager: too many tasks submitted in a single frame", PX_FL);
+		return id;
+	}
+
+	PxAtomicIncrement(&mPendingTasks);
+	mTaskTable[ id ].init( task, type );
+	return id;
+}
+
 /* If called at runtime, must be thread-safe */
 PxTaskID PxTaskMgr::submitNamedTask( PxTask *task, const char *name, PxTaskType::Enum type )
 {
@@ -283,17 +409,9 @@ PxTaskID PxTaskMgr::submitNamedTask( PxTask *task, const char *name, PxTaskType:
     }
     else
     {
-        PxAtomicIncrement(&mPendingTasks);
-        PxTaskID id = static_cast<PxTaskID>(mTaskTable.size());
-        mName2IDmap[ name ] = id;
-        if( task )
-		{
-            task->mTaskID = id;
-		}
-        PxTaskTableRow r;
-        r.mTask = task;
-        r.mType = type;
-		mTaskTable.pushBack(r);
+        const PxTaskID id = allocateRow( task, type );
+        if( id != INVALID_TASK_ID )
+            mName2IDmap[ name ] = id;
         return id;
     }
 }
@@ -303,18 +421,10 @@ PxTaskID PxTaskMgr::submitNamedTask( PxTask *task, const char *name, PxTaskType:
  */
 PxTaskID PxTaskMgr::submitUnnamedTask( PxTask& task, PxTaskType::Enum type )
 {
-    PxAtomicIncrement(&mPendingTasks);
-
 	task.mTm = this;
     task.submitted();
-    
-	LOCK();
-    task.mTaskID = static_cast<PxTaskID>(mTaskTable.size());
-    PxTaskTableRow r;
-    r.mTask = &task;
-    r.mType = type;
-    mTaskTable.pushBack(r);
-    return task.mTaskID;
+
+    return allocateRow( &task, type );
 }
 
 /* Called by worker threads (or cooperating application threads) when a
@@ -324,7 +434,6 @@ PxTaskID PxTaskMgr::submitUnnamedTask( PxTask& task, PxTaskType::Enum type )
  */
 void PxTaskMgr::taskCompleted( PxTask& task )
 {
-    LOCK();
 	resolveRow(task.mTaskID);
 }
 
@@ -336,11 +445,7 @@ void PxTaskMgr::taskCompleted( PxTask& task )
  */
 void PxTaskMgr::finishBefore( PxTask& task, PxTaskID taskID )
 {
-    LOCK();
-	PX_ASSERT( mTaskTable[ taskID ].mType != PxTaskType::eCOMPLETED );
-
-    mTaskTable[ task.mTaskID ].addDependency( mDepTable, taskID );
-	PxAtomicIncrement( &mTaskTable[ taskID ].mRefCount );
+	addDependency( task.mTaskID, taskID );
 }
 
 /*
@@ -349,26 +454,51 @@ void PxTaskMgr::finishBefore( PxTask& task, PxTaskID taskID )
  */
 void PxTaskMgr::startAfter( PxTask& task, PxTaskID taskID )
 {
-    LOCK();
-	PX_ASSERT( mTaskTable[ taskID ].mType != PxTaskType::eCOMPLETED );
+	addDependency( taskID, task.mTaskID );
+}
+
+/*
+ * Make 'toTaskID' wait for 'fromTaskID' to complete. Thread-safe, lock-free.
+ */
+void PxTaskMgr::addDependency( PxTaskID fromTaskID, PxTaskID toTaskID )
+{
+	if( fromTaskID == INVALID_TASK_ID || toTaskID == INVALID_TASK_ID )
+	{
+		mErrorCallback.reportError(PxErrorCode::eINVALID_OPERATION, "PxTaskManager: dependency on a task that could not be submitted", PX_FL);
+		return;
+	}
+
+	PX_ASSERT( mTaskTable[ toTaskID ].mType != PxTaskType::eCOMPLETED );
+
+	// the reference must be taken before the dependency becomes visible to resolveRow()
+	PxAtomicIncrement( &mTaskTable[ toTaskID ].mRefCount );
 
-    mTaskTable[ taskID ].addDependency( mDepTable, task.mTaskID );
-	PxAtomicIncrement( &mTaskTable[ task.mTaskID ].mRefCount );
+	switch( mTaskTable[ fromTaskID ].addDependency( mDepTable, toTaskID ) )
+	{
+	case PxTaskTableRow::eADDED:
+		break;
+	case PxTaskTableRow::eALREADY_RESOLVED:
+		decrReference( toTaskID );	// 'fromTaskID' already completed
+		break;
+	case PxTaskTableRow::eOUT_OF_MEMORY:
+		// the ordering can't be enforced. Report it, and let the task run rather than deadlocking the frame.
+		mErrorCallback.reportError(PxErrorCode::eOUT_OF_MEMORY, "PxTaskManager: too many task dependencies in a single frame, task ordering is not enforced", PX_FL);
+		decrReference( toTaskID );
+		break;
+	}
 }
 
 void PxTaskMgr::addReference( PxTaskID taskID )
 {
-    LOCK();
     PxAtomicIncrement( &mTaskTable[ taskID ].mRefCount );
 }
 
 /*
- * Remove one reference count from a task. Must be done here to make it thread safe.
+ * Remove one reference count from a task. Only the thread bringing it to
+ * zero dispatches the task, so this does not need a lock.
  */
 void PxTaskMgr::decrReference( PxTaskID taskID )
 {
-    LOCK();
-
     if( !PxAtomicDecrement( &mTaskTable[ taskID ].mRefCount ) )
     {
 		dispatchTask(taskID);
@@ -387,11 +517,24 @@ int32_t PxTaskMgr::getReference(PxTaskID taskID) const
  */
 void PxTaskMgr::resolveRow( PxTaskID taskID )
 {
-    int depRow = mTaskTable[ taskID ].mStartDep;
+	// seal the list so that late dependencies are resolved by their submitter
+    int depRow = PxAtomicExchange( &mTaskTable[ taskID ].mStartDep, SEALED );
 
-    while( depRow != EOL )
+	// the list is ours now. Dependencies were inserted at its head, reverse it to dispatch them in FIFO order.
+	int reversed = EOL;
+	while( depRow >= 0 )
+	{
+		PxTaskDepTableRow& row = mDepTable[ uint32_t(depRow) ];
+		const int next = row.mNextDep;
+		row.mNextDep = reversed;
+		reversed = depRow;
+		depRow = next;
+	}
+	depRow = reversed;
+
+    while( depRow >= 0 )
     {
-        PxTaskDepTableRow& row = mDepTable[ uint32_t(depRow) ];
+        const PxTaskDepTableRow& row = mDepTable[ uint32_t(depRow) ];
         PxTaskTableRow& dtt = mTaskTable[ row.mTaskID ];
 
         if( !PxAtomicDecrement( &dtt.mRefCount ) )
@@ -410,17 +553,12 @@ void PxTaskMgr::resolveRow( PxTaskID taskID )
  */
 void PxTaskMgr::dispatchTask( PxTaskID taskID )
 {
-	LOCK(); // todo: reader lock necessary?
     PxTaskTableRow& tt = mTaskTable[ taskID ];
 
 	// prevent re-submission
-    if( tt.mType == PxTaskType::eCOMPLETED )
-    {		
-		mErrorCallback.reportError(PxErrorCode::eDEBUG_WARNING, "PxTask dispatched twice", PX_FL);
-		return;
-    }
+	const int type = PxAtomicExchange( &tt.mType, PxTaskType::eCOMPLETED );
 
-    switch ( tt.mType )
+    switch ( type )
     {
     case PxTaskType::eCPU:
         mCpuDispatcher->submitTask( *tt.mTask );
@@ -432,13 +570,13 @@ void PxTaskMgr::dispatchTask( PxTaskID taskID )
         resolveRow( taskID );
 		break;
 	case PxTaskType::eCOMPLETED:
+		mErrorCallback.reportError(PxErrorCode::eDEBUG_WARNING, "PxTask dispatched twice", PX_FL);
+		break;
     default:
         mErrorCallback.reportError(PxErrorCode::eDEBUG_WARNING, "Unknown task type", PX_FL);
         resolveRow( taskID );
         break;
     }
-
-    tt.mType = PxTaskType::eCOMPLETED;
 }
 
 }// end physx namespace